@@ -0,0 +1,382 @@
+/* Atlas Module Implementation
+ *
+ * Atlas.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio>               // for sprintf
+#include <cstring>              // for strlen, memset, memmove
+#include <cctype>               // for tolower
+#include <new>                  // for std::nothrow
+#include "DeviceSettings.h"     // for TEXTURE_BAKE, TEXTURE_BAKE_THREADS
+#include "ModelSettings.h"      // for ATLAS_PAGE, ATLAS_PADDING, ATLAS_LEVELS
+#include "Utilities.h"          // for error(), report(), strcopy(), ticks()
+#include "ImageDecoder.h"       // for Image, loadImage, decompressImage
+#include "TextureCompressor.h"  // for buildMipChain, compressImage
+#include "TextureBaker.h"       // for isBaked, saveBakedImage
+#include "Files.h"              // for fileStamp
+#include "Atlas.h"              // for Atlas
+
+// placements are aligned to the texels of the smallest level and to the
+// 4 x 4 blocks of a compressed page
+const int ALIGN = ATLAS_LEVELS > 3 ? 1 << (ATLAS_LEVELS - 1) : 4;
+
+//-------------------------------- Skyline -------------------------------
+//
+// Skyline is a segment of the upper outline of the rectangles packed into
+// a page - the segments of a page cover its width from left to right
+//
+struct Skyline {
+	int x; // left edge of the segment
+	int y; // lowest free row above the segment
+	int w; // width of the segment
+};
+
+// rest returns the row at which a w x h rectangle with its left edge at
+// segment i rests on the n segments at s - -1 if it leaves the page
+//
+static int rest(const Skyline* s, int n, int i, int w, int h) {
+
+	if (s[i].x + w > ATLAS_PAGE)
+		return -1;
+	int y = s[i].y;
+	for (int j = i, left = w; left > 0; j++) {
+		if (j == n)
+			return -1;
+		if (s[j].y > y)
+			y = s[j].y;
+		left -= s[j].w;
+	}
+
+	return y + h <= ATLAS_PAGE ? y : -1;
+}
+
+// pack places a w x h rectangle as low as possible on the n segments at
+// s, and then as far left as possible, and returns true if it fits - the
+// segments are raised over the rectangle and each pair of neighbouring
+// segments at the same height is merged
+//
+static bool pack(Skyline* s, int& n, int w, int h, int& x, int& y) {
+
+	int best = -1;
+	y = ATLAS_PAGE;
+	for (int i = 0; i < n; i++) {
+		int r = rest(s, n, i, w, h);
+		if (r >= 0 && r < y) {
+			best = i;
+			y    = r;
+		}
+	}
+	if (best < 0)
+		return false;
+	x = s[best].x;
+
+	// the new segment replaces those that the rectangle covers
+	memmove(s + best + 1, s + best, (n - best) * sizeof *s);
+	n++;
+	s[best].x = x;
+	s[best].y = y + h;
+	s[best].w = w;
+	for (int j = best + 1; j < n; ) {
+		int cover = x + w - s[j].x;
+		if (cover <= 0)
+			break;
+		if (cover < s[j].w) {
+			s[j].x += cover;
+			s[j].w -= cover;
+			break;
+		}
+		memmove(s + j, s + j + 1, (n - j - 1) * sizeof *s);
+		n--;
+	}
+	for (int j = 0; j + 1 < n; )
+		if (s[j].y == s[j + 1].y) {
+			s[j].w += s[j + 1].w;
+			memmove(s + j + 1, s + j + 2, (n - j - 2) * sizeof *s);
+			n--;
+		}
+		else
+			j++;
+
+	return true;
+}
+
+//-------------------------------- Stamps --------------------------------
+//
+// mix folds the four bytes of v into the FNV-1a hash h
+//
+inline unsigned mix(unsigned h, unsigned v) {
+
+	for (int i = 0; i < 4; i++, v >>= 8)
+		h = (h ^ (v & 0xFF)) * 16777619u;
+
+	return h;
+}
+
+// same returns true if a and b name the same file, regardless of case
+//
+static bool same(const char* a, const char* b) {
+
+	while (*a && tolower(*a) == tolower(*b)) {
+		a++;
+		b++;
+	}
+
+	return !*a && !*b;
+}
+
+// roundUp returns the smallest power of two not less than n and min
+//
+inline int roundUp(int n, int min) {
+
+	int p = min;
+	while (p < n)
+		p *= 2;
+
+	return p;
+}
+
+//-------------------------------- Atlas ---------------------------------
+//
+// Atlas packs small texture files into shared pages
+//
+Atlas::Entry* Atlas::entry    = NULL;
+int           Atlas::nEntries = 0;
+char**        Atlas::page     = NULL;
+int           Atlas::nPages   = 0;
+
+// build packs the n texture files named in file into pages, composing
+// each page whose file is out of date, and returns the number of pages -
+// a file that cannot be decoded, is larger than ATLAS_MAX_SIDE or would
+// be alone on its page is left out and is loaded as a texture of its own
+//
+int Atlas::build(const char* const* file, int n) {
+
+	clear();
+	if (!file || n <= 0)
+		return 0;
+
+	entry    = new Entry[n];
+	nEntries = n;
+	Image* image = new Image[n];
+	int*   order = new int[n];
+	int    m     = 0;
+	for (int i = 0; i < n; i++) {
+		Entry& e = entry[i];
+		e.file = NULL;
+		e.page = -1;
+		if (file[i]) {
+			e.file = new char[strlen(file[i]) + 1];
+			strcopy(e.file, file[i], strlen(file[i]));
+		}
+		image[i].data = NULL;
+		if (!file[i] || !loadImage(file[i], image[i]) ||
+		 !decompressImage(image[i]) || image[i].width > ATLAS_MAX_SIDE ||
+		 image[i].height > ATLAS_MAX_SIDE) {
+			releaseImage(image[i]);
+			continue;
+		}
+		e.w = (image[i].width + 2 * ATLAS_PADDING + ALIGN - 1) / ALIGN *
+		 ALIGN;
+		e.h = (image[i].height + 2 * ATLAS_PADDING + ALIGN - 1) / ALIGN *
+		 ALIGN;
+		if (e.w > ATLAS_PAGE || e.h > ATLAS_PAGE) {
+			releaseImage(image[i]);
+			continue;
+		}
+		// keep the files in order of height, tallest first
+		int k = m++;
+		for (; k > 0 && (entry[order[k - 1]].h < e.h ||
+		 (entry[order[k - 1]].h == e.h && entry[order[k - 1]].w < e.w));
+		 k--)
+			order[k] = order[k - 1];
+		order[k] = i;
+	}
+
+	// place each file on the first page with room for it - a page never
+	// has more than two segments more than the files on it
+	Skyline** sky  = new Skyline*[m + 1];
+	int*      nSky = new int[m + 1];
+	for (int k = 0; k < m; k++) {
+		Entry& e = entry[order[k]];
+		for (int p = 0; e.page < 0; p++) {
+			if (p == nPages) {
+				sky[p] = new Skyline[m + 2];
+				sky[p][0].x = 0;
+				sky[p][0].y = 0;
+				sky[p][0].w = ATLAS_PAGE;
+				nSky[p] = 1;
+				nPages++;
+			}
+			if (pack(sky[p], nSky[p], e.w, e.h, e.x, e.y))
+				e.page = p;
+		}
+	}
+	for (int p = 0; p < nPages; p++)
+		delete [] sky[p];
+	delete [] sky;
+	delete [] nSky;
+
+	// a page that holds a single file batches nothing and would only
+	// filter and compress the file again - the file is left out
+	int* renumber = new int[nPages + 1];
+	for (int p = 0; p < nPages; p++)
+		renumber[p] = 0;
+	for (int i = 0; i < n; i++)
+		if (entry[i].page >= 0)
+			renumber[entry[i].page]++;
+	int kept = 0;
+	for (int p = 0; p < nPages; p++)
+		renumber[p] = renumber[p] > 1 ? kept++ : -1;
+	for (int i = 0; i < n; i++)
+		if (entry[i].page >= 0)
+			entry[i].page = renumber[entry[i].page];
+	nPages = kept;
+	delete [] renumber;
+
+	// size each page to the files on it, map the files into it and
+	// compose it if its file does not hold the same files in the same
+	// places
+	page = new char*[nPages];
+	for (int p = 0; p < nPages; p++) {
+		page[p] = new char[MAX_PATH + 1];
+		sprintf(page[p], ATLAS_FILE, p);
+		int width = ALIGN, height = ALIGN;
+		for (int i = 0; i < n; i++)
+			if (entry[i].page == p) {
+				width  = roundUp(entry[i].x + entry[i].w, width);
+				height = roundUp(entry[i].y + entry[i].h, height);
+			}
+		unsigned key[3] = {2166136261u, 2166136261u, 2166136261u};
+		key[1] = mix(mix(mix(key[1], width), height), ATLAS_PADDING <<
+		 16 | ATLAS_LEVELS << 8 | TEXTURE_BAKE);
+		for (int i = 0; i < n; i++) {
+			Entry& e = entry[i];
+			if (e.page != p)
+				continue;
+			e.region[0] = float(e.x + ATLAS_PADDING) / width;
+			e.region[1] = float(e.y + ATLAS_PADDING) / height;
+			e.region[2] = float(image[i].width) / width;
+			e.region[3] = float(image[i].height) / height;
+			unsigned stamp[3] = {0, 0, 0};
+			fileStamp(e.file, stamp);
+			for (int j = 0; j < 3; j++)
+				key[0] = mix(key[0], stamp[j]);
+			key[1] = mix(mix(key[1], e.x << 16 | e.y), image[i].width <<
+			 16 | image[i].height);
+			for (const char* c = e.file; *c; c++)
+				key[2] = mix(key[2], tolower(*c));
+		}
+		if (!isBaked(page[p], key))
+			compose(p, width, height, image, key);
+	}
+
+	for (int i = 0; i < n; i++)
+		releaseImage(image[i]);
+	delete [] image;
+	delete [] order;
+
+	return nPages;
+}
+
+// compose composes page p of width x height texels from the decoded
+// files at image, filters its mip levels, compresses it if textures are
+// baked and saves it stamped with key
+//
+void Atlas::compose(int p, int width, int height, const Image* image,
+ const unsigned* key) {
+
+	LONGLONG begin = ticks();
+	Image a;
+	a.width  = width;
+	a.height = height;
+	a.levels = 1;
+	a.format = IMAGE_ARGB;
+	a.size   = width * height * 4;
+	a.data   = (unsigned char*)new (std::nothrow) unsigned[width * height];
+	if (!a.data) {
+		error("Atlas::10 Couldn\'t allocate an atlas page");
+		return;
+	}
+	memset(a.data, 0, a.size);
+
+	// copy each file into its place, repeating its edges into the
+	// padding around it
+	unsigned* t = (unsigned*)a.data;
+	int nFiles = 0;
+	for (int i = 0; i < nEntries; i++) {
+		const Entry& e = entry[i];
+		if (e.page != p)
+			continue;
+		const unsigned* src = (const unsigned*)image[i].data;
+		int w = image[i].width, h = image[i].height;
+		for (int r = 0; r < e.h; r++) {
+			int sy = r < ATLAS_PADDING ? 0 : r - ATLAS_PADDING < h ?
+			 r - ATLAS_PADDING : h - 1;
+			const unsigned* s = src + sy * w;
+			unsigned* d = t + (e.y + r) * width + e.x;
+			for (int c = 0; c < e.w; c++)
+				d[c] = s[c < ATLAS_PADDING ? 0 : c - ATLAS_PADDING < w ?
+				 c - ATLAS_PADDING : w - 1];
+		}
+		nFiles++;
+	}
+
+	// keep the levels that the padding protects
+	if (ATLAS_LEVELS > 1 && buildMipChain(a, TEXTURE_BAKE_THREADS) &&
+	 a.levels > ATLAS_LEVELS) {
+		int size = 0;
+		for (int l = 0, w = width, h = height; l < ATLAS_LEVELS; l++) {
+			size += imageLevelSize(IMAGE_ARGB, w, h);
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+		}
+		a.levels = ATLAS_LEVELS;
+		a.size   = size;
+	}
+	if (TEXTURE_BAKE)
+		compressImage(a, TEXTURE_BAKE_THREADS);
+	bool saved = saveBakedImage(page[p], a, key);
+
+	char str[MAX_PATH + 81];
+	sprintf(str, "Atlas: composed %s %dx%d from %d files in %d ms%s",
+	 page[p], width, height, nFiles, microseconds(begin, ticks()) / 1000,
+	 saved ? "" : " - couldn\'t save the page");
+	report(str);
+	releaseImage(a);
+}
+
+// find returns the name of the page that holds file and its region of
+// the page - left, top, width and height - through region, or NULL if
+// file is not packed
+//
+const char* Atlas::find(const char* file, float* region) {
+
+	for (int i = 0; file && i < nEntries; i++)
+		if (entry[i].page >= 0 && entry[i].file &&
+		 same(entry[i].file, file)) {
+			for (int j = 0; j < 4; j++)
+				region[j] = entry[i].region[j];
+			return page[entry[i].page];
+		}
+
+	return NULL;
+}
+
+// clear forgets the packed files and the pages
+//
+void Atlas::clear() {
+
+	for (int i = 0; i < nEntries; i++)
+		delete [] entry[i].file;
+	delete [] entry;
+	for (int p = 0; p < nPages; p++)
+		delete [] page[p];
+	delete [] page;
+	entry    = NULL;
+	nEntries = 0;
+	page     = NULL;
+	nPages   = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef _ATLAS_H_
+#define _ATLAS_H_
+
+/* Header for the Atlas Module
+ *
+ * consists of Atlas declaration
+ *
+ * Atlas.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Atlas ---------------------------------
+//
+// Atlas packs small texture files into shared pages, so that surfaces
+// covered by different files sample the same texture and can be drawn
+// in one batch.  A texture created from a packed file samples the file's
+// page, and whatever it covers - an object, a particle or the hud - maps
+// its texture coordinates into the file's region of the page through
+// map() - which suits billboards, sprites and other surfaces whose
+// coordinates stay within [0, 1], but not surfaces that repeat their
+// texture
+//
+// Each file is placed on the first page with room for it, tallest file
+// first, by a skyline packer.  Its edges are repeated ATLAS_PADDING
+// texels around it and its place is aligned to 2^(ATLAS_LEVELS - 1)
+// texels, so that neither the ATLAS_LEVELS mip levels of a page nor its
+// 4 x 4 blocks mix the texels of neighbouring files.  Each page is saved
+// as a baked file named by ATLAS_FILE, stamped with the files that it
+// holds and where, and is composed again only when one of them changes.
+// A page that would hold a single file is not made - the file gains
+// nothing from it and, if compressed, would lose detail in recompression
+//
+struct Image;
+
+class Atlas {
+
+	// Entry is a texture file packed into a page
+	struct Entry {
+		char* file;      // name of the texture file
+		int   page;      // page that holds the file, -1 if not packed
+		int   x;         // left edge of the padded texels in the page
+		int   y;         // top edge of the padded texels in the page
+		int   w;         // width of the padded texels
+		int   h;         // height of the padded texels
+		float region[4]; // left, top, width and height in the page
+	};
+
+	static Entry* entry;    // packed files
+	static int    nEntries; // number of packed files
+	static char** page;     // names of the page files
+	static int    nPages;   // number of pages
+
+	static void compose(int p, int width, int height, const Image* image,
+	 const unsigned* key);
+
+  public:
+	static int         build(const char* const* file, int n);
+	static const char* find(const char* file, float* region);
+	static void        clear();
+	// map maps the texture coordinates [u, v] of a file to those of its
+	// region of the page - left, top, width and height
+	static void map(const float* region, float& u, float& v) {
+		u = region[0] + u * region[2];
+		v = region[1] + v * region[3];
+	}
+};
+
+#endif
@@ -0,0 +1,228 @@
+/* Component Store Implementation
+ *
+ * Components.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "Frame.h"      // for Frame
+#include "ICameras.h"   // for ICameras
+#include "Components.h" // for Components
+
+//-------------------------------- Components ----------------------------
+//
+// Components stores each kind of component in its own contiguous array
+// and runs the systems that update them
+//
+SlotMap<Transform> Components::transforms;
+SlotMap<Motion>    Components::motions;
+SlotMap<Bounds>    Components::bounds;
+SlotMap<Facing>    Components::facings;
+SlotMap<Matrix>    Components::saved;
+
+// addTransform adds an identity transform with unit scale and no parent
+// and returns its handle
+//
+Handle Components::addTransform() {
+
+	Transform t;
+	t.T      = Matrix(1);
+	t.s      = Vector(1, 1, 1);
+	t.parent = 0;
+
+	return transforms.add(t);
+}
+
+// addMotion adds a motion at rest that displaces transform h and returns
+// its handle
+//
+Handle Components::addMotion(Handle h) {
+
+	Motion m;
+	m.transform = h;
+
+	return motions.add(m);
+}
+
+// addBounds adds an empty set of bounding volumes and returns its handle
+//
+Handle Components::addBounds() {
+
+	Bounds b;
+	b.hasSphere   = false;
+	b.hasCylinder = false;
+	b.hasBox      = false;
+	b.radius      = 0;
+	b.height      = 0;
+	b.sx = b.sy = b.sz = 0;
+
+	return bounds.add(b);
+}
+
+// addFacing adds a facing of the given type that orients transform h
+// towards the current camera and returns its handle
+//
+Handle Components::addFacing(Handle h, ICameras* cameras,
+ Orientation type) {
+
+	Facing f;
+	f.transform = h;
+	f.cameras   = cameras;
+	f.type      = type;
+
+	return facings.add(f);
+}
+
+// addSaved adds an identity orientation and returns its handle
+//
+Handle Components::addSaved() {
+
+	return saved.add(Matrix(1));
+}
+
+// move translates transform t by vector [x, y, z]
+//
+void Components::move(Transform& t, float x, float y, float z) {
+
+    Matrix trans;
+	t.T *= ::translate(trans, x, y, z);
+}
+
+// rotate rotates transform t about its origin using rotation matrix rot
+//
+void Components::rotate(Transform& t, const Matrix& rot) {
+
+    Vector cr(t.T.m41, t.T.m42, t.T.m43);
+    move(t, -cr.x, -cr.y, -cr.z);
+    t.T *= rot;
+    move(t, cr.x, cr.y, cr.z);
+}
+
+// orient replaces the orientation of transform t with rot, keeping its
+// position and scale
+//
+void Components::orient(Transform& t, const Matrix& rot) {
+
+    Matrix trans;
+	Vector p(t.T.m41, t.T.m42, t.T.m43);
+    t.T.isIdentity();
+    t.T *= rot;
+	t.T *= ::scale(trans, t.s.x, t.s.y, t.s.z);
+    move(t, p.x, p.y, p.z);
+}
+
+// position returns the position of transform t in world space
+//
+Vector Components::position(const Transform& t) {
+
+	return t.parent ? ::position(t.T) * t.parent->rotation() +
+	 t.parent->position() : ::position(t.T);
+}
+
+// rotation returns the orientation of transform t with respect to world
+// space
+//
+Matrix Components::rotation(const Transform& t) {
+
+	return t.parent ? ::rotation(t.T) * t.parent->rotation() :
+	 ::rotation(t.T);
+}
+
+// integrate moves the transform displaced by motion m into its new
+// position after time step dt
+//
+// this function receives the time step in SECONDS while much of the code
+// uses milliseconds as the time unit
+//
+void Components::integrate(Motion& m, float dt) {
+
+	Transform* t = transforms.find(m.transform);
+	if (!t) return;
+
+	// calculate linear displacement
+	Vector disp = dt * m.v + 0.5f * dt * dt * m.a;
+
+	// displace the frame
+	move(*t, disp.x, disp.y, disp.z);
+
+	// update the linear velocity
+	m.v += dt * m.a;
+
+	// calculate the change in orientation
+	Vector& w = m.angular_v;
+	Matrix omega(   0,  w.z, -w.y, 0,
+				 -w.z,    0,  w.x, 0,
+				  w.y, -w.x,    0, 0,
+				    0,    0,    0, 0);
+	Matrix Rcurrent = rotation(*t);
+	Matrix Rdelta   = dt * (omega * Rcurrent);
+	Matrix Rnew     = orthoNormalize(Rcurrent + Rdelta);
+	Matrix Rnet     = orthoNormalize(Rcurrent.transpose() * Rnew);
+
+	// rotate the frame
+	rotate(*t, Rnet);
+
+	// update the angular velocity
+	m.angular_v += dt * m.angular_a;
+}
+
+// integrate moves every frame in motion into its new position after
+// time step dt in SECONDS
+//
+void Components::integrate(float dt) {
+
+	for (int i = 0; i < motions.size(); i++)
+		integrate(motions[i], dt);
+}
+
+// face orients the transform of facing f towards the current camera
+//
+void Components::face(const Facing& f) {
+
+	Transform* t = transforms.find(f.transform);
+	if (!t) return;
+
+	Vector h, u, r, p = position(*t);
+	switch (f.type) {
+		case SCREEN:
+			h = normal(f.cameras->heading());
+			u = normal(f.cameras->top());
+			r = cross(u, h);
+			break;
+		case VIEW_PLANE:
+			h = normal(f.cameras->heading()); // fixed
+			u = Vector(0, 1, 0);
+			r = cross(u, h);
+			u = cross(h, r);
+			break;
+		case VIEWPOINT:
+			h = normal(p - f.cameras->position()); // fixed
+			u = Vector(0, -1, 0);
+			r = cross(u, h);
+			u = cross(h, r);
+			break;
+		case AXIAL:
+			h = normal(p - f.cameras->position());
+			u = Vector(0, 1, 0); // fixed
+			r = cross(u, h);
+			h = cross(h, r);
+			break;
+		case INVERSE:
+			// no rule turns an inverse billboard - leave it as it is
+			return;
+	}
+	Matrix rot(r.x, r.y, r.z, 0,
+		       u.x, u.y, u.z, 0,
+			   h.x, h.y, h.z, 0,
+			     0,   0,   0, 1);
+	orient(*t, rot);
+}
+
+// face orients every billboard towards the current camera
+//
+void Components::face() {
+
+	for (int i = 0; i < facings.size(); i++)
+		face(facings[i]);
+}
@@ -0,0 +1,126 @@
+#ifndef _COMPONENTS_H_
+#define _COMPONENTS_H_
+
+/* Header for the Component Store
+ *
+ * consists of Transform declaration
+ *             Motion declaration
+ *             Bounds declaration
+ *             Facing declaration
+ *             Components declaration
+ *
+ * Components.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "IScene.h"  // for Orientation
+#include "math.h"    // for Vector, Matrix
+#include "SlotMap.h" // for SlotMap
+
+class Frame;
+class ICameras;
+
+//-------------------------------- Transform -----------------------------
+//
+// A Transform holds the placement of a Frame - every Frame has one
+//
+struct Transform {
+    Matrix T;      // relative transformation matrix wrt parent frame or
+	               // wrt world space if independent
+	Vector s;      // scaling vector
+    Frame* parent; // points to the parent frame, NULL if independent
+};
+
+//-------------------------------- Motion --------------------------------
+//
+// A Motion holds the velocities and accelerations of an AnimatedFrame -
+// only frames that have been set in motion have one
+//
+struct Motion {
+	Handle transform; // transform that the motion displaces
+	Vector v;         // relative linear velocity wrt the parent frame
+	Vector a;         // relative linear acceleration
+	Vector angular_v; // angular velocity wrt the parent frame
+	Vector angular_a; // angular acceleration
+};
+
+//-------------------------------- Bounds --------------------------------
+//
+// Bounds holds the bounding volumes of a Body - only bodies that take
+// part in collision detection have one
+//
+struct Bounds {
+	// level 1 bounds on the body - sphere or cylinder
+	bool   hasSphere;   // has a bounding sphere?
+	bool   hasCylinder; // has a bounding cylinder?
+	float  radius;      // radius of the bounding sphere/cylinder
+	float  height;      // height of the bounding cylinder
+	Vector centroid;    // geometric centre of body wrt to AnimatedFrame
+
+	// level 2 bounds on the body - box aligned with the local axes
+	bool   hasBox;      // has a bounding box?
+	float  sx;          // half side length in x direction
+	float  sy;          // half side length in y direction
+	float  sz;          // half side length in z direction
+	Vector vertex[8];   // list of corner vertices - local space
+};
+
+//-------------------------------- Facing --------------------------------
+//
+// A Facing turns the transform of a Billboard towards the current camera
+//
+struct Facing {
+	Handle      transform; // transform that the facing orients
+	ICameras*   cameras;   // points to the set of cameras
+	Orientation type;      // method of orientation
+};
+
+//-------------------------------- Components ----------------------------
+//
+// Components stores each kind of component in its own contiguous array
+// and runs the systems that update them - an object holds only the
+// handles of the components that it uses
+//
+class Components {
+
+	static SlotMap<Transform> transforms; // placement of every frame
+	static SlotMap<Motion>    motions;    // frames in motion
+	static SlotMap<Bounds>    bounds;     // bodies with bounding volumes
+	static SlotMap<Facing>    facings;    // billboards
+	static SlotMap<Matrix>    saved;      // saved orientations
+
+  public:
+	static Handle     addTransform();
+	static Handle     addMotion(Handle transform);
+	static Handle     addBounds();
+	static Handle     addFacing(Handle transform, ICameras* cameras,
+	 Orientation type);
+	static Handle     addSaved();
+	static Transform* transform(Handle h) { return transforms.find(h); }
+	static Motion*    motion(Handle h)    { return motions.find(h); }
+	static Bounds*    bound(Handle h)     { return bounds.find(h); }
+	static Facing*    facing(Handle h)    { return facings.find(h); }
+	static Matrix*    orientation(Handle h) { return saved.find(h); }
+	static void       removeTransform(Handle h) { transforms.remove(h); }
+	static void       removeMotion(Handle h)    { motions.remove(h); }
+	static void       removeBounds(Handle h)    { bounds.remove(h); }
+	static void       removeFacing(Handle h)    { facings.remove(h); }
+	static void       removeSaved(Handle h)     { saved.remove(h); }
+
+	// operations on a single transform
+	static void   move(Transform& t, float x, float y, float z);
+	static void   rotate(Transform& t, const Matrix& rot);
+	static void   orient(Transform& t, const Matrix& rot);
+	static Vector position(const Transform& t);
+	static Matrix rotation(const Transform& t);
+
+	// systems
+	static void   integrate(Motion& m, float dt);
+	static void   integrate(float dt);
+	static void   face(const Facing& f);
+	static void   face();
+};
+
+#endif
@@ -1,106 +1,181 @@
-#ifndef _DEVICE_SETTINGS_H_
-#define _DEVICE_SETTINGS_H_
-
-/* Header for Device Component Configuration
- *
- * DeviceSettings.h
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include "Settings.h" // for keypress codes
-
-// available api's
-#define DIRECT3D   1
-#define OPENGL     2
-
-// select the api here and change the linker input accordingly
-//    Direct3D - d3d9.lib d3dx9.lib 
-//    OpenGL   - opengl32.lib glu32.lib
-//
-#define GRAPHICS_API DIRECT3D
-//#define GRAPHICS_API OPENGL
-
-// windowing parameters
-#if GRAPHICS_API == DIRECT3D
-#define WND_EXSTYLE   0
-#define WND_STYLE     WS_OVERLAPPEDWINDOW
-#define D3D_NO_DOC_FORMATS 6
-#define D3D_DOC_FORMATS { D3DFMT_X8R8G8B8, D3DFMT_A8R8G8B8,\
-     D3DFMT_A2R10G10B10, D3DFMT_X1R5G5B5, D3DFMT_A1R5G5B5,\
-     D3DFMT_R5G6B5 }
-#define D3D_FORMAT_WINDOW 5
-// short descriptions for each format. In practice, you
-// just might want to call them either "16" or "32" (so
-// the user is deciding between 16 and 32 bit colour)
-// but we are making them all different here so that we
-// can learn what modes the hardware we have makes available.
-#define D3D_FORMAT_DESC { "X32", "A32", "A30+2", "X15", "A16", "16" }
-#elif GRAPHICS_API == OPENGL
-#define WND_EXSTYLE WS_EX_APPWINDOW | WS_EX_WINDOWEDGE
-#define WND_STYLE   WS_OVERLAPPEDWINDOW | WS_CLIPSIBLINGS | WS_CLIPCHILDREN
-#endif
-// background colour
-#if GRAPHICS_API == DIRECT3D
-#define BGROUND_R 200
-#define BGROUND_G 200
-#define BGROUND_B 200
-#elif GRAPHICS_API == OPENGL
-#define BGROUND_R .4f
-#define BGROUND_G .4f
-#define BGROUND_B .4f
-#endif
-
-// hud background colour
-//
-#define SPRITE_R 255
-#define SPRITE_G 255
-#define SPRITE_B 255
-#define SPRITE_A  32
-
-// projection transformation
-//
-// frustum properties
-#define NEAR_CLIPPING 1.0f
-#define FAR_CLIPPING  2000.f
-#if GRAPHICS_API == DIRECT3D
-#define FIELD_OF_VIEW 0.9f // radians for Direct3D
-#elif GRAPHICS_API == OPENGL
-#define FIELD_OF_VIEW 51.57f // degrees for OpenGL
-#endif
-
-// text display colour
-//
-#if GRAPHICS_API == DIRECT3D
-#define TEXT_R 255
-#define TEXT_G 255
-#define TEXT_B 255
-#define TEXT_A 255
-#elif GRAPHICS_API == OPENGL
-#define TEXT_R 1.f
-#define TEXT_G 1.f
-#define TEXT_B 1.f
-#define TEXT_A 1.f
-#endif
-
-// font reference
-//
-#if GRAPHICS_API == DIRECT3D
-#elif GRAPHICS_API == OPENGL
-#define FONT_REF 1000 // for openGL text display
-#endif
-
-// input device parameters
-//
-#define SAMPLE_BUFFER_SIZE    30
-
-// sound parameters
-//
-#define INTERIOR_CONE 0.67f
-#define MAX_SOUND_BUFFER_SIZE 500000
-#define SOUND_DISTANCE_FACTOR 0.5f     // metres per unit distance
-#define ATTENUATION_DISTANCE_FACTOR 30
-
-#endif
+#ifndef _DEVICE_SETTINGS_H_
+#define _DEVICE_SETTINGS_H_
+
+/* Header for Device Component Configuration
+ *
+ * DeviceSettings.h
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include "Settings.h" // for keypress codes
+
+// available api's
+#define DIRECT3D   1
+#define OPENGL     2
+#define HEADLESS   3
+
+// select the api here and change the linker input accordingly
+//    Direct3D - d3d9.lib d3dx9.lib 
+//    OpenGL   - opengl32.lib glu32.lib
+//    Headless - none (records a command stream instead of drawing)
+// - a build may select it on the command line instead, as the tests do
+//
+#ifndef GRAPHICS_API
+#define GRAPHICS_API DIRECT3D
+//#define GRAPHICS_API OPENGL
+//#define GRAPHICS_API HEADLESS
+#endif
+
+// windowing parameters
+#if GRAPHICS_API == DIRECT3D
+#define WND_EXSTYLE   0
+#define WND_STYLE     WS_OVERLAPPEDWINDOW
+#define D3D_NO_DOC_FORMATS 6
+#define D3D_DOC_FORMATS { D3DFMT_X8R8G8B8, D3DFMT_A8R8G8B8,\
+     D3DFMT_A2R10G10B10, D3DFMT_X1R5G5B5, D3DFMT_A1R5G5B5,\
+     D3DFMT_R5G6B5 }
+#define D3D_FORMAT_WINDOW 5
+// short descriptions for each format. In practice, you
+// just might want to call them either "16" or "32" (so
+// the user is deciding between 16 and 32 bit colour)
+// but we are making them all different here so that we
+// can learn what modes the hardware we have makes available.
+#define D3D_FORMAT_DESC { "X32", "A32", "A30+2", "X15", "A16", "16" }
+#elif GRAPHICS_API == OPENGL
+#define WND_EXSTYLE WS_EX_APPWINDOW | WS_EX_WINDOWEDGE
+#define WND_STYLE   WS_OVERLAPPEDWINDOW | WS_CLIPSIBLINGS | WS_CLIPCHILDREN
+#elif GRAPHICS_API == HEADLESS
+#define WND_EXSTYLE   0
+#define WND_STYLE     0x00CF0000 // WS_OVERLAPPEDWINDOW, without windows.h
+#endif
+// background colour
+#if GRAPHICS_API == DIRECT3D
+#define BGROUND_R 200
+#define BGROUND_G 200
+#define BGROUND_B 200
+#elif GRAPHICS_API == OPENGL
+#define BGROUND_R .4f
+#define BGROUND_G .4f
+#define BGROUND_B .4f
+#elif GRAPHICS_API == HEADLESS
+#define BGROUND_R 200
+#define BGROUND_G 200
+#define BGROUND_B 200
+#endif
+
+// hud background colour
+//
+#define SPRITE_R 255
+#define SPRITE_G 255
+#define SPRITE_B 255
+#define SPRITE_A  32
+
+// projection transformation
+//
+// frustum properties
+#define NEAR_CLIPPING 1.0f
+#define FAR_CLIPPING  2000.f
+#if GRAPHICS_API == DIRECT3D
+#define FIELD_OF_VIEW 0.9f // radians for Direct3D
+#elif GRAPHICS_API == OPENGL
+#define FIELD_OF_VIEW 51.57f // degrees for OpenGL
+#elif GRAPHICS_API == HEADLESS
+#define FIELD_OF_VIEW 0.9f // radians for the headless recorder
+#endif
+
+// text display colour
+//
+#if GRAPHICS_API == DIRECT3D
+#define TEXT_R 255
+#define TEXT_G 255
+#define TEXT_B 255
+#define TEXT_A 255
+#elif GRAPHICS_API == OPENGL
+#define TEXT_R 1.f
+#define TEXT_G 1.f
+#define TEXT_B 1.f
+#define TEXT_A 1.f
+#elif GRAPHICS_API == HEADLESS
+#define TEXT_R 255
+#define TEXT_G 255
+#define TEXT_B 255
+#define TEXT_A 255
+#endif
+
+// font reference
+//
+#if GRAPHICS_API == DIRECT3D
+#elif GRAPHICS_API == OPENGL
+#define FONT_REF 1000 // for openGL text display
+#endif
+
+// device-lost recovery
+//
+#if GRAPHICS_API == DIRECT3D
+#define SHADOW_BUDGET (64 << 20) // bytes of default pool geometry kept in
+                                 // system memory for restores - 0 for none
+#endif
+
+// vertex packing
+//
+#define VERTEX_PACKING 1             // 1 to pack the vertices of a graphic
+#define VERTEX_PACK_ERROR 0.005f     // largest error in a packed position
+#define VERTEX_PACK_UV_ERROR (1.f / 4096) // largest error in a packed
+                                          // texture coordinate
+
+// mesh levels of detail
+//
+#define MESH_LODS 4             // levels of detail generated for a mesh
+#define MESH_LOD_PRIMITIVES 256 // faces below which a mesh has one level
+#define MESH_LOD_ERROR 0.02f    // error of the first coarser level as a
+                                // fraction of the radius - doubles with
+                                // each further level
+
+// texture cache
+//
+#define TEXTURE_BUDGET (128 << 20) // bytes of textures kept on the card
+                                   // before the least recently used are
+                                   // evicted
+
+// texture baking
+//
+#define TEXTURE_BAKE 1            // 1 to build the mip chain of a texture
+                                  // file and compress it on first use
+#define TEXTURE_BAKE_EXT ".baked.dds" // extension appended to the name of
+                                      // a texture file for its baked copy
+#define TEXTURE_BAKE_THREADS 0    // threads that bake a texture - 0 for
+                                  // one per core
+
+// file loading
+//
+#define LOADER_THREADS 2 // threads that read texture and mesh files - 0
+                         // to read them on the render thread
+#define LOADER_REQUESTS 4096 // requests in flight - beyond this many, a
+                             // request is read on the thread submitting it
+
+// headless command stream
+//
+#if GRAPHICS_API == HEADLESS
+#define HEADLESS_REPORT_FRAMES 300 // frames between reports to report.log
+#define HEADLESS_RASTERIZE       1 // 1 to rasterize frames on the cpu
+#define HEADLESS_RASTER_THREADS  0 // worker threads - 0 for one per core
+#define HEADLESS_CAPTURE_FRAMES 60 // frames between captures - 0 for none
+#define HEADLESS_CAPTURE_FILE "frame%05d.ppm" // name of a captured frame
+#define HEADLESS_POINT_SIZE      4 // side of a point sprite in pixels
+#endif
+
+// input device parameters
+//
+#define SAMPLE_BUFFER_SIZE    30
+
+// sound parameters
+//
+#define INTERIOR_CONE 0.67f
+#define MAX_SOUND_BUFFER_SIZE 500000
+#define SOUND_DISTANCE_FACTOR 0.5f     // metres per unit distance
+#define ATTENUATION_DISTANCE_FACTOR 30
+
+#endif
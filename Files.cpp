@@ -0,0 +1,142 @@
+/* Files Module Implementation
+ *
+ * Files.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "Files.h"    // for MappedFile
+
+#ifdef _WIN32
+#include <windows.h>  // for CreateFileMapping, MoveFileEx
+#else
+#include <fcntl.h>    // for open
+#include <unistd.h>   // for close
+#include <pthread.h>  // for pthread_self
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for stat, fstat
+#endif
+#include <cstdio>     // for sprintf, rename, remove
+#include <cstring>    // for strlen
+
+//-------------------------------- MappedFile ----------------------------
+//
+// open maps file name into memory and returns true if successful - an
+// empty file cannot be mapped
+//
+bool MappedFile::open(const char* name) {
+
+	close();
+	#ifdef _WIN32
+	HANDLE f = CreateFile(name, GENERIC_READ, FILE_SHARE_READ, NULL,
+	 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+	if (f == INVALID_HANDLE_VALUE)
+		return false;
+	file    = f;
+	bytes   = GetFileSize(f, NULL);
+	mapping = CreateFileMapping(f, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping)
+		data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	#else
+	int fd = ::open(name, O_RDONLY);
+	struct stat s;
+	if (fd != -1 && !fstat(fd, &s) && s.st_size > 0) {
+		void* v = mmap(NULL, s.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (v != MAP_FAILED) {
+			data  = (const char*)v;
+			bytes = (unsigned)s.st_size;
+		}
+	}
+	// the mapping outlives the descriptor
+	if (fd != -1)
+		::close(fd);
+	#endif
+	if (!data)
+		close();
+
+	return data != 0;
+}
+
+// close unmaps the file
+//
+void MappedFile::close() {
+
+	#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file)
+		CloseHandle(file);
+	#else
+	if (data)
+		munmap((void*)data, bytes);
+	#endif
+	file    = 0;
+	mapping = 0;
+	data    = 0;
+	bytes   = 0;
+}
+
+//-------------------------------- Stamps --------------------------------
+//
+// fileStamp sets the three words of key to the size and the time of the
+// last write of file and returns true if file exists
+//
+bool fileStamp(const char* file, unsigned* key) {
+
+	#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA a;
+	if (!GetFileAttributesEx(file, GetFileExInfoStandard, &a))
+		return false;
+	key[0] = a.nFileSizeLow;
+	key[1] = a.ftLastWriteTime.dwLowDateTime;
+	key[2] = a.ftLastWriteTime.dwHighDateTime;
+	#else
+	struct stat s;
+	if (stat(file, &s))
+		return false;
+	key[0] = (unsigned)s.st_size;
+	key[1] = (unsigned)s.st_mtime;
+	key[2] = (unsigned)((long long)s.st_mtime >> 32);
+	#endif
+
+	return true;
+}
+
+//-------------------------------- Replacing -----------------------------
+//
+// tempName writes file followed by the id of the calling thread into
+// temp[max + 1], so that two threads building the same file do not mix
+// their writes, and returns false if the name is too long
+//
+bool tempName(char* temp, const char* file, int max) {
+
+	if (strlen(file) + 9 > (size_t)max)
+		return false;
+	#ifdef _WIN32
+	unsigned id = GetCurrentThreadId();
+	#else
+	unsigned id = (unsigned)(unsigned long)pthread_self();
+	#endif
+	sprintf(temp, "%s.%x", file, id);
+
+	return true;
+}
+
+// replaceFile renames temp to file, replacing any file of that name,
+// and returns true if successful - temp is removed if it fails
+//
+bool replaceFile(const char* temp, const char* file) {
+
+	#ifdef _WIN32
+	bool rc = MoveFileEx(temp, file, MOVEFILE_REPLACE_EXISTING) != 0;
+	#else
+	bool rc = !rename(temp, file);
+	#endif
+	if (!rc)
+		remove(temp);
+
+	return rc;
+}
@@ -0,0 +1,53 @@
+#ifndef _FILES_H_
+#define _FILES_H_
+
+/* Header for the Files Module
+ *
+ * consists of MappedFile declaration
+ *             file stamping and replacing functions
+ *
+ * Files.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Files ---------------------------------
+//
+// The class and the functions wrap the file system of the host - Win32
+// where _WIN32 is defined and POSIX elsewhere - so that the modules that
+// cache their work in files build on either
+//
+// MappedFile maps a file into memory read-only - the operating system
+// reads only the pages that are touched
+//
+class MappedFile {
+
+	void*       file;    // host file, NULL if none
+	void*       mapping; // host mapping of the file, NULL if none
+	const char* data;    // start of the mapped file, NULL if not mapped
+	unsigned    bytes;   // size of the mapped file
+
+	MappedFile(const MappedFile&);            // prevents copying
+	MappedFile& operator=(const MappedFile&); // prevents assignment
+
+  public:
+	MappedFile() : file(0), mapping(0), data(0), bytes(0) {}
+	~MappedFile() { close(); }
+	bool open(const char* name);
+	void close();
+	const char* view() const { return data; }
+	unsigned    size() const { return bytes; }
+};
+
+// fileStamp sets the three words of key to the size and the time of the
+// last write of file and returns true if file exists
+bool fileStamp(const char* file, unsigned* key);
+// tempName writes a name of its own for a copy of file that the calling
+// thread builds into temp[max + 1] and returns false if it is too long
+bool tempName(char* temp, const char* file, int max);
+// replaceFile puts the complete copy temp in place of file as one step
+// and removes temp if it cannot
+bool replaceFile(const char* temp, const char* file);
+
+#endif
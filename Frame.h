@@ -1,83 +1,95 @@
-#ifndef _FRAME_H_
-#define _FRAME_H_
-
-/* Header for an Object's Reference Frame
- *
- * Frame.h
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include "IScene.h" // for IObject
-#include "math.h"   // for Matrix
-
-//-------------------------------- Frame -----------------------------------
-//
-// a Frame specifies a position and orientation with respect to another 
-// Frame, or if independent, with respect to world space
-//
-class Frame : public IObject {
-
-    Frame* parent; // points to the parent frame, NULL if independent
-    Matrix T;      // relative transformation matrix wrt parent frame or 
-	               // wrt world space if independent
-	Vector s;      // scaling vector
-	Matrix Rold;   // saved orientation matrix
-
-  public:
-    Frame();
-    void    scale(float sx, float sy, float sz);
-    void    rotatex(float rad);
-    void    rotatey(float rad);
-    void    rotatez(float rad);
-	void	planetRotate(float rad);
-    void    rotate(Vector a, float rad);
-    void    rotate(const Matrix& rot);
-    void    move(float x, float y, float z);
-    void    orient(const Matrix& rot);
-	void    save(const Matrix& rot);
-	Matrix  restore() const;
-    Vector  position() const;
-    Matrix  rotation() const;
-    Vector  orientation(const Vector& v) const;
-	Vector  orientation(char c) const;
-    Matrix  world() const;
-	void attach(IObject* newParent, bool reset);
-	void detach();
-    virtual ~Frame() {}
-	friend class ParticleSystem;
-	
-};
-
-//-------------------------------- AnimatedFrame -------------------------
-//
-// An AnimatedFrame is a Frame with linear and angular velocities and 
-// possibly linear and angular accelerations
-//
-class AnimatedFrame : public Frame {
-
-    Frame* parent;    // points to the parent frame, NULL if independent
-	Vector v;         // relative linear velocity wrt the parent frame
-	Vector a;         // relative linear acceleration
-	Vector angular_v; // angular velocity wrt the parent frame
-	Vector angular_a; // angular acceleration
-
-public:
-	AnimatedFrame();
-	Vector velocity() const;
-	Vector acceleration() const;
-	Vector angularVelocity() const;
-	Vector angularAcceleration() const;
-	void   velocity(float vx, float vy, float vz);
-	void   accelerate(float ax, float ay, float az);
-	void   angularVelocity(float vx, float vy, float vz);
-    void   angularAcceleration(float ax, float ay, float az);
-	void   update(float dt);
-	void   reflect(const Vector& n);
-	void   attach(IObject* newParent, bool reset);
-	void   detach();
-};
-
+#ifndef _FRAME_H_
+#define _FRAME_H_
+
+/* Header for an Object's Reference Frame
+ *
+ * Frame.h
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include "IScene.h"     // for IObject
+#include "math.h"       // for Matrix
+#include "Components.h" // for Transform, Motion
+
+//-------------------------------- Frame -----------------------------------
+//
+// a Frame specifies a position and orientation with respect to another 
+// Frame, or if independent, with respect to world space
+//
+// The placement itself is a Transform held in the component store - the
+// Frame holds only its handle
+//
+class Frame : public IObject {
+
+	Handle transform_; // identifies the placement of the frame
+	Handle saved;      // identifies the saved orientation, if any
+
+	Frame(const Frame&);            // prevents copying
+	Frame& operator=(const Frame&); // prevents assignment
+
+  protected:
+	Handle     placement() const { return transform_; }
+	Transform& transform() const { 
+		return *Components::transform(transform_); }
+
+  public:
+    Frame();
+    void    scale(float sx, float sy, float sz);
+    void    rotatex(float rad);
+    void    rotatey(float rad);
+    void    rotatez(float rad);
+	void	planetRotate(float rad);
+    void    rotate(Vector a, float rad);
+    void    rotate(const Matrix& rot);
+    void    move(float x, float y, float z);
+    void    orient(const Matrix& rot);
+	void    save(const Matrix& rot);
+	Matrix  restore() const;
+    Vector  position() const;
+    Matrix  rotation() const;
+    Vector  orientation(const Vector& v) const;
+	Vector  orientation(char c) const;
+    Matrix  world() const;
+	void attach(IObject* newParent, bool reset);
+	void detach();
+    virtual ~Frame();
+	friend class ParticleSystem;
+	
+};
+
+//-------------------------------- AnimatedFrame -------------------------
+//
+// An AnimatedFrame is a Frame with linear and angular velocities and 
+// possibly linear and angular accelerations
+//
+// The velocities and accelerations are a Motion held in the component
+// store, which is added only once the frame is set in motion
+//
+class AnimatedFrame : public Frame {
+
+	Handle motion_; // identifies the motion of the frame, if any
+
+	Motion* motion() const { return Components::motion(motion_); }
+	Motion& moving();
+
+public:
+	AnimatedFrame();
+	virtual ~AnimatedFrame();
+	Vector velocity() const;
+	Vector acceleration() const;
+	Vector angularVelocity() const;
+	Vector angularAcceleration() const;
+	void   velocity(float vx, float vy, float vz);
+	void   accelerate(float ax, float ay, float az);
+	void   angularVelocity(float vx, float vy, float vz);
+    void   angularAcceleration(float ax, float ay, float az);
+	void   update(float dt);
+	void   reflect(const Vector& n);
+	void   attach(IObject* newParent, bool reset);
+	void   detach();
+};
+
 #endif
\ No newline at end of file
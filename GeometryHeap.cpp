@@ -0,0 +1,230 @@
+/* GeometryHeap Module Implementation
+ *
+ * GeometryHeap.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "GeometryHeap.h" // for GeometryHeap
+
+#if GRAPHICS_API == DIRECT3D
+#include "Utilities.h"    // for error()
+
+//-------------------------------- GeometryHeap --------------------------
+//
+// GeometryHeap sub-allocates vertices and indices from large buffers
+//
+// constructor initializes an empty heap
+//
+GeometryHeap::GeometryHeap() : d3dd(NULL), fvf(0), vertexSize(0),
+ nBlocks(0), generation(1) {
+
+	nPages[HEAP_VERTICES] = 0;
+	nPages[HEAP_INDICES]  = 0;
+}
+
+// attach attaches the heap to display device d - vertices are in format
+// f and size bytes long
+//
+void GeometryHeap::attach(LPDIRECT3DDEVICE9 d, DWORD f, int size) {
+
+	release();
+	d3dd       = d;
+	fvf        = f;
+	vertexSize = size;
+}
+
+// addPage creates a new page of the given kind and returns true if
+// successful
+//
+bool GeometryHeap::addPage(HeapKind kind) {
+
+	if (!d3dd || nPages[kind] == MAX_PAGES)
+		return false;
+
+	Page& p = page[kind][nPages[kind]];
+	p.vb = NULL;
+	p.ib = NULL;
+	int units;
+	if (kind == HEAP_VERTICES) {
+		units = PAGE_VERTICES;
+		if (FAILED(d3dd->CreateVertexBuffer(units * vertexSize, 0, fvf,
+		 D3DPOOL_DEFAULT, &p.vb, NULL))) {
+			error("GeometryHeap::10 Couldn\'t create a vertex page");
+			return false;
+		}
+	}
+	else {
+		units = PAGE_INDICES;
+		if (FAILED(d3dd->CreateIndexBuffer(units * sizeof(short), 0,
+		 D3DFMT_INDEX16, D3DPOOL_DEFAULT, &p.ib, NULL))) {
+			error("GeometryHeap::11 Couldn\'t create an index page");
+			return false;
+		}
+	}
+	// the whole page is free
+	p.span        = new Span[MIN_SPANS];
+	p.maxSpans    = MIN_SPANS;
+	p.nSpans      = 1;
+	p.span[0].first = 0;
+	p.span[0].count = units;
+	nPages[kind]++;
+
+	return true;
+}
+
+// take removes n units from the first free run of page p that can hold
+// them, sets first to the first unit taken and returns true if
+// successful
+//
+bool GeometryHeap::take(Page& p, int n, int& first) {
+
+	for (int i = 0; i < p.nSpans; i++) {
+		Span& s = p.span[i];
+		if (s.count >= n) {
+			first    = s.first;
+			s.first += n;
+			s.count -= n;
+			if (!s.count) {
+				for (int j = i + 1; j < p.nSpans; j++)
+					p.span[j - 1] = p.span[j];
+				p.nSpans--;
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// give returns the n units that start at first to page p, merging them
+// with the free runs on either side
+//
+void GeometryHeap::give(Page& p, int first, int n) {
+
+	// find the first free run after the units
+	int i = 0;
+	while (i < p.nSpans && p.span[i].first < first)
+		i++;
+	bool before = i > 0 &&
+	 p.span[i - 1].first + p.span[i - 1].count == first;
+	bool after  = i < p.nSpans && first + n == p.span[i].first;
+
+	if (before && after) {
+		p.span[i - 1].count += n + p.span[i].count;
+		for (int j = i + 1; j < p.nSpans; j++)
+			p.span[j - 1] = p.span[j];
+		p.nSpans--;
+	}
+	else if (before)
+		p.span[i - 1].count += n;
+	else if (after) {
+		p.span[i].first  = first;
+		p.span[i].count += n;
+	}
+	else {
+		if (p.nSpans == p.maxSpans) {
+			Span* s = new Span[2 * p.maxSpans];
+			for (int j = 0; j < p.nSpans; j++)
+				s[j] = p.span[j];
+			delete [] p.span;
+			p.span      = s;
+			p.maxSpans *= 2;
+		}
+		for (int j = p.nSpans; j > i; j--)
+			p.span[j] = p.span[j - 1];
+		p.span[i].first = first;
+		p.span[i].count = n;
+		p.nSpans++;
+	}
+}
+
+// allocate allocates a run of n vertices or indices, adding a page if no
+// page has room, and returns true if successful - a run larger than a
+// page is not allocated
+//
+bool GeometryHeap::allocate(HeapKind kind, int n, HeapBlock& b) {
+
+	int units = kind == HEAP_VERTICES ? PAGE_VERTICES : PAGE_INDICES;
+
+	b.kind  = kind;
+	b.page  = -1;
+	b.count = 0;
+	if (n <= 0 || n > units)
+		return false;
+
+	int first;
+	for (int i = 0; i < nPages[kind] && b.page < 0; i++)
+		if (take(page[kind][i], n, first))
+			b.page = i;
+	if (b.page < 0 && addPage(kind) &&
+	 take(page[kind][nPages[kind] - 1], n, first))
+		b.page = nPages[kind] - 1;
+	if (b.page < 0)
+		return false;
+
+	b.first      = first;
+	b.count      = n;
+	b.generation = generation;
+	nBlocks++;
+
+	return true;
+}
+
+// free returns run b to its page - a run from an earlier generation is
+// ignored
+//
+void GeometryHeap::free(HeapBlock& b) {
+
+	if (b.page >= 0 && b.generation == generation &&
+	 b.page < nPages[b.kind]) {
+		give(page[b.kind][b.page], b.first, b.count);
+		nBlocks--;
+	}
+	b.page  = -1;
+	b.count = 0;
+}
+
+// vertexBuffer returns the vertex buffer that holds run b
+//
+IDirect3DVertexBuffer9* GeometryHeap::vertexBuffer(const HeapBlock& b)
+ const {
+
+	return b.kind == HEAP_VERTICES && b.page >= 0 &&
+	 b.generation == generation ? page[HEAP_VERTICES][b.page].vb : NULL;
+}
+
+// indexBuffer returns the index buffer that holds run b
+//
+IDirect3DIndexBuffer9* GeometryHeap::indexBuffer(const HeapBlock& b)
+ const {
+
+	return b.kind == HEAP_INDICES && b.page >= 0 &&
+	 b.generation == generation ? page[HEAP_INDICES][b.page].ib : NULL;
+}
+
+// release releases every page and starts a new generation
+//
+void GeometryHeap::release() {
+
+	for (int k = 0; k < 2; k++) {
+		for (int i = 0; i < nPages[k]; i++) {
+			Page& p = page[k][i];
+			if (p.vb) p.vb->Release();
+			if (p.ib) p.ib->Release();
+			delete [] p.span;
+		}
+		nPages[k] = 0;
+	}
+	nBlocks = 0;
+	generation++;
+}
+
+// destructor releases the pages
+//
+GeometryHeap::~GeometryHeap() {
+
+	release();
+}
+#endif
@@ -0,0 +1,102 @@
+#ifndef _GEOMETRY_HEAP_H_
+#define _GEOMETRY_HEAP_H_
+
+/* Header for the GeometryHeap Module
+ *
+ * consists of HeapBlock declaration
+ *             GeometryHeap declaration
+ *
+ * GeometryHeap.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+
+#if GRAPHICS_API == DIRECT3D
+#include <d3d9.h> // for basic D3D
+
+//-------------------------------- HeapBlock -----------------------------
+//
+// HeapBlock identifies a run of vertices or indices in a page of the
+// geometry heap
+//
+typedef enum HeapKind {
+	HEAP_VERTICES = 0,
+	HEAP_INDICES  = 1
+} HeapKind;
+
+struct HeapBlock {
+	HeapKind kind;       // vertices or indices
+	int      page;       // page that holds the run, -1 if none
+	int      first;      // first vertex or index of the run in the page
+	int      count;      // number of vertices or indices in the run
+	unsigned generation; // generation of the heap that allocated the run
+};
+
+//-------------------------------- GeometryHeap --------------------------
+//
+// GeometryHeap sub-allocates the vertices and the 16-bit indices of small
+// graphics from a few large vertex and index buffers - the pages - so
+// that each graphic does not own a device allocation of its own.  A
+// graphic draws its run with a base vertex offset into the page
+//
+// Each page keeps its free runs in order of position.  Allocation takes
+// the first free run that is large enough and freeing merges a run with
+// its free neighbours.  Releasing the heap - when the device is lost -
+// releases every page and starts a new generation, so that runs from the
+// old generation are ignored when they are freed
+//
+class GeometryHeap {
+
+	static const int MAX_PAGES     = 32;    // pages of each kind
+	static const int PAGE_VERTICES = 65536; // vertices in a page
+	static const int PAGE_INDICES  = 3 * PAGE_VERTICES; // indices in a page
+	static const int MIN_SPANS     = 16;    // initial allocation
+
+	// Span is a run of free vertices or indices
+	struct Span {
+		int first; // first vertex or index of the run
+		int count; // number of vertices or indices in the run
+	};
+
+	// Page is a single buffer and its free runs
+	struct Page {
+		IDirect3DVertexBuffer9* vb; // vertex buffer, if a vertex page
+		IDirect3DIndexBuffer9*  ib; // index buffer, if an index page
+		Span* span;                 // free runs in order of position
+		int   nSpans;               // number of free runs
+		int   maxSpans;             // number of free runs allocated
+	};
+
+	LPDIRECT3DDEVICE9 d3dd;        // display device
+	DWORD    fvf;                  // flexible vertex format of a vertex
+	int      vertexSize;           // size of a single vertex
+	Page     page[2][MAX_PAGES];   // vertex pages and index pages
+	int      nPages[2];            // number of pages of each kind
+	int      nBlocks;              // number of runs allocated
+	unsigned generation;           // incremented on each release
+
+	GeometryHeap(const GeometryHeap&);            // prevents copying
+	GeometryHeap& operator=(const GeometryHeap&); // prevents assignment
+	bool addPage(HeapKind kind);
+	bool take(Page& p, int n, int& first);
+	void give(Page& p, int first, int n);
+
+  public:
+	GeometryHeap();
+	~GeometryHeap();
+	void attach(LPDIRECT3DDEVICE9 d, DWORD f, int size);
+	bool allocate(HeapKind kind, int n, HeapBlock& b);
+	void free(HeapBlock& b);
+	IDirect3DVertexBuffer9* vertexBuffer(const HeapBlock& b) const;
+	IDirect3DIndexBuffer9*  indexBuffer(const HeapBlock& b) const;
+	void release();
+	int  pages() const  { return nPages[HEAP_VERTICES] +
+	 nPages[HEAP_INDICES]; }
+	int  blocks() const { return nBlocks; }
+};
+#endif
+
+#endif
@@ -1,365 +1,568 @@
-#ifndef _GRAPHICSCARD_H_
-#define _GRAPHICSCARD_H_
-
-/* Header for the GraphicsCard Module
- *
- * consists of Host declaration
- *             Display declaration
- *             DeviceLight declaration
- *             Graphic declaration
- *             DeviceTexture declaration
- *             Font declaration
- *
- * GraphicsCard.h
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include "DeviceSettings.h" // for GRAPHICS_API
-#include "Particle.h"
-//#include "Utilities.h"
-
-#if GRAPHICS_API == DIRECT3D
-#include <d3d9.h>      // for basic D3D
-#include <d3dx9.h>     // for D3D utilities
-#include <d3dx9core.h> // for LPD3DXFONT
-#elif GRAPHICS_API == OPENGL
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#include <windowsx.h>
-#include <gl/gl.h>  // for basic OpenGL   
-#include <gl/glu.h> // for OpenGL utilities
-#define MFORMAT 300 // maximum number of pixel formats
-#endif
-
-#include "IGraphicsCard.h"
-#include "IScene.h"
-
-//-------------------------------- Host ---------------------------------
-//
-// Host provides access to the graphics card for capability interrogation
-//
-class Host : public IHost {
-
-	HWND hwnd;
-
-    #if GRAPHICS_API == DIRECT3D
-    LPDIRECT3D9 d3d;            // interface to the Direct3D object
-    D3DFORMAT format;           // pixel format identifier
-
-    #elif GRAPHICS_API == OPENGL
-    HDC  hdc;                   // Windows device context
-    int  format;                // pixel format identifier
-    int  pixelFmt[MFORMAT];     // list of suitable pixel formats
-    #endif
-
-	Host(void* hDbWnd);
-	Host(const Host&);
-	Host& operator=(const Host&);
-    virtual ~Host();
-
-  public:
-	friend IHost* CreateHost(void* hDbWnd);
-    int    adapterCount() const;
-    int    displayDescription(int id, char* desc, int maxDesc) const;
-    int    formatCount();
-    int    modeCount(int id, int k) const;
-    bool   getMode(int id, int ir, int k, unsigned& fmMd, char* line);
-	void   configure(unsigned fmMd, int& id, int& ir, int& format, 
-	 int& width, int& height, int& wndStyle, int& wndExStyle);
-	void   Delete() { delete this; }
-};
-
-//-------------------------------- Display ------------------------------
-//
-// Display manages the display device on the graphics card
-//
-class Display : public IDisplay {
-
-	static const int MAX_LIGHTS = 8;
-
-    HWND       hwnd;     // points to the main application window
-    IScene*    scene;    // points to the scene interface
-    ILighting* lighting; // points to the lighting interface
-    IHUD*      hud;      // points to the heads up display interface
-	ICameras* cameras; //particle implementation
-	ParticleSystem* psGun; //particle implementation // for laser pointer
-	ParticleSystem* psSnow;
-	BoundingBox boundingBox;
-	IObject* terrain;
-
-
-
-    int display;          // display adapter identifier
-    int mode;             // resolution mode identifier
-    int pixel;            // pixel format identifier
-    int width;            // width of the client area
-    int height;           // height of the client area
-    int titleBar;         // approximate height of the title bar
-    int maxLights;        // max no of lights supported by graphics card
-
-    #if GRAPHICS_API == DIRECT3D
-    LPDIRECT3D9 d3d;             // interface to the Direct3D object
-    LPDIRECT3DDEVICE9 d3dd;      // interface to Direct3D display device
-    D3DPRESENT_PARAMETERS d3dpp; // parameters for creating/restoring D3D
-                                 // display device
-    LPD3DXSPRITE sprite;         // points to the sprite COM object
-    LPDIRECT3DTEXTURE9 hud_tex;  // points to the hud texture
-	unsigned fvf;                // holds the flexible vertex format
-
-    #elif GRAPHICS_API == OPENGL
-    HDC hdc;                     // Windows device context
-    HGLRC hrc;                   // OpenGL rendering context
-    #endif
-
-    void setupProjection();      // sets up the projection matrix
-    void setupLighting();        // sets up the lighting
-	void setGlobalState();        // sets up the alpha blending
-
-    Display(IScene* s, ILighting* l, IHUD* h, ICameras* ca);
-	Display(const Display& d);            // prevents copying
-	Display& operator=(const Display& d); // prevents assignment
-    virtual ~Display();
-
-  public:
-	friend IDisplay* CreateDisplay(IScene* s, ILighting* l, IHUD* h, ICameras* ca);
-    bool   setup();
-    void   wndResize();
-    void   draw(const Vector& p, const Vector& h, const Vector& u);
-    void   suspend();
-    bool   restore();
-    void   release();
-	void   Delete() { delete this; }
-    friend class Font;
-	friend class Graphic;
-};
-
-//-------------------------------- DeviceLight ---------------------------
-//
-// DeviceLight manages a light source as stored on the graphics card
-//
-class ILight;
-
-class DeviceLight : public IDeviceLight {
-
-    #if GRAPHICS_API == DIRECT3D
-    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device interface
-    #elif GRAPHICS_API == OPENGL
-    #endif
-	
-	ILight* light;                 // points to light source interface
-	int index;                     // identifier on graphics card
-
-	DeviceLight(ILight* light);
-
-  public:
-	friend IDeviceLight* CreateDeviceLight(ILight* light);
-	void   setup(int index);
-	void   update();
-	friend class Display;
-};
-
-//-------------------------------- Graphic -------------------------------
-//
-// Graphic manages the graphics primitives that represent an object on the 
-// graphics card
-//
-class IObject;
-
-class Graphic : public IGraphic {
-
-    bool isOpaque;                  // is perfectly opaque?
-	bool antiAliasingOn;            // anti-aliasing is on?
-	int  nVertices;                 // number of vertices
-	int  nTextures;                 // number of texture levels
-	int  vertexSize;                // size of a single vertex
-	int  vertexBufferSize;          // size of the vertex buffer
-	int  indexBufferSize;           // size of the index buffer
-	IDeviceTexture** deviceTexture; // points to the deviceTexture object
-
-    #if GRAPHICS_API == DIRECT3D
-    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
-	static unsigned fvf;           // flexible vertex format
-    int nPrimitives;               // number of primitives
-    D3DPRIMITIVETYPE type;         // primitive type
-    D3DMATERIAL9 mat;              // material reflectivity
-    LPDIRECT3DVERTEXBUFFER9 vb;    // vertex buffer (holds the vertices)
-    LPDIRECT3DINDEXBUFFER9 ib;     // index buffer (points to vertices)
-
-    #elif GRAPHICS_API == OPENGL
-    int nVertices;        // number of vertices
-	GLfloat (*vb)[3];     // vertex array
-    GLfloat (*nv)[3];     // normal array
-    GLfloat (*tc)[2];     // texture array
-    GLenum type;          // primitive type
-    unsigned int tex;     // texture spread over object's surface
-    GLfloat red;          // colour ...
-    GLfloat green;        //  ...
-    GLfloat blue;         //   ...
-    GLfloat alpha;        //    ...
-    int power;            // shininess
-    #endif
-
-    Graphic(Shape pType, int noPrimitives, int noVertices, 
-	 int vSize, int noIndices, Colour clr, IDeviceTexture* devTex, 
-	 bool antiAlias);
-    Graphic(const Graphic& v);            // prevents copying
-    Graphic& operator=(const Graphic& v); // prevents assignment
-    virtual ~Graphic();
-
-	void setup(const IObject* object);
-
-  public:
-	friend IGraphic* CreateGraphic(Shape pType, int noPrimitives, 
-	 int noVertices, int vSize, int noIndices, Colour clr, 
-	 IDeviceTexture* devTex, bool antiAlias);
-    bool   opaque() const { return isOpaque; }
-	void   add(IDeviceTexture* deviceTexture);
-    void   draw(const IObject* object);
-    void   suspend();
-	void   Delete() { delete this; }
-    friend class Display;
-};
-
-//-------------------------------- Mesh ----------------------------------
-//
-// Mesh manages the graphics primitives that represent an object on the 
-// graphics card in the form of a mesh
-//
-class IObject;
-
-class Mesh : public IGraphic {
-
-    bool isOpaque;                 // is perfectly opaque?
-	bool antiAliasingOn;           // anti-aliasing is on?
-    int  nSubsets;                 // number of subsets in the mesh
-	int  nTextures;                // number of texture levels
-    int  nPrimitives;              // number of primitives in the mesh
-	int  nVertices;                // number of vertices in the mesh
-	IDeviceTexture** tex;          // points to deviceTexture addresses
-	Shape shape;                   // the type of shape being represented
-	float dimension[3];            // dimensions of stock shapes
-	int partition[2];              // tesselation parameters for stock shapes
-	const char* file;              // file containing mesh data
-
-    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
-	static unsigned fvf;           // flexible vertex format
-    LPD3DXMESH mesh;               // set of vertices, indices, attributes
-    D3DMATERIAL9* mat;             // material reflectivity for each subset
-
-    Mesh(int noSubsets, int noPrimitives, int noVertices, Colour* clr, 
-	 IDeviceTexture** devTex, bool antiAlias);
-	Mesh(Shape shape, float* d, int* p, Colour clr, bool antiAlias);
-	Mesh(Shape shape, const char* filename, bool antiAlias);
-    Mesh(const Mesh& v);            // prevents copying
-    Mesh& operator=(const Mesh& v); // prevents assignment
-    virtual ~Mesh();
-
-	void setup(const IObject* object);
-
-  public:
-	friend IGraphic* CreateMesh(int noSubsets, int noPrimitives, 
-	 int noVertices, Colour* clr, IDeviceTexture** devTex, 
-	 bool antiAlias);
-	friend IGraphic* CreateMesh(Shape shape, float* d, int* p, 
-	 Colour clr, bool antiAlias);
-	friend IGraphic* CreateMesh(Shape shape, const char* filename, 
-	 bool antiAlias);
-    bool   opaque() const { return isOpaque; }
-	void   add(IDeviceTexture* deviceTexture);
-    void   draw(const IObject* object);
-    void   suspend();
-	void   Delete() { delete this; }
-    friend class Display;
-};
-
-//-------------------------------- DeviceTexture -------------------------
-//
-// DeviceTexture manages a texture as stored on the graphics card
-//
-class DeviceTexture : public IDeviceTexture {
-
-	static int width;     // width of the client area
-	static int height;    // height of the client area
-	static int maxStages; // maximum number of texture stages
-
-	unsigned filter;      // sample filtering flags
-	unsigned borderColor; // border colour
-	char* filename;       // points to the background image file
-
-	#if GRAPHICS_API == DIRECT3D
-    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
-	static LPD3DXSPRITE sprite;    // point to the drawing manager to use
-    LPDIRECT3DTEXTURE9 tex;        // texture spread over object's surface 
-
-    #elif GRAPHICS_API == OPENGL
-    unsigned int tex;              // texture spread over object's surface
-    #endif
-
-	DeviceTexture(const char* file, unsigned flags, Colour brdrClr);
-	virtual ~DeviceTexture();
-
-	void setSamplerState(int i);
-	void setup();
-
-  public:
-	friend IDeviceTexture* CreateDeviceTexture(const char* file, 
-	 unsigned flags, Colour brdrClr);
-	void   attach(int i);
-	void   detach(int i);
-	void   draw(int topLeftX, int topLeftY, int bottomRightX,
-     int bottomRightY);
-	void   suspend();
-	void   Delete() { delete this; }
-	friend class Display;
-};
-
-//-------------------------------- Font ----------------------------------
-//
-// Font manages a single Text object as stored on the graphics card
-//
-class IText;
-
-class Font : public IFont {
-
-	static int width;     // width of the client area
-	static int height;    // height of the client area
-
-    const    IText* text; // points to the parent Text object 
-	unsigned flags;       // font display flags
-
-    #if GRAPHICS_API == DIRECT3D
-    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device interface
-    static LPD3DXSPRITE sprite;    // points to font manager COM object
-    LPD3DXFONT d3dfont;            // points to the Direct3D font
-
-    #elif GRAPHICS_API == OPENGL
-    static HGLRC hrc;              // OpenGL rendering context
-	static HDC hdc;                // Windows device context
-	bool  isSetup;                 // the font object is setup?
-    #endif
-
-    Font(const IText* t, unsigned f);
-    Font(const Font& v);
-    Font& operator=(const Font& v);
-    virtual ~Font();
-    void    setup();
-
-  public:
-	friend IFont* CreateFont_(IText* text, unsigned int flags);
-    void   draw(const char* text);
-    void   suspend();
-    bool   restore();
-	void   release();
-	void   Delete() { delete this; }
-    friend class Display;
-};
-
-#if GRAPHICS_API == DIRECT3D
-#elif GRAPHICS_API == OPENGL
-unsigned char *createTexData(const char *file, int &width, int &height);
-#endif
-
+#ifndef _GRAPHICSCARD_H_
+#define _GRAPHICSCARD_H_
+
+/* Header for the GraphicsCard Module
+ *
+ * consists of Host declaration
+ *             RenderQueue declaration
+ *             Display declaration
+ *             DeviceLight declaration
+ *             Graphic declaration
+ *             DeviceTexture declaration
+ *             FileLoad declaration
+ *             Font declaration
+ *
+ * GraphicsCard.h
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+#include "Particle.h"
+//#include "Utilities.h"
+
+#if GRAPHICS_API == DIRECT3D
+#include <d3d9.h>      // for basic D3D
+#include <d3dx9.h>     // for D3D utilities
+#include <d3dx9core.h> // for LPD3DXFONT
+#elif GRAPHICS_API == OPENGL
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <windowsx.h>
+#include <gl/gl.h>  // for basic OpenGL   
+#include <gl/glu.h> // for OpenGL utilities
+#define MFORMAT 300 // maximum number of pixel formats
+#endif
+
+#include "IGraphicsCard.h"
+#include "IScene.h"
+#include "GeometryHeap.h" // for GeometryHeap and HeapBlock
+#include "TextureCache.h" // for TextureCache
+#include "Loader.h"       // for Loader and LoadRequest
+#include "ImageDecoder.h" // for Image
+#include "VertexCodec.h"  // for PackedVertex and VertexPacking
+
+//-------------------------------- Host ---------------------------------
+//
+// Host provides access to the graphics card for capability interrogation
+//
+class Host : public IHost {
+
+	HWND hwnd;
+
+    #if GRAPHICS_API == DIRECT3D
+    LPDIRECT3D9 d3d;            // interface to the Direct3D object
+    D3DFORMAT format;           // pixel format identifier
+
+    #elif GRAPHICS_API == OPENGL
+    HDC  hdc;                   // Windows device context
+    int  format;                // pixel format identifier
+    int  pixelFmt[MFORMAT];     // list of suitable pixel formats
+    #endif
+
+	Host(void* hDbWnd);
+	Host(const Host&);
+	Host& operator=(const Host&);
+    virtual ~Host();
+
+  public:
+	friend IHost* CreateHost(void* hDbWnd);
+    int    adapterCount() const;
+    int    displayDescription(int id, char* desc, int maxDesc) const;
+    int    formatCount();
+    int    modeCount(int id, int k) const;
+    bool   getMode(int id, int ir, int k, unsigned& fmMd, char* line);
+	void   configure(unsigned fmMd, int& id, int& ir, int& format, 
+	 int& width, int& height, int& wndStyle, int& wndExStyle);
+	void   Delete() { delete this; }
+};
+
+//-------------------------------- RenderQueue --------------------------
+//
+// RenderQueue collects the draw requests for a frame, sorts them by a
+// 64-bit key and submits them to the display device
+//
+// The key holds, from the most significant bit down:
+//
+//   opaque      - 0 | texture (23) | material (16) | depth (24)
+//   translucent - 1 | inverted depth (24) | texture (23) | material (16)
+//
+// so that opaque items are batched by state and drawn front to back and
+// translucent items are drawn back to front after all of the opaque ones.
+// Texture identifiers past 23 bits share their keys with earlier ones,
+// which costs only state changes - the queue compares the textures
+// themselves before it sets a stage or merges two graphics.
+// Consecutive items that draw the same subset of the same graphic are
+// handed to the graphic together, which may draw them as one batch.
+// Consecutive items of different graphics that share their textures and
+// their material - billboards that sample the same atlas page, say - are
+// batched together as well
+//
+#if GRAPHICS_API == DIRECT3D
+class IGraphic;
+class IObject;
+class IDeviceTexture;
+class Graphic;
+
+class RenderQueue {
+
+	static const int      MIN_ITEMS     = 64;       // initial allocation
+	static const int      MAX_STAGES    = 8;        // texture stages tracked
+	static const unsigned DEPTH_MASK    = 0xFFFFFF; // 24 bits of depth
+	static const unsigned TEXTURE_MASK  = 0x7FFFFF; // 23 bits of texture
+	static const unsigned MATERIAL_MASK = 0xFFFF;   // 16 bits of material
+
+	// Item is a single draw request
+	struct Item {
+		unsigned __int64 key;     // sort key
+		IGraphic*        graphic; // draws the item
+		const IObject*   object;  // object being drawn
+		int              subset;  // part of the graphic to draw
+		bool             merge;   // may be batched with other graphics?
+	};
+
+	Item*          item;          // draw requests for the current frame
+	Item*          scratch;       // scratch space for sorting
+	const IObject** run;          // objects of a run of the same graphic
+	Graphic**      runGraphic;    // graphics of a run of merged items
+	int            nItems;        // number of draw requests
+	int            capacity;      // number of requests allocated
+	D3DMATERIAL9*  materials;     // distinct materials seen so far
+	int            nMaterials;    // number of distinct materials
+	int            maxMaterials;  // number of materials allocated
+	Matrix         view;          // view transformation for the frame
+
+	// state set by the draws so far
+	const IObject*  world_;               // object whose world is set
+	IDeviceTexture* texture_[MAX_STAGES]; // texture attached to each stage
+	bool            blend;                // is alpha blending on?
+
+	RenderQueue(const RenderQueue&);            // prevents copying
+	RenderQueue& operator=(const RenderQueue&); // prevents assignment
+	void sort();
+	void reset();
+
+  public:
+	RenderQueue();
+	~RenderQueue();
+	void     begin(const Matrix& v);
+	unsigned material(const D3DMATERIAL9& m);
+	void     add(IGraphic* graphic, const IObject* object, int subset,
+	 bool translucent, IDeviceTexture* texture, unsigned material,
+	 bool merge = false);
+	void     flush();
+	// state setters used by the graphics as they are drawn
+	void     world(const IObject* object);
+	void     textures(IDeviceTexture** texture, int n);
+};
+#endif
+
+//-------------------------------- Display ------------------------------
+//
+// Display manages the display device on the graphics card
+//
+class IText;
+
+class Display : public IDisplay {
+
+	static const int MAX_LIGHTS = 8;
+
+    HWND       hwnd;     // points to the main application window
+    IScene*    scene;    // points to the scene interface
+    ILighting* lighting; // points to the lighting interface
+    IHUD*      hud;      // points to the heads up display interface
+	ICameras* cameras; //particle implementation
+	ParticleSystem* psGun; //particle implementation // for laser pointer
+	ParticleSystem* psSnow;
+	BoundingBox boundingBox;
+	IObject* terrain;
+
+
+
+    int display;          // display adapter identifier
+    int mode;             // resolution mode identifier
+    int pixel;            // pixel format identifier
+    int width;            // width of the client area
+    int height;           // height of the client area
+    int titleBar;         // approximate height of the title bar
+    int maxLights;        // max no of lights supported by graphics card
+	float lodScale;       // pixels per unit of size at unit distance
+	Matrix projection;    // projection transformation
+
+    #if GRAPHICS_API == DIRECT3D
+    LPDIRECT3D9 d3d;             // interface to the Direct3D object
+    LPDIRECT3DDEVICE9 d3dd;      // interface to Direct3D display device
+    D3DPRESENT_PARAMETERS d3dpp; // parameters for creating/restoring D3D
+                                 // display device
+    LPD3DXSPRITE sprite;         // points to the sprite COM object
+    LPDIRECT3DTEXTURE9 hud_tex;  // points to the hud texture
+	float hudRegion[4];          // region of the hud image in hud_tex
+	bool hudPacked;              // is hud_tex the hud image's atlas page?
+	unsigned fvf;                // holds the flexible vertex format
+	RenderQueue queue;           // draw requests for the current frame
+	GeometryHeap heap;           // pages that hold the small graphics
+	IText* stateCalls;           // points to the state call counts
+
+    #elif GRAPHICS_API == OPENGL
+    HDC hdc;                     // Windows device context
+    HGLRC hrc;                   // OpenGL rendering context
+    #endif
+
+    void setupProjection();      // sets up the projection matrix
+    void setupLighting();        // sets up the lighting
+	void setGlobalState();        // sets up the alpha blending
+	#if GRAPHICS_API == DIRECT3D
+	bool loadHud();               // loads the hud image into hud_tex
+	#endif
+
+    Display(IScene* s, ILighting* l, IHUD* h, ICameras* ca);
+	Display(const Display& d);            // prevents copying
+	Display& operator=(const Display& d); // prevents assignment
+    virtual ~Display();
+
+  public:
+	friend IDisplay* CreateDisplay(IScene* s, ILighting* l, IHUD* h, ICameras* ca);
+    bool   setup();
+    void   wndResize();
+    void   draw(const Vector& p, const Vector& h, const Vector& u);
+    void   suspend();
+    bool   restore();
+    void   release();
+	void   Delete() { delete this; }
+    friend class Font;
+	friend class Graphic;
+};
+
+//-------------------------------- DeviceLight ---------------------------
+//
+// DeviceLight manages a light source as stored on the graphics card
+//
+class ILight;
+
+class DeviceLight : public IDeviceLight {
+
+    #if GRAPHICS_API == DIRECT3D
+    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device interface
+    #elif GRAPHICS_API == OPENGL
+    #endif
+	
+	ILight* light;                 // points to light source interface
+	int index;                     // identifier on graphics card
+
+	DeviceLight(ILight* light);
+
+  public:
+	friend IDeviceLight* CreateDeviceLight(ILight* light);
+	void   setup(int index);
+	void   update();
+	friend class Display;
+};
+
+//-------------------------------- Graphic -------------------------------
+//
+// Graphic manages the graphics primitives that represent an object on the 
+// graphics card
+//
+class IObject;
+
+class Graphic : public IGraphic {
+
+    bool isOpaque;                  // is perfectly opaque?
+	bool antiAliasingOn;            // anti-aliasing is on?
+	int  nVertices;                 // number of vertices
+	int  nTextures;                 // number of texture levels
+	int  vertexSize;                // size of a single vertex
+	int  vertexBufferSize;          // size of the vertex buffer
+	int  nIndices;                  // number of indices
+	int  indexBufferSize;           // size of the index buffer
+	IDeviceTexture** deviceTexture; // points to the deviceTexture object
+
+    #if GRAPHICS_API == DIRECT3D
+    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
+	static unsigned fvf;           // flexible vertex format
+	static unsigned maxIndex;      // largest index supported by the device
+	static RenderQueue* queue;     // collects the draw requests
+	static GeometryHeap* heap;     // sub-allocates the small graphics
+	static const int BATCH_VERTICES = 16384; // vertices in a batch
+	static const int BATCH_INDICES  = 3 * BATCH_VERTICES;
+	static LPDIRECT3DVERTEXBUFFER9 batchVB; // instances in world space
+	static LPDIRECT3DINDEXBUFFER9  batchIB; // indices of the instances
+	static int batchVertex;        // next free vertex in batchVB
+	static int batchIndex;         // next free index in batchIB
+    int nPrimitives;               // number of primitives
+    D3DPRIMITIVETYPE type;         // primitive type
+    D3DMATERIAL9 mat;              // material reflectivity
+	unsigned matId;                // material identifier in the queue
+    LPDIRECT3DVERTEXBUFFER9 vb;    // vertex buffer (holds the vertices)
+    LPDIRECT3DINDEXBUFFER9 ib;     // index buffer (points to vertices)
+	HeapBlock vBlock;              // vertices in the heap, if pooled
+	HeapBlock iBlock;              // indices in the heap, if pooled
+	int  baseVertex;               // first vertex in vb
+	int  startIndex;               // first index in ib
+	bool wide;                     // holds 32-bit indices?
+	bool dynamic;                  // are vertices replaced while drawn?
+	char* shadow;                  // vertices then indices in system memory
+	int  shadowSize;               // size of the shadow in bytes
+	bool packed;                   // are the vertices in the shadow packed?
+	VertexPacking packing;         // quantization of the packed vertices
+	Graphic* next;                 // next graphic that holds a shadow
+	Graphic* prev;                 // previous graphic that holds a shadow
+	static Graphic* shadowed;      // first graphic that holds a shadow
+
+    #elif GRAPHICS_API == OPENGL
+    int nVertices;        // number of vertices
+	GLfloat (*vb)[3];     // vertex array
+    GLfloat (*nv)[3];     // normal array
+    GLfloat (*tc)[2];     // texture array
+    GLenum type;          // primitive type
+    unsigned int tex;     // texture spread over object's surface
+    GLfloat red;          // colour ...
+    GLfloat green;        //  ...
+    GLfloat blue;         //   ...
+    GLfloat alpha;        //    ...
+    int power;            // shininess
+    #endif
+
+    Graphic(Shape pType, int noPrimitives, int noVertices, 
+	 int vSize, int noIndices, Colour clr, IDeviceTexture* devTex, 
+	 bool antiAlias);
+    Graphic(const Graphic& v);            // prevents copying
+    Graphic& operator=(const Graphic& v); // prevents assignment
+    virtual ~Graphic();
+
+	void setup(const IObject* object);
+	#if GRAPHICS_API == DIRECT3D
+	void shade(const IObject* object);
+	void unpack();
+	void drop();
+	int  shadowVertices() const;
+	bool create();
+	bool pool();
+	int  fill(const IObject* object);
+	bool joins(const Graphic* g) const;
+	bool batch(const IObject* const* object, Graphic* const* graphic,
+	 int n);
+	static void setupBatch();
+	static void releaseBatch();
+	static void restoreShadows();
+	#endif
+
+  public:
+	friend IGraphic* CreateGraphic(Shape pType, int noPrimitives, 
+	 int noVertices, int vSize, int noIndices, Colour clr, 
+	 IDeviceTexture* devTex, bool antiAlias);
+    bool   opaque() const { return isOpaque; }
+	void   add(IDeviceTexture* deviceTexture);
+	void   update(const IObject* object, int first, int n);
+    void   draw(const IObject* object);
+	void   render(const IObject* object, int subset);
+	void   render(const IObject* const* object, int n, int subset);
+	bool   bound(Vector&, float&) const { return false; }
+    void   suspend();
+	void   Delete() { delete this; }
+    friend class Display;
+	friend class RenderQueue;
+};
+
+//-------------------------------- Mesh ----------------------------------
+//
+// Mesh manages the graphics primitives that represent an object on the 
+// graphics card in the form of a mesh, simplified into levels of detail
+// that share its vertices
+//
+class IObject;
+class FileLoad;
+
+class Mesh : public IGraphic {
+
+    bool isOpaque;                 // is perfectly opaque?
+	bool antiAliasingOn;           // anti-aliasing is on?
+    int  nSubsets;                 // number of subsets in the mesh
+	int  nTextures;                // number of texture levels
+    int  nPrimitives;              // number of primitives in the mesh
+	int  nVertices;                // number of vertices in the mesh
+	IDeviceTexture** tex;          // points to deviceTexture addresses
+	Shape shape;                   // the type of shape being represented
+	float dimension[3];            // dimensions of stock shapes
+	int partition[2];              // tesselation parameters for stock shapes
+	const char* file;              // file containing mesh data, NULL if bad
+
+    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
+	static unsigned fvf;           // flexible vertex format
+	static unsigned maxIndex;      // largest index supported by the device
+	static RenderQueue* queue;     // collects the draw requests
+    LPD3DXMESH mesh;               // set of vertices, indices, attributes
+    D3DMATERIAL9* mat;             // material reflectivity for each subset
+	unsigned* matId;               // material identifiers in the queue
+	int  nLevels;                  // levels of detail in the mesh
+	int* levelFaces;               // faces in each subset at each level
+	bool bounded;                  // are the bounds below known?
+	float centre[3];               // centre of the mesh in local space
+	float radius;                  // radius of the mesh around centre
+	static int drawnFaces;         // faces drawn from meshes with levels
+	static int savedFaces;         // faces saved by coarser levels
+	FileLoad* loading;             // reads the .x file, NULL if idle
+
+    Mesh(int noSubsets, int noPrimitives, int noVertices, Colour* clr, 
+	 IDeviceTexture** devTex, bool antiAlias);
+	Mesh(Shape shape, float* d, int* p, Colour clr, bool antiAlias);
+	Mesh(Shape shape, const char* filename, bool antiAlias);
+    Mesh(const Mesh& v);            // prevents copying
+    Mesh& operator=(const Mesh& v); // prevents assignment
+    virtual ~Mesh();
+
+	void setup(const IObject* object);
+	void loaded(const char* data, int size, bool read);
+	void simplify();
+
+  public:
+	friend IGraphic* CreateMesh(int noSubsets, int noPrimitives, 
+	 int noVertices, Colour* clr, IDeviceTexture** devTex, 
+	 bool antiAlias);
+	friend IGraphic* CreateMesh(Shape shape, float* d, int* p, 
+	 Colour clr, bool antiAlias);
+	friend IGraphic* CreateMesh(Shape shape, const char* filename, 
+	 bool antiAlias);
+    bool   opaque() const { return isOpaque; }
+	void   add(IDeviceTexture* deviceTexture);
+	void   update(const IObject* object, int first, int n);
+    void   draw(const IObject* object);
+	void   render(const IObject* object, int subset);
+	void   render(const IObject* const* object, int n, int subset);
+	bool   bound(Vector& centre, float& radius) const;
+    void   suspend();
+	void   Delete() { delete this; }
+    friend class Display;
+	friend class FileLoad;
+};
+
+//-------------------------------- DeviceTexture -------------------------
+//
+// DeviceTexture manages a texture as stored on the graphics card
+//
+class DeviceTexture : public IDeviceTexture {
+
+	static int width;     // width of the client area
+	static int height;    // height of the client area
+	static int maxStages; // maximum number of texture stages
+	static unsigned count; // number of device textures created
+
+	unsigned id;          // identifies the texture in sort keys
+	unsigned filter;      // sample filtering flags
+	unsigned borderColor; // border colour
+	char* filename;       // points to the background image file
+	TextureCache::Entry* entry; // shares the texture through the cache
+	FileLoad* loading;    // reads the texture file, NULL if idle
+
+	#if GRAPHICS_API == DIRECT3D
+    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
+	static LPD3DXSPRITE sprite;    // point to the drawing manager to use
+	static bool powerOfTwo;        // does the device need 2^n x 2^n sides?
+    LPDIRECT3DTEXTURE9 tex;        // texture spread over object's surface 
+
+    #elif GRAPHICS_API == OPENGL
+    unsigned int tex;              // texture spread over object's surface
+    #endif
+
+	DeviceTexture(const char* file, unsigned flags, Colour brdrClr);
+	virtual ~DeviceTexture();
+
+	void setSamplerState(int i);
+	void setup();
+	void loaded(const Image& image, const char* data, int size, bool read);
+	#if GRAPHICS_API == DIRECT3D
+	static bool direct(const Image& image);
+	bool create(const Image& image);
+	int  size() const;
+	#endif
+
+  public:
+	friend IDeviceTexture* CreateDeviceTexture(const char* file, 
+	 unsigned flags, Colour brdrClr);
+	void   attach(int i);
+	void   detach(int i);
+	void   draw(int topLeftX, int topLeftY, int bottomRightX,
+     int bottomRightY);
+	void   suspend();
+	void   Delete();
+	friend class Display;
+	friend class RenderQueue;
+	friend class FileLoad;
+};
+
+//-------------------------------- FileLoad ------------------------------
+//
+// FileLoad reads a texture file or an .x file on a loader thread and
+// hands its contents to the waiting texture or mesh on the render thread
+// - a texture file is decoded on the loader thread, while the upload and
+// any file that D3DX decodes stay on the render thread, which owns the
+// device.  cancel() and finish() run on the render thread and load()
+// never reads texture or mesh, so a texture or mesh deleted while its
+// file is loading does not race the loader thread
+//
+class FileLoad : public LoadRequest {
+
+	char*          file;    // name of the file
+	char*          data;    // contents of the file, NULL if unread
+	Image          image;   // decoded texture, data NULL if not decoded
+	int            size;    // number of bytes in data
+	bool           read;    // has a loader thread tried to read the file?
+	bool           decode;  // is the file a texture to be decoded?
+	DeviceTexture* texture; // texture waiting for the file, NULL if none
+	Mesh*          mesh;    // mesh waiting for the file, NULL if none
+
+	FileLoad(const FileLoad&);            // prevents copying
+	FileLoad& operator=(const FileLoad&); // prevents assignment
+
+  public:
+	FileLoad(const char* file, DeviceTexture* t, Mesh* m);
+	void load();
+	void finish();
+	void cancel() { texture = NULL; mesh = NULL; }
+	virtual ~FileLoad();
+};
+
+//-------------------------------- Font ----------------------------------
+//
+// Font manages a single Text object as stored on the graphics card
+//
+class IText;
+
+class Font : public IFont {
+
+	static int width;     // width of the client area
+	static int height;    // height of the client area
+
+    const    IText* text; // points to the parent Text object 
+	unsigned flags;       // font display flags
+
+    #if GRAPHICS_API == DIRECT3D
+    static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device interface
+    static LPD3DXSPRITE sprite;    // points to font manager COM object
+    LPD3DXFONT d3dfont;            // points to the Direct3D font
+
+    #elif GRAPHICS_API == OPENGL
+    static HGLRC hrc;              // OpenGL rendering context
+	static HDC hdc;                // Windows device context
+	bool  isSetup;                 // the font object is setup?
+    #endif
+
+    Font(const IText* t, unsigned f);
+    Font(const Font& v);
+    Font& operator=(const Font& v);
+    virtual ~Font();
+    void    setup();
+
+  public:
+	friend IFont* CreateFont_(IText* text, unsigned int flags);
+    void   draw(const char* text);
+    void   suspend();
+    bool   restore();
+	void   release();
+	void   Delete() { delete this; }
+    friend class Display;
+};
+
 #endif
\ No newline at end of file
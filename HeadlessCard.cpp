@@ -0,0 +1,1247 @@
+/* Headless GraphicsCard Module Implementation
+ *
+ * HeadlessCard.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+
+#if GRAPHICS_API == HEADLESS
+#include <cstring>          // for memcpy, memcmp, strlen
+#include <cstdio>           // for fopen, fseek, ftell, sprintf
+#include <new>              // for nothrow
+#include "IConfiguration.h" // for Selector interface
+#include "IScene.h"         // for Scene and Object interfaces
+#include "ILighting.h"      // for Lighting and Light interfaces
+#include "IHUD.h"           // for HUD and Text interfaces
+#include "math.h"           // for Matrix, Vector and Colour
+#include "Utilities.h"      // for report(), strcopy()
+#include "TextureCache.h"   // for TextureCache
+#include "Loader.h"         // for Loader
+#include "ImageDecoder.h"   // for Image, loadImage(), decompressImage()
+#include "TextureBaker.h"   // for loadBakedImage()
+#include "HeadlessCard.h"   // for Recorder, Host, Display, DeviceLight,
+                            // Graphic, Mesh, DeviceTexture and Font
+
+//-------------------------------- Recorder ------------------------------
+//
+// Recorder records the commands for a frame in a compact stream of words
+//
+Recorder* Recorder::address_ = NULL;
+
+// RecorderAddress returns the address of the most recent recorder - for
+// inspecting the stream of the last recorded frame
+//
+const Recorder* RecorderAddress() {
+
+	return Recorder::address();
+}
+
+// constructor allocates the stream and marks every state as unknown
+//
+Recorder::Recorder() : word(NULL), nWords(0), capacity(0) {
+
+	address_ = this;
+	grow(MIN_WORDS);
+	memset(&current, 0, sizeof current);
+	memset(&last, 0, sizeof last);
+	forget();
+}
+
+// grow enlarges the stream to hold at least n words and returns true if
+// successful
+//
+bool Recorder::grow(int n) {
+
+	int c = capacity ? capacity : MIN_WORDS;
+	while (c < n)
+		c *= 2;
+	unsigned* w = new (std::nothrow) unsigned[c];
+	if (!w) {
+		error("Recorder::10 Unable to grow the command stream");
+		return false;
+	}
+	if (word) {
+		memcpy(w, word, nWords * sizeof(unsigned));
+		delete [] word;
+	}
+	word     = w;
+	capacity = c;
+
+	return true;
+}
+
+// record appends command c followed by the n words at data
+//
+void Recorder::record(Command c, const unsigned* data, int n) {
+
+	if (nWords + n + 1 > capacity && !grow(nWords + n + 1))
+		return;
+	word[nWords++] = (unsigned)c << 24 | n;
+	for (int i = 0; i < n; i++)
+		word[nWords++] = data[i];
+	current.commands++;
+}
+
+// change records command c with the n words at data unless shadow
+// already holds them
+//
+void Recorder::change(Command c, unsigned* shadow, bool& known,
+ const unsigned* data, int n) {
+
+	if (known && !memcmp(shadow, data, n * sizeof(unsigned)))
+		current.saved++;
+	else {
+		memcpy(shadow, data, n * sizeof(unsigned));
+		known = true;
+		record(c, data, n);
+		current.states++;
+	}
+}
+
+// forget marks every state as unknown - the next command that sets a
+// state is always recorded
+//
+void Recorder::forget() {
+
+	viewKnown       = false;
+	projectionKnown = false;
+	worldKnown      = false;
+	materialKnown   = false;
+	memset(textureKnown, 0, sizeof textureKnown);
+	memset(stateKnown, 0, sizeof stateKnown);
+	memset(lightKnown, 0, sizeof lightKnown);
+}
+
+// begin empties the stream and opens frame f
+//
+void Recorder::begin(int f) {
+
+	nWords = 0;
+	memset(&current, 0, sizeof current);
+	current.frame = f;
+	unsigned data = f;
+	record(CMD_FRAME, &data, 1);
+}
+
+// view records the view transformation m
+//
+void Recorder::view(const Matrix& m) {
+
+	unsigned data[16];
+	memcpy(data, &m, sizeof data);
+	change(CMD_VIEW, view_, viewKnown, data, 16);
+}
+
+// projection records the projection transformation m
+//
+void Recorder::projection(const Matrix& m) {
+
+	unsigned data[16];
+	memcpy(data, &m, sizeof data);
+	change(CMD_PROJECTION, projection_, projectionKnown, data, 16);
+}
+
+// world records the world transformation m
+//
+void Recorder::world(const Matrix& m) {
+
+	unsigned data[16];
+	memcpy(data, &m, sizeof data);
+	change(CMD_WORLD, world_, worldKnown, data, 16);
+}
+
+// material records the diffuse, ambient and specular reflectivity and
+// the shininess of the material
+//
+void Recorder::material(const Colour& d, const Colour& a,
+ const Colour& s, float power) {
+
+	float f[MAT_WORDS] = { d.r, d.g, d.b, d.a, a.r, a.g, a.b, a.a,
+	 s.r, s.g, s.b, s.a, power };
+	unsigned data[MAT_WORDS];
+	memcpy(data, f, sizeof data);
+	change(CMD_MATERIAL, material_, materialKnown, data, MAT_WORDS);
+}
+
+// texture records the binding of texture id to stage - id 0 unbinds the
+// stage
+//
+void Recorder::texture(int stage, unsigned id) {
+
+	unsigned data[2] = { (unsigned)stage, id };
+	if (stage < MAX_STAGES)
+		change(CMD_TEXTURE, texture_[stage], textureKnown[stage], data, 2);
+}
+
+// state records the value of render state s
+//
+void Recorder::state(RenderState s, unsigned value) {
+
+	unsigned data[2] = { s, value };
+	change(CMD_STATE, state_[s], stateKnown[s], data, 2);
+}
+
+// light records whether light index is on
+//
+void Recorder::light(int index, bool on) {
+
+	unsigned data[2] = { (unsigned)index, on };
+	if (index < MAX_LIGHTS)
+		change(CMD_LIGHT, light_[index], lightKnown[index], data, 2);
+}
+
+// upload records the copy of bytes bytes into buffer starting at byte
+// first
+//
+void Recorder::upload(unsigned buffer, int first, int bytes) {
+
+	unsigned data[3] = { buffer, (unsigned)first, (unsigned)bytes };
+	record(CMD_UPLOAD, data, 3);
+	current.uploads++;
+	current.uploadBytes += bytes;
+}
+
+// draw records the draw of primitives primitives of the given shape from
+// subset of buffer
+//
+void Recorder::draw(unsigned buffer, Shape shape, int subset,
+ int primitives) {
+
+	unsigned data[4] = { buffer, shape, (unsigned)subset,
+	 (unsigned)primitives };
+	record(CMD_DRAW, data, 4);
+	current.draws++;
+	current.primitives += primitives;
+}
+
+// sprite records the draw of the rectangle [left, top, right, bottom] of
+// texture id onto the background
+//
+void Recorder::sprite(unsigned id, int left, int top, int right,
+ int bottom) {
+
+	unsigned data[5] = { id, (unsigned)left, (unsigned)top,
+	 (unsigned)right, (unsigned)bottom };
+	record(CMD_SPRITE, data, 5);
+	current.draws++;
+}
+
+// text records the draw of str with its top left corner at [left, top] -
+// the characters are packed four to a word
+//
+void Recorder::text(int left, int top, const char* str) {
+
+	int n = strlen(str);
+	int nChars = (n + 3) / 4;
+	if (nWords + nChars + 4 > capacity && !grow(nWords + nChars + 4))
+		return;
+	word[nWords++] = (unsigned)CMD_TEXT << 24 | (3 + nChars);
+	word[nWords++] = left;
+	word[nWords++] = top;
+	word[nWords++] = n;
+	if (nChars)
+		word[nWords + nChars - 1] = 0;
+	memcpy(word + nWords, str, n);
+	nWords += nChars;
+	current.commands++;
+}
+
+// end closes the frame and keeps its counts
+//
+void Recorder::end() {
+
+	record(CMD_PRESENT, NULL, 0);
+	last = current;
+}
+
+// destructor releases the stream
+//
+Recorder::~Recorder() {
+
+	if (word)
+		delete [] word;
+	if (address_ == this)
+		address_ = NULL;
+}
+
+//-------------------------------- Host ---------------------------------
+//
+// Host describes a single display adapter with a single windowed mode
+//
+IHost* CreateHost(void* hDbWnd) {
+
+	return new Host(hDbWnd);
+}
+
+// displayDescription fills desc[maxDesc+1] with the description of the
+// recorder
+//
+int Host::displayDescription(int id, char* desc, int maxDesc) const {
+
+	strcopy(desc, "Headless command recorder", maxDesc);
+
+	return 1;
+}
+
+// getMode describes the single mode of the recorder
+//
+bool Host::getMode(int id, int ir, int ip, unsigned& fmMd, char* line) {
+
+	sprintf(line, "%dx%d recorded", WND_WIDTH, WND_HEIGHT);
+	fmMd = 0;
+
+	return true;
+}
+
+// configure returns the properties for running in a window - the
+// recorder has no full screen modes
+//
+void Host::configure(unsigned fmMd, int& id, int& ir, int& ip,
+ int& width, int& height, int& wndStyle, int& wndExStyle) {
+
+	id         = RUN_IN_WINDOW;
+	ir         = 0;
+	ip         = 0;
+	width      = WND_WIDTH;
+	height     = WND_HEIGHT;
+	wndExStyle = WND_EXSTYLE;
+	wndStyle   = WND_STYLE;
+}
+
+//-------------------------------- Display ------------------------------
+//
+// Display records each frame of the scene and the hud
+//
+IDisplay* CreateDisplay(IScene* s, ILighting* l, IHUD* h, ICameras* ca) {
+
+	return new Display(s, l, h, ca);
+}
+
+// constructor initializes the instance variables
+//
+Display::Display(IScene* s, ILighting* l, IHUD* h, ICameras* ca) :
+ scene(s), lighting(l), hud(h), cameras(ca) {
+
+	display  = RUN_IN_WINDOW;
+	mode     = 0;
+	pixel    = 0;
+	width    = WND_WIDTH;
+	height   = WND_HEIGHT;
+	titleBar = 0;
+	frame    = 0;
+	lodScale = 1;
+}
+
+// setup attaches the recorder and the rasterizer to the related classes
+// and records the projection transformation and the lights
+//
+bool Display::setup() {
+
+	// the selector is absent when the engine runs without its dialog -
+	// and there is no dialog without Win32
+	#ifdef _WIN32
+	if (SelectorAddress())
+		SelectorAddress()->configureD(width, height, display, mode,
+		 pixel, titleBar);
+	#endif
+
+	release();
+
+	DeviceLight::recorder   = &recorder;
+	Graphic::recorder       = &recorder;
+	Mesh::recorder          = &recorder;
+	DeviceTexture::recorder = &recorder;
+	Font::recorder          = &recorder;
+	Font::width             = width;
+	Font::height            = height;
+	if (HEADLESS_RASTERIZE) {
+		if (!rasterizer.setup(width, height, HEADLESS_RASTER_THREADS))
+			error("Display::16 Couldn\'t start every rasterizer thread");
+		DeviceLight::rasterizer   = &rasterizer;
+		Graphic::rasterizer       = &rasterizer;
+		Mesh::rasterizer          = &rasterizer;
+		DeviceTexture::rasterizer = &rasterizer;
+		rasterizer.ambient(*lighting->ambient());
+	}
+
+	recorder.forget();
+	setupProjection();
+	lighting->setupDeviceLights(MAX_LIGHTS);
+	// start the threads that read texture files
+	if (!Loader::start())
+		error("Display::17 Couldn\'t start every loader thread");
+
+	return true;
+}
+
+// setupProjection calculates the transformation from camera space to
+// homogeneous clip space and records it
+//
+void Display::setupProjection() {
+
+	projectionFov(projection, FIELD_OF_VIEW, width/float(height),
+	 NEAR_CLIPPING, FAR_CLIPPING);
+	recorder.projection(projection);
+	// number of pixels covered by a unit length at unit distance
+	lodScale = height / (2 * tan(FIELD_OF_VIEW * 0.5f));
+}
+
+// draw records a frame of the Scene followed by the hud, rasterizes the
+// scene and reports the counts for the frame every HEADLESS_REPORT_FRAMES
+// frames - every HEADLESS_CAPTURE_FRAMES frames draw writes the
+// rasterized frame to a file
+//
+void Display::draw(const Vector& p, const Vector& h, const Vector& u) {
+
+	// hand the files that the loader threads have read to their textures
+	Loader::finish();
+
+	Matrix v;
+	view(v, p, p + h, u);
+	recorder.begin(frame);
+	recorder.view(v);
+
+	// select the parts of the scene that lie within the frustum
+	Frustum f;
+	scene->select(p, frustum(f, v * projection), lodScale);
+
+	if (DeviceLight::rasterizer) {
+		rasterizer.ambient(*lighting->ambient());
+		rasterizer.begin(v * projection, Colour(BGROUND_R / 255.f,
+		 BGROUND_G / 255.f, BGROUND_B / 255.f));
+	}
+	recorder.state(STATE_Z_ENABLE, true);
+	scene->drawBackground();
+	recorder.state(STATE_ALPHA_BLEND, false);
+	scene->drawOpaque();
+	recorder.state(STATE_ALPHA_BLEND, true);
+	scene->drawTranslucent();
+	recorder.state(STATE_ALPHA_BLEND, false);
+	if (DeviceLight::rasterizer) {
+		rasterizer.end();
+		if (HEADLESS_CAPTURE_FRAMES &&
+		 frame % HEADLESS_CAPTURE_FRAMES == 0) {
+			char file[80], str[160];
+			sprintf(file, HEADLESS_CAPTURE_FILE, frame);
+			if (rasterizer.capture(file))
+				sprintf(str, "Frame %d: captured %d triangles to %s",
+				 frame, rasterizer.triangles(), file);
+			else
+				sprintf(str, "Frame %d: couldn\'t capture to %s", frame,
+				 file);
+			report(str);
+		}
+	}
+
+	if (hud->isOn()) {
+		recorder.state(STATE_Z_ENABLE, false);
+		hud->draw();
+	}
+	recorder.end();
+
+	if (HEADLESS_REPORT_FRAMES && frame % HEADLESS_REPORT_FRAMES == 0) {
+		const FrameStats& s = recorder.stats();
+		int drawn, culled;
+		scene->cullCounts(drawn, culled);
+		char str[180];
+		sprintf(str, "Frame %d: %d commands, %d draws, %d primitives, "
+		 "%d states, %d saved, %d uploads (%d bytes), objects drawn %d, "
+		 "culled %d, overruns %d", s.frame, s.commands, s.draws,
+		 s.primitives, s.states, s.saved, s.uploads, s.uploadBytes, drawn,
+		 culled, s.overruns);
+		report(str);
+		sprintf(str, "Frame %d: textures %d (%d KB), hits %d, misses %d",
+		 s.frame, TextureCache::textures(), TextureCache::resident() / 1024,
+		 TextureCache::hits(), TextureCache::misses());
+		report(str);
+	}
+	TextureCache::endFrame();
+	frame++;
+}
+
+// wndResize recalculates the projection for the new client area
+//
+void Display::wndResize() {
+
+	setupProjection();
+}
+
+// suspend detaches the fonts
+//
+void Display::suspend() {
+
+	hud->suspend();
+}
+
+// restore marks the recorded state as unknown - the recorder cannot be
+// lost
+//
+bool Display::restore() {
+
+	recorder.forget();
+	setupProjection();
+	lighting->setupDeviceLights(MAX_LIGHTS);
+
+	return true;
+}
+
+// release detaches the recorder and the rasterizer from the related
+// classes
+//
+void Display::release() {
+
+	// finish the files being read before the recorder detaches
+	Loader::stop();
+	suspend();
+	hud->release();
+	// delete the cached textures that have no users
+	TextureCache::flush();
+
+	DeviceLight::recorder   = NULL;
+	Graphic::recorder       = NULL;
+	Mesh::recorder          = NULL;
+	DeviceTexture::recorder = NULL;
+	Font::recorder          = NULL;
+	DeviceLight::rasterizer   = NULL;
+	Graphic::rasterizer       = NULL;
+	Mesh::rasterizer          = NULL;
+	DeviceTexture::rasterizer = NULL;
+}
+
+// destructor releases the recorder
+//
+Display::~Display() {
+
+	release();
+}
+
+//-------------------------------- DeviceLight ---------------------------
+//
+// DeviceLight records the state of a light source
+//
+IDeviceLight* CreateDeviceLight(ILight* light) {
+
+	return new DeviceLight(light);
+}
+
+Recorder*   DeviceLight::recorder   = NULL;
+Rasterizer* DeviceLight::rasterizer = NULL;
+
+// setup records light source i and attaches it to the rasterizer
+//
+void DeviceLight::setup(int i) {
+
+	index = i;
+	if (rasterizer)
+		rasterizer->light(index, light);
+	update();
+}
+
+// update records whether the light source is on
+//
+void DeviceLight::update() {
+
+	if (recorder)
+		recorder->light(index, light->isOn());
+}
+
+//-------------------------------- Graphic -------------------------------
+//
+// Graphic records the uploads and draws of the primitives of an object
+//
+IGraphic* CreateGraphic(Shape pType, int noPrimitives, int noVertices,
+ int vSize, int noIndices, Colour clr, IDeviceTexture* devTex,
+ bool antiAlias) {
+
+	return new Graphic(pType, noPrimitives, noVertices, vSize, noIndices,
+	 clr, devTex, antiAlias);
+}
+
+Recorder*   Graphic::recorder   = NULL;
+Rasterizer* Graphic::rasterizer = NULL;
+unsigned    Graphic::count      = 0;
+
+// constructor stores the primitive type and the reflective colour
+//
+Graphic::Graphic(Shape pType, int noPrimitives, int noVertices,
+ int vSize, int noIndices, Colour clr, IDeviceTexture* devTex,
+ bool antiAlias) : shape(pType), antiAliasingOn(antiAlias),
+ nVertices(noVertices), vertexSize(vSize), nIndices(noIndices),
+ indexSize(sizeof(short)), nTextures(0), deviceTexture(NULL),
+ diffuse(clr), vb(NULL), ib(NULL), packed(false) {
+
+	id          = ++count;
+	nPrimitives = noPrimitives > 0 ? noPrimitives : 1;
+	isOpaque    = clr.a == 1.f;
+	add(devTex);
+}
+
+// setup copies the vertices and the indices of the object and records
+// their upload - the vertices are packed to half their size if the
+// bounds of the graphic allow
+//
+void Graphic::setup(const IObject* object) {
+
+	indexSize = object->wideIndices() ? sizeof(unsigned) : sizeof(short);
+	vb = new char[nVertices * vertexSize];
+	ib = new char[nIndices * indexSize];
+	object->populateVB(vb);
+	object->populateIB(ib);
+	#if VERTEX_PACKING
+	if (vertexSize == VERTEX_FLOATS * sizeof(float) &&
+	 choosePacking((const float*)vb, nVertices, VERTEX_PACK_ERROR,
+	 VERTEX_PACK_UV_ERROR, packing)) {
+		char* p = new char[nVertices * sizeof(PackedVertex)];
+		encodeVertices((const float*)vb, nVertices, packing,
+		 (PackedVertex*)p);
+		delete [] vb;
+		vb     = p;
+		packed = true;
+	}
+	#endif
+	if (recorder) {
+		recorder->upload(id, 0, nVertices * stride());
+		recorder->upload(id, 0, nIndices * indexSize);
+	}
+}
+
+// unpack replaces the packed vertices with vertices at full precision
+//
+void Graphic::unpack() {
+
+	char* p = new char[nVertices * vertexSize];
+	decodeVertices((const PackedVertex*)vb, nVertices, packing, (float*)p);
+	delete [] vb;
+	vb     = p;
+	packed = false;
+}
+
+// add adds a texture level to the graphic representation
+//
+void Graphic::add(IDeviceTexture* devTex) {
+
+	if (devTex) {
+		IDeviceTexture** dTexture = new IDeviceTexture*[nTextures + 1];
+		for (int i = 0; i < nTextures; i++)
+			dTexture[i] = deviceTexture[i];
+		dTexture[nTextures++] = devTex;
+		if (deviceTexture) delete [] deviceTexture;
+		deviceTexture = dTexture;
+	}
+}
+
+// update copies the n vertices of the object that start at index first
+// and records their upload - a vertex that moves outside the bounds of
+// the packed vertices unpacks them
+//
+void Graphic::update(const IObject* object, int first, int n) {
+
+	if (vb && packed) {
+		float* vertex = new float[n * VERTEX_FLOATS];
+		object->populateVB(vertex, first, n);
+		if (!encodeVertices(vertex, n, packing, (PackedVertex*)vb + first)) {
+			unpack();
+			memcpy(vb + first * vertexSize, vertex, n * vertexSize);
+		}
+		delete [] vertex;
+	}
+	else if (vb)
+		object->populateVB(vb + first * vertexSize, first, n);
+	if (vb && recorder)
+		recorder->upload(id, first * stride(), n * stride());
+}
+
+// draw records the draw of the object - there is no queue to sort, so
+// the draw is recorded at once
+//
+void Graphic::draw(const IObject* object) {
+
+	// if just created, setup first
+	if (!vb) setup(object);
+
+	render(object, 0);
+}
+
+// render records the state for the object followed by the draw of each
+// range that the object has selected and rasterizes each range - the
+// rasterizer samples the first texture level
+//
+void Graphic::render(const IObject* object, int) {
+
+	if (!recorder) return;
+
+	const RasterTexture* t = nTextures ?
+	 &((DeviceTexture*)deviceTexture[0])->image : NULL;
+
+	recorder->world(object->world());
+	recorder->material(diffuse, Colour(diffuse.r * 0.7f,
+	 diffuse.g * 0.7f, diffuse.b * 0.7f, diffuse.a),
+	 Colour(1, 1, 1, diffuse.a), 100);
+	for (int i = 0; i < nTextures; i++)
+		deviceTexture[i]->attach(i);
+	recorder->texture(nTextures, 0);
+	recorder->state(STATE_ANTI_ALIAS, antiAliasingOn);
+	int nRanges;
+	const Range* range = object->ranges(nRanges);
+	if (range)
+		for (int i = 0; i < nRanges; i++) {
+			recorder->draw(id, shape, i, range[i].nPrimitives);
+			if (!within(range[i].baseVertex, range[i].startIndex,
+			 range[i].nPrimitives))
+				recorder->overrun();
+			if (rasterizer)
+				rasterizer->draw(object->world(), diffuse, t, !isOpaque,
+				 shape, vb, vertexSize, packed ? &packing : NULL,
+				 nVertices, ib, indexSize == 4, range[i].baseVertex,
+				 range[i].startIndex, range[i].nPrimitives);
+		}
+	else {
+		recorder->draw(id, shape, 0, nPrimitives);
+		if (!within(0, 0, nPrimitives))
+			recorder->overrun();
+		if (rasterizer)
+			rasterizer->draw(object->world(), diffuse, t, !isOpaque, shape,
+			 vb, vertexSize, packed ? &packing : NULL, nVertices, ib,
+			 indexSize == 4, 0, 0, nPrimitives);
+	}
+}
+
+// within returns true if the primitives primitives that start at index
+// startIndex lie within the copy of the indices and each of their
+// indices, offset by baseVertex, addresses a vertex in the copy of the
+// vertices
+//
+bool Graphic::within(int baseVertex, int startIndex, int primitives) const {
+
+	int n;
+	switch (shape) {
+		case POINT_LIST:     n = primitives;     break;
+		case LINE_LIST:      n = 2 * primitives; break;
+		case LINE_STRIP:     n = primitives + 1; break;
+		case TRIANGLE_LIST:  n = 3 * primitives; break;
+		case TRIANGLE_STRIP:
+		case TRIANGLE_FAN:   n = primitives + 2; break;
+		default:             return true;
+	}
+	if (!ib || startIndex < 0 || startIndex + n > nIndices)
+		return false;
+	const unsigned short* i16 = (const unsigned short*)ib + startIndex;
+	const unsigned*       i32 = (const unsigned*)ib + startIndex;
+	for (int i = 0; i < n; i++) {
+		int v = baseVertex + (int)(wide() ? i32[i] : i16[i]);
+		if (v < 0 || v >= nVertices)
+			return false;
+	}
+
+	return true;
+}
+
+// render records and rasterizes the draws of the n objects at object one
+// at a time - the recorder draws without a queue
+//
+void Graphic::render(const IObject* const* object, int n, int subset) {
+
+	for (int i = 0; i < n; i++)
+		render(object[i], subset);
+}
+
+// suspend discards the copies - the next draw uploads them again
+//
+void Graphic::suspend() {
+
+	if (vb) {
+		delete [] vb;
+		vb     = NULL;
+		packed = false;
+	}
+	if (ib) {
+		delete [] ib;
+		ib = NULL;
+	}
+}
+
+// destructor releases the graphic representation
+//
+Graphic::~Graphic() {
+
+	suspend();
+	if (deviceTexture)
+		delete [] deviceTexture;
+}
+
+//-------------------------------- Mesh ----------------------------------
+//
+// Mesh records the uploads and draws of the subsets of a mesh
+//
+IGraphic* CreateMesh(int noSubsets, int noPrimitives, int noVertices,
+ Colour* clr, IDeviceTexture** devTex, bool antiAlias) {
+
+	return new Mesh(noSubsets, noPrimitives, noVertices, clr, devTex,
+	 antiAlias);
+}
+
+IGraphic* CreateMesh(Shape shape, float* d, int* p, Colour clr,
+ bool antiAlias) {
+
+	return new Mesh(shape, d, p, clr, antiAlias);
+}
+
+IGraphic* CreateMesh(Shape shape, const char* filename, bool antiAlias) {
+
+	return new Mesh(shape, filename, antiAlias);
+}
+
+Recorder*   Mesh::recorder   = NULL;
+Rasterizer* Mesh::rasterizer = NULL;
+unsigned    Mesh::count      = 0;
+
+// constructor stores the tesselation and colour of a stock shape
+//
+Mesh::Mesh(Shape s, float* d, int* p, Colour clr, bool antiAlias) :
+ antiAliasingOn(antiAlias), isSetup(false), nSubsets(1), nPrimitives(0),
+ nVertices(0), subsetPrimitives(NULL), shape(s), file(NULL), vb(NULL),
+ ib(NULL), subsetStart(NULL) {
+
+	id           = ++count;
+	partition[0] = s == TEAPOT ? 0 : p[0];
+	partition[1] = s == TEAPOT ? 0 : p[1];
+	diffuse      = new Colour[1];
+	diffuse[0]   = clr;
+	tex          = new IDeviceTexture*[1];
+	tex[0]       = NULL;
+	isOpaque     = clr.a == 1.f;
+}
+
+// constructor stores the name of the file that holds the mesh
+//
+Mesh::Mesh(Shape s, const char* filename, bool antiAlias) :
+ antiAliasingOn(antiAlias), isSetup(false), nSubsets(1), nPrimitives(0),
+ nVertices(0), subsetPrimitives(NULL), shape(s), file(filename),
+ vb(NULL), ib(NULL), subsetStart(NULL) {
+
+	id           = ++count;
+	partition[0] = 0;
+	partition[1] = 0;
+	diffuse      = new Colour[1];
+	diffuse[0]   = Colour(1, 1, 1, 1);
+	tex          = new IDeviceTexture*[1];
+	tex[0]       = NULL;
+	isOpaque     = true;
+}
+
+// constructor stores the colours and device textures of each subset of
+// a custom mesh
+//
+Mesh::Mesh(int noSubsets, int noPrimitives, int noVertices, Colour* clr,
+ IDeviceTexture** devTex, bool antiAlias) : antiAliasingOn(antiAlias),
+ isSetup(false), nSubsets(noSubsets), nPrimitives(noPrimitives),
+ nVertices(noVertices), subsetPrimitives(NULL), shape(CUSTOM),
+ file(NULL), vb(NULL), ib(NULL), subsetStart(NULL) {
+
+	id           = ++count;
+	partition[0] = 0;
+	partition[1] = 0;
+	diffuse      = new Colour[nSubsets];
+	tex          = new IDeviceTexture*[nSubsets];
+	isOpaque     = true;
+	for (int i = 0; i < nSubsets; i++) {
+		if (clr[i].a < 1.f)
+			isOpaque = false;
+		diffuse[i] = clr[i];
+		tex[i]     = devTex[i];
+	}
+}
+
+// setup counts the primitives in each subset and records the upload of
+// the mesh - the stock shapes count the triangles of the D3DX
+// tesselations and a .x file, which the recorder does not read, counts
+// none.  Only a custom mesh keeps copies of its vertices and indices for
+// the rasterizer
+//
+void Mesh::setup(const IObject* object) {
+
+	int slices = partition[0], stacks = partition[1];
+
+	if (!subsetPrimitives) {
+		subsetPrimitives = new int[nSubsets];
+		for (int i = 0; i < nSubsets; i++)
+			subsetPrimitives[i] = 0;
+	}
+	switch (shape) {
+		case SPHERE:
+			subsetPrimitives[0] = 2 * slices * (stacks - 1);
+			break;
+		case CYLINDER:
+			subsetPrimitives[0] = 2 * slices * (stacks + 1);
+			break;
+		case TORUS:
+			subsetPrimitives[0] = 2 * slices * stacks;
+			break;
+		case TEAPOT:
+			subsetPrimitives[0] = 2256;
+			break;
+		case CUSTOM:
+			if (nPrimitives) {
+				// the attribute buffer assigns each primitive to a subset
+				unsigned* ab = new unsigned[nPrimitives];
+				object->populateAB(ab);
+				for (int i = 0; i < nPrimitives; i++)
+					if (ab[i] < (unsigned)nSubsets)
+						subsetPrimitives[ab[i]]++;
+				if (rasterizer && !vb)
+					copy(object, ab);
+				delete [] ab;
+			}
+			if (recorder) {
+				int indexSize = object->wideIndices() ? sizeof(unsigned) :
+				 sizeof(short);
+				recorder->upload(id, 0, nVertices * VERTEX_SIZE);
+				recorder->upload(id, 0, 3 * nPrimitives * indexSize);
+			}
+			break;
+		default:
+			break;
+	}
+	isSetup = true;
+}
+
+// copy copies the vertices and the indices of a custom mesh for the
+// rasterizer - the indices of each subset are gathered using the
+// attribute buffer ab
+//
+void Mesh::copy(const IObject* object, const unsigned* ab) {
+
+	vb = new char[nVertices * VERTEX_SIZE];
+	object->populateVB(vb);
+
+	bool wide = object->wideIndices();
+	char* raw = new char[3 * nPrimitives *
+	 (wide ? sizeof(unsigned) : sizeof(short))];
+	object->populateIB(raw);
+	ib          = new unsigned[3 * nPrimitives];
+	subsetStart = new int[nSubsets];
+	int k = 0;
+	for (int s = 0; s < nSubsets; s++) {
+		subsetStart[s] = k;
+		for (int i = 0; i < nPrimitives; i++)
+			if (ab[i] == (unsigned)s)
+				for (int j = 3 * i; j < 3 * i + 3; j++)
+					ib[k++] = wide ? ((unsigned*)raw)[j] :
+					 ((unsigned short*)raw)[j];
+	}
+	delete [] raw;
+}
+
+// update records the upload of the n vertices of the object that start
+// at index first and refreshes the rasterizer's copy
+//
+void Mesh::update(const IObject* object, int first, int n) {
+
+	if (isSetup && shape == CUSTOM && recorder)
+		recorder->upload(id, first * VERTEX_SIZE, n * VERTEX_SIZE);
+	if (vb)
+		object->populateVB(vb + first * VERTEX_SIZE, first, n);
+}
+
+// draw records the draw of each subset of the mesh
+//
+void Mesh::draw(const IObject* object) {
+
+	// if just created, setup first
+	if (!isSetup) setup(object);
+
+	for (int i = 0; i < nSubsets; i++)
+		render(object, i);
+}
+
+// render records the state for subset i followed by its draw and
+// rasterizes the subset of a custom mesh
+//
+void Mesh::render(const IObject* object, int i) {
+
+	if (!recorder) return;
+
+	Colour& d = diffuse[i];
+	recorder->world(object->world());
+	recorder->material(d, Colour(d.r * 0.7f, d.g * 0.7f, d.b * 0.7f, d.a),
+	 Colour(1, 1, 1, d.a), 100);
+	if (tex[i])
+		tex[i]->attach(0);
+	else
+		recorder->texture(0, 0);
+	recorder->texture(1, 0);
+	recorder->state(STATE_ANTI_ALIAS, antiAliasingOn);
+	recorder->draw(id, shape, i, subsetPrimitives[i]);
+	if (rasterizer && vb)
+		rasterizer->draw(object->world(), d, tex[i] ?
+		 &((DeviceTexture*)tex[i])->image : NULL, d.a < 1.f,
+		 TRIANGLE_LIST, vb, VERTEX_SIZE, NULL, nVertices, ib, true, 0,
+		 subsetStart[i], subsetPrimitives[i]);
+}
+
+// render records and rasterizes subset i of the n objects at object one
+// at a time
+//
+void Mesh::render(const IObject* const* object, int n, int i) {
+
+	for (int k = 0; k < n; k++)
+		render(object[k], i);
+}
+
+// suspend discards the copies for the rasterizer - the next draw sets up
+// the mesh again
+//
+void Mesh::suspend() {
+
+	isSetup = false;
+	if (vb) {
+		delete [] vb;
+		vb = NULL;
+	}
+	if (ib) {
+		delete [] ib;
+		ib = NULL;
+	}
+	if (subsetStart) {
+		delete [] subsetStart;
+		subsetStart = NULL;
+	}
+}
+
+// destructor releases the mesh representation
+//
+Mesh::~Mesh() {
+
+	suspend();
+	if (subsetPrimitives)
+		delete [] subsetPrimitives;
+	if (diffuse)
+		delete [] diffuse;
+	if (tex)
+		delete [] tex;
+}
+
+//-------------------------------- DeviceTexture -------------------------
+//
+// DeviceTexture records the upload and use of a texture - a file that
+// has been loaded with the same flags and border colour shares the
+// texture that the cache holds for it
+//
+IDeviceTexture* CreateDeviceTexture(const char* file, unsigned flags,
+ Colour brdrClr) {
+
+	IDeviceTexture* texture = TextureCache::find(file, flags, brdrClr);
+	if (!texture) {
+		DeviceTexture* t = new DeviceTexture(file, flags, brdrClr);
+		t->entry = TextureCache::add(t, file, flags, brdrClr);
+		texture  = t;
+	}
+
+	return texture;
+}
+
+Recorder*   DeviceTexture::recorder   = NULL;
+Rasterizer* DeviceTexture::rasterizer = NULL;
+unsigned    DeviceTexture::count      = 0;
+
+// constructor stores the name of the image file
+//
+DeviceTexture::DeviceTexture(const char* file, unsigned flags,
+ Colour brdrClr) : bytes(0), isSetup(false) {
+
+	id = ++count;
+	entry        = NULL;
+	loading      = NULL;
+	image.width  = 0;
+	image.height = 0;
+	image.texel  = NULL;
+	filename = new char[strlen(file) + 1];
+	strcopy(filename, file, strlen(file));
+}
+
+// setup decodes the image file on a loader thread - the texture is
+// drawn without texels until the file has been decoded
+//
+void DeviceTexture::setup() {
+
+	if (!loading) {
+		loading = new TextureLoad(filename, rasterizer && !image.texel,
+		 this);
+		Loader::submit(loading);
+	}
+}
+
+// loaded records the upload of the texture once its file has been read
+// and takes the texels that the loader thread decoded
+//
+void DeviceTexture::loaded(int size, RasterTexture& texels) {
+
+	loading = NULL;
+	if (texels.texel) {
+		if (image.texel)
+			delete [] image.texel;
+		image = texels;
+		texels.texel = NULL;
+	}
+	bytes = size;
+	if (recorder)
+		recorder->upload(id, 0, bytes);
+	TextureCache::resident(entry, bytes);
+	isSetup = true;
+}
+
+// attach records the binding of the texture to stage i
+//
+void DeviceTexture::attach(int i) {
+
+	if (!isSetup) setup();
+	TextureCache::used(entry);
+
+	if (recorder)
+		recorder->texture(i, id);
+}
+
+// detach records the unbinding of stage i
+//
+void DeviceTexture::detach(int i) {
+
+	if (recorder)
+		recorder->texture(i, 0);
+}
+
+// draw records the draw of the visible portion of the texture onto the
+// background
+//
+void DeviceTexture::draw(int topLeftX, int topLeftY, int bottomRightX,
+ int bottomRightY) {
+
+	if (!isSetup) setup();
+	TextureCache::used(entry);
+
+	if (recorder)
+		recorder->sprite(id, topLeftX, topLeftY, bottomRightX,
+		 bottomRightY);
+	if (rasterizer)
+		rasterizer->background(&image, topLeftX, topLeftY, bottomRightX,
+		 bottomRightY);
+}
+
+// suspend marks the texture as no longer uploaded
+//
+void DeviceTexture::suspend() {
+
+	isSetup = false;
+	TextureCache::resident(entry, 0);
+}
+
+// Delete removes a user from the texture and deletes the texture once
+// the cache has evicted it
+//
+void DeviceTexture::Delete() {
+
+	if (TextureCache::release(entry)) {
+		entry = NULL;
+		delete this;
+	}
+}
+
+// destructor releases the file name and the texels
+//
+DeviceTexture::~DeviceTexture() {
+
+	if (loading)
+		loading->cancel();
+	if (filename)
+		delete [] filename;
+	if (image.texel)
+		delete [] image.texel;
+}
+
+//-------------------------------- TextureLoad ---------------------------
+//
+// TextureLoad reads an image file for a device texture
+//
+// constructor copies the name of the file for the loader thread
+//
+TextureLoad::TextureLoad(const char* f, bool d, DeviceTexture* t) :
+ decode(d), bytes(0), texture(t) {
+
+	file = new char[strlen(f) + 1];
+	strcopy(file, f, strlen(f));
+	image.width  = 0;
+	image.height = 0;
+	image.texel  = NULL;
+}
+
+// load decodes the file on a loader thread - the size of the decoded
+// image, or of a file that cannot be decoded, stands in for the size of
+// the texture.  The rasterizer samples uncompressed texels, so only a
+// texture that it does not sample is baked
+//
+void TextureLoad::load() {
+
+	Image decoded;
+	if (decode ? loadImage(file, decoded) : loadBakedImage(file, decoded)) {
+		bytes = decoded.size;
+		// the rasterizer samples the top level of uncompressed texels -
+		// DXT blocks, such as those of an atlas page, are decompressed
+		if (decode && decompressImage(decoded)) {
+			image.width   = decoded.width;
+			image.height  = decoded.height;
+			image.texel   = (unsigned*)decoded.data;
+			decoded.data  = NULL;
+		}
+		releaseImage(decoded);
+	}
+	else {
+		FILE* fp = fopen(file, "rb");
+		if (fp) {
+			fseek(fp, 0, SEEK_END);
+			bytes = (int)ftell(fp);
+			fclose(fp);
+		}
+	}
+}
+
+// finish hands the texels to the texture that is still waiting for them
+//
+void TextureLoad::finish() {
+
+	if (texture)
+		texture->loaded(bytes, image);
+}
+
+// destructor releases the name and any texels not handed over
+//
+TextureLoad::~TextureLoad() {
+
+	delete [] file;
+	if (image.texel)
+		delete [] image.texel;
+}
+
+//-------------------------------- Font ----------------------------------
+//
+// Font records the text drawn by a single Text object
+//
+IFont* CreateFont_(IText* text, unsigned int flags) {
+
+	return new Font(text);
+}
+
+Recorder* Font::recorder = NULL;
+int       Font::width    = WND_WIDTH;
+int       Font::height   = WND_HEIGHT;
+
+// draw records str at the top left corner of the text's rectangle
+//
+void Font::draw(const char* str) {
+
+	if (recorder && str)
+		recorder->text((int)(width * text->topLeftX()),
+		 (int)(height * text->topLeftY()), str);
+}
+#endif
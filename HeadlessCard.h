@@ -0,0 +1,468 @@
+#ifndef _HEADLESS_CARD_H_
+#define _HEADLESS_CARD_H_
+
+/* Header for the Headless GraphicsCard Module
+ *
+ * consists of Command declaration
+ *             FrameStats declaration
+ *             Recorder declaration
+ *             Host declaration
+ *             Display declaration
+ *             DeviceLight declaration
+ *             Graphic declaration
+ *             Mesh declaration
+ *             DeviceTexture declaration
+ *             TextureLoad declaration
+ *             Font declaration
+ *
+ * HeadlessCard.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+
+#if GRAPHICS_API == HEADLESS
+#include "IGraphicsCard.h" // for the graphics card interfaces
+#include "math.h"          // for Matrix and Colour
+#include "Rasterizer.h"    // for Rasterizer and RasterTexture
+#include "VertexCodec.h"   // for PackedVertex and VertexPacking
+#include "TextureCache.h"  // for TextureCache
+#include "Loader.h"        // for Loader and LoadRequest
+
+//-------------------------------- Command -------------------------------
+//
+// A Command opens each record in the command stream - the first word of
+// a record holds the command in its high byte and the number of words
+// that follow in its low bytes
+//
+typedef enum Command {
+	CMD_FRAME      = 1,  // frame number
+	CMD_VIEW       = 2,  // view transformation - 16 floats
+	CMD_PROJECTION = 3,  // projection transformation - 16 floats
+	CMD_WORLD      = 4,  // world transformation - 16 floats
+	CMD_MATERIAL   = 5,  // diffuse, ambient, specular rgba, power
+	CMD_TEXTURE    = 6,  // stage, texture identifier - 0 for none
+	CMD_STATE      = 7,  // render state, value
+	CMD_LIGHT      = 8,  // light index, on
+	CMD_UPLOAD     = 9,  // buffer identifier, first byte, bytes
+	CMD_DRAW       = 10, // buffer identifier, shape, subset, primitives
+	CMD_SPRITE     = 11, // texture identifier, left, top, right, bottom
+	CMD_TEXT       = 12, // left, top, characters, packed text
+	CMD_PRESENT    = 13  // end of the frame
+} Command;
+
+// render states recorded with CMD_STATE
+//
+typedef enum RenderState {
+	STATE_ALPHA_BLEND = 0,
+	STATE_ANTI_ALIAS  = 1,
+	STATE_Z_ENABLE    = 2
+} RenderState;
+
+//-------------------------------- FrameStats ----------------------------
+//
+// FrameStats holds the counts for a single recorded frame
+//
+struct FrameStats {
+	int frame;       // frame number
+	int commands;    // records in the stream
+	int draws;       // draw records
+	int primitives;  // primitives drawn
+	int states;      // state records
+	int saved;       // state records dropped as redundant
+	int uploads;     // upload records
+	int uploadBytes; // bytes uploaded
+	int overruns;    // draws that address a vertex outside their buffer
+};
+
+//-------------------------------- Recorder ------------------------------
+//
+// Recorder stands in for the display device - it appends each command
+// to a compact stream of 32-bit words that holds the current frame.  The
+// recorder shadows the state that it has recorded and drops each command
+// that would set a state to the value that it already holds
+//
+class Recorder {
+
+	static const int MIN_WORDS  = 1024; // initial allocation
+	static const int MAX_STAGES = 8;    // texture stages shadowed
+	static const int MAX_STATES = 3;    // render states shadowed
+	static const int MAX_LIGHTS = 8;    // lights shadowed
+	static const int MAT_WORDS  = 13;   // words in a material record
+
+	static Recorder* address_; // points to the most recent recorder
+
+	unsigned*  word;     // the stream for the current frame
+	int        nWords;   // number of words recorded
+	int        capacity; // number of words allocated
+	FrameStats current;  // counts for the current frame
+	FrameStats last;     // counts for the last complete frame
+
+	// shadowed state - each shadow holds the payload last recorded
+	unsigned view_[16];
+	unsigned projection_[16];
+	unsigned world_[16];
+	unsigned material_[MAT_WORDS];
+	unsigned texture_[MAX_STAGES][2];
+	unsigned state_[MAX_STATES][2];
+	unsigned light_[MAX_LIGHTS][2];
+	bool     viewKnown;
+	bool     projectionKnown;
+	bool     worldKnown;
+	bool     materialKnown;
+	bool     textureKnown[MAX_STAGES];
+	bool     stateKnown[MAX_STATES];
+	bool     lightKnown[MAX_LIGHTS];
+
+	Recorder(const Recorder&);            // prevents copying
+	Recorder& operator=(const Recorder&); // prevents assignment
+	bool grow(int n);
+	void record(Command c, const unsigned* data, int n);
+	void change(Command c, unsigned* shadow, bool& known,
+	 const unsigned* data, int n);
+
+  public:
+	Recorder();
+	~Recorder();
+	static Recorder* address() { return address_; }
+	void begin(int frame);
+	void view(const Matrix& m);
+	void projection(const Matrix& m);
+	void world(const Matrix& m);
+	void material(const Colour& d, const Colour& a, const Colour& s,
+	 float power);
+	void texture(int stage, unsigned id);
+	void state(RenderState s, unsigned value);
+	void light(int index, bool on);
+	void upload(unsigned buffer, int first, int bytes);
+	void draw(unsigned buffer, Shape shape, int subset, int primitives);
+	void overrun() { current.overruns++; }
+	void sprite(unsigned id, int left, int top, int right, int bottom);
+	void text(int left, int top, const char* str);
+	void end();
+	void forget();
+	const unsigned*   stream(int& n) const { n = nWords; return word; }
+	const FrameStats& stats() const        { return last; }
+};
+
+const Recorder* RecorderAddress();
+
+//-------------------------------- Host ---------------------------------
+//
+// Host describes a single display adapter with a single windowed mode
+//
+class Host : public IHost {
+
+	Host(void* hDbWnd) {}
+	Host(const Host&);
+	Host& operator=(const Host&);
+    virtual ~Host() {}
+
+  public:
+	friend IHost* CreateHost(void* hDbWnd);
+    int    adapterCount() const { return 1; }
+    int    displayDescription(int id, char* desc, int maxDesc) const;
+    int    formatCount()        { return 1; }
+    int    modeCount(int id, int k) const { return 1; }
+    bool   getMode(int id, int ir, int k, unsigned& fmMd, char* line);
+	void   configure(unsigned fmMd, int& id, int& ir, int& format,
+	 int& width, int& height, int& wndStyle, int& wndExStyle);
+	void   Delete() { delete this; }
+};
+
+//-------------------------------- Display ------------------------------
+//
+// Display records each frame of the scene and the hud in place of
+// drawing it - and rasterizes the scene on the cpu if HEADLESS_RASTERIZE
+// is set
+//
+class Display : public IDisplay {
+
+	static const int MAX_LIGHTS = 8;
+
+    IScene*    scene;      // points to the scene interface
+    ILighting* lighting;   // points to the lighting interface
+    IHUD*      hud;        // points to the heads up display interface
+	ICameras*  cameras;    // points to the cameras interface
+    int        display;    // display adapter identifier
+    int        mode;       // resolution mode identifier
+    int        pixel;      // pixel format identifier
+    int        width;      // width of the client area
+    int        height;     // height of the client area
+    int        titleBar;   // approximate height of the title bar
+	int        frame;      // number of frames recorded
+	float      lodScale;   // pixels per unit of size at unit distance
+	Matrix     projection; // projection transformation
+	Recorder   recorder;   // records the command stream
+	Rasterizer rasterizer; // draws the frame on the cpu
+
+    void setupProjection();
+
+    Display(IScene* s, ILighting* l, IHUD* h, ICameras* ca);
+	Display(const Display& d);            // prevents copying
+	Display& operator=(const Display& d); // prevents assignment
+    virtual ~Display();
+
+  public:
+	friend IDisplay* CreateDisplay(IScene* s, ILighting* l, IHUD* h,
+	 ICameras* ca);
+    bool   setup();
+    void   wndResize();
+    void   draw(const Vector& p, const Vector& h, const Vector& u);
+    void   suspend();
+    bool   restore();
+    void   release();
+	void   Delete() { delete this; }
+};
+
+//-------------------------------- DeviceLight ---------------------------
+//
+// DeviceLight records the state of a light source
+//
+class ILight;
+
+class DeviceLight : public IDeviceLight {
+
+	static Recorder* recorder;     // records the command stream
+	static Rasterizer* rasterizer; // draws the frame, NULL if off
+
+	ILight* light;             // points to light source interface
+	int index;                 // identifier on the recorder
+
+	DeviceLight(ILight* l) : light(l), index(0) {}
+
+  public:
+	friend IDeviceLight* CreateDeviceLight(ILight* light);
+	void   setup(int index);
+	void   update();
+	friend class Display;
+};
+
+//-------------------------------- Graphic -------------------------------
+//
+// Graphic records the uploads and draws of the graphics primitives that
+// represent an object - a copy of the vertices and indices stands in for
+// the vertex and index buffers, and each draw is checked against the
+// copies, so that a draw that addresses a vertex outside them is counted
+// as an overrun
+//
+class IObject;
+
+class Graphic : public IGraphic {
+
+	static Recorder* recorder;      // records the command stream
+	static Rasterizer* rasterizer;  // draws the frame, NULL if off
+	static unsigned  count;         // number of buffers created
+
+	unsigned id;                    // identifies the buffers in the stream
+	Shape shape;                    // primitive type
+    bool  isOpaque;                 // is perfectly opaque?
+	bool  antiAliasingOn;           // anti-aliasing is on?
+    int   nPrimitives;              // number of primitives
+	int   nVertices;                // number of vertices
+	int   vertexSize;               // size of a single vertex
+	int   nIndices;                 // number of indices
+	int   indexSize;                // size of a single index
+	int   nTextures;                // number of texture levels
+	IDeviceTexture** deviceTexture; // points to the deviceTexture object
+	Colour diffuse;                 // material reflectivity
+	char* vb;                       // copy of the vertices
+	char* ib;                       // copy of the indices
+	bool  packed;                   // are the vertices in vb packed?
+	VertexPacking packing;          // quantization of the packed vertices
+
+    Graphic(Shape pType, int noPrimitives, int noVertices,
+	 int vSize, int noIndices, Colour clr, IDeviceTexture* devTex,
+	 bool antiAlias);
+    Graphic(const Graphic& v);            // prevents copying
+    Graphic& operator=(const Graphic& v); // prevents assignment
+    virtual ~Graphic();
+
+	void setup(const IObject* object);
+	void unpack();
+	int  stride() const { return packed ? sizeof(PackedVertex) :
+	 vertexSize; }
+
+  public:
+	friend IGraphic* CreateGraphic(Shape pType, int noPrimitives,
+	 int noVertices, int vSize, int noIndices, Colour clr,
+	 IDeviceTexture* devTex, bool antiAlias);
+    bool   opaque() const { return isOpaque; }
+	void   add(IDeviceTexture* deviceTexture);
+	void   update(const IObject* object, int first, int n);
+    void   draw(const IObject* object);
+	void   render(const IObject* object, int subset);
+	void   render(const IObject* const* object, int n, int subset);
+	bool   bound(Vector&, float&) const { return false; }
+    void   suspend();
+	void   Delete() { delete this; }
+	// inspection of the copies made by setup - for tests
+	int    vertices() const { return nVertices; }
+	int    indices() const  { return nIndices; }
+	bool   wide() const     { return indexSize == sizeof(unsigned); }
+	bool   within(int baseVertex, int startIndex, int primitives) const;
+    friend class Display;
+};
+
+//-------------------------------- Mesh ----------------------------------
+//
+// Mesh records the uploads and draws of the subsets of a mesh - stock
+// shapes record the number of primitives that their tesselation yields
+//
+class Mesh : public IGraphic {
+
+	static const int VERTEX_SIZE = 32; // position, normal, texture coords
+
+	static Recorder* recorder;     // records the command stream
+	static Rasterizer* rasterizer; // draws the frame, NULL if off
+	static unsigned  count;        // number of meshes created
+
+	unsigned id;                   // identifies the mesh in the stream
+    bool  isOpaque;                // is perfectly opaque?
+	bool  antiAliasingOn;          // anti-aliasing is on?
+	bool  isSetup;                 // has been uploaded?
+    int   nSubsets;                // number of subsets in the mesh
+    int   nPrimitives;             // number of primitives in the mesh
+	int   nVertices;               // number of vertices in the mesh
+	int*  subsetPrimitives;        // number of primitives in each subset
+	Colour* diffuse;               // material reflectivity of each subset
+	IDeviceTexture** tex;          // points to deviceTexture addresses
+	Shape shape;                   // the type of shape being represented
+	int   partition[2];            // tesselation parameters
+	const char* file;              // file containing mesh data
+	char* vb;                      // copy of the vertices - rasterized
+	unsigned* ib;                  // indices sorted by subset - rasterized
+	int*  subsetStart;             // first index of each subset in ib
+
+    Mesh(int noSubsets, int noPrimitives, int noVertices, Colour* clr,
+	 IDeviceTexture** devTex, bool antiAlias);
+	Mesh(Shape shape, float* d, int* p, Colour clr, bool antiAlias);
+	Mesh(Shape shape, const char* filename, bool antiAlias);
+    Mesh(const Mesh& v);            // prevents copying
+    Mesh& operator=(const Mesh& v); // prevents assignment
+    virtual ~Mesh();
+
+	void setup(const IObject* object);
+	void copy(const IObject* object, const unsigned* ab);
+
+  public:
+	friend IGraphic* CreateMesh(int noSubsets, int noPrimitives,
+	 int noVertices, Colour* clr, IDeviceTexture** devTex,
+	 bool antiAlias);
+	friend IGraphic* CreateMesh(Shape shape, float* d, int* p,
+	 Colour clr, bool antiAlias);
+	friend IGraphic* CreateMesh(Shape shape, const char* filename,
+	 bool antiAlias);
+    bool   opaque() const { return isOpaque; }
+	void   add(IDeviceTexture* deviceTexture) {}
+	void   update(const IObject* object, int first, int n);
+    void   draw(const IObject* object);
+	void   render(const IObject* object, int subset);
+	void   render(const IObject* const* object, int n, int subset);
+	bool   bound(Vector&, float&) const { return false; }
+    void   suspend();
+	void   Delete() { delete this; }
+    friend class Display;
+};
+
+class TextureLoad;
+
+//-------------------------------- DeviceTexture -------------------------
+//
+// DeviceTexture records the upload and use of a texture - the
+// rasterizer samples the texels of a bitmap image
+//
+class DeviceTexture : public IDeviceTexture {
+
+	static Recorder* recorder;     // records the command stream
+	static Rasterizer* rasterizer; // draws the frame, NULL if off
+	static unsigned  count;        // number of device textures created
+
+	unsigned id;               // identifies the texture in the stream
+	int      bytes;            // size of the texture
+	bool     isSetup;          // has been uploaded?
+	char*    filename;         // points to the image file
+	RasterTexture image;       // texels for the rasterizer
+	TextureCache::Entry* entry; // shares the texture through the cache
+	TextureLoad* loading;      // reads the image file, NULL if idle
+
+	DeviceTexture(const char* file, unsigned flags, Colour brdrClr);
+	DeviceTexture(const DeviceTexture&);
+	DeviceTexture& operator=(const DeviceTexture&);
+	virtual ~DeviceTexture();
+
+	void setup();
+	void loaded(int size, RasterTexture& texels);
+
+  public:
+	friend IDeviceTexture* CreateDeviceTexture(const char* file,
+	 unsigned flags, Colour brdrClr);
+	void   attach(int i);
+	void   detach(int i);
+	void   draw(int topLeftX, int topLeftY, int bottomRightX,
+     int bottomRightY);
+	void   suspend();
+	void   Delete();
+	friend class Display;
+	friend class Graphic;
+	friend class Mesh;
+	friend class TextureLoad;
+};
+
+//-------------------------------- TextureLoad ---------------------------
+//
+// TextureLoad decodes an image file on a loader thread, then hands its
+// texels to the waiting texture on the render thread
+//
+class TextureLoad : public LoadRequest {
+
+	char*          file;    // name of the image file
+	bool           decode;  // keep the texels for the rasterizer?
+	int            bytes;   // size of the texture
+	RasterTexture  image;   // decoded texels
+	DeviceTexture* texture; // texture waiting for the image, NULL if none
+
+	TextureLoad(const TextureLoad&);            // prevents copying
+	TextureLoad& operator=(const TextureLoad&); // prevents assignment
+
+  public:
+	TextureLoad(const char* file, bool decode, DeviceTexture* t);
+	void load();
+	void finish();
+	void cancel() { texture = NULL; }
+	virtual ~TextureLoad();
+};
+
+//-------------------------------- Font ----------------------------------
+//
+// Font records the text drawn by a single Text object
+//
+class IText;
+
+class Font : public IFont {
+
+	static Recorder* recorder; // records the command stream
+	static int width;          // width of the client area
+	static int height;         // height of the client area
+
+    const IText* text;         // points to the parent Text object
+
+    Font(const IText* t) : text(t) {}
+    Font(const Font& v);
+    Font& operator=(const Font& v);
+    virtual ~Font() {}
+
+  public:
+	friend IFont* CreateFont_(IText* text, unsigned int flags);
+    void   draw(const char* str);
+    void   suspend()            {}
+    bool   restore()            { return true; }
+	void   release()            {}
+	void   Delete() { delete this; }
+    friend class Display;
+};
+#endif
+
+#endif
@@ -0,0 +1,257 @@
+/* HeightMap Module Implementation
+ *
+ * HeightMap.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <istream>     // for std::istream
+#include <emmintrin.h> // for SSE2 intrinsics
+#include "HeightMap.h" // for HeightMap
+
+const int      FILE_HEADER  = 14;      // bytes in the file header
+const int      INFO_HEADER  = 40;      // bytes in the smallest info header
+const int      MASKS        = 12;      // bytes in the masks of a file
+const unsigned BI_RGB       = 0;       // an uncompressed file
+const unsigned BI_BITFIELDS = 3;       // an uncompressed file with masks
+const int      MAX_SIDE     = 1 << 16; // pixels along the side of a map
+
+// u16 and u32 read little-endian values
+//
+inline unsigned u16(const unsigned char* p) {
+
+	return p[0] | p[1] << 8;
+}
+
+inline unsigned u32(const unsigned char* p) {
+
+	return p[0] | p[1] << 8 | p[2] << 16 | (unsigned)p[3] << 24;
+}
+
+//-------------------------------- Height Map ----------------------------
+//
+// readHeightMap reads the file header, the info header, the masks and
+// the palette of the height map from in and skips to its first scan
+// line
+//
+bool readHeightMap(std::istream& in, HeightMap& map) {
+
+	unsigned char h[FILE_HEADER + INFO_HEADER + MASKS];
+	if (!in.read((char*)h, FILE_HEADER + INFO_HEADER) || h[0] != 'B' ||
+	 h[1] != 'M')
+		return false;
+	const unsigned char* info = h + FILE_HEADER;
+	unsigned offset      = u32(h + 10);
+	unsigned size        = u32(info);
+	int      width       = (int)u32(info + 4);
+	int      height      = (int)u32(info + 8);
+	int      bits        = u16(info + 14);
+	unsigned compression = u32(info + 16);
+	unsigned colours     = u32(info + 32);
+	if (size < (unsigned)INFO_HEADER || width <= 0 || width > MAX_SIDE ||
+	 height <= 0 || height > MAX_SIDE)
+		return false;
+	if (bits != 8 && bits != 16 && bits != 24 && bits != 32)
+		return false;
+	bool masked = bits == 16 || bits == 32;
+	if (compression != BI_RGB && (compression != BI_BITFIELDS || !masked))
+		return false;
+
+	// the masks follow an info header of 40 bytes and sit at the same
+	// place within a larger one
+	unsigned position = FILE_HEADER + INFO_HEADER;
+	if (compression == BI_BITFIELDS) {
+		if (!in.read((char*)h + position, MASKS))
+			return false;
+		position += MASKS;
+		for (int c = 0; c < 3; c++)
+			map.mask[c] = u32(h + FILE_HEADER + INFO_HEADER + 4 * c);
+	}
+	else if (bits == 16) {
+		map.mask[0] = 0x7C00;
+		map.mask[1] = 0x03E0;
+		map.mask[2] = 0x001F;
+	}
+	else {
+		map.mask[0] = 0xFF0000;
+		map.mask[1] = 0x00FF00;
+		map.mask[2] = 0x0000FF;
+	}
+	// a mask must select bits within the pixel below its top bit, so
+	// that a channel converts as a positive integer
+	unsigned limit = bits == 16 ? 0xFFFF : 0x7FFFFFFF;
+	for (int c = 0; masked && c < 3; c++)
+		if (!map.mask[c] || map.mask[c] > limit)
+			return false;
+	if (FILE_HEADER + size > position) {
+		in.ignore(FILE_HEADER + size - position);
+		position = FILE_HEADER + size;
+	}
+
+	// the palette of an 8-bit file holds blue, green, red and a byte of
+	// padding for each entry
+	map.ramp = false;
+	if (bits == 8) {
+		if (!colours)
+			colours = 256;
+		if (colours > 256)
+			return false;
+		unsigned char entry[4];
+		map.ramp = colours == 256;
+		for (unsigned i = 0; i < 256; i++) {
+			map.grey[i] = 0;
+			if (i < colours) {
+				if (!in.read((char*)entry, 4))
+					return false;
+				map.grey[i] = (entry[0] + entry[1] + entry[2]) * (1 / 765.f);
+				if (entry[0] != i || entry[1] != i || entry[2] != i)
+					map.ramp = false;
+			}
+		}
+		position += 4 * colours;
+		// a grey ramp converts by the arithmetic of its SSE2 kernel
+		for (int i = 0; map.ramp && i < 256; i++)
+			map.grey[i] = float(i) * (1 / 255.f);
+	}
+
+	if (offset < position)
+		return false;
+	in.ignore(offset - position);
+	map.width  = width;
+	map.height = height;
+	map.bits   = bits;
+	map.pitch  = (width * bits + 31) / 32 * 4;
+
+	return (bool)in;
+}
+
+//-------------------------------- Scan Lines ----------------------------
+//
+// Channels holds the masks of a 16 or 32-bit height map and the factors
+// that take each channel to its share of a height - a grey map has one
+// channel
+//
+struct Channels {
+	bool     grey;     // do the three masks select the same bits?
+	unsigned mask[3];  // red, green and blue masks
+	float    scale[3]; // share of a height per unit of each channel
+};
+
+// height returns the height of pixel p
+//
+inline float height(unsigned p, const Channels& k) {
+
+	if (k.grey)
+		return float(int(p & k.mask[0])) * k.scale[0];
+
+	return float(int(p & k.mask[0])) * k.scale[0] +
+	 float(int(p & k.mask[1])) * k.scale[1] +
+	 float(int(p & k.mask[2])) * k.scale[2];
+}
+
+// heights returns the heights of the four pixels in p by the arithmetic
+// of height
+//
+inline __m128 heights(__m128i p, const Channels& k) {
+
+	__m128 h = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(p,
+	 _mm_set1_epi32(k.mask[0]))), _mm_set1_ps(k.scale[0]));
+	if (!k.grey) {
+		h = _mm_add_ps(h, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(p,
+		 _mm_set1_epi32(k.mask[1]))), _mm_set1_ps(k.scale[1])));
+		h = _mm_add_ps(h, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(p,
+		 _mm_set1_epi32(k.mask[2]))), _mm_set1_ps(k.scale[2])));
+	}
+
+	return h;
+}
+
+// raise returns v raised to floor
+//
+inline float raise(float v, float floor) {
+
+	return v > floor ? v : floor;
+}
+
+// store stores the four heights in v raised to lowest at h
+//
+inline void store(float* h, __m128 v, __m128 lowest) {
+
+	_mm_storeu_ps(h, _mm_max_ps(v, lowest));
+}
+
+// convertScanLine converts the scan line at line by the format of map -
+// the SSE2 kernels and the loops that finish each line perform the same
+// operations in the same order
+//
+void convertScanLine(const HeightMap& map, const unsigned char* line,
+ float* h, float floor, bool simd) {
+
+	const __m128  lowest = _mm_set1_ps(floor);
+	const __m128i zero   = _mm_setzero_si128();
+	unsigned width = map.width;
+	unsigned j = 0;
+	Channels k;
+	k.grey = map.mask[0] == map.mask[1] && map.mask[1] == map.mask[2];
+	for (int c = 0; c < 3; c++) {
+		k.mask[c]  = map.mask[c];
+		k.scale[c] = 1 / ((k.grey ? 1 : 3) * float(map.mask[c]));
+	}
+
+	switch (map.bits) {
+		case 8:
+			// sixteen grey levels at a time - other palettes are looked up
+			if (simd && map.ramp)
+				for (; j + 16 <= width; j += 16) {
+					const __m128 scale = _mm_set1_ps(1 / 255.f);
+					__m128i p  = _mm_loadu_si128((const __m128i*)(line + j));
+					__m128i lo = _mm_unpacklo_epi8(p, zero);
+					__m128i hi = _mm_unpackhi_epi8(p, zero);
+					store(h + j, _mm_mul_ps(_mm_cvtepi32_ps(
+					 _mm_unpacklo_epi16(lo, zero)), scale), lowest);
+					store(h + j + 4, _mm_mul_ps(_mm_cvtepi32_ps(
+					 _mm_unpackhi_epi16(lo, zero)), scale), lowest);
+					store(h + j + 8, _mm_mul_ps(_mm_cvtepi32_ps(
+					 _mm_unpacklo_epi16(hi, zero)), scale), lowest);
+					store(h + j + 12, _mm_mul_ps(_mm_cvtepi32_ps(
+					 _mm_unpackhi_epi16(hi, zero)), scale), lowest);
+				}
+			for (; j < width; j++)
+				h[j] = raise(map.grey[line[j]], floor);
+			break;
+		case 16:
+			// eight pixels at a time
+			for (; simd && j + 8 <= width; j += 8) {
+				__m128i p = _mm_loadu_si128((const __m128i*)(line + 2 * j));
+				store(h + j, heights(_mm_unpacklo_epi16(p, zero), k), lowest);
+				store(h + j + 4, heights(_mm_unpackhi_epi16(p, zero), k),
+				 lowest);
+			}
+			for (; j < width; j++)
+				h[j] = raise(height(u16(line + 2 * j), k), floor);
+			break;
+		case 24:
+			// the channels of four pixels at a time, summed
+			for (; simd && j + 4 <= width; j += 4) {
+				const __m128 scale = _mm_set1_ps(1 / 765.f);
+				const unsigned char* p = line + 3 * j;
+				store(h + j, _mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(
+				 p[0] + p[1] + p[2], p[3] + p[4] + p[5], p[6] + p[7] + p[8],
+				 p[9] + p[10] + p[11])), scale), lowest);
+			}
+			for (; j < width; j++) {
+				const unsigned char* p = line + 3 * j;
+				h[j] = raise(float(p[0] + p[1] + p[2]) * (1 / 765.f), floor);
+			}
+			break;
+		case 32:
+			// four pixels at a time
+			for (; simd && j + 4 <= width; j += 4)
+				store(h + j, heights(_mm_loadu_si128((const __m128i*)
+				 (line + 4 * j)), k), lowest);
+			for (; j < width; j++)
+				h[j] = raise(height(u32(line + 4 * j), k), floor);
+			break;
+	}
+}
@@ -0,0 +1,53 @@
+#ifndef _HEIGHT_MAP_H_
+#define _HEIGHT_MAP_H_
+
+/* Header for the HeightMap Module
+ *
+ * consists of HeightMap declaration
+ *             height map reading functions
+ *
+ * HeightMap.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <iosfwd> // for std::istream
+
+//-------------------------------- Height Map ----------------------------
+//
+// A height map is an uncompressed BMP file whose pixels hold the
+// elevations of a terrain, bottom row first.  The height of a pixel is
+// the mean of its red, green and blue channels in the range [0, 1]:
+//
+//  8-bit pixels index a palette of blue, green and red entries
+// 16-bit pixels are X1R5G5B5 and 32-bit pixels are X8R8G8B8, unless the
+//        file is BI_BITFIELDS and gives masks of its own - a file whose
+//        three masks are the same holds a single grey channel, so that
+//        a 16-bit grey mask holds a full-precision elevation
+// 24-bit pixels hold blue, green and red bytes
+//
+// Compressed and top-down files, other depths and masks that are empty
+// or reach the top bit of a pixel are refused
+//
+struct HeightMap {
+	int      width;     // pixels in a scan line
+	int      height;    // scan lines in the file
+	int      bits;      // bits in a pixel - 8, 16, 24 or 32
+	int      pitch;     // bytes in a scan line, a multiple of 4
+	unsigned mask[3];   // red, green and blue bits of a 16 or 32-bit pixel
+	bool     ramp;      // does palette entry i hold grey level i?
+	float    grey[256]; // height of each palette entry of an 8-bit pixel
+};
+
+// readHeightMap reads the headers of a height map from in, leaves in at
+// the first scan line and returns true if the file is a height map
+bool readHeightMap(std::istream& in, HeightMap& map);
+// convertScanLine converts the pixels of a scan line of map at line into
+// heights at h, raising those below floor to floor - the bulk of a line
+// is converted several pixels at a time with SSE2 unless simd is false,
+// and either way gives the same heights
+void convertScanLine(const HeightMap& map, const unsigned char* line,
+ float* h, float floor, bool simd = true);
+
+#endif
@@ -0,0 +1,897 @@
+/* ImageDecoder Module Implementation
+ *
+ * ImageDecoder.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#ifdef _WIN32
+#include <windows.h>      // for CreateFile, CreateFileMapping, MapViewOfFile
+#endif
+#include <cstdio>         // for fopen, fread, fclose
+#include <cstring>        // for memcpy, memcmp, memset
+#include <new>            // for std::nothrow
+#include <emmintrin.h>    // for SSE2 intrinsics
+#include "ImageDecoder.h" // for Image and ImageFormat
+
+const int MAX_DIMENSION = 16384; // texels in the side of an image
+const int MAX_LEVELS    = 15;    // levels in a full chain of that size
+
+//-------------------------------- Layouts -------------------------------
+//
+// PixelLayout describes a stored pixel - its bytes, little-endian, and
+// the bits of each channel.  A pixel without an alpha mask is opaque
+//
+struct PixelLayout {
+	int      bytes; // bytes in a pixel, 1 to 4
+	unsigned a;     // alpha mask, 0 for opaque pixels
+	unsigned r;     // red mask
+	unsigned g;     // green mask
+	unsigned b;     // blue mask
+};
+
+static const unsigned OPAQUE_ALPHA = 0xFF000000;
+
+// u16 and u32 read little-endian values
+//
+inline unsigned u16(const unsigned char* p) {
+
+	return p[0] | p[1] << 8;
+}
+
+inline unsigned u32(const unsigned char* p) {
+
+	return p[0] | p[1] << 8 | p[2] << 16 | (unsigned)p[3] << 24;
+}
+
+// channel returns the bits of pixel px under mask scaled to 0 - 255
+//
+static unsigned channel(unsigned px, unsigned mask) {
+
+	if (!mask)
+		return 0;
+	unsigned v = px & mask;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		v    >>= 1;
+	}
+	// keep the eight most significant bits of a wider channel
+	while (mask > 0xFF) {
+		mask >>= 1;
+		v    >>= 1;
+	}
+
+	return (v * 255 + mask / 2) / mask;
+}
+
+// texel returns the stored pixel at p in 0xAARRGGBB form
+//
+static unsigned texel(const unsigned char* p, const PixelLayout& l) {
+
+	unsigned px = 0;
+	for (int i = l.bytes - 1; i >= 0; i--)
+		px = px << 8 | p[i];
+
+	return (l.a ? channel(px, l.a) : 0xFF) << 24 | channel(px, l.r) << 16 |
+	 channel(px, l.g) << 8 | channel(px, l.b);
+}
+
+// expand5 and expand6 scale 5-bit and 6-bit channels held in 32-bit
+// lanes to eight bits, rounded as channel() rounds them
+//
+inline __m128i expand5(__m128i v) {
+
+	return _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(v,
+	 _mm_set1_epi32(527)), _mm_set1_epi32(23)), 6);
+}
+
+inline __m128i expand6(__m128i v) {
+
+	return _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(v,
+	 _mm_set1_epi32(259)), _mm_set1_epi32(33)), 6);
+}
+
+// from565 and from555 convert four 16-bit pixels held in 32-bit lanes -
+// the top bit of a 555 pixel is alpha if alpha is set
+//
+inline __m128i from565(__m128i v) {
+
+	const __m128i five = _mm_set1_epi32(31), six = _mm_set1_epi32(63);
+	__m128i r = expand5(_mm_and_si128(_mm_srli_epi32(v, 11), five));
+	__m128i g = expand6(_mm_and_si128(_mm_srli_epi32(v, 5), six));
+	__m128i b = expand5(_mm_and_si128(v, five));
+
+	return _mm_or_si128(_mm_set1_epi32(OPAQUE_ALPHA), _mm_or_si128(
+	 _mm_slli_epi32(r, 16), _mm_or_si128(_mm_slli_epi32(g, 8), b)));
+}
+
+inline __m128i from555(__m128i v, bool alpha) {
+
+	const __m128i five = _mm_set1_epi32(31), top = _mm_set1_epi32(0x8000);
+	__m128i r = expand5(_mm_and_si128(_mm_srli_epi32(v, 10), five));
+	__m128i g = expand5(_mm_and_si128(_mm_srli_epi32(v, 5), five));
+	__m128i b = expand5(_mm_and_si128(v, five));
+	__m128i a = alpha ? _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(v, top),
+	 top), _mm_set1_epi32(OPAQUE_ALPHA)) : _mm_set1_epi32(OPAQUE_ALPHA);
+
+	return _mm_or_si128(a, _mm_or_si128(_mm_slli_epi32(r, 16),
+	 _mm_or_si128(_mm_slli_epi32(g, 8), b)));
+}
+
+// convertRow converts n pixels stored at src in layout l to 0xAARRGGBB
+// texels at dst - the common layouts convert four or more pixels at a
+// time and the rest one at a time
+//
+static void convertRow(const unsigned char* src, unsigned* dst, int n,
+ const PixelLayout& l) {
+
+	int x = 0;
+	bool rgb   = l.r == 0xFF0000 && l.g == 0xFF00 && l.b == 0xFF;
+	bool bgr   = l.r == 0xFF && l.g == 0xFF00 && l.b == 0xFF0000;
+	bool alpha = l.a == OPAQUE_ALPHA;
+	__m128i fill = _mm_set1_epi32(alpha ? 0 : OPAQUE_ALPHA);
+
+	if (l.bytes == 4 && rgb && (alpha || !l.a)) {
+		// the stored order is the texel order
+		for (; x + 4 <= n; x += 4)
+			_mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(fill,
+			 _mm_loadu_si128((const __m128i*)(src + x * 4))));
+	}
+	else if (l.bytes == 4 && bgr && (alpha || !l.a)) {
+		// swap red and blue
+		const __m128i ag = _mm_set1_epi32(0xFF00FF00);
+		const __m128i lo = _mm_set1_epi32(0xFF);
+		for (; x + 4 <= n; x += 4) {
+			__m128i p = _mm_loadu_si128((const __m128i*)(src + x * 4));
+			__m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), lo);
+			__m128i b = _mm_slli_epi32(_mm_and_si128(p, lo), 16);
+			_mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(fill,
+			 _mm_or_si128(_mm_and_si128(p, ag), _mm_or_si128(r, b))));
+		}
+	}
+	else if (l.bytes == 3 && rgb) {
+		// each load takes the first byte of the next pixel, which the
+		// alpha replaces - the loop stops before the last pixel of the row
+		for (; x + 5 <= n; x += 4) {
+			int w[4];
+			memcpy(w, src + x * 3, sizeof w[0]);
+			memcpy(w + 1, src + x * 3 + 3, sizeof w[0]);
+			memcpy(w + 2, src + x * 3 + 6, sizeof w[0]);
+			memcpy(w + 3, src + x * 3 + 9, sizeof w[0]);
+			_mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(fill,
+			 _mm_set_epi32(w[3], w[2], w[1], w[0])));
+		}
+	}
+	else if (l.bytes == 2 && l.r == 0xF800 && l.g == 0x7E0 && l.b == 0x1F &&
+	 !l.a) {
+		const __m128i zero = _mm_setzero_si128();
+		for (; x + 8 <= n; x += 8) {
+			__m128i p = _mm_loadu_si128((const __m128i*)(src + x * 2));
+			_mm_storeu_si128((__m128i*)(dst + x),
+			 from565(_mm_unpacklo_epi16(p, zero)));
+			_mm_storeu_si128((__m128i*)(dst + x + 4),
+			 from565(_mm_unpackhi_epi16(p, zero)));
+		}
+	}
+	else if (l.bytes == 2 && l.r == 0x7C00 && l.g == 0x3E0 && l.b == 0x1F &&
+	 (l.a == 0x8000 || !l.a)) {
+		const __m128i zero = _mm_setzero_si128();
+		bool a = l.a != 0;
+		for (; x + 8 <= n; x += 8) {
+			__m128i p = _mm_loadu_si128((const __m128i*)(src + x * 2));
+			_mm_storeu_si128((__m128i*)(dst + x),
+			 from555(_mm_unpacklo_epi16(p, zero), a));
+			_mm_storeu_si128((__m128i*)(dst + x + 4),
+			 from555(_mm_unpackhi_epi16(p, zero), a));
+		}
+	}
+	else if (l.bytes == 1 && l.r == 0xFF && l.g == 0xFF && l.b == 0xFF &&
+	 !l.a) {
+		// repeat each grey level across the three colour channels
+		for (; x + 16 <= n; x += 16) {
+			__m128i p  = _mm_loadu_si128((const __m128i*)(src + x));
+			__m128i lo = _mm_unpacklo_epi8(p, p);
+			__m128i hi = _mm_unpackhi_epi8(p, p);
+			_mm_storeu_si128((__m128i*)(dst + x), _mm_or_si128(fill,
+			 _mm_unpacklo_epi16(lo, lo)));
+			_mm_storeu_si128((__m128i*)(dst + x + 4), _mm_or_si128(fill,
+			 _mm_unpackhi_epi16(lo, lo)));
+			_mm_storeu_si128((__m128i*)(dst + x + 8), _mm_or_si128(fill,
+			 _mm_unpacklo_epi16(hi, hi)));
+			_mm_storeu_si128((__m128i*)(dst + x + 12), _mm_or_si128(fill,
+			 _mm_unpackhi_epi16(hi, hi)));
+		}
+	}
+
+	for (; x < n; x++)
+		dst[x] = texel(src + x * l.bytes, l);
+}
+
+// indexRow converts n palette indices of bits bits each, packed from the
+// high bits of each byte at src, to texels at dst
+//
+static void indexRow(const unsigned char* src, unsigned* dst, int n,
+ int bits, const unsigned* palette) {
+
+	if (bits == 8)
+		for (int x = 0; x < n; x++)
+			dst[x] = palette[src[x]];
+	else {
+		unsigned mask = (1u << bits) - 1;
+		for (int x = 0; x < n; x++) {
+			int bit = x * bits;
+			dst[x] = palette[src[bit >> 3] >> (8 - bits - (bit & 7)) & mask];
+		}
+	}
+}
+
+// reverseRow reverses the order of the n texels at t
+//
+static void reverseRow(unsigned* t, int n) {
+
+	for (int i = 0, j = n - 1; i < j; i++, j--) {
+		unsigned c = t[i];
+		t[i] = t[j];
+		t[j] = c;
+	}
+}
+
+// clear empties image
+//
+static void clear(Image& image) {
+
+	image.width  = 0;
+	image.height = 0;
+	image.levels = 0;
+	image.format = IMAGE_ARGB;
+	image.size   = 0;
+	image.data   = NULL;
+}
+
+// allocate sizes image for levels levels of w x h texels in format f and
+// returns true if successful
+//
+static bool allocate(Image& image, int w, int h, int levels,
+ ImageFormat f) {
+
+	int size = 0;
+	for (int i = 0, lw = w, lh = h; i < levels; i++) {
+		size += imageLevelSize(f, lw, lh);
+		lw = lw > 1 ? lw / 2 : 1;
+		lh = lh > 1 ? lh / 2 : 1;
+	}
+	unsigned* words = new (std::nothrow) unsigned[(size + 3) / 4];
+	if (!words)
+		return false;
+	image.width  = w;
+	image.height = h;
+	image.levels = levels;
+	image.format = f;
+	image.size   = size;
+	image.data   = (unsigned char*)words;
+
+	return true;
+}
+
+// valid returns true if an image of w x h texels can be decoded
+//
+inline bool valid(int w, int h) {
+
+	return w > 0 && h > 0 && w <= MAX_DIMENSION && h <= MAX_DIMENSION;
+}
+
+//-------------------------------- BMP -----------------------------------
+//
+// BMP files hold 1, 2, 4 or 8-bit palette indices, uncompressed or run-
+// length encoded, or 16, 24 or 32-bit pixels with default or explicit
+// channel masks.  Rows are padded to four bytes and are stored bottom
+// row first unless the height is negative
+//
+const int BMP_RGB            = 0; // uncompressed
+const int BMP_RLE8           = 1; // run-length encoded 8-bit indices
+const int BMP_RLE4           = 2; // run-length encoded 4-bit indices
+const int BMP_BITFIELDS      = 3; // uncompressed with colour masks
+const int BMP_ALPHABITFIELDS = 6; // uncompressed with colour and alpha masks
+
+// unpackRLE expands the run-length encoded bits-bit indices of a w x h
+// image at src[0, n) into one index for each byte at dst and returns
+// true if successful - texels that the encoding skips keep index 0
+//
+static bool unpackRLE(const unsigned char* src, int n, unsigned char* dst,
+ int w, int h, int bits) {
+
+	int x = 0, y = 0, i = 0;
+	memset(dst, 0, w * h);
+	while (i + 1 < n && y < h) {
+		int c = src[i++], v = src[i++];
+		if (c) {
+			// a run of c texels
+			for (int k = 0; k < c && x < w; k++, x++)
+				dst[y * w + x] = bits == 8 ? v : k & 1 ? v & 15 : v >> 4;
+		}
+		else if (v == 0) {
+			// end of the row
+			x = 0;
+			y++;
+		}
+		else if (v == 1)
+			// end of the image
+			return true;
+		else if (v == 2) {
+			// move right and up
+			if (i + 1 >= n)
+				return false;
+			x += src[i++];
+			y += src[i++];
+		}
+		else {
+			// v texels stored as they are, padded to two bytes
+			int bytes = bits == 8 ? v : (v + 1) / 2;
+			if (i + bytes > n)
+				return false;
+			for (int k = 0; k < v; k++, x++)
+				if (x < w && y < h)
+					dst[y * w + x] = bits == 8 ? src[i + k] :
+					 k & 1 ? src[i + k / 2] & 15 : src[i + k / 2] >> 4;
+			i += (bytes + 1) & ~1;
+		}
+	}
+
+	return y >= h;
+}
+
+static bool decodeBMP(const unsigned char* d, int size, Image& image) {
+
+	if (size < 26)
+		return false;
+	int offset = (int)u32(d + 10);
+	int hs     = (int)u32(d + 14);
+	int w, h, bpp, comp = BMP_RGB, colours = 0;
+	if (hs == 12) {
+		w   = u16(d + 18);
+		h   = (short)u16(d + 20);
+		bpp = u16(d + 24);
+	}
+	else if (hs >= 40 && size >= 54) {
+		w       = (int)u32(d + 18);
+		h       = (int)u32(d + 22);
+		bpp     = u16(d + 28);
+		comp    = (int)u32(d + 30);
+		colours = (int)u32(d + 46);
+	}
+	else
+		return false;
+	// a negative height marks an image stored top row first
+	bool topDown = h < 0;
+	if (topDown) h = -h;
+	if (!valid(w, h) || offset <= 0 || offset >= size)
+		return false;
+
+	// the layout of a stored pixel
+	PixelLayout l = { bpp / 8, 0, 0, 0, 0 };
+	bool masks = comp == BMP_BITFIELDS || comp == BMP_ALPHABITFIELDS;
+	if (masks) {
+		if (size < 66 || (bpp != 16 && bpp != 32))
+			return false;
+		l.r = u32(d + 54);
+		l.g = u32(d + 58);
+		l.b = u32(d + 62);
+		if ((hs >= 56 || comp == BMP_ALPHABITFIELDS) && size >= 70)
+			l.a = u32(d + 66);
+	}
+	else if (bpp == 16) {
+		l.r = 0x7C00;
+		l.g = 0x3E0;
+		l.b = 0x1F;
+	}
+	else if (bpp == 24 || bpp == 32) {
+		l.r = 0xFF0000;
+		l.g = 0xFF00;
+		l.b = 0xFF;
+		l.a = bpp == 32 ? OPAQUE_ALPHA : 0;
+	}
+	else if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)
+		return false;
+	if (comp != BMP_RGB && !masks && !(comp == BMP_RLE8 && bpp == 8) &&
+	 !(comp == BMP_RLE4 && bpp == 4))
+		return false;
+
+	// the palette follows the header and any masks outside it
+	unsigned palette[256];
+	memset(palette, 0, sizeof palette);
+	if (bpp <= 8) {
+		int entry = hs == 12 ? 3 : 4;
+		int p = 14 + hs + (hs == 40 && comp == BMP_BITFIELDS ? 12 :
+		 hs == 40 && comp == BMP_ALPHABITFIELDS ? 16 : 0);
+		int n = colours > 0 && colours < (1 << bpp) ? colours : 1 << bpp;
+		for (int i = 0; i < n && p + entry <= size; i++, p += entry)
+			palette[i] = OPAQUE_ALPHA | d[p + 2] << 16 | d[p + 1] << 8 | d[p];
+	}
+
+	// the stored rows
+	const unsigned char* src = d + offset;
+	int n = size - offset;
+	unsigned char* indices = NULL;
+	int pitch = ((w * bpp + 31) / 32) * 4;
+	if (comp == BMP_RLE8 || comp == BMP_RLE4) {
+		indices = new (std::nothrow) unsigned char[w * h];
+		if (!indices || !unpackRLE(src, n, indices, w, h, bpp)) {
+			if (indices)
+				delete [] indices;
+			return false;
+		}
+		src   = indices;
+		pitch = w;
+		bpp   = 8;
+	}
+	else if (pitch * (h - 1) + (w * bpp + 7) / 8 > n)
+		return false;
+	if (!allocate(image, w, h, 1, IMAGE_ARGB)) {
+		if (indices)
+			delete [] indices;
+		return false;
+	}
+
+	unsigned* t = (unsigned*)image.data;
+	for (int y = 0; y < h; y++) {
+		unsigned* row = t + (topDown ? y : h - 1 - y) * w;
+		if (bpp <= 8)
+			indexRow(src + y * pitch, row, w, bpp, palette);
+		else
+			convertRow(src + y * pitch, row, w, l);
+	}
+	if (indices)
+		delete [] indices;
+
+	// 32-bit files that leave the fourth byte clear are opaque
+	if (bpp == 32 && !masks) {
+		unsigned any = 0;
+		for (int i = 0; i < w * h; i++)
+			any |= t[i];
+		if (!(any & OPAQUE_ALPHA))
+			for (int i = 0; i < w * h; i++)
+				t[i] |= OPAQUE_ALPHA;
+	}
+
+	return true;
+}
+
+//-------------------------------- TGA -----------------------------------
+//
+// TGA files hold 8-bit palette indices, 15, 16, 24 or 32-bit pixels or
+// 8 or 16-bit grey levels, uncompressed or run-length encoded.  The
+// descriptor sets the number of alpha bits and the corner at which the
+// first stored pixel sits
+//
+const int TGA_MAPPED = 1; // palette indices
+const int TGA_COLOUR = 2; // colour pixels
+const int TGA_GREY   = 3; // grey levels
+const int TGA_RLE    = 8; // added to the type for run-length encoding
+
+// tgaLayout returns the layout of a bits-bit pixel of type type with
+// alpha bits of alpha through l and returns true if the file can hold it
+//
+static bool tgaLayout(int type, int bits, int alpha, PixelLayout& l) {
+
+	l.bytes = (bits + 7) / 8;
+	l.a = l.r = l.g = l.b = 0;
+	if (type == TGA_GREY && (bits == 8 || bits == 16)) {
+		l.r = l.g = l.b = 0xFF;
+		l.a = bits == 16 ? 0xFF00 : 0;
+	}
+	else if (type != TGA_GREY && (bits == 15 || bits == 16)) {
+		l.r = 0x7C00;
+		l.g = 0x3E0;
+		l.b = 0x1F;
+		l.a = bits == 16 && alpha ? 0x8000 : 0;
+	}
+	else if (type != TGA_GREY && (bits == 24 || bits == 32)) {
+		l.r = 0xFF0000;
+		l.g = 0xFF00;
+		l.b = 0xFF;
+		l.a = bits == 32 && alpha ? OPAQUE_ALPHA : 0;
+	}
+	else
+		return false;
+
+	return true;
+}
+
+static bool decodeTGA(const unsigned char* d, int size, Image& image) {
+
+	if (size < 18)
+		return false;
+	int idLength  = d[0];
+	int mapType   = d[1];
+	int type      = d[2] & ~TGA_RLE;
+	bool rle      = (d[2] & TGA_RLE) != 0;
+	int mapFirst  = u16(d + 3);
+	int mapLength = u16(d + 5);
+	int mapBits   = d[7];
+	int w         = u16(d + 12);
+	int h         = u16(d + 14);
+	int bits      = d[16];
+	int alpha     = d[17] & 15;
+	bool topDown  = (d[17] & 0x20) != 0;
+	bool leftward = (d[17] & 0x10) != 0;
+	// the file has no signature, so the header must make sense
+	if (type < TGA_MAPPED || type > TGA_GREY || d[2] & ~(TGA_RLE | 3) ||
+	 mapType > 1 || (type == TGA_MAPPED && (!mapType || bits != 8)) ||
+	 !valid(w, h))
+		return false;
+	PixelLayout l;
+	if (type != TGA_MAPPED && !tgaLayout(type, bits, alpha, l))
+		return false;
+	l.bytes = (bits + 7) / 8;
+
+	// the palette follows the identification field
+	int p = 18 + idLength;
+	unsigned palette[256];
+	memset(palette, 0, sizeof palette);
+	if (mapType) {
+		PixelLayout m;
+		if (!tgaLayout(TGA_COLOUR, mapBits, alpha, m))
+			return false;
+		for (int i = 0; i < mapLength; i++, p += m.bytes)
+			if (p + m.bytes <= size && mapFirst + i < 256)
+				palette[mapFirst + i] = texel(d + p, m);
+	}
+	if (p >= size)
+		return false;
+
+	// the stored pixels
+	const unsigned char* src = d + p;
+	int n = size - p, pitch = w * l.bytes;
+	unsigned char* unpacked = NULL;
+	if (rle) {
+		// packets may run across rows, and no packet of fewer than two
+		// bytes holds more than 128 pixels
+		unpacked = w * h / 64 <= n ? new (std::nothrow)
+		 unsigned char[pitch * h] : NULL;
+		if (!unpacked)
+			return false;
+		int i = 0, o = 0, end = pitch * h;
+		while (o < end && i < n) {
+			int c = src[i++], k = (c & 127) + 1;
+			int bytes = k * l.bytes;
+			if (o + bytes > end || i + (c & 128 ? l.bytes : bytes) > n)
+				break;
+			if (c & 128) {
+				for (int j = 0; j < k; j++, o += l.bytes)
+					memcpy(unpacked + o, src + i, l.bytes);
+				i += l.bytes;
+			}
+			else {
+				memcpy(unpacked + o, src + i, bytes);
+				o += bytes;
+				i += bytes;
+			}
+		}
+		if (o < end) {
+			delete [] unpacked;
+			return false;
+		}
+		src = unpacked;
+	}
+	else if (pitch * h > n)
+		return false;
+	if (!allocate(image, w, h, 1, IMAGE_ARGB)) {
+		if (unpacked)
+			delete [] unpacked;
+		return false;
+	}
+
+	unsigned* t = (unsigned*)image.data;
+	for (int y = 0; y < h; y++) {
+		unsigned* row = t + (topDown ? y : h - 1 - y) * w;
+		if (type == TGA_MAPPED)
+			indexRow(src + y * pitch, row, w, 8, palette);
+		else
+			convertRow(src + y * pitch, row, w, l);
+		if (leftward)
+			reverseRow(row, w);
+	}
+	if (unpacked)
+		delete [] unpacked;
+
+	return true;
+}
+
+//-------------------------------- DDS -----------------------------------
+//
+// DDS files hold a mip chain of DXT blocks, which are kept as they are,
+// or of uncompressed pixels with channel masks.  Cube maps, volumes and
+// the extended DX10 header are not decoded
+//
+const unsigned DDS_MIPMAPCOUNT = 0x20000;  // header holds the level count
+const unsigned DDS_ALPHAPIXELS = 0x1;      // pixels have alpha
+const unsigned DDS_FOURCC      = 0x4;      // pixels are compressed
+const unsigned DDS_RGB         = 0x40;     // pixels have colour masks
+const unsigned DDS_LUMINANCE   = 0x20000;  // pixels have a grey mask
+const unsigned DDS_CUBEMAP     = 0x200;    // six faces
+const unsigned DDS_VOLUME      = 0x200000; // slices
+
+static bool decodeDDS(const unsigned char* d, int size, Image& image) {
+
+	if (size < 128 || memcmp(d, "DDS ", 4) || u32(d + 4) != 124)
+		return false;
+	unsigned flags   = u32(d + 8);
+	int      h       = (int)u32(d + 12);
+	int      w       = (int)u32(d + 16);
+	int      levels  = flags & DDS_MIPMAPCOUNT && u32(d + 28) ?
+	 (int)u32(d + 28) : 1;
+	unsigned pixel   = u32(d + 80);
+	unsigned fourCC  = u32(d + 84);
+	int      bits    = (int)u32(d + 88);
+	if (!valid(w, h) || u32(d + 112) & (DDS_CUBEMAP | DDS_VOLUME))
+		return false;
+	if (levels > MAX_LEVELS)
+		levels = MAX_LEVELS;
+
+	ImageFormat f;
+	PixelLayout l = { bits / 8, 0, 0, 0, 0 };
+	if (pixel & DDS_FOURCC) {
+		if ((fourCC & 0xFFFFFF) != ('D' | 'X' << 8 | 'T' << 16))
+			return false;
+		switch (fourCC >> 24) {
+			case '1': f = IMAGE_DXT1; break;
+			case '2': f = IMAGE_DXT2; break;
+			case '3': f = IMAGE_DXT3; break;
+			case '4': f = IMAGE_DXT4; break;
+			case '5': f = IMAGE_DXT5; break;
+			default:  return false;
+		}
+	}
+	else if (pixel & (DDS_RGB | DDS_LUMINANCE) && bits % 8 == 0 &&
+	 bits >= 8 && bits <= 32) {
+		f   = IMAGE_ARGB;
+		l.r = u32(d + 92);
+		l.g = pixel & DDS_RGB ? u32(d + 96) : l.r;
+		l.b = pixel & DDS_RGB ? u32(d + 100) : l.r;
+		l.a = pixel & DDS_ALPHAPIXELS ? u32(d + 104) : 0;
+	}
+	else
+		return false;
+
+	// keep the levels that the file holds in full
+	int stored = 0, kept = 0;
+	for (int i = 0, lw = w, lh = h; i < levels; i++) {
+		int bytes = f == IMAGE_ARGB ? lw * lh * l.bytes :
+		 imageLevelSize(f, lw, lh);
+		if (128 + stored + bytes > size)
+			break;
+		stored += bytes;
+		kept++;
+		if (lw == 1 && lh == 1)
+			break;
+		lw = lw > 1 ? lw / 2 : 1;
+		lh = lh > 1 ? lh / 2 : 1;
+	}
+	if (!kept || !allocate(image, w, h, kept, f))
+		return false;
+
+	if (f != IMAGE_ARGB)
+		memcpy(image.data, d + 128, image.size);
+	else {
+		const unsigned char* src = d + 128;
+		unsigned* t = (unsigned*)image.data;
+		for (int i = 0, lw = w, lh = h; i < kept; i++) {
+			for (int y = 0; y < lh; y++, src += lw * l.bytes, t += lw)
+				convertRow(src, t, lw, l);
+			lw = lw > 1 ? lw / 2 : 1;
+			lh = lh > 1 ? lh / 2 : 1;
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------- DXT -----------------------------------
+//
+// A DXT block holds 4 x 4 texels as two 5:6:5 end points and a 2-bit
+// index for each texel into the four colours between them - preceded in
+// DXT2 to DXT5 by 64 bits of alpha, either 4 bits for each texel or two
+// 8-bit end points and a 3-bit index for each texel
+//
+// colour565 expands a 5:6:5 colour to an opaque texel, rounded as the
+// decoder rounds 16-bit pixels
+//
+static unsigned colour565(unsigned c) {
+
+	unsigned r = ((c >> 11) * 527 + 23) >> 6;
+	unsigned g = ((c >> 5 & 0x3F) * 259 + 33) >> 6;
+	unsigned b = ((c & 0x1F) * 527 + 23) >> 6;
+
+	return OPAQUE_ALPHA | r << 16 | g << 8 | b;
+}
+
+// mix returns the texel a weighted wa and b weighted wb, over wa + wb
+//
+static unsigned mix(unsigned a, unsigned b, unsigned wa, unsigned wb) {
+
+	unsigned t = (wa + wb) / 2, s = wa + wb, c = OPAQUE_ALPHA;
+	for (int shift = 0; shift < 24; shift += 8)
+		c |= ((a >> shift & 0xFF) * wa + (b >> shift & 0xFF) * wb + t) / s
+		 << shift;
+
+	return c;
+}
+
+// colourBlock decodes the colour half of block b into the 16 texels at t
+// - in a DXT1 block whose first end point is not the greater, the third
+// colour lies halfway and the fourth is transparent black
+//
+static void colourBlock(const unsigned char* b, unsigned* t, bool dxt1) {
+
+	unsigned c0 = u16(b), c1 = u16(b + 2), palette[4];
+	palette[0] = colour565(c0);
+	palette[1] = colour565(c1);
+	if (dxt1 && c0 <= c1) {
+		palette[2] = mix(palette[0], palette[1], 1, 1);
+		palette[3] = 0;
+	}
+	else {
+		palette[2] = mix(palette[0], palette[1], 2, 1);
+		palette[3] = mix(palette[0], palette[1], 1, 2);
+	}
+	unsigned bits = u32(b + 4);
+	for (int i = 0; i < 16; i++, bits >>= 2)
+		t[i] = palette[bits & 3];
+}
+
+// alphaBlock replaces the alpha of the 16 texels at t with the alpha
+// half of block b in DXT3 (explicit) or DXT5 (interpolated) form
+//
+static void alphaBlock(const unsigned char* b, unsigned* t,
+ bool explicitAlpha) {
+
+	if (explicitAlpha) {
+		for (int i = 0; i < 16; i++) {
+			unsigned a = b[i / 2] >> 4 * (i & 1) & 0xF;
+			t[i] = (t[i] & 0xFFFFFF) | (a * 17) << 24;
+		}
+		return;
+	}
+	unsigned a[8];
+	a[0] = b[0];
+	a[1] = b[1];
+	if (a[0] > a[1])
+		for (int i = 1; i < 7; i++)
+			a[i + 1] = ((7 - i) * a[0] + i * a[1] + 3) / 7;
+	else {
+		for (int i = 1; i < 5; i++)
+			a[i + 1] = ((5 - i) * a[0] + i * a[1] + 2) / 5;
+		a[6] = 0;
+		a[7] = 255;
+	}
+	// 48 bits of 3-bit indices, the first texel in the lowest bits
+	unsigned lo = b[2] | b[3] << 8 | b[4] << 16;
+	unsigned hi = b[5] | b[6] << 8 | b[7] << 16;
+	for (int i = 0; i < 16; i++) {
+		unsigned k = i < 8 ? lo >> 3 * i & 7 : hi >> 3 * (i - 8) & 7;
+		t[i] = (t[i] & 0xFFFFFF) | a[k] << 24;
+	}
+}
+
+// decompressImage replaces the blocks of a DXT image with the texels of
+// its top level and returns true if successful - an uncompressed image is
+// left as it is.  DXT2 and DXT4 blocks keep their premultiplied colours
+//
+bool decompressImage(Image& image) {
+
+	if (image.format == IMAGE_ARGB)
+		return image.data != NULL;
+	if (!image.data)
+		return false;
+
+	Image argb;
+	clear(argb);
+	if (!allocate(argb, image.width, image.height, 1, IMAGE_ARGB))
+		return false;
+	bool dxt1 = image.format == IMAGE_DXT1;
+	bool explicitAlpha = image.format == IMAGE_DXT2 ||
+	 image.format == IMAGE_DXT3;
+	const unsigned char* b = image.data;
+	unsigned* texel = (unsigned*)argb.data;
+	unsigned t[16];
+	for (int y = 0; y < image.height; y += 4)
+		for (int x = 0; x < image.width; x += 4) {
+			colourBlock(dxt1 ? b : b + 8, t, dxt1);
+			if (!dxt1)
+				alphaBlock(b, t, explicitAlpha);
+			b += dxt1 ? 8 : 16;
+			// a block at the right or bottom edge may overhang the image
+			for (int j = 0; j < 4 && y + j < image.height; j++)
+				for (int i = 0; i < 4 && x + i < image.width; i++)
+					texel[(y + j) * image.width + x + i] = t[4 * j + i];
+		}
+	releaseImage(image);
+	image = argb;
+
+	return true;
+}
+
+//-------------------------------- Image ---------------------------------
+//
+// decodeImage decodes the BMP, TGA or DDS file of size bytes at data
+// into image and returns true if successful
+//
+bool decodeImage(const void* data, int size, Image& image) {
+
+	const unsigned char* d = (const unsigned char*)data;
+	clear(image);
+	if (!d || size < 4)
+		return false;
+	if (d[0] == 'B' && d[1] == 'M')
+		return decodeBMP(d, size, image);
+	if (!memcmp(d, "DDS ", 4))
+		return decodeDDS(d, size, image);
+
+	return decodeTGA(d, size, image);
+}
+
+// loadImage decodes the image file from a read-only view of the file,
+// which the operating system fills as the decoder touches it, and
+// returns true if successful - without Win32, it reads the whole file
+// into memory first
+//
+bool loadImage(const char* file, Image& image) {
+
+	bool rc = false;
+	clear(image);
+	#ifdef _WIN32
+	HANDLE f = file ? CreateFile(file, GENERIC_READ, FILE_SHARE_READ, NULL,
+	 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+	 NULL) : INVALID_HANDLE_VALUE;
+	if (f != INVALID_HANDLE_VALUE) {
+		DWORD size = GetFileSize(f, NULL);
+		HANDLE m = size ? CreateFileMapping(f, NULL, PAGE_READONLY, 0, 0,
+		 NULL) : NULL;
+		const char* v = m ? (const char*)MapViewOfFile(m, FILE_MAP_READ, 0,
+		 0, 0) : NULL;
+		if (v) {
+			rc = decodeImage(v, (int)size, image);
+			UnmapViewOfFile(v);
+		}
+		if (m)
+			CloseHandle(m);
+		CloseHandle(f);
+	}
+	#else
+	FILE* fp = file ? fopen(file, "rb") : NULL;
+	if (fp) {
+		fseek(fp, 0, SEEK_END);
+		long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		char* v = size > 0 ? new (std::nothrow) char[size] : NULL;
+		if (v && (long)fread(v, 1, size, fp) == size)
+			rc = decodeImage(v, (int)size, image);
+		if (v)
+			delete [] v;
+		fclose(fp);
+	}
+	#endif
+
+	return rc;
+}
+
+// releaseImage releases the texels of image
+//
+void releaseImage(Image& image) {
+
+	if (image.data)
+		delete [] (unsigned*)image.data;
+	clear(image);
+}
+
+// imageLevelSize returns the number of bytes in a level of width x height
+// texels in format
+//
+int imageLevelSize(ImageFormat format, int width, int height) {
+
+	int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+
+	return format == IMAGE_ARGB ? width * height * 4 :
+	 format == IMAGE_DXT1 ? blocks * 8 : blocks * 16;
+}
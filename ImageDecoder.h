@@ -0,0 +1,55 @@
+#ifndef _IMAGE_DECODER_H_
+#define _IMAGE_DECODER_H_
+
+/* Header for the ImageDecoder Module
+ *
+ * consists of ImageFormat enumeration
+ *             Image declaration
+ *             image decoding functions
+ *
+ * ImageDecoder.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Image ---------------------------------
+//
+// Image holds the decoded texels of a BMP, TGA or DDS file, top row
+// first - every level of the mip chain that the file holds, the top
+// level first.  Texels are 32-bit 0xAARRGGBB values, the layout of
+// D3DFMT_A8R8G8B8 and of the rasterizer's textures.  The blocks of a
+// DXT file are kept as they are in the file.  data is allocated as an
+// array of unsigned, so that a rasterizer texture can adopt its texels
+//
+typedef enum ImageFormat {
+	IMAGE_ARGB, // 32-bit texels in 0xAARRGGBB form
+	IMAGE_DXT1, // 8-byte blocks of 4 x 4 texels
+	IMAGE_DXT2, // 16-byte blocks of 4 x 4 texels
+	IMAGE_DXT3,
+	IMAGE_DXT4,
+	IMAGE_DXT5
+} ImageFormat;
+
+struct Image {
+	int            width;  // texels in a row of the top level
+	int            height; // rows in the top level
+	int            levels; // levels in data
+	ImageFormat    format; // format of the texels
+	int            size;   // bytes in data
+	unsigned char* data;   // texels or blocks, NULL if not decoded
+};
+
+// decodeImage decodes the size bytes of a BMP, TGA or DDS file at data -
+// it needs no more than the C library and SSE2, and keeps no state
+// between calls, so separate threads may decode separate files at once
+bool decodeImage(const void* data, int size, Image& image);
+// loadImage maps file into memory - or reads it, without Win32 - and
+// decodes it
+bool loadImage(const char* file, Image& image);
+// decompressImage turns the top level of a DXT image into 32-bit texels
+bool decompressImage(Image& image);
+void releaseImage(Image& image);
+int  imageLevelSize(ImageFormat format, int width, int height);
+
+#endif
@@ -0,0 +1,206 @@
+/* Loader Module Implementation
+ *
+ * Loader.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstddef>  // for NULL
+#include "Loader.h" // for Loader and LoadRequest
+
+//-------------------------------- Loader --------------------------------
+//
+// Loader reads files on a pool of threads for the render thread
+//
+Loader::Node  Loader::pool[MAX_NODES];
+Loader::List  Loader::spare;
+Loader::List  Loader::pending;
+Loader::List  Loader::loaded;
+Semaphore     Loader::work;
+Thread        Loader::thread[MAX_THREADS];
+int           Loader::nThreads      = 0;
+volatile long Loader::outstanding_  = 0;
+volatile bool Loader::quit          = false;
+bool          Loader::running       = false;
+
+const unsigned long long INDEX = 0xFFFFFFFFull; // index bits of a head
+
+// follow returns the head of a list that follows head h and starts with
+// node index + 1 of the pool - the count of changes wraps around
+//
+inline long long follow(long long h, long long first) {
+
+	return (long long)((((unsigned long long)h | INDEX) + 1) | first);
+}
+
+// push adds node to the front of the list
+//
+void Loader::List::push(Node* node) {
+
+	long long h = atomicCompareExchange(&head, 0, 0), seen;
+	while (true) {
+		node->next = (int)(h & INDEX);
+		long long n = follow(h, node - pool + 1);
+		if ((seen = atomicCompareExchange(&head, n, h)) == h)
+			break;
+		h = seen;
+	}
+}
+
+// pop removes the node at the front of the list and returns it, 0 if the
+// list is empty
+//
+Loader::Node* Loader::List::pop() {
+
+	long long h = atomicCompareExchange(&head, 0, 0), seen;
+	while (h & INDEX) {
+		Node* node  = pool + (h & INDEX) - 1;
+		long long n = follow(h, node->next);
+		if ((seen = atomicCompareExchange(&head, n, h)) == h)
+			return node;
+		h = seen;
+	}
+
+	return 0;
+}
+
+// popAll empties the list and returns its nodes, still linked from the
+// front
+//
+Loader::Node* Loader::List::popAll() {
+
+	long long h = atomicCompareExchange(&head, 0, 0), seen;
+	while (h & INDEX) {
+		if ((seen = atomicCompareExchange(&head, follow(h, 0), h)) == h)
+			return pool + (h & INDEX) - 1;
+		h = seen;
+	}
+
+	return 0;
+}
+
+// start starts the pool with threads threads - with none, the render
+// thread loads the requests.  start returns false if a thread could not
+// be started; the threads that did start serve the requests
+//
+bool Loader::start(int threads) {
+
+	if (running)
+		return true;
+	if (threads > MAX_THREADS)
+		threads = MAX_THREADS;
+	quit     = false;
+	running  = true;
+	nThreads = 0;
+	// every node is spare once the pool has stopped
+	spare.head = pending.head = loaded.head = 0;
+	for (int i = MAX_NODES - 1; i >= 0; i--)
+		spare.push(pool + i);
+	if (!work.valid())
+		return threads <= 0;
+	while (nThreads < threads && thread[nThreads].start(serve, NULL))
+		nThreads++;
+
+	return nThreads == (threads > 0 ? threads : 0);
+}
+
+// submit queues request for loading - the loader deletes the request
+// once it has been finished.  With every node in use, or before the pool
+// starts, the request is loaded and finished at once
+//
+void Loader::submit(LoadRequest* request) {
+
+	Node* node = spare.pop();
+	if (!node) {
+		request->load();
+		request->finish();
+		delete request;
+		return;
+	}
+	node->request = request;
+	atomicIncrement(&outstanding_);
+	pending.push(node);
+	if (nThreads)
+		work.release();
+}
+
+// serve is the entry point of a loader thread - each count of the
+// semaphore stands for one pending request
+//
+void Loader::serve(void*) {
+
+	while (true) {
+		work.wait();
+		if (quit)
+			break;
+		Node* node = pending.pop();
+		if (node) {
+			node->request->load();
+			loaded.push(node);
+		}
+	}
+}
+
+// finish finishes the loaded requests on the render thread in the order
+// in which they were loaded and returns the number finished
+//
+int Loader::finish() {
+
+	// without threads, load the pending requests here
+	if (!nThreads) {
+		Node* node;
+		while ((node = pending.pop()) != NULL) {
+			node->request->load();
+			loaded.push(node);
+		}
+	}
+
+	// take the whole list at once and reverse it - the list is last in,
+	// first out
+	Node* node  = loaded.popAll();
+	Node* first = NULL;
+	while (node) {
+		Node* next = node->next ? pool + node->next - 1 : NULL;
+		node->next = first ? int(first - pool + 1) : 0;
+		first = node;
+		node  = next;
+	}
+
+	int n = 0;
+	while (first) {
+		Node* next = first->next ? pool + first->next - 1 : NULL;
+		first->request->finish();
+		delete first->request;
+		spare.push(first);
+		atomicDecrement(&outstanding_);
+		first = next;
+		n++;
+	}
+
+	return n;
+}
+
+// stop ends the threads after the requests that they are loading and
+// finishes every request - those that had not started without loading
+//
+void Loader::stop() {
+
+	if (!running)
+		return;
+	if (nThreads) {
+		quit = true;
+		work.release(nThreads);
+		for (int i = 0; i < nThreads; i++)
+			thread[i].join();
+		nThreads = 0;
+	}
+
+	Node* node;
+	while ((node = pending.pop()) != NULL)
+		loaded.push(node);
+	finish();
+	// until the pool starts again, submit loads each request at once
+	spare.head = 0;
+	running = false;
+}
@@ -0,0 +1,92 @@
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+/* Header for the Loader Module
+ *
+ * consists of LoadRequest declaration
+ *             Loader declaration
+ *
+ * Loader.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for LOADER_THREADS
+#include "Threads.h"        // for Thread, Semaphore and the atomics
+
+//-------------------------------- LoadRequest ---------------------------
+//
+// LoadRequest is a file to be read - and decoded where the graphics card
+// allows - away from the render thread.  load() runs on a loader thread
+// and must not touch the device; finish() runs on the render thread,
+// which then deletes the request
+//
+class LoadRequest {
+
+  public:
+	virtual void load()   = 0;
+	virtual void finish() = 0;
+	virtual ~LoadRequest() {}
+};
+
+//-------------------------------- Loader --------------------------------
+//
+// Loader is a pool of LOADER_THREADS threads that carries out requests
+// so that the frame loop never waits on a disk.  The render thread
+// pushes requests onto a list that the threads pop them from, and the
+// threads push each loaded request onto a second list that the render
+// thread empties at the start of each frame.  Neither list takes a lock.
+// A request that has not started when the pool stops is finished without
+// being loaded
+//
+// Without threads the render thread loads each request itself when it
+// next empties the queue
+//
+class Loader {
+
+	static const int MAX_THREADS = 8; // threads in the pool
+	static const int MAX_NODES   = LOADER_REQUESTS;
+
+	// Node links a request into one of the lists - nodes are drawn from
+	// a fixed pool and never freed, so that a thread may read the link
+	// of a node that another thread has just popped
+	struct Node {
+		volatile int next;    // index + 1 of the next node, 0 if none
+		LoadRequest* request; // request carried by the node
+	};
+
+	// List is a lock-free last in, first out list of the nodes in the
+	// pool - as in a Win32 SList, its head packs a count of its changes
+	// with the index of its first node, so that an exchange fails if the
+	// node was popped and pushed again since the head was read
+	struct List {
+		volatile long long head; // changes << 32 | index + 1, 0 if empty
+		List() : head(0) {}
+		void  push(Node* node);
+		Node* pop();
+		Node* popAll();
+	};
+
+	static Node          pool[MAX_NODES];      // nodes of the lists
+	static List          spare;                // nodes not in use
+	static List          pending;              // requests not yet loaded
+	static List          loaded;               // requests to finish
+	static Semaphore     work;                 // counts pending requests
+	static Thread        thread[MAX_THREADS];  // threads in the pool
+	static int           nThreads;             // number of threads
+	static volatile long outstanding_;         // requests not finished
+	static volatile bool quit;                 // tells the threads to end
+	static bool          running;              // has the pool started?
+
+	static void serve(void*);
+
+  public:
+	static bool start(int threads = LOADER_THREADS);
+	static void submit(LoadRequest* request);
+	static int  finish();
+	static void stop();
+	static int  outstanding() { return outstanding_; }
+};
+
+#endif
@@ -0,0 +1,1300 @@
+/* MeshLoader Module Implementation
+ *
+ * MeshLoader.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio>        // for FILE, fopen, fread, fclose
+#include <cstring>       // for memcpy, memset, strlen
+#include <cmath>         // for sqrtf, pow
+#include <new>           // for std::nothrow
+#include "MeshLoader.h"  // for MeshData and MeshMaterial
+
+//-------------------------------- List ----------------------------------
+//
+// List is an array of items that grows as items are added
+//
+template <class T>
+class List {
+
+	T*  item;
+	int n;
+	int capacity;
+
+	List(const List&);            // prevents copying
+	List& operator=(const List&); // prevents assignment
+
+  public:
+	List() : item(0), n(0), capacity(0) {}
+	~List() { delete [] item; }
+	void reserve(int c) {
+		if (c > capacity) {
+			T* i = new T[c];
+			for (int k = 0; k < n; k++)
+				i[k] = item[k];
+			delete [] item;
+			item     = i;
+			capacity = c;
+		}
+	}
+	void add(const T& t) {
+		if (n == capacity)
+			reserve(capacity ? 2 * capacity : 64);
+		item[n++] = t;
+	}
+	void clear()      { n = 0; }
+	int  size() const { return n; }
+	T&       operator[](int i)       { return item[i]; }
+	const T& operator[](int i) const { return item[i]; }
+	// release hands the items to the caller
+	T* release() { T* i = item; item = 0; n = capacity = 0; return i; }
+};
+
+//-------------------------------- Builder -------------------------------
+//
+// Builder assembles the vertices and faces of a mesh from corners that
+// index separate lists of positions, normals and texture coordinates -
+// a corner that repeats an earlier corner of the same part reuses its
+// vertex.  A part is a set of faces that share a list of positions
+//
+class Builder {
+
+	struct Key {
+		int p, t, n; // position, texture coordinates and normal
+	};
+
+	List<float>    vertex;    // eight floats for each vertex
+	List<unsigned> index;     // three indices for each face
+	List<unsigned> attribute; // material of each face
+	List<Key>      key;       // corner of each vertex of the part
+	int*           table;     // vertex of the part for each hash slot
+	int            size;      // number of hash slots
+	int            first;     // first vertex of the part
+	int            firstFace; // first face of the part
+
+	Builder(const Builder&);            // prevents copying
+	Builder& operator=(const Builder&); // prevents assignment
+	void rehash(int n);
+
+  public:
+	List<MeshMaterial> material;
+
+	Builder() : table(0), size(0), first(0), firstFace(0) {}
+	~Builder() { delete [] table; }
+	void     begin();
+	unsigned corner(int p, int t, int n, const float* position,
+	 const float* uv, const float* normal);
+	void     face(unsigned a, unsigned b, unsigned c, unsigned mtrl);
+	void     end(int nPositions);
+	void     finish(MeshData& mesh);
+};
+
+// hash returns the hash of corner (p, t, n)
+//
+static unsigned hash(int p, int t, int n) {
+
+	return (unsigned)p * 73856093u ^ (unsigned)t * 19349663u ^
+	 (unsigned)n * 83492791u;
+}
+
+// rehash resizes the hash table to n slots and reinserts the vertices of
+// the part
+//
+void Builder::rehash(int n) {
+
+	delete [] table;
+	size  = n;
+	table = new int[size];
+	for (int i = 0; i < size; i++)
+		table[i] = -1;
+	for (int v = 0; v < key.size(); v++) {
+		unsigned h = hash(key[v].p, key[v].t, key[v].n) & (size - 1);
+		while (table[h] >= 0)
+			h = (h + 1) & (size - 1);
+		table[h] = v;
+	}
+}
+
+// begin starts a new part
+//
+void Builder::begin() {
+
+	key.clear();
+	first     = vertex.size() / 8;
+	firstFace = attribute.size();
+	rehash(1024);
+}
+
+// corner returns the vertex for corner (p, t, n) of the part, adding the
+// vertex from position, uv and normal if the corner is new - a corner
+// without a normal gets a zero normal that end replaces
+//
+unsigned Builder::corner(int p, int t, int n, const float* position,
+ const float* uv, const float* normal) {
+
+	unsigned h = hash(p, t, n) & (size - 1);
+	while (table[h] >= 0) {
+		const Key& k = key[table[h]];
+		if (k.p == p && k.t == t && k.n == n)
+			return first + table[h];
+		h = (h + 1) & (size - 1);
+	}
+
+	Key k = {p, t, n};
+	table[h] = key.size();
+	key.add(k);
+	for (int i = 0; i < 3; i++)
+		vertex.add(position[i]);
+	for (int i = 0; i < 3; i++)
+		vertex.add(normal ? normal[i] : 0);
+	vertex.add(uv ? uv[0] : 0);
+	vertex.add(uv ? uv[1] : 0);
+	if (2 * key.size() > size)
+		rehash(2 * size);
+
+	return first + key.size() - 1;
+}
+
+// face adds the face a, b, c with material mtrl
+//
+void Builder::face(unsigned a, unsigned b, unsigned c, unsigned mtrl) {
+
+	index.add(a);
+	index.add(b);
+	index.add(c);
+	attribute.add(mtrl);
+}
+
+// end finishes the part, which addresses nPositions positions - each
+// vertex without a normal gets the average of the normals of the faces
+// around its position
+//
+void Builder::end(int nPositions) {
+
+	bool smooth = false;
+	for (int v = first; v < vertex.size() / 8 && !smooth; v++) {
+		const float* n = &vertex[8 * v + 3];
+		smooth = n[0] == 0 && n[1] == 0 && n[2] == 0;
+	}
+	if (!smooth)
+		return;
+
+	float* sum = new float[3 * nPositions];
+	for (int i = 0; i < 3 * nPositions; i++)
+		sum[i] = 0;
+	for (int f = firstFace; f < attribute.size(); f++) {
+		const float* a = &vertex[8 * index[3 * f]];
+		const float* b = &vertex[8 * index[3 * f + 1]];
+		const float* c = &vertex[8 * index[3 * f + 2]];
+		float e1[3], e2[3];
+		for (int i = 0; i < 3; i++) {
+			e1[i] = b[i] - a[i];
+			e2[i] = c[i] - a[i];
+		}
+		float n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+		 e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+		for (int k = 0; k < 3; k++) {
+			float* s = sum + 3 * key[index[3 * f + k] - first].p;
+			s[0] += n[0];
+			s[1] += n[1];
+			s[2] += n[2];
+		}
+	}
+	for (int v = first; v < vertex.size() / 8; v++) {
+		float* n = &vertex[8 * v + 3];
+		if (n[0] == 0 && n[1] == 0 && n[2] == 0) {
+			const float* s = sum + 3 * key[v - first].p;
+			float l = sqrtf(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+			if (l > 0) {
+				n[0] = s[0] / l;
+				n[1] = s[1] / l;
+				n[2] = s[2] / l;
+			}
+		}
+	}
+	delete [] sum;
+}
+
+// finish hands the vertices, faces and materials to mesh
+//
+void Builder::finish(MeshData& mesh) {
+
+	mesh.nVertices  = vertex.size() / 8;
+	mesh.nFaces     = attribute.size();
+	mesh.nMaterials = material.size();
+	mesh.vertex     = vertex.release();
+	mesh.index      = index.release();
+	mesh.attribute  = attribute.release();
+	mesh.material   = material.release();
+}
+
+//-------------------------------- Mesh Loading --------------------------
+//
+// Both formats are read into memory in a single read and parsed in a
+// single pass without building a document tree
+//
+static const int MAX_NAME = 64; // characters in a material name
+
+// read returns the contents of file with a terminating null byte and
+// their size through n, NULL if the file cannot be read
+//
+static char* read(const char* file, int& n) {
+
+	FILE* fp = fopen(file, "rb");
+	if (!fp)
+		return 0;
+	fseek(fp, 0, SEEK_END);
+	n = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	char* buffer = n >= 0 ? new (std::nothrow) char[n + 1] : 0;
+	if (buffer && (int)fread(buffer, 1, n, fp) != n) {
+		delete [] buffer;
+		buffer = 0;
+	}
+	fclose(fp);
+	if (buffer)
+		buffer[n] = '\0';
+
+	return buffer;
+}
+
+// directory copies the directory part of path, with its separator,
+// into dir
+//
+static void directory(const char* path, char* dir) {
+
+	int n = 0;
+	for (int i = 0; path[i]; i++)
+		if (path[i] == '/' || path[i] == '\\')
+			n = i + 1;
+	if (n >= MAX_MATERIAL_PATH)
+		n = 0;
+	memcpy(dir, path, n);
+	dir[n] = '\0';
+}
+
+// setTexture stores the path of texture file name - length characters -
+// relative to directory dir in m
+//
+static void setTexture(MeshMaterial& m, const char* dir, const char* name,
+ int length) {
+
+	int d = (int)strlen(dir);
+	if (d + length >= MAX_MATERIAL_PATH)
+		length = MAX_MATERIAL_PATH - 1 - d;
+	memcpy(m.texture, dir, d);
+	memcpy(m.texture + d, name, length);
+	m.texture[d + length] = '\0';
+}
+
+// defaultMaterial returns a white material without a texture
+//
+static MeshMaterial defaultMaterial() {
+
+	MeshMaterial m;
+	for (int i = 0; i < 4; i++)
+		m.diffuse[i] = 1;
+	m.texture[0] = '\0';
+
+	return m;
+}
+
+// parseNumber reads the decimal number at p into v and returns the
+// address that follows it, NULL if p does not address a number
+//
+static const char* parseNumber(const char* p, const char* end, double& v) {
+
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = *p++ == '-';
+	double m = 0;
+	int digits = 0, scale = 0;
+	while (p < end && *p >= '0' && *p <= '9') {
+		m = 10 * m + (*p++ - '0');
+		digits++;
+	}
+	if (p < end && *p == '.') {
+		p++;
+		while (p < end && *p >= '0' && *p <= '9') {
+			m = 10 * m + (*p++ - '0');
+			digits++;
+			scale--;
+		}
+	}
+	if (!digits)
+		return 0;
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		const char* q = p + 1;
+		bool negE = false;
+		if (q < end && (*q == '-' || *q == '+'))
+			negE = *q++ == '-';
+		int e = 0;
+		if (q < end && *q >= '0' && *q <= '9') {
+			while (q < end && *q >= '0' && *q <= '9')
+				e = 10 * e + (*q++ - '0');
+			scale += negE ? -e : e;
+			p = q;
+		}
+	}
+	v = scale ? m * pow(10.0, scale) : m;
+	if (negative)
+		v = -v;
+
+	return p;
+}
+
+//-------------------------------- X File --------------------------------
+//
+// An X file is a sequence of templates and data objects in text or in
+// binary form.  The reader turns either form into one stream of names,
+// strings, numbers and braces - separators, guids and the lists of the
+// binary form are folded into that stream
+//
+enum TokenType {
+	T_END,
+	T_NAME,
+	T_STRING,
+	T_NUMBER,
+	T_OPEN,
+	T_CLOSE
+};
+
+struct Token {
+	TokenType   type;
+	double      number;
+	const char* text;   // name or string, not terminated
+	int         length; // characters in text
+};
+
+// binary tokens
+static const int X_NAME         = 1;
+static const int X_STRING       = 2;
+static const int X_INTEGER      = 3;
+static const int X_GUID         = 5;
+static const int X_INTEGER_LIST = 6;
+static const int X_FLOAT_LIST   = 7;
+static const int X_OBRACE       = 10;
+static const int X_CBRACE       = 11;
+static const int X_TEMPLATE     = 31;
+
+class XReader {
+
+	const char* p;         // next byte to read
+	const char* end;       // end of the data
+	bool        binary;    // binary form?
+	bool        doubles;   // binary floats have 64 bits?
+	int         listLeft;  // items left in the current binary list
+	bool        listFloat; // current binary list holds floats?
+	Token       look;      // token that has been put back
+	bool        peeked;    // has a token been put back?
+
+	bool     dword(unsigned& v);
+	TokenType textToken(Token& t);
+	TokenType binaryToken(Token& t);
+
+  public:
+	XReader(const char* data, int n, bool bin, bool dbl) : p(data),
+	 end(data + n), binary(bin), doubles(dbl), listLeft(0),
+	 listFloat(false), peeked(false) {}
+	TokenType get(Token& t);
+	void      unget(const Token& t) { look = t; peeked = true; }
+	bool      number(double& v);
+	bool      integer(int& v);
+	bool      open();
+	bool      skip();
+	bool      holds(int n, int k) const;
+};
+
+// dword reads a 32-bit little-endian value into v
+//
+bool XReader::dword(unsigned& v) {
+
+	if (end - p < 4)
+		return false;
+	const unsigned char* b = (const unsigned char*)p;
+	v = b[0] | b[1] << 8 | b[2] << 16 | (unsigned)b[3] << 24;
+	p += 4;
+
+	return true;
+}
+
+// get reads the next token into t and returns its type
+//
+TokenType XReader::get(Token& t) {
+
+	if (peeked) {
+		peeked = false;
+		t = look;
+		return t.type;
+	}
+
+	return binary ? binaryToken(t) : textToken(t);
+}
+
+// textToken reads the next token of the text form
+//
+TokenType XReader::textToken(Token& t) {
+
+	while (p < end) {
+		char c = *p;
+		if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' ||
+		 c == ';')
+			p++;
+		else if (c == '#' || (c == '/' && p + 1 < end && p[1] == '/')) {
+			while (p < end && *p != '\n')
+				p++;
+		}
+		else if (c == '<') {
+			while (p < end && *p != '>')
+				p++;
+			p++;
+		}
+		else if (c == '{') {
+			p++;
+			return t.type = T_OPEN;
+		}
+		else if (c == '}') {
+			p++;
+			return t.type = T_CLOSE;
+		}
+		else if (c == '"') {
+			t.text = ++p;
+			while (p < end && *p != '"')
+				p++;
+			t.length = (int)(p - t.text);
+			p++;
+			return t.type = T_STRING;
+		}
+		else if ((c >= '0' && c <= '9') || c == '-' || c == '+' ||
+		 c == '.') {
+			const char* q = parseNumber(p, end, t.number);
+			if (q) {
+				p = q;
+				return t.type = T_NUMBER;
+			}
+			p++;
+		}
+		else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+		 c == '_') {
+			t.text = p;
+			while (p < end && ((*p >= 'A' && *p <= 'Z') ||
+			 (*p >= 'a' && *p <= 'z') || (*p >= '0' && *p <= '9') ||
+			 *p == '_' || *p == '-' || *p == '.'))
+				p++;
+			t.length = (int)(p - t.text);
+			return t.type = T_NAME;
+		}
+		else
+			p++; // brackets and other template punctuation
+	}
+
+	return t.type = T_END;
+}
+
+// binaryToken reads the next token of the binary form - a list yields
+// its items one number at a time
+//
+TokenType XReader::binaryToken(Token& t) {
+
+	for (;;) {
+		if (listLeft) {
+			unsigned v;
+			if (listFloat && doubles) {
+				if (end - p < 8) return t.type = T_END;
+				double d;
+				memcpy(&d, p, 8);
+				p += 8;
+				t.number = d;
+			}
+			else if (!dword(v))
+				return t.type = T_END;
+			else if (listFloat) {
+				float f;
+				memcpy(&f, &v, 4);
+				t.number = f;
+			}
+			else
+				t.number = (double)v;
+			listLeft--;
+			return t.type = T_NUMBER;
+		}
+
+		if (end - p < 2)
+			return t.type = T_END;
+		int token = (unsigned char)p[0] | (unsigned char)p[1] << 8;
+		p += 2;
+		unsigned n;
+		switch (token) {
+			case X_NAME:
+			case X_STRING:
+				if (!dword(n) || (unsigned)(end - p) < n)
+					return t.type = T_END;
+				t.text   = p;
+				t.length = n;
+				p += n;
+				if (token == X_STRING) {
+					p += 2; // terminating separator
+					return t.type = T_STRING;
+				}
+				return t.type = T_NAME;
+			case X_INTEGER:
+				if (!dword(n))
+					return t.type = T_END;
+				t.number = (double)n;
+				return t.type = T_NUMBER;
+			case X_GUID:
+				p += 16;
+				break;
+			case X_INTEGER_LIST:
+			case X_FLOAT_LIST:
+				if (!dword(n))
+					return t.type = T_END;
+				listLeft  = n;
+				listFloat = token == X_FLOAT_LIST;
+				break;
+			case X_OBRACE:
+				return t.type = T_OPEN;
+			case X_CBRACE:
+				return t.type = T_CLOSE;
+			case X_TEMPLATE:
+				t.text   = "template";
+				t.length = 8;
+				return t.type = T_NAME;
+			default:
+				break; // separators and the types in templates
+		}
+		if (p > end)
+			return t.type = T_END;
+	}
+}
+
+// number reads the next token, which must be a number, into v
+//
+bool XReader::number(double& v) {
+
+	Token t;
+	if (get(t) != T_NUMBER)
+		return false;
+	v = t.number;
+
+	return true;
+}
+
+// integer reads the next token, which must be a non-negative integer,
+// into v
+//
+bool XReader::integer(int& v) {
+
+	double d;
+	if (!number(d) || d < 0 || d > 0x7FFFFFFF)
+		return false;
+	v = (int)d;
+
+	return true;
+}
+
+// holds returns true if the data left can hold n items of k numbers -
+// a number takes at least one byte of the text form and four bytes of
+// the binary form, so that a count read from a damaged file cannot
+// allocate more than a few times the size of the file
+//
+bool XReader::holds(int n, int k) const {
+
+	return (double)n * k * (binary ? 4 : 1) <= (double)(end - p);
+}
+
+// open reads the optional name of a data object and its opening brace
+//
+bool XReader::open() {
+
+	Token t;
+	if (get(t) == T_NAME)
+		get(t);
+
+	return t.type == T_OPEN;
+}
+
+// skip reads up to and including the brace that closes the current
+// data object
+//
+bool XReader::skip() {
+
+	Token t;
+	int depth = 1;
+	while (depth && get(t) != T_END) {
+		if (t.type == T_OPEN)
+			depth++;
+		else if (t.type == T_CLOSE)
+			depth--;
+	}
+
+	return !depth;
+}
+
+// is returns true if token t is the name s, regardless of case
+//
+static bool is(const Token& t, const char* s) {
+
+	int i = 0;
+	for (; i < t.length && s[i]; i++) {
+		char a = t.text[i], b = s[i];
+		if (a >= 'A' && a <= 'Z') a += 'a' - 'A';
+		if (b >= 'A' && b <= 'Z') b += 'a' - 'A';
+		if (a != b)
+			return false;
+	}
+
+	return i == t.length && !s[i];
+}
+
+// NamedMaterial is a material defined at the top level of an X file that
+// a material list refers to by name
+struct NamedMaterial {
+	char         name[MAX_NAME + 1];
+	MeshMaterial material;
+};
+
+// XParser reads the frames, meshes and materials of an X file into a
+// Builder - each mesh is a part, transformed by the frames around it
+//
+class XParser {
+
+	XReader&              r;
+	Builder&              b;
+	const char*           dir;   // directory of the file
+	List<NamedMaterial>   named; // materials defined at the top level
+
+	bool frame(const float* parent);
+	bool mesh(const float* m);
+	bool material(MeshMaterial& m);
+	bool materialList(List<MeshMaterial>& list, List<int>& faceMaterial);
+	bool numbers(float* v, int n);
+	bool faces(int n, List<int>& start, List<int>& corner);
+
+  public:
+	XParser(XReader& reader, Builder& builder, const char* d) :
+	 r(reader), b(builder), dir(d) {}
+	bool parse();
+};
+
+// numbers reads n numbers into v
+//
+bool XParser::numbers(float* v, int n) {
+
+	double d;
+	for (int i = 0; i < n; i++) {
+		if (!r.number(d))
+			return false;
+		v[i] = (float)d;
+	}
+
+	return true;
+}
+
+// faces reads n faces - the count of corners of each face followed by
+// its indices - into the first corner of each face and the corners
+//
+bool XParser::faces(int n, List<int>& start, List<int>& corner) {
+
+	if (!r.holds(n, 1))
+		return false;
+	start.reserve(n + 1);
+	for (int f = 0; f < n; f++) {
+		int k, v;
+		if (!r.integer(k))
+			return false;
+		start.add(corner.size());
+		for (int i = 0; i < k; i++) {
+			if (!r.integer(v))
+				return false;
+			corner.add(v);
+		}
+	}
+	start.add(corner.size());
+
+	return true;
+}
+
+// parse reads the top level of the file
+//
+bool XParser::parse() {
+
+	const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+	 0, 0, 0, 1};
+	Token t;
+	bool ok = true;
+	while (ok && r.get(t) != T_END) {
+		if (t.type != T_NAME)
+			ok = t.type != T_OPEN || r.skip();
+		else if (is(t, "template")) {
+			Token n;
+			ok = r.get(n) == T_NAME && r.get(n) == T_OPEN && r.skip();
+		}
+		else if (is(t, "Frame"))
+			ok = r.open() && frame(identity);
+		else if (is(t, "Mesh"))
+			ok = r.open() && mesh(identity);
+		else if (is(t, "Material")) {
+			NamedMaterial m;
+			Token n;
+			m.name[0] = '\0';
+			if (r.get(n) == T_NAME) {
+				int k = n.length < MAX_NAME ? n.length : MAX_NAME;
+				memcpy(m.name, n.text, k);
+				m.name[k] = '\0';
+				r.get(n);
+			}
+			ok = n.type == T_OPEN && material(m.material);
+			if (ok)
+				named.add(m);
+		}
+		else
+			ok = r.open() && r.skip();
+	}
+
+	return ok;
+}
+
+// frame reads the body of a frame whose parent transforms to the root by
+// parent - the transformations are row-major with row vectors
+//
+bool XParser::frame(const float* parent) {
+
+	float m[16];
+	memcpy(m, parent, sizeof m);
+	Token t;
+	while (r.get(t) != T_CLOSE) {
+		if (t.type == T_END)
+			return false;
+		else if (t.type == T_OPEN) {
+			if (!r.skip()) return false;
+		}
+		else if (t.type != T_NAME)
+			continue;
+		else if (is(t, "FrameTransformMatrix")) {
+			float local[16];
+			if (!r.open() || !numbers(local, 16) || !r.skip())
+				return false;
+			for (int i = 0; i < 4; i++)
+				for (int j = 0; j < 4; j++)
+					m[4 * i + j] = local[4 * i] * parent[j] +
+					 local[4 * i + 1] * parent[4 + j] +
+					 local[4 * i + 2] * parent[8 + j] +
+					 local[4 * i + 3] * parent[12 + j];
+		}
+		else if (is(t, "Frame")) {
+			if (!r.open() || !frame(m)) return false;
+		}
+		else if (is(t, "Mesh")) {
+			if (!r.open() || !mesh(m)) return false;
+		}
+		else if (!r.open() || !r.skip())
+			return false;
+	}
+
+	return true;
+}
+
+// material reads the body of a material into m
+//
+bool XParser::material(MeshMaterial& m) {
+
+	float colour[11]; // face colour, power, specular and emissive
+	m = defaultMaterial();
+	if (!numbers(colour, 11))
+		return false;
+	for (int i = 0; i < 4; i++)
+		m.diffuse[i] = colour[i];
+
+	Token t;
+	while (r.get(t) != T_CLOSE) {
+		if (t.type == T_END)
+			return false;
+		else if (t.type == T_OPEN) {
+			if (!r.skip()) return false;
+		}
+		else if (t.type != T_NAME)
+			continue;
+		else if (is(t, "TextureFilename")) {
+			Token s;
+			if (!r.open() || r.get(s) != T_STRING)
+				return false;
+			setTexture(m, dir, s.text, s.length);
+			if (!r.skip())
+				return false;
+		}
+		else if (!r.open() || !r.skip())
+			return false;
+	}
+
+	return true;
+}
+
+// materialList reads the body of a material list - the material of each
+// face into faceMaterial and the materials, defined in place or by
+// reference to a named material, into list
+//
+bool XParser::materialList(List<MeshMaterial>& list,
+ List<int>& faceMaterial) {
+
+	int nMaterials, nFaces, k;
+	if (!r.integer(nMaterials) || !r.integer(nFaces) ||
+	 !r.holds(nMaterials, 1) || !r.holds(nFaces, 1))
+		return false;
+	for (int f = 0; f < nFaces; f++) {
+		if (!r.integer(k))
+			return false;
+		faceMaterial.add(k);
+	}
+
+	Token t;
+	while (r.get(t) != T_CLOSE) {
+		if (t.type == T_END)
+			return false;
+		else if (t.type == T_OPEN) {
+			// reference to a named material
+			Token n;
+			if (r.get(n) != T_NAME)
+				return false;
+			MeshMaterial m = defaultMaterial();
+			for (int i = 0; i < named.size(); i++)
+				if (is(n, named[i].name))
+					m = named[i].material;
+			list.add(m);
+			if (!r.skip())
+				return false;
+		}
+		else if (t.type != T_NAME)
+			continue;
+		else if (is(t, "Material")) {
+			MeshMaterial m;
+			if (!r.open() || !material(m))
+				return false;
+			list.add(m);
+		}
+		else if (!r.open() || !r.skip())
+			return false;
+	}
+	while (list.size() < nMaterials)
+		list.add(defaultMaterial());
+
+	return true;
+}
+
+// mesh reads the body of a mesh, transforms its positions and normals by
+// m and adds it to the builder as a part
+//
+bool XParser::mesh(const float* m) {
+
+	// positions and faces
+	int nPositions, nFaces;
+	if (!r.integer(nPositions) || !r.holds(nPositions, 3))
+		return false;
+	float* position = new (std::nothrow) float[3 * nPositions + 1];
+	if (!position)
+		return false;
+	List<int> start, corner;
+	bool ok = numbers(position, 3 * nPositions) && r.integer(nFaces) &&
+	 faces(nFaces, start, corner);
+
+	// normals, texture coordinates and materials
+	float* normal = 0;
+	float* uv     = 0;
+	int    nNormals = 0, nUVs = 0;
+	List<int> normalStart, normalCorner, faceMaterial;
+	List<MeshMaterial> materials;
+	Token t;
+	while (ok && r.get(t) != T_CLOSE) {
+		if (t.type == T_END)
+			ok = false;
+		else if (t.type == T_OPEN)
+			ok = r.skip();
+		else if (t.type != T_NAME)
+			continue;
+		else if (is(t, "MeshNormals")) {
+			int n;
+			ok = r.open() && r.integer(nNormals) && !normal &&
+			 r.holds(nNormals, 3) && (normal = new (std::nothrow)
+			 float[3 * nNormals + 1]) != 0;
+			if (ok)
+				ok = numbers(normal, 3 * nNormals) && r.integer(n) &&
+				 faces(n, normalStart, normalCorner) && r.skip();
+		}
+		else if (is(t, "MeshTextureCoords")) {
+			ok = r.open() && r.integer(nUVs) && !uv && r.holds(nUVs, 2) &&
+			 (uv = new (std::nothrow) float[2 * nUVs + 1]) != 0;
+			if (ok)
+				ok = numbers(uv, 2 * nUVs) && r.skip();
+		}
+		else if (is(t, "MeshMaterialList"))
+			ok = r.open() && materialList(materials, faceMaterial);
+		else
+			ok = r.open() && r.skip();
+	}
+
+	// transform the positions and the normals to the root frame
+	for (int i = 0; ok && i < nPositions; i++) {
+		float* v = position + 3 * i;
+		float x = v[0], y = v[1], z = v[2];
+		for (int j = 0; j < 3; j++)
+			v[j] = x * m[j] + y * m[4 + j] + z * m[8 + j] + m[12 + j];
+	}
+	for (int i = 0; ok && i < nNormals; i++) {
+		float* v = normal + 3 * i;
+		float x = v[0], y = v[1], z = v[2];
+		for (int j = 0; j < 3; j++)
+			v[j] = x * m[j] + y * m[4 + j] + z * m[8 + j];
+		float l = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		if (l > 0)
+			for (int j = 0; j < 3; j++)
+				v[j] /= l;
+	}
+
+	// the normals are usable if their faces match the faces of the mesh
+	bool useNormals = normal && normalStart.size() == start.size();
+	for (int f = 0; useNormals && f < nFaces; f++)
+		useNormals = normalStart[f + 1] - normalStart[f] ==
+		 start[f + 1] - start[f];
+	for (int i = 0; useNormals && i < normalCorner.size(); i++)
+		useNormals = normalCorner[i] < nNormals;
+	bool useUVs = uv && nUVs >= nPositions;
+
+	// add the materials and the faces, splitting polygons into fans
+	int base = b.material.size();
+	if (!materials.size())
+		materials.add(defaultMaterial());
+	for (int i = 0; i < materials.size(); i++)
+		b.material.add(materials[i]);
+	if (ok) {
+		b.begin();
+		for (int f = 0; ok && f < nFaces; f++) {
+			int n = start[f + 1] - start[f];
+			int mtrl = faceMaterial.size() ? faceMaterial[f <
+			 faceMaterial.size() ? f : faceMaterial.size() - 1] : 0;
+			if (mtrl >= materials.size())
+				mtrl = 0;
+			unsigned v[3];
+			for (int k = 0; ok && k < n; k++) {
+				int p = corner[start[f] + k];
+				int q = useNormals ? normalCorner[normalStart[f] + k] : -1;
+				ok = p < nPositions;
+				if (ok)
+					v[k < 2 ? k : 2] = b.corner(p, useUVs ? p : -1, q,
+					 position + 3 * p, useUVs ? uv + 2 * p : 0,
+					 q >= 0 ? normal + 3 * q : 0);
+				if (ok && k >= 2) {
+					b.face(v[0], v[1], v[2], base + mtrl);
+					v[1] = v[2];
+				}
+			}
+		}
+		if (ok)
+			b.end(nPositions);
+	}
+
+	delete [] position;
+	delete [] normal;
+	delete [] uv;
+
+	return ok;
+}
+
+// loadX reads the n bytes of X file data - text or binary - into mesh
+//
+static bool loadX(const char* data, int n, const char* dir,
+ MeshData& mesh) {
+
+	// header: magic, version, format and float size
+	if (n < 16 || memcmp(data, "xof ", 4))
+		return false;
+	bool binary = !memcmp(data + 8, "bin ", 4);
+	if (!binary && memcmp(data + 8, "txt ", 4))
+		return false; // compressed forms are not supported
+	bool doubles = !memcmp(data + 12, "0064", 4);
+
+	XReader reader(data + 16, n - 16, binary, doubles);
+	Builder builder;
+	XParser parser(reader, builder, dir);
+	bool ok = parser.parse();
+	if (ok)
+		builder.finish(mesh);
+
+	return ok;
+}
+
+//-------------------------------- OBJ File ------------------------------
+//
+// An OBJ file is a list of lines - positions (v), normals (vn), texture
+// coordinates (vt), faces (f) and references to materials (usemtl) in
+// material libraries (mtllib).  OBJ files are right-handed with
+// counter-clockwise faces and texture coordinates that rise upwards -
+// the loader negates z, reverses the faces and flips tv
+//
+
+// NamedIndex is a material of an OBJ file identified by name
+struct NamedIndex {
+	char name[MAX_NAME + 1];
+	int  index;
+};
+
+// line returns the end of the line that starts at p, and the start of
+// the next line through next
+//
+static const char* line(const char* p, const char* end, const char*& next) {
+
+	const char* e = p;
+	while (e < end && *e != '\n' && *e != '\r')
+		e++;
+	next = e;
+	while (next < end && (*next == '\n' || *next == '\r'))
+		next++;
+
+	return e;
+}
+
+// spaces returns the first character at or after p that is not a space
+//
+static const char* spaces(const char* p, const char* end) {
+
+	while (p < end && (*p == ' ' || *p == '\t'))
+		p++;
+
+	return p;
+}
+
+// keyword returns true if the line at p starts with keyword k followed by
+// a space and moves p past the space
+//
+static bool keyword(const char*& p, const char* end, const char* k) {
+
+	int n = (int)strlen(k);
+	if (end - p <= n || memcmp(p, k, n) || (p[n] != ' ' && p[n] != '\t'))
+		return false;
+	p = spaces(p + n, end);
+
+	return true;
+}
+
+// trim copies the rest of the line at p, without trailing spaces, into s
+// of up to max characters and returns the number copied
+//
+static int trim(const char* p, const char* end, char* s, int max) {
+
+	while (end > p && (end[-1] == ' ' || end[-1] == '\t'))
+		end--;
+	int n = (int)(end - p) < max ? (int)(end - p) : max;
+	memcpy(s, p, n);
+	s[n] = '\0';
+
+	return n;
+}
+
+// findMaterial returns the index of the material named s, adding a
+// default material with that name if there is none
+//
+static int findMaterial(List<NamedIndex>& names, Builder& b, const char* s) {
+
+	for (int i = 0; i < names.size(); i++)
+		if (!strcmp(names[i].name, s))
+			return names[i].index;
+	NamedIndex n;
+	strcpy(n.name, s);
+	n.index = b.material.size();
+	names.add(n);
+	b.material.add(defaultMaterial());
+
+	return n.index;
+}
+
+// loadMaterials reads the material library file into the builder
+//
+static void loadMaterials(const char* file, List<NamedIndex>& names,
+ Builder& b) {
+
+	int n;
+	char* data = read(file, n);
+	if (!data)
+		return;
+	char dir[MAX_MATERIAL_PATH];
+	directory(file, dir);
+
+	const char* end = data + n;
+	int current = -1;
+	for (const char* p = data, *next; p < end; p = next) {
+		const char* e = line(p, end, next);
+		p = spaces(p, e);
+		double v[3] = {0, 0, 0};
+		if (keyword(p, e, "newmtl")) {
+			char s[MAX_NAME + 1];
+			trim(p, e, s, MAX_NAME);
+			current = findMaterial(names, b, s);
+		}
+		else if (current < 0)
+			continue;
+		else if (keyword(p, e, "Kd")) {
+			for (int i = 0; i < 3 && p; i++)
+				if ((p = parseNumber(spaces(p, e), e, v[i])) != 0)
+					b.material[current].diffuse[i] = (float)v[i];
+		}
+		else if (keyword(p, e, "d")) {
+			if (parseNumber(p, e, v[0]))
+				b.material[current].diffuse[3] = (float)v[0];
+		}
+		else if (keyword(p, e, "Tr")) {
+			if (parseNumber(p, e, v[0]))
+				b.material[current].diffuse[3] = 1 - (float)v[0];
+		}
+		else if (keyword(p, e, "map_Kd")) {
+			// the file name is the last word - options precede it
+			const char* s = e;
+			while (s > p && s[-1] == ' ')
+				s--;
+			const char* f = s;
+			while (f > p && f[-1] != ' ' && f[-1] != '\t')
+				f--;
+			setTexture(b.material[current], dir, f, (int)(s - f));
+		}
+	}
+	delete [] data;
+}
+
+// loadOBJ reads the n bytes of OBJ data into mesh
+//
+static bool loadOBJ(const char* data, int n, const char* dir,
+ MeshData& mesh) {
+
+	List<float> position, normal, uv;
+	List<NamedIndex> names;
+	Builder b;
+	int  current = -1;
+	bool ok = true;
+
+	b.begin();
+	const char* end = data + n;
+	for (const char* p = data, *next; ok && p < end; p = next) {
+		const char* e = line(p, end, next);
+		p = spaces(p, e);
+		double v[3] = {0, 0, 0};
+		if (keyword(p, e, "v")) {
+			for (int i = 0; i < 3 && p; i++)
+				p = parseNumber(spaces(p, e), e, v[i]);
+			position.add((float)v[0]);
+			position.add((float)v[1]);
+			position.add(-(float)v[2]);
+		}
+		else if (keyword(p, e, "vn")) {
+			for (int i = 0; i < 3 && p; i++)
+				p = parseNumber(spaces(p, e), e, v[i]);
+			normal.add((float)v[0]);
+			normal.add((float)v[1]);
+			normal.add(-(float)v[2]);
+		}
+		else if (keyword(p, e, "vt")) {
+			for (int i = 0; i < 2 && p; i++)
+				p = parseNumber(spaces(p, e), e, v[i]);
+			uv.add((float)v[0]);
+			uv.add(1 - (float)v[1]);
+		}
+		else if (keyword(p, e, "f")) {
+			if (current < 0)
+				current = findMaterial(names, b, "");
+			// corners are p, p/t, p//n or p/t/n - 1-based or, if
+			// negative, relative to the end of each list
+			unsigned first = 0, last = 0;
+			int k = 0;
+			while (ok && (p = spaces(p, e)) < e) {
+				int c[3] = {0, 0, 0};
+				int count[3] = {position.size() / 3, uv.size() / 2,
+				 normal.size() / 3};
+				for (int i = 0; i < 3; i++) {
+					if (i && (p >= e || *p != '/'))
+						break;
+					if (i) p++;
+					const char* q = parseNumber(p, e, v[i]);
+					if (q) {
+						c[i] = v[i] < 0 ? count[i] + (int)v[i] + 1 :
+						 (int)v[i];
+						p = q;
+					}
+				}
+				while (p < e && *p != ' ' && *p != '\t')
+					p++;
+				ok = c[0] >= 1 && c[0] <= count[0] && c[1] <= count[1] &&
+				 c[2] <= count[2] && c[1] >= 0 && c[2] >= 0;
+				if (!ok)
+					break;
+				int pi = c[0] - 1, ti = c[1] - 1, ni = c[2] - 1;
+				unsigned vtx = b.corner(pi, ti, ni, &position[3 * pi],
+				 ti >= 0 ? &uv[2 * ti] : 0, ni >= 0 ? &normal[3 * ni] : 0);
+				if (k == 0)
+					first = vtx;
+				else if (k >= 2)
+					b.face(first, vtx, last, current);
+				last = vtx;
+				k++;
+			}
+		}
+		else if (keyword(p, e, "usemtl")) {
+			char s[MAX_NAME + 1];
+			trim(p, e, s, MAX_NAME);
+			current = findMaterial(names, b, s);
+		}
+		else if (keyword(p, e, "mtllib")) {
+			char file[MAX_MATERIAL_PATH], s[MAX_MATERIAL_PATH];
+			int d = (int)strlen(dir);
+			trim(p, e, s, MAX_MATERIAL_PATH - 1 - d);
+			memcpy(file, dir, d);
+			strcpy(file + d, s);
+			loadMaterials(file, names, b);
+		}
+	}
+	if (ok) {
+		b.end(position.size() / 3);
+		if (!b.material.size())
+			b.material.add(defaultMaterial());
+		b.finish(mesh);
+	}
+
+	return ok;
+}
+
+// loadMesh reads file - a text or binary .x file or an .obj file - into
+// mesh and returns true if successful, false otherwise
+//
+bool loadMesh(const char* file, MeshData& mesh) {
+
+	memset(&mesh, 0, sizeof mesh);
+	int n;
+	char* data = read(file, n);
+	if (!data)
+		return false;
+	char dir[MAX_MATERIAL_PATH];
+	directory(file, dir);
+
+	int l = (int)strlen(file);
+	bool obj = l > 4 && (file[l - 4] == '.') &&
+	 (file[l - 3] == 'o' || file[l - 3] == 'O') &&
+	 (file[l - 2] == 'b' || file[l - 2] == 'B') &&
+	 (file[l - 1] == 'j' || file[l - 1] == 'J');
+	bool ok = obj ? loadOBJ(data, n, dir, mesh) : loadX(data, n, dir, mesh);
+	delete [] data;
+	if (ok && !mesh.nFaces) {
+		releaseMesh(mesh);
+		ok = false;
+	}
+
+	return ok;
+}
+
+// releaseMesh releases the lists of mesh
+//
+void releaseMesh(MeshData& mesh) {
+
+	delete [] mesh.vertex;
+	delete [] mesh.index;
+	delete [] mesh.attribute;
+	delete [] mesh.material;
+	memset(&mesh, 0, sizeof mesh);
+}
@@ -0,0 +1,46 @@
+#ifndef _MESH_LOADER_H_
+#define _MESH_LOADER_H_
+
+/* Header for the MeshLoader Module
+ *
+ * consists of MeshMaterial declaration
+ *             MeshData declaration
+ *             mesh loading functions
+ *
+ * MeshLoader.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- MeshData ------------------------------
+//
+// MeshData holds a mesh loaded from a file as an indexed triangle list in
+// the left-handed, clockwise convention of the scene - eight floats for
+// each vertex (x, y, z, nx, ny, nz, tu, tv), three indices for each face,
+// the material of each face and the materials themselves
+//
+const int MAX_MATERIAL_PATH = 260; // characters in a texture path
+
+struct MeshMaterial {
+	float diffuse[4];                   // reflected r, g, b, a
+	char  texture[MAX_MATERIAL_PATH];   // texture file, "" if none
+};
+
+struct MeshData {
+	float*        vertex;    // eight floats for each vertex
+	unsigned*     index;     // three indices for each face
+	unsigned*     attribute; // material of each face
+	MeshMaterial* material;  // materials of the faces
+	int           nVertices;
+	int           nFaces;
+	int           nMaterials;
+};
+
+// loadMesh reads a text or binary .x file or an .obj file - the loader
+// keeps no state between calls, so separate threads may load separate
+// files at once
+bool loadMesh(const char* file, MeshData& mesh);
+void releaseMesh(MeshData& mesh);
+
+#endif
@@ -0,0 +1,649 @@
+/* MeshOptimizer Module Implementation
+ *
+ * MeshOptimizer.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cmath>           // for powf, sqrtf, sqrt
+#include <cstdlib>         // for qsort
+#include <cstring>         // for memcmp, memcpy
+#include "MeshOptimizer.h" // for the mesh optimization functions
+
+//-------------------------------- Mesh Optimization ---------------------
+//
+// The scores of the vertex cache optimizer follow Forsyth: a vertex in
+// the three most recent cache entries scores LAST_TRIANGLE, an older
+// entry scores less with its age and a vertex with few remaining
+// triangles is boosted so that it is finished off
+//
+static const float LAST_TRIANGLE  = 0.75f;
+static const float DECAY_POWER    = 1.5f;
+static const float VALENCE_SCALE  = 2.0f;
+static const float VALENCE_POWER  = -0.5f;
+static const unsigned UNUSED      = ~0u;
+
+// weldVertices maps each of the nVertices vertices at vertex - stride
+// floats apart - to the first vertex with identical contents through
+// remap and returns the number of distinct vertices
+//
+int weldVertices(const float* vertex, int nVertices, int stride,
+ unsigned* remap) {
+
+	int size = 1;
+	while (size < 2 * nVertices)
+		size <<= 1;
+	int* table = new int[size];
+	for (int i = 0; i < size; i++)
+		table[i] = -1;
+
+	int distinct = 0;
+	for (int i = 0; i < nVertices; i++) {
+		const float* v = vertex + i * stride;
+		const unsigned char* b = (const unsigned char*)v;
+		unsigned h = 2166136261u;
+		for (int k = 0; k < stride * (int)sizeof(float); k++)
+			h = (h ^ b[k]) * 16777619u;
+		int slot = h & (size - 1);
+		while (table[slot] >= 0 && memcmp(vertex + table[slot] * stride,
+		 v, stride * sizeof(float)))
+			slot = (slot + 1) & (size - 1);
+		if (table[slot] < 0) {
+			table[slot] = i;
+			distinct++;
+		}
+		remap[i] = table[slot];
+	}
+	delete [] table;
+
+	return distinct;
+}
+
+// score returns the score of a vertex at position cachePos in the cache
+// (-1 if not in the cache) that belongs to live remaining triangles
+//
+static float score(int cachePos, int live) {
+
+	if (!live)
+		return -1;
+	float s = 0;
+	if (cachePos >= 0) {
+		if (cachePos < 3)
+			s = LAST_TRIANGLE;
+		else
+			s = powf(1 - float(cachePos - 3) / (VERTEX_CACHE_SIZE - 3),
+			 DECAY_POWER);
+	}
+
+	return s + VALENCE_SCALE * powf((float)live, VALENCE_POWER);
+}
+
+// optimizeCache reorders the triangles of the list of nIndices indices
+// into nVertices vertices for the post-transform vertex cache
+//
+void optimizeCache(unsigned* index, int nIndices, int nVertices) {
+
+	int nTriangles = nIndices / 3;
+	if (nTriangles < 2 || nVertices <= 0)
+		return;
+
+	// triangles that use each vertex
+	int*   live     = new int[nVertices];
+	int*   first    = new int[nVertices + 1];
+	int*   adjacent = new int[3 * nTriangles];
+	int*   cachePos = new int[nVertices];
+	float* vScore   = new float[nVertices];
+	for (int v = 0; v < nVertices; v++) {
+		live[v]     = 0;
+		cachePos[v] = -1;
+	}
+	for (int i = 0; i < 3 * nTriangles; i++)
+		live[index[i]]++;
+	first[0] = 0;
+	for (int v = 0; v < nVertices; v++)
+		first[v + 1] = first[v] + live[v];
+	for (int v = 0; v < nVertices; v++)
+		live[v] = 0;
+	for (int t = 0; t < nTriangles; t++)
+		for (int k = 0; k < 3; k++) {
+			unsigned v = index[3 * t + k];
+			adjacent[first[v] + live[v]++] = t;
+		}
+	for (int v = 0; v < nVertices; v++)
+		vScore[v] = score(-1, live[v]);
+
+	// score each triangle
+	float* tScore = new float[nTriangles];
+	bool*  done   = new bool[nTriangles];
+	int best = 0;
+	for (int t = 0; t < nTriangles; t++) {
+		tScore[t] = vScore[index[3 * t]] + vScore[index[3 * t + 1]] +
+		 vScore[index[3 * t + 2]];
+		done[t] = false;
+		if (tScore[t] > tScore[best])
+			best = t;
+	}
+
+	unsigned* out = new unsigned[3 * nTriangles];
+	int cache[VERTEX_CACHE_SIZE + 3], nCache = 0;
+	int next = 0; // first triangle that may not be done
+	for (int i = 0; i < nTriangles; i++) {
+		if (best < 0) {
+			// no triangle touches the cache - take the next one
+			while (done[next])
+				next++;
+			best = next;
+		}
+		const unsigned* tri = index + 3 * best;
+		out[3 * i]     = tri[0];
+		out[3 * i + 1] = tri[1];
+		out[3 * i + 2] = tri[2];
+		done[best] = true;
+
+		// remove the triangle from the lists of its vertices
+		for (int k = 0; k < 3; k++) {
+			unsigned v = tri[k];
+			int* a = adjacent + first[v];
+			for (int j = 0; j < live[v]; j++)
+				if (a[j] == best) {
+					a[j] = a[--live[v]];
+					break;
+				}
+		}
+
+		// move the triangle's vertices to the front of the cache
+		int fresh[VERTEX_CACHE_SIZE + 3], nFresh = 0;
+		for (int k = 0; k < 3; k++)
+			fresh[nFresh++] = tri[k];
+		for (int j = 0; j < nCache; j++) {
+			int v = cache[j];
+			if (v != (int)tri[0] && v != (int)tri[1] && v != (int)tri[2])
+				fresh[nFresh++] = v;
+		}
+		for (int j = 0; j < nFresh; j++) {
+			int v = fresh[j];
+			cachePos[v] = j < VERTEX_CACHE_SIZE ? j : -1;
+			vScore[v]   = score(cachePos[v], live[v]);
+		}
+		nCache = nFresh < VERTEX_CACHE_SIZE ? nFresh : VERTEX_CACHE_SIZE;
+		memcpy(cache, fresh, nCache * sizeof(int));
+
+		// rescore the triangles that touch the cache and find the best
+		best = -1;
+		float top = -1;
+		for (int j = 0; j < nFresh; j++) {
+			int v = fresh[j];
+			for (int k = 0; k < live[v]; k++) {
+				int t = adjacent[first[v] + k];
+				const unsigned* w = index + 3 * t;
+				tScore[t] = vScore[w[0]] + vScore[w[1]] + vScore[w[2]];
+				if (tScore[t] > top) {
+					top  = tScore[t];
+					best = t;
+				}
+			}
+		}
+	}
+	memcpy(index, out, 3 * nTriangles * sizeof(unsigned));
+
+	delete [] out;
+	delete [] done;
+	delete [] tScore;
+	delete [] vScore;
+	delete [] cachePos;
+	delete [] adjacent;
+	delete [] first;
+	delete [] live;
+}
+
+// Cluster is a run of triangles ordered for overdraw
+struct Cluster {
+	float key; // outward facing measure
+	int   id;  // position of the cluster in cache order
+};
+
+// compareClusters orders clusters by decreasing key, keeping the cache
+// order of clusters with the same key
+//
+static int compareClusters(const void* a, const void* b) {
+
+	const Cluster* x = (const Cluster*)a;
+	const Cluster* y = (const Cluster*)b;
+
+	return x->key > y->key ? -1 : x->key < y->key ? 1 : x->id - y->id;
+}
+
+// optimizeOverdraw splits the list of nIndices indices into clusters of
+// cluster triangles and draws first the clusters whose normal points
+// away from the centre of the mesh - those are the clusters most likely
+// to hide others.  The positions lead each vertex at vertex, stride
+// floats apart
+//
+void optimizeOverdraw(unsigned* index, int nIndices, const float* vertex,
+ int stride, int cluster) {
+
+	int nTriangles = nIndices / 3;
+	int nClusters  = cluster > 0 ? (nTriangles + cluster - 1) / cluster : 0;
+	if (nClusters < 2)
+		return;
+
+	// centre of the mesh and the centre and normal of each cluster
+	float  centre[3] = {0, 0, 0};
+	float* c = new float[6 * nClusters];
+	for (int k = 0; k < 6 * nClusters; k++)
+		c[k] = 0;
+	for (int t = 0; t < nTriangles; t++) {
+		const float* a = vertex + index[3 * t] * stride;
+		const float* b = vertex + index[3 * t + 1] * stride;
+		const float* d = vertex + index[3 * t + 2] * stride;
+		float* p = c + 6 * (t / cluster);
+		float e1[3], e2[3];
+		for (int k = 0; k < 3; k++) {
+			float m = (a[k] + b[k] + d[k]) / 3;
+			centre[k] += m;
+			p[k]      += m;
+			e1[k]      = b[k] - a[k];
+			e2[k]      = d[k] - a[k];
+		}
+		p[3] += e1[1] * e2[2] - e1[2] * e2[1];
+		p[4] += e1[2] * e2[0] - e1[0] * e2[2];
+		p[5] += e1[0] * e2[1] - e1[1] * e2[0];
+	}
+	for (int k = 0; k < 3; k++)
+		centre[k] /= nTriangles;
+
+	Cluster* order = new Cluster[nClusters];
+	for (int i = 0; i < nClusters; i++) {
+		float* p = c + 6 * i;
+		int n = i + 1 < nClusters ? cluster : nTriangles - i * cluster;
+		float l = sqrtf(p[3] * p[3] + p[4] * p[4] + p[5] * p[5]);
+		order[i].id  = i;
+		order[i].key = l > 0 ? ((p[0] / n - centre[0]) * p[3] +
+		 (p[1] / n - centre[1]) * p[4] + (p[2] / n - centre[2]) * p[5]) / l :
+		 0;
+	}
+	qsort(order, nClusters, sizeof(Cluster), compareClusters);
+
+	unsigned* out = new unsigned[3 * nTriangles];
+	int k = 0;
+	for (int i = 0; i < nClusters; i++) {
+		int from = order[i].id * cluster * 3;
+		int to   = from + 3 * cluster;
+		if (to > 3 * nTriangles) to = 3 * nTriangles;
+		for (int j = from; j < to; j++)
+			out[k++] = index[j];
+	}
+	memcpy(index, out, 3 * nTriangles * sizeof(unsigned));
+
+	delete [] out;
+	delete [] order;
+	delete [] c;
+}
+
+// optimizeFetch numbers the vertices in the order that the list of
+// nIndices indices first uses them, rewrites the indices and returns the
+// new number of each of the nVertices vertices through remap - vertices
+// that are not used follow those that are
+//
+void optimizeFetch(unsigned* index, int nIndices, int nVertices,
+ unsigned* remap) {
+
+	for (int v = 0; v < nVertices; v++)
+		remap[v] = UNUSED;
+	unsigned next = 0;
+	for (int i = 0; i < nIndices; i++) {
+		unsigned v = index[i];
+		if (remap[v] == UNUSED)
+			remap[v] = next++;
+		index[i] = remap[v];
+	}
+	for (int v = 0; v < nVertices; v++)
+		if (remap[v] == UNUSED)
+			remap[v] = next++;
+}
+
+// acmr returns the average number of misses per triangle in a FIFO cache
+// of cacheSize vertices for the list of nIndices indices into nVertices
+// vertices
+//
+float acmr(const unsigned* index, int nIndices, int nVertices,
+ int cacheSize) {
+
+	int nTriangles = nIndices / 3;
+	if (!nTriangles || nVertices <= 0)
+		return 0;
+
+	// a vertex is in the cache if fewer than cacheSize misses have
+	// occurred since it was loaded
+	int* loaded = new int[nVertices];
+	for (int v = 0; v < nVertices; v++)
+		loaded[v] = -cacheSize - 1;
+	int misses = 0;
+	for (int i = 0; i < 3 * nTriangles; i++) {
+		unsigned v = index[i];
+		if (misses - loaded[v] > cacheSize) {
+			loaded[v] = misses;
+			misses++;
+		}
+	}
+	delete [] loaded;
+
+	return (float)misses / nTriangles;
+}
+
+//-------------------------------- Mesh Simplification -------------------
+//
+// simplifyMesh collapses edges onto one of their vertices so that the
+// vertices of the mesh keep their normals and texture coordinates.  The
+// cost of a collapse is the sum of the squared distances of the kept
+// vertex from the planes of the triangles around both vertices - the
+// quadric error metric of Garland and Heckbert
+//
+struct Quadric {
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+};
+
+// Collapse is a candidate collapse of vertex from onto vertex to
+struct Collapse {
+	float    cost;
+	unsigned from;
+	unsigned to;
+};
+
+// Edge is an edge of a triangle, its lower vertex first
+struct Edge {
+	unsigned a;
+	unsigned b;
+	unsigned attribute; // attribute of the triangle
+};
+
+// compareCollapses orders collapses by increasing cost
+//
+static int compareCollapses(const void* a, const void* b) {
+
+	float x = ((const Collapse*)a)->cost, y = ((const Collapse*)b)->cost;
+
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// compareEdges orders edges by their vertices
+//
+static int compareEdges(const void* a, const void* b) {
+
+	const Edge* x = (const Edge*)a;
+	const Edge* y = (const Edge*)b;
+
+	return x->a != y->a ? (x->a < y->a ? -1 : 1) : x->b != y->b ?
+	 (x->b < y->b ? -1 : 1) : 0;
+}
+
+// comparePositions orders vertex numbers by the positions that they
+// address
+//
+static const float* sortVertex;
+static int          sortStride;
+
+static int comparePositions(const void* a, const void* b) {
+
+	const float* x = sortVertex + *(const unsigned*)a * sortStride;
+	const float* y = sortVertex + *(const unsigned*)b * sortStride;
+	for (int k = 0; k < 3; k++)
+		if (x[k] != y[k])
+			return x[k] < y[k] ? -1 : 1;
+	return 0;
+}
+
+// quadricError returns the error of quadric q at position p
+//
+static double quadricError(const Quadric& q, const float* p) {
+
+	double x = p[0], y = p[1], z = p[2];
+
+	return q.a2 * x * x + 2 * q.ab * x * y + 2 * q.ac * x * z + 
+	 2 * q.ad * x + q.b2 * y * y + 2 * q.bc * y * z + 2 * q.bd * y + 
+	 q.c2 * z * z + 2 * q.cd * z + q.d2;
+}
+
+// accumulate adds quadric q to quadric sum
+//
+static void accumulate(Quadric& sum, const Quadric& q) {
+
+	const double* s = &q.a2;
+	double* d = &sum.a2;
+	for (int k = 0; k < 10; k++)
+		d[k] += s[k];
+}
+
+// flips returns true if moving vertex from to the position of vertex to
+// would turn over or flatten one of the n triangles listed in adjacent
+// that do not contain to
+//
+static bool flips(const unsigned* index, const int* adjacent, int n,
+ unsigned from, unsigned to, const float* vertex, int stride) {
+
+	const float* p = vertex + to * stride;
+	for (int i = 0; i < n; i++) {
+		const unsigned* t = index + 3 * adjacent[i];
+		if (t[0] == t[1] || t[1] == t[2] || t[0] == t[2] ||
+		 t[0] == to || t[1] == to || t[2] == to)
+			continue;
+		int k = t[0] == from ? 0 : t[1] == from ? 1 : 2;
+		const float* a = vertex + t[k] * stride;
+		const float* b = vertex + t[(k + 1) % 3] * stride;
+		const float* c = vertex + t[(k + 2) % 3] * stride;
+		// normals before and after the move
+		float e1[3], e2[3], f1[3], n0[3], n1[3];
+		for (int j = 0; j < 3; j++) {
+			e1[j] = b[j] - a[j];
+			e2[j] = c[j] - a[j];
+			f1[j] = b[j] - p[j];
+		}
+		float f2[3] = {c[0] - p[0], c[1] - p[1], c[2] - p[2]};
+		n0[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		n0[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		n0[2] = e1[0] * e2[1] - e1[1] * e2[0];
+		n1[0] = f1[1] * f2[2] - f1[2] * f2[1];
+		n1[1] = f1[2] * f2[0] - f1[0] * f2[2];
+		n1[2] = f1[0] * f2[1] - f1[1] * f2[0];
+		float d  = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+		float l0 = n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2];
+		float l1 = n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2];
+		// reject a turn of more than about 80 degrees
+		if (d <= 0 || d * d < 0.03f * l0 * l1)
+			return true;
+	}
+
+	return false;
+}
+
+// simplifyMesh reduces the list of nIndices triangle indices into the
+// nVertices vertices at vertex - stride floats apart, positions first -
+// towards target indices without moving any vertex further than about
+// maxError from the surface and returns the number of indices kept.
+// attribute - if not NULL - holds the attribute of each triangle and is
+// compacted along with the indices.  Vertices on an open edge, on the
+// border between attributes or on a seam where vertices share their
+// position are never moved
+//
+int simplifyMesh(unsigned* index, unsigned* attribute, int nIndices,
+ const float* vertex, int nVertices, int stride, int target,
+ float maxError) {
+
+	int nTriangles = nIndices / 3;
+	if (target >= 3 * nTriangles || nTriangles < 2 || nVertices <= 0)
+		return 3 * nTriangles;
+
+	// quadric of each vertex from the planes of its triangles
+	Quadric* q = new Quadric[nVertices];
+	for (int v = 0; v < nVertices; v++) {
+		double* d = &q[v].a2;
+		for (int k = 0; k < 10; k++)
+			d[k] = 0;
+	}
+	for (int t = 0; t < nTriangles; t++) {
+		const float* a = vertex + index[3 * t] * stride;
+		const float* b = vertex + index[3 * t + 1] * stride;
+		const float* c = vertex + index[3 * t + 2] * stride;
+		double e1[3], e2[3];
+		for (int k = 0; k < 3; k++) {
+			e1[k] = b[k] - a[k];
+			e2[k] = c[k] - a[k];
+		}
+		double n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+		 e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+		double l = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (l <= 0)
+			continue;
+		n[0] /= l; n[1] /= l; n[2] /= l;
+		double d = -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]);
+		Quadric p = {n[0] * n[0], n[0] * n[1], n[0] * n[2], n[0] * d,
+		 n[1] * n[1], n[1] * n[2], n[1] * d, n[2] * n[2], n[2] * d, d * d};
+		for (int k = 0; k < 3; k++)
+			accumulate(q[index[3 * t + k]], p);
+	}
+
+	// lock the vertices on open edges and attribute borders - an edge
+	// that is not shared by exactly two triangles of one attribute
+	bool* locked = new bool[nVertices];
+	for (int v = 0; v < nVertices; v++)
+		locked[v] = false;
+	int nEdges = 3 * nTriangles;
+	Edge* edge = new Edge[nEdges];
+	for (int t = 0; t < nTriangles; t++)
+		for (int k = 0; k < 3; k++) {
+			unsigned a = index[3 * t + k], b = index[3 * t + (k + 1) % 3];
+			Edge& e = edge[3 * t + k];
+			e.a = a < b ? a : b;
+			e.b = a < b ? b : a;
+			e.attribute = attribute ? attribute[t] : 0;
+		}
+	qsort(edge, nEdges, sizeof(Edge), compareEdges);
+	for (int i = 0; i < nEdges; ) {
+		int j = i + 1;
+		bool mixed = false;
+		while (j < nEdges && !compareEdges(edge + i, edge + j)) {
+			if (edge[j].attribute != edge[i].attribute)
+				mixed = true;
+			j++;
+		}
+		if (j - i != 2 || mixed)
+			locked[edge[i].a] = locked[edge[i].b] = true;
+		i = j;
+	}
+
+	// lock the vertices that share their position with another
+	unsigned* sorted = new unsigned[nVertices];
+	for (int v = 0; v < nVertices; v++)
+		sorted[v] = v;
+	sortVertex = vertex;
+	sortStride = stride;
+	qsort(sorted, nVertices, sizeof(unsigned), comparePositions);
+	for (int v = 1; v < nVertices; v++)
+		if (!comparePositions(sorted + v - 1, sorted + v))
+			locked[sorted[v - 1]] = locked[sorted[v]] = true;
+	delete [] sorted;
+
+	// collapse the cheapest edges in passes - each pass collapses
+	// edges whose vertices no earlier collapse in the pass has touched
+	double    limit    = (double)maxError * maxError;
+	int*      live     = new int[nVertices];
+	int*      first    = new int[nVertices + 1];
+	int*      adjacent = new int[3 * nTriangles];
+	bool*     touched  = new bool[nVertices];
+	Collapse* collapse = new Collapse[nEdges];
+	bool more = true;
+	while (more && 3 * nTriangles > target) {
+		// triangles around each vertex
+		for (int v = 0; v < nVertices; v++) {
+			live[v]    = 0;
+			touched[v] = false;
+		}
+		for (int i = 0; i < 3 * nTriangles; i++)
+			live[index[i]]++;
+		first[0] = 0;
+		for (int v = 0; v < nVertices; v++)
+			first[v + 1] = first[v] + live[v];
+		for (int v = 0; v < nVertices; v++)
+			live[v] = 0;
+		for (int t = 0; t < nTriangles; t++)
+			for (int k = 0; k < 3; k++) {
+				unsigned v = index[3 * t + k];
+				adjacent[first[v] + live[v]++] = t;
+			}
+
+		// cheaper direction of each edge that may collapse
+		int nCollapses = 0;
+		for (int t = 0; t < nTriangles; t++)
+			for (int k = 0; k < 3; k++) {
+				unsigned a = index[3 * t + k], b = index[3 * t + (k + 1) % 3];
+				// the other triangle of the edge lists it the other way
+				if (a > b || (locked[a] && locked[b]))
+					continue;
+				Quadric sum = q[a];
+				accumulate(sum, q[b]);
+				double ab = locked[a] ? -1 : quadricError(sum, vertex + b * stride);
+				double ba = locked[b] ? -1 : quadricError(sum, vertex + a * stride);
+				Collapse& c = collapse[nCollapses];
+				if (ba < 0 || (ab >= 0 && ab <= ba)) {
+					c.from = a; c.to = b; c.cost = (float)ab;
+				}
+				else {
+					c.from = b; c.to = a; c.cost = (float)ba;
+				}
+				if (c.cost <= limit)
+					nCollapses++;
+			}
+		qsort(collapse, nCollapses, sizeof(Collapse), compareCollapses);
+
+		// collapse the cheapest edges until the target is reached
+		int removed = 0, excess = nTriangles - target / 3;
+		int done = 0;
+		for (int i = 0; i < nCollapses && removed < excess; i++) {
+			unsigned from = collapse[i].from, to = collapse[i].to;
+			if (touched[from] || touched[to])
+				continue;
+			const int* a = adjacent + first[from];
+			if (flips(index, a, live[from], from, to, vertex, stride))
+				continue;
+			for (int j = 0; j < live[from]; j++) {
+				unsigned* t = index + 3 * a[j];
+				if (t[0] == to || t[1] == to || t[2] == to)
+					removed++;
+				for (int k = 0; k < 3; k++)
+					if (t[k] == from)
+						t[k] = to;
+			}
+			accumulate(q[to], q[from]);
+			touched[from] = touched[to] = true;
+			done++;
+		}
+
+		// drop the triangles that have collapsed
+		int n = 0;
+		for (int t = 0; t < nTriangles; t++) {
+			const unsigned* s = index + 3 * t;
+			if (s[0] != s[1] && s[1] != s[2] && s[0] != s[2]) {
+				index[3 * n]     = s[0];
+				index[3 * n + 1] = s[1];
+				index[3 * n + 2] = s[2];
+				if (attribute)
+					attribute[n] = attribute[t];
+				n++;
+			}
+		}
+		nTriangles = n;
+		more = done > 0;
+	}
+
+	delete [] collapse;
+	delete [] touched;
+	delete [] adjacent;
+	delete [] first;
+	delete [] live;
+	delete [] edge;
+	delete [] locked;
+	delete [] q;
+
+	return 3 * nTriangles;
+}
@@ -0,0 +1,44 @@
+#ifndef _MESH_OPTIMIZER_H_
+#define _MESH_OPTIMIZER_H_
+
+/* Header for the MeshOptimizer Module
+ *
+ * consists of mesh optimization functions
+ *
+ * MeshOptimizer.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Mesh Optimization ---------------------
+//
+// The functions reorder the indices and the vertices of an indexed list
+// of primitives in place before the list is uploaded:
+//
+//   weldVertices       - maps each vertex to the first identical vertex
+//   optimizeCache      - orders triangles for the post-transform vertex
+//                        cache (Forsyth's linear-speed algorithm)
+//   optimizeOverdraw   - orders clusters of triangles so that those that
+//                        face outwards from the centre are drawn first
+//   optimizeFetch      - numbers the vertices in order of first use
+//   acmr               - average number of cache misses per triangle
+//   simplifyMesh       - collapses edges by quadric error to reduce the
+//                        number of triangles for a coarser level of detail
+//
+const int VERTEX_CACHE_SIZE = 32; // entries in the simulated cache
+
+int   weldVertices(const float* vertex, int nVertices, int stride,
+ unsigned* remap);
+void  optimizeCache(unsigned* index, int nIndices, int nVertices);
+void  optimizeOverdraw(unsigned* index, int nIndices,
+ const float* vertex, int stride, int cluster);
+void  optimizeFetch(unsigned* index, int nIndices, int nVertices,
+ unsigned* remap);
+float acmr(const unsigned* index, int nIndices, int nVertices,
+ int cacheSize = VERTEX_CACHE_SIZE);
+int   simplifyMesh(unsigned* index, unsigned* attribute, int nIndices,
+ const float* vertex, int nVertices, int stride, int target,
+ float maxError);
+
+#endif
@@ -1,90 +1,136 @@
-#ifndef _MODEL_SETTINGS_H_
-#define _MODEL_SETTINGS_H_
-
-/* Header with the Model Component Settings
- *
- * ModelSettings.h
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include "Settings.h" // for ZAXIS_DIRECTION and the keypress codes
-
-// background file
-//
-#define BACKGROUND "space.jpg"
-#define BACKGROUND_WIDTH          1280
-#define BACKGROUND_HEIGHT         1280
-#define BACKGROUND_TOP_LEFT_XMAX   500
-#define BACKGROUND_SPEED         0.0f
-
-// lighting parameters
-//
-// initial light settings
-#define LIGHT0 TRUE
-#define LIGHT1 FALSE
-#define LIGHT2 TRUE
-#define AMBIENT_LIGHT 0.2f
-
-// camera parameters
-//
-// initial position and orientation
-#define CAMERA_X    0
-#define CAMERA_Y    5
-#define CAMERA_H_X  0
-#define CAMERA_H_Y  0
-#define CAMERA_U_X  0
-#define CAMERA_U_Y  1
-#define CAMERA_Z  -80 * ZAXIS_DIRECTION
-#define CAMERA_H_Z  1 * ZAXIS_DIRECTION
-#define CAMERA_U_Z  0 * ZAXIS_DIRECTION
-// motion factors
-#define ROT_SPEED     0.000833f
-#define TILT_SPEED    0.001f
-#define FORWARD_SPEED 0.01f
-#define UP_SPEED      0.005f
-// camera speed control factors
-#define CAM_SPEED       0.12f
-#define TURNING_RADIUS  120.00f
-#define ANG_CAM_SPEED   ( CAM_SPEED / TURNING_RADIUS )
-// "Floor" of the world - lowest possible y value
-#define FLOOR -50
-
-// scene parameters
-//
-// object rotation factors
-#define ROLL_SPEED 0.001111f
-#define SPIN_SPEED 0.000909f
-#define CONSTANT_ROLL  0.01f
-
-// sound parameters
-//
-// initial sound settings
-#define SOUND0 true
-#define SOUND1 false
-#define START_VOLUME 0.7f
-#define DELTA_VOLUME 0.001f
-#define FREQ_RANGE      5000  // in Hertz (cycles per sec)
-#define FREQ_DROP_VELOCITY 8  // rate of fall to idle
-#define FREQ_RISE_VELOCITY 4  // rate of rise to top
-
-// input device conversion factors
-//
-#define MOUSE_DISPLACEMENT_TO_WORLD_ROTATION     80
-#define MOUSE_DISPLACEMENT_TO_WORLD_DISPLACEMENT 40
-#define MOUSE_ROTATION_TO_WORLD_ROTATION        200
-#define MOUSE_BUTTON_SCALE                      400
-#define JOY_ROTATION_FACTOR                    0.05f
-#define JOY_DISPLACEMENT_FACTOR                0.15f
-
-// Terrain Settings
-#define TERRAIN_CHAR_BIT 8
-#define HEIGHT_MAP_FLOOR 120
-#define CLEARANCE 3
-#define BORDER 1
-#define TINY_VALUE 1.0e-10f
-#define PI 3.14159f
-#define MOVE_SPEED 0.1f
-#endif
+#ifndef _MODEL_SETTINGS_H_
+#define _MODEL_SETTINGS_H_
+
+/* Header with the Model Component Settings
+ *
+ * ModelSettings.h
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include "Settings.h" // for ZAXIS_DIRECTION and the keypress codes
+
+// background file
+//
+#define BACKGROUND "space.jpg"
+#define BACKGROUND_WIDTH          1280
+#define BACKGROUND_HEIGHT         1280
+#define BACKGROUND_TOP_LEFT_XMAX   500
+#define BACKGROUND_SPEED         0.0f
+
+// lighting parameters
+//
+// initial light settings
+#define LIGHT0 true
+#define LIGHT1 false
+#define LIGHT2 true
+#define AMBIENT_LIGHT 0.2f
+
+// camera parameters
+//
+// initial position and orientation
+#define CAMERA_X    0
+#define CAMERA_Y    5
+#define CAMERA_H_X  0
+#define CAMERA_H_Y  0
+#define CAMERA_U_X  0
+#define CAMERA_U_Y  1
+#define CAMERA_Z  -80 * ZAXIS_DIRECTION
+#define CAMERA_H_Z  1 * ZAXIS_DIRECTION
+#define CAMERA_U_Z  0 * ZAXIS_DIRECTION
+// motion factors
+#define ROT_SPEED     0.000833f
+#define TILT_SPEED    0.001f
+#define FORWARD_SPEED 0.01f
+#define UP_SPEED      0.005f
+// camera speed control factors
+#define CAM_SPEED       0.12f
+#define TURNING_RADIUS  120.00f
+#define ANG_CAM_SPEED   ( CAM_SPEED / TURNING_RADIUS )
+// "Floor" of the world - lowest possible y value
+#define FLOOR -50
+
+// scene parameters
+//
+// object rotation factors
+#define ROLL_SPEED 0.001111f
+#define SPIN_SPEED 0.000909f
+#define CONSTANT_ROLL  0.01f
+// number of bounded objects above which culling buckets them into a grid
+#define CULL_GRID_OBJECTS 256
+// average number of bounded objects in each cell of the culling grid
+#define CULL_CELL_OBJECTS 16
+// 1 to reorder the lists of an object for the vertex cache once built
+#define MESH_OPTIMIZE 1
+// extension appended to the name of a mesh file for its baked order
+#define MESH_BAKE_EXT ".baked.order"
+// triangles in each cluster that is reordered to reduce overdraw
+#define MESH_OVERDRAW_CLUSTER 64
+// primitives above which the cache miss rates of an object are reported
+#define MESH_REPORT_PRIMITIVES 256
+// projected diameter in pixels below which an object drops to its first
+// coarser level of detail - each further level halves the diameter
+#define MESH_LOD_PIXELS 240.f
+// fraction by which the projected diameter must pass a threshold before
+// the level of detail changes
+#define MESH_LOD_HYSTERESIS 0.2f
+
+// texture atlas parameters
+//
+// largest side of an atlas page in texels
+#define ATLAS_PAGE 1024
+// largest side of a texture file that is packed into a page
+#define ATLAS_MAX_SIDE 256
+// texels by which the edges of each packed file are repeated around it
+#define ATLAS_PADDING 4
+// mip levels in a page - level l repeats the edges ATLAS_PADDING >> l
+// texels, so levels past the padding would mix neighbouring files
+#define ATLAS_LEVELS 3
+// name of each page file - %d is the number of the page
+#define ATLAS_FILE "atlas%d.dds"
+
+// particle parameters
+//
+// textures of the particles of the gun and of the snow
+#define GUN_PARTICLE_IMAGE  "flare_alpha.dds"
+#define SNOW_PARTICLE_IMAGE "snowflake.dds"
+
+// sound parameters
+//
+// initial sound settings
+#define SOUND0 true
+#define SOUND1 false
+#define START_VOLUME 0.7f
+#define DELTA_VOLUME 0.001f
+#define FREQ_RANGE      5000  // in Hertz (cycles per sec)
+#define FREQ_DROP_VELOCITY 8  // rate of fall to idle
+#define FREQ_RISE_VELOCITY 4  // rate of rise to top
+
+// input device conversion factors
+//
+#define MOUSE_DISPLACEMENT_TO_WORLD_ROTATION     80
+#define MOUSE_DISPLACEMENT_TO_WORLD_DISPLACEMENT 40
+#define MOUSE_ROTATION_TO_WORLD_ROTATION        200
+#define MOUSE_BUTTON_SCALE                      400
+#define JOY_ROTATION_FACTOR                    0.05f
+#define JOY_DISPLACEMENT_FACTOR                0.15f
+
+// Terrain Settings
+#define TERRAIN_CHAR_BIT 8
+#define HEIGHT_MAP_FLOOR 120
+#define CLEARANCE 3
+#define BORDER 1
+#define TINY_VALUE 1.0e-10f
+#define PI 3.14159f
+#define MOVE_SPEED 0.1f
+// largest screen space error in pixels tolerated for a terrain tile
+#define TERRAIN_PIXEL_ERROR 2.0f
+// number of terrain tiles kept in the vertex buffer
+#define TERRAIN_SLOTS 256
+// radius in tiles of the neighbourhood of the viewpoint kept resident
+#define TERRAIN_PREFETCH 2
+// extension appended to the height map name for its tiled copy
+#define TERRAIN_TILE_EXT ".tiles"
+#endif
@@ -0,0 +1,730 @@
+/* Rasterizer Module Implementation
+ *
+ * Rasterizer.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "Rasterizer.h" // for Rasterizer
+
+#if GRAPHICS_API == HEADLESS
+#include <cstdio>        // for fopen, fwrite, fclose, sprintf
+#include <cstring>       // for memcpy
+#include <xmmintrin.h>   // for SSE intrinsics
+#include "ILighting.h"   // for Light interface and LightType
+
+// pack returns the colour [r, g, b] in 0x00RRGGBB form
+//
+inline unsigned pack(float r, float g, float b) {
+
+	if (r < 0) r = 0; else if (r > 1) r = 1;
+	if (g < 0) g = 0; else if (g > 1) g = 1;
+	if (b < 0) b = 0; else if (b > 1) b = 1;
+
+	return (unsigned)(r * 255 + 0.5f) << 16 |
+	 (unsigned)(g * 255 + 0.5f) << 8 | (unsigned)(b * 255 + 0.5f);
+}
+
+//-------------------------------- Rasterizer ----------------------------
+//
+// Rasterizer draws triangles into a colour and depth buffer on the CPU
+//
+// constructor initializes the instance variables
+//
+Rasterizer::Rasterizer() : width(0), height(0), stride(0), tilesX(0),
+ tilesY(0), colour(NULL), depth(NULL), clear(0), backdrop(NULL),
+ nSources(0), triangle(NULL), nTriangles(0), maxTriangles(0), bin(NULL),
+ nBinned(NULL), maxBinned(NULL), cache(NULL), stamp(NULL), maxCache(0),
+ nDraws(0), packing(NULL), nWorkers(0), nextTile(0), quit(false) {
+
+	for (int i = 0; i < MAX_LIGHTS; i++)
+		light_[i] = NULL;
+}
+
+// setup allocates the buffers for a frame of w x h pixels and starts
+// threads workers - one less than the number of processors if threads
+// is 0 - and returns false if a worker could not be started, in which
+// case the workers that did start share the tiles
+//
+bool Rasterizer::setup(int w, int h, int threads) {
+
+	release();
+
+	width  = w > 0 ? w : 1;
+	height = h > 0 ? h : 1;
+	tilesX = (width  + TILE_SIZE - 1) / TILE_SIZE;
+	tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+	// whole tiles, so that a group of four pixels never spans two tiles
+	stride = tilesX * TILE_SIZE;
+	int nTiles = tilesX * tilesY;
+	colour    = new unsigned[stride * tilesY * TILE_SIZE];
+	depth     = new float[stride * tilesY * TILE_SIZE];
+	bin       = new int*[nTiles];
+	nBinned   = new int[nTiles];
+	maxBinned = new int[nTiles];
+	for (int i = 0; i < nTiles; i++) {
+		bin[i]       = NULL;
+		nBinned[i]   = 0;
+		maxBinned[i] = 0;
+	}
+
+	// start the workers - the calling thread rasterizes too
+	if (threads <= 0)
+		threads = processors() - 1;
+	if (threads > MAX_THREADS)
+		threads = MAX_THREADS;
+	quit = false;
+	for (nWorkers = 0; nWorkers < threads; nWorkers++) {
+		Worker& k = worker[nWorkers];
+		k.rasterizer = this;
+		if (!k.start.valid() || !k.done.valid() ||
+		 !k.thread.start(serve, &k))
+			break;
+	}
+
+	return nWorkers == (threads > 0 ? threads : 0);
+}
+
+// light attaches light source l to index
+//
+void Rasterizer::light(int index, const ILight* l) {
+
+	if (index >= 0 && index < MAX_LIGHTS)
+		light_[index] = l;
+}
+
+// begin opens a frame that is viewed through transformation vp and
+// cleared to colour c
+//
+void Rasterizer::begin(const Matrix& vp, const Colour& c) {
+
+	viewProjection = vp;
+	clear          = pack(c.r, c.g, c.b);
+	backdrop       = NULL;
+	nTriangles     = 0;
+	for (int i = 0; i < tilesX * tilesY; i++)
+		nBinned[i] = 0;
+
+	// collect the light sources that are on
+	nSources = 0;
+	for (int i = 0; i < MAX_LIGHTS; i++) {
+		const ILight* l = light_[i];
+		if (l && l->isOn()) {
+			Source& s = source[nSources++];
+			s.type      = l->isType();
+			s.diffuse   = l->diffuse();
+			s.ambient   = l->ambient();
+			s.position  = l->position();
+			s.direction = l->direction();
+			s.position.z  *= ZAXIS_DIRECTION;
+			s.direction.z *= ZAXIS_DIRECTION;
+			if (s.direction.length())
+				s.direction = normal(s.direction);
+			s.range     = l->range();
+			s.a0        = l->attenuation0();
+			s.a1        = l->attenuation1();
+			s.a2        = l->attenuation2();
+			s.cosPhi    = cosf(l->phi() * 0.5f);
+			s.cosTheta  = cosf(l->theta() * 0.5f);
+		}
+	}
+}
+
+// background draws the rectangle [left, top, right, bottom] of texture
+// t behind the frame, scaled to cover the frame
+//
+void Rasterizer::background(const RasterTexture* t, int left, int top,
+ int right, int bottom) {
+
+	if (t && t->texel && right > left && bottom > top) {
+		backdrop   = t;
+		backLeft   = left;
+		backTop    = top;
+		backRight  = right;
+		backBottom = bottom;
+	}
+}
+
+// transform returns vertex i of the draw in clip space, lit with
+// material colour diffuse - each vertex is transformed once per draw
+//
+const Rasterizer::ClipVertex& Rasterizer::transform(const char* vb,
+ int vertexSize, int i, const Matrix& w, const Colour& diffuse) {
+
+	ClipVertex& c = cache[i];
+	if (stamp[i] == nDraws)
+		return c;
+	stamp[i] = nDraws;
+
+	// position, normal, texture coordinates
+	float unpacked[VERTEX_FLOATS];
+	const float* f = (const float*)(vb + i * vertexSize);
+	if (packing) {
+		decodeVertices((const PackedVertex*)vb + i, 1, *packing, unpacked);
+		f = unpacked;
+	}
+	Vector p(f[0] * w.m11 + f[1] * w.m21 + f[2] * w.m31 + w.m41,
+	         f[0] * w.m12 + f[1] * w.m22 + f[2] * w.m32 + w.m42,
+	         f[0] * w.m13 + f[1] * w.m23 + f[2] * w.m33 + w.m43);
+	Vector n(f[3] * w.m11 + f[4] * w.m21 + f[5] * w.m31,
+	         f[3] * w.m12 + f[4] * w.m22 + f[5] * w.m32,
+	         f[3] * w.m13 + f[4] * w.m23 + f[5] * w.m33);
+	if (n.length())
+		n = normal(n);
+	const Matrix& m = viewProjection;
+	c.x = p.x * m.m11 + p.y * m.m21 + p.z * m.m31 + m.m41;
+	c.y = p.x * m.m12 + p.y * m.m22 + p.z * m.m32 + m.m42;
+	c.z = p.x * m.m13 + p.y * m.m23 + p.z * m.m33 + m.m43;
+	c.w = p.x * m.m14 + p.y * m.m24 + p.z * m.m34 + m.m44;
+	c.u = f[6];
+	c.v = f[7];
+
+	// the material reflects 70% of the ambient light - as for the
+	// display device materials
+	float r = ambient_.r * 0.7f * diffuse.r;
+	float g = ambient_.g * 0.7f * diffuse.g;
+	float b = ambient_.b * 0.7f * diffuse.b;
+	for (int k = 0; k < nSources; k++) {
+		const Source& s = source[k];
+		Vector l;
+		float  att = 1;
+		if (s.type == DIRECTIONAL_LIGHT)
+			l = -s.direction;
+		else {
+			l = s.position - p;
+			float d = l.length();
+			if (d > s.range || !d)
+				continue;
+			l   = l / d;
+			att = s.a0 + s.a1 * d + s.a2 * d * d;
+			att = att > 0 ? 1 / att : 1;
+			if (s.type == SPOT_LIGHT) {
+				float rho = -dot(l, s.direction);
+				if (rho <= s.cosPhi)
+					att = 0;
+				else if (rho < s.cosTheta && s.cosTheta > s.cosPhi)
+					att *= (rho - s.cosPhi) / (s.cosTheta - s.cosPhi);
+			}
+		}
+		float ndotl = dot(n, l);
+		if (ndotl < 0) ndotl = 0;
+		r += att * (s.diffuse.r * ndotl + s.ambient.r * 0.7f) * diffuse.r;
+		g += att * (s.diffuse.g * ndotl + s.ambient.g * 0.7f) * diffuse.g;
+		b += att * (s.diffuse.b * ndotl + s.ambient.b * 0.7f) * diffuse.b;
+	}
+	c.r = r;
+	c.g = g;
+	c.b = b;
+	c.a = diffuse.a;
+
+	return c;
+}
+
+// clip clips triangle [a, b, c] against the near plane and sets up the
+// one or two triangles that remain
+//
+void Rasterizer::clip(const ClipVertex& a, const ClipVertex& b,
+ const ClipVertex& c, const RasterTexture* texture, bool blend) {
+
+	const ClipVertex* in[3] = { &a, &b, &c };
+	ClipVertex out[4];
+	int n = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const ClipVertex& p = *in[i];
+		const ClipVertex& q = *in[(i + 1) % 3];
+		if (p.z >= 0)
+			out[n++] = p;
+		if ((p.z >= 0) != (q.z >= 0)) {
+			// the edge crosses the near plane
+			float t = p.z / (p.z - q.z);
+			const float* fp = &p.x;
+			const float* fq = &q.x;
+			float* fo = &out[n++].x;
+			for (int k = 0; k < 10; k++)
+				fo[k] = fp[k] + t * (fq[k] - fp[k]);
+		}
+	}
+
+	// project onto the screen
+	float sx[4], sy[4], f[4][8];
+	for (int i = 0; i < n; i++) {
+		const ClipVertex& v = out[i];
+		float iw = 1 / v.w;
+		sx[i]   = (v.x * iw * 0.5f + 0.5f) * width;
+		sy[i]   = (0.5f - v.y * iw * 0.5f) * height;
+		f[i][0] = v.z * iw;
+		f[i][1] = iw;
+		f[i][2] = v.r * iw;
+		f[i][3] = v.g * iw;
+		f[i][4] = v.b * iw;
+		f[i][5] = v.a * iw;
+		f[i][6] = v.u * iw;
+		f[i][7] = v.v * iw;
+	}
+	if (n >= 3)
+		setupTriangle(sx, sy, f, texture, blend, true);
+	if (n == 4) {
+		float qx[3] = { sx[0], sx[2], sx[3] };
+		float qy[3] = { sy[0], sy[2], sy[3] };
+		float qf[3][8];
+		memcpy(qf[0], f[0], sizeof qf[0]);
+		memcpy(qf[1], f[2], sizeof qf[1]);
+		memcpy(qf[2], f[3], sizeof qf[2]);
+		setupTriangle(qx, qy, qf, texture, blend, true);
+	}
+}
+
+// point sets up a square sprite of HEADLESS_POINT_SIZE pixels centred on
+// vertex v - the texture spans the square
+//
+void Rasterizer::point(const ClipVertex& v, const RasterTexture* texture,
+ bool blend) {
+
+	if (v.z < 0 || v.w <= 0)
+		return;
+
+	float iw = 1 / v.w;
+	float cx = (v.x * iw * 0.5f + 0.5f) * width;
+	float cy = (0.5f - v.y * iw * 0.5f) * height;
+	float h  = HEADLESS_POINT_SIZE * 0.5f;
+	float x[4] = { cx - h, cx + h, cx + h, cx - h };
+	float y[4] = { cy - h, cy - h, cy + h, cy + h };
+	float u[4] = { 0, 1, 1, 0 };
+	float t[4] = { 0, 0, 1, 1 };
+	float f[4][8];
+	for (int i = 0; i < 4; i++) {
+		f[i][0] = v.z * iw;
+		f[i][1] = 1;
+		f[i][2] = v.r;
+		f[i][3] = v.g;
+		f[i][4] = v.b;
+		f[i][5] = v.a;
+		f[i][6] = u[i];
+		f[i][7] = t[i];
+	}
+	setupTriangle(x, y, f, texture, blend, false);
+	float qx[3] = { x[0], x[2], x[3] };
+	float qy[3] = { y[0], y[2], y[3] };
+	float qf[3][8];
+	memcpy(qf[0], f[0], sizeof qf[0]);
+	memcpy(qf[1], f[2], sizeof qf[1]);
+	memcpy(qf[2], f[3], sizeof qf[2]);
+	setupTriangle(qx, qy, qf, texture, blend, false);
+}
+
+// setupTriangle sets up the edge functions and attribute planes of the
+// triangle with screen coordinates sx, sy and attributes f and bins it -
+// counter-clockwise triangles are culled as on the display device
+//
+void Rasterizer::setupTriangle(const float* sx, const float* sy,
+ float (*f)[8], const RasterTexture* texture, bool blend, bool cull) {
+
+	int i1 = 1, i2 = 2;
+	float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) -
+	 (sx[2] - sx[0]) * (sy[1] - sy[0]);
+	if (area < 0 && !cull) {
+		i1   = 2;
+		i2   = 1;
+		area = -area;
+	}
+	if (area <= 0)
+		return;
+
+	float x[3] = { sx[0], sx[i1], sx[i2] };
+	float y[3] = { sy[0], sy[i1], sy[i2] };
+	const float* a[3] = { f[0], f[i1], f[i2] };
+
+	Triangle t;
+	float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+	for (int i = 1; i < 3; i++) {
+		if (x[i] < minX) minX = x[i];
+		if (x[i] > maxX) maxX = x[i];
+		if (y[i] < minY) minY = y[i];
+		if (y[i] > maxY) maxY = y[i];
+	}
+	// pixel centres lie at half coordinates
+	t.x0 = minX > 0 ? (int)(minX - 0.5f) : 0;
+	t.y0 = minY > 0 ? (int)(minY - 0.5f) : 0;
+	t.x1 = maxX < width  ? (int)(maxX + 0.5f) : width - 1;
+	t.y1 = maxY < height ? (int)(maxY + 0.5f) : height - 1;
+	if (t.x0 > t.x1 || t.y0 > t.y1 || t.x1 < 0 || t.y1 < 0)
+		return;
+	if (t.x1 >= width)  t.x1 = width - 1;
+	if (t.y1 >= height) t.y1 = height - 1;
+
+	// edge functions are positive inside the triangle
+	for (int e = 0; e < 3; e++) {
+		int n = (e + 1) % 3;
+		float A = y[e] - y[n];
+		float B = x[n] - x[e];
+		t.edge[e][0] = A;
+		t.edge[e][1] = B;
+		t.edge[e][2] = -(A * x[e] + B * y[e]);
+		t.topLeft[e] = (y[e] == y[n] && x[n] > x[e]) || y[n] < y[e];
+	}
+
+	// attribute planes
+	float dx1 = x[1] - x[0], dy1 = y[1] - y[0];
+	float dx2 = x[2] - x[0], dy2 = y[2] - y[0];
+	for (int k = 0; k < 8; k++) {
+		float df1 = a[1][k] - a[0][k];
+		float df2 = a[2][k] - a[0][k];
+		float fx  = (df1 * dy2 - df2 * dy1) / area;
+		float fy  = (df2 * dx1 - df1 * dx2) / area;
+		t.plane[k][0] = fx;
+		t.plane[k][1] = fy;
+		t.plane[k][2] = a[0][k] - fx * x[0] - fy * y[0];
+	}
+	t.texture = texture && texture->texel ? texture : NULL;
+	t.blend   = blend;
+
+	add(t);
+}
+
+// add appends triangle t to the frame and to the bin of each tile that
+// its bounding box overlaps
+//
+void Rasterizer::add(const Triangle& t) {
+
+	if (nTriangles == maxTriangles) {
+		int n = maxTriangles ? 2 * maxTriangles : MIN_ITEMS;
+		Triangle* tr = new Triangle[n];
+		if (triangle) {
+			memcpy(tr, triangle, nTriangles * sizeof(Triangle));
+			delete [] triangle;
+		}
+		triangle     = tr;
+		maxTriangles = n;
+	}
+	int i = nTriangles++;
+	triangle[i] = t;
+
+	for (int ty = t.y0 / TILE_SIZE; ty <= t.y1 / TILE_SIZE; ty++)
+		for (int tx = t.x0 / TILE_SIZE; tx <= t.x1 / TILE_SIZE; tx++) {
+			int k = ty * tilesX + tx;
+			if (nBinned[k] == maxBinned[k]) {
+				int n = maxBinned[k] ? 2 * maxBinned[k] : MIN_ITEMS;
+				int* b = new int[n];
+				if (bin[k]) {
+					memcpy(b, bin[k], nBinned[k] * sizeof(int));
+					delete [] bin[k];
+				}
+				bin[k]       = b;
+				maxBinned[k] = n;
+			}
+			bin[k][nBinned[k]++] = i;
+		}
+}
+
+// draw transforms, lights, clips and bins the nPrimitives primitives of
+// the given type that start at index startIndex of ib - each index is
+// offset by baseVertex into the nVertices vertices at vb.  The vertices
+// are packed if p is not NULL.  Lines are not rasterized
+//
+void Rasterizer::draw(const Matrix& world, const Colour& diffuse,
+ const RasterTexture* texture, bool blend, Shape type, const char* vb,
+ int vertexSize, const VertexPacking* p, int nVertices, const void* ib,
+ bool wide, int baseVertex, int startIndex, int nPrimitives) {
+
+	// a vertex holds a position, a normal and texture coordinates
+	if (!colour || !vb || !ib || nPrimitives <= 0 ||
+	 (!p && vertexSize < VERTEX_FLOATS * (int)sizeof(float)))
+		return;
+	packing = p;
+
+	if (nVertices > maxCache) {
+		if (cache) delete [] cache;
+		if (stamp) delete [] stamp;
+		cache    = new ClipVertex[nVertices];
+		stamp    = new int[nVertices];
+		maxCache = nVertices;
+		for (int i = 0; i < nVertices; i++)
+			stamp[i] = -1;
+	}
+	nDraws++;
+
+	const unsigned short* i16 = (const unsigned short*)ib + startIndex;
+	const unsigned*       i32 = (const unsigned*)ib + startIndex;
+	#define INDEX(k) (baseVertex + (int)(wide ? i32[k] : i16[k]))
+
+	for (int p = 0; p < nPrimitives; p++) {
+		int v[3];
+		switch (type) {
+			case TRIANGLE_LIST:
+				v[0] = INDEX(3 * p);
+				v[1] = INDEX(3 * p + 1);
+				v[2] = INDEX(3 * p + 2);
+				break;
+			case TRIANGLE_STRIP:
+				// every other triangle of a strip is wound the other way
+				v[0] = INDEX(p);
+				v[1] = INDEX(p + 1 + (p & 1));
+				v[2] = INDEX(p + 2 - (p & 1));
+				break;
+			case TRIANGLE_FAN:
+				v[0] = INDEX(0);
+				v[1] = INDEX(p + 1);
+				v[2] = INDEX(p + 2);
+				break;
+			case POINT_LIST:
+				v[0] = INDEX(p);
+				if (v[0] >= 0 && v[0] < nVertices)
+					point(transform(vb, vertexSize, v[0], world, diffuse),
+					 texture, blend);
+				continue;
+			default:
+				return;
+		}
+		if (v[0] < 0 || v[0] >= nVertices || v[1] < 0 ||
+		 v[1] >= nVertices || v[2] < 0 || v[2] >= nVertices)
+			continue;
+		clip(transform(vb, vertexSize, v[0], world, diffuse),
+		 transform(vb, vertexSize, v[1], world, diffuse),
+		 transform(vb, vertexSize, v[2], world, diffuse), texture, blend);
+	}
+	#undef INDEX
+}
+
+// end rasterizes the binned triangles - the workers and the calling
+// thread claim the tiles one at a time
+//
+void Rasterizer::end() {
+
+	if (!colour) return;
+
+	nextTile = 0;
+	for (int i = 0; i < nWorkers; i++)
+		worker[i].start.set();
+	work();
+	for (int i = 0; i < nWorkers; i++)
+		worker[i].done.wait();
+}
+
+// serve is the entry point of a worker thread
+//
+void Rasterizer::serve(void* w) {
+
+	Worker* k = (Worker*)w;
+	Rasterizer* r = k->rasterizer;
+
+	while (true) {
+		k->start.wait();
+		if (r->quit)
+			break;
+		r->work();
+		k->done.set();
+	}
+}
+
+// work rasterizes tiles until none remain unclaimed
+//
+void Rasterizer::work() {
+
+	int nTiles = tilesX * tilesY;
+	int t;
+	while ((t = atomicIncrement(&nextTile) - 1) < nTiles)
+		rasterize(t);
+}
+
+// rasterize clears tile t and draws the triangles in its bin
+//
+void Rasterizer::rasterize(int tile) {
+
+	int x0 = (tile % tilesX) * TILE_SIZE;
+	int y0 = (tile / tilesX) * TILE_SIZE;
+	int x1 = x0 + TILE_SIZE - 1;
+	int y1 = y0 + TILE_SIZE - 1;
+	if (x1 >= width)  x1 = width - 1;
+	if (y1 >= height) y1 = height - 1;
+
+	fill(x0, y0, x1, y1);
+	for (int i = 0; i < nBinned[tile]; i++) {
+		const Triangle& t = triangle[bin[tile][i]];
+		scan(t, t.x0 > x0 ? t.x0 : x0, t.y0 > y0 ? t.y0 : y0,
+		 t.x1 < x1 ? t.x1 : x1, t.y1 < y1 ? t.y1 : y1);
+	}
+}
+
+// fill clears the rectangle [x0, y0, x1, y1] to the background
+//
+void Rasterizer::fill(int x0, int y0, int x1, int y1) {
+
+	for (int y = y0; y <= y1; y++) {
+		unsigned* c = colour + y * stride;
+		float*    d = depth  + y * stride;
+		const unsigned* row = NULL;
+		if (backdrop) {
+			int ty = backTop + y * (backBottom - backTop) / height;
+			if (ty >= 0 && ty < backdrop->height)
+				row = backdrop->texel + ty * backdrop->width;
+		}
+		for (int x = x0; x <= x1; x++) {
+			d[x] = 1;
+			c[x] = clear;
+			if (row) {
+				int tx = backLeft + x * (backRight - backLeft) / width;
+				if (tx >= 0 && tx < backdrop->width)
+					c[x] = row[tx] & 0xFFFFFF;
+			}
+		}
+	}
+}
+
+// scan draws the pixels of triangle t that lie within [x0, y0, x1, y1]
+// - the edge functions and depth test are evaluated for four pixels at
+// a time and the covered pixels are shaded one at a time
+//
+void Rasterizer::scan(const Triangle& t, int x0, int y0, int x1, int y1) {
+
+	if (x0 > x1 || y0 > y1)
+		return;
+
+	const __m128 zero   = _mm_setzero_ps();
+	const __m128 offset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 left   = _mm_set1_ps((float)x0);
+	const __m128 right  = _mm_set1_ps((float)x1 + 1);
+	__m128 A[3], topLeft[3];
+	for (int e = 0; e < 3; e++) {
+		A[e]       = _mm_set1_ps(t.edge[e][0]);
+		topLeft[e] = _mm_castsi128_ps(_mm_set1_epi32(t.topLeft[e] ? -1 : 0));
+	}
+	const __m128 zdx = _mm_set1_ps(t.plane[0][0]);
+	const RasterTexture* tex = t.texture;
+
+	for (int y = y0; y <= y1; y++) {
+		float py = y + 0.5f;
+		__m128 row[3];
+		for (int e = 0; e < 3; e++)
+			row[e] = _mm_set1_ps(t.edge[e][1] * py + t.edge[e][2]);
+		__m128 zrow = _mm_set1_ps(t.plane[0][1] * py + t.plane[0][2]);
+		unsigned* c = colour + y * stride;
+		float*    d = depth  + y * stride;
+
+		// groups of four pixels start on a multiple of four
+		for (int x = x0 & ~3; x <= x1; x += 4) {
+			__m128 px   = _mm_add_ps(_mm_set1_ps((float)x), offset);
+			__m128 mask = _mm_and_ps(_mm_cmpgt_ps(px, left),
+			 _mm_cmplt_ps(px, right));
+			for (int e = 0; e < 3; e++) {
+				__m128 v = _mm_add_ps(_mm_mul_ps(A[e], px), row[e]);
+				// an edge owns the pixels on it only if it is a top or
+				// left edge
+				__m128 in = _mm_or_ps(_mm_cmpgt_ps(v, zero),
+				 _mm_and_ps(topLeft[e], _mm_cmpeq_ps(v, zero)));
+				mask = _mm_and_ps(mask, in);
+			}
+			if (!_mm_movemask_ps(mask))
+				continue;
+			__m128 z = _mm_add_ps(_mm_mul_ps(zdx, px), zrow);
+			mask = _mm_and_ps(mask, _mm_cmplt_ps(z, _mm_loadu_ps(d + x)));
+			int bits = _mm_movemask_ps(mask);
+			if (!bits)
+				continue;
+
+			float zs[4];
+			_mm_storeu_ps(zs, z);
+			for (int k = 0; k < 4; k++) {
+				if (!(bits & (1 << k)))
+					continue;
+				float fx = x + k + 0.5f;
+				const float (*p)[3] = t.plane;
+				float w = 1 / (p[1][0] * fx + p[1][1] * py + p[1][2]);
+				float r = (p[2][0] * fx + p[2][1] * py + p[2][2]) * w;
+				float g = (p[3][0] * fx + p[3][1] * py + p[3][2]) * w;
+				float b = (p[4][0] * fx + p[4][1] * py + p[4][2]) * w;
+				float a = (p[5][0] * fx + p[5][1] * py + p[5][2]) * w;
+				if (tex) {
+					float u = (p[6][0] * fx + p[6][1] * py + p[6][2]) * w;
+					float v = (p[7][0] * fx + p[7][1] * py + p[7][2]) * w;
+					int tx = (int)floorf(u * tex->width)  % tex->width;
+					int ty = (int)floorf(v * tex->height) % tex->height;
+					if (tx < 0) tx += tex->width;
+					if (ty < 0) ty += tex->height;
+					unsigned s = tex->texel[ty * tex->width + tx];
+					const float scale = 1.f / 255;
+					r *= (s >> 16 & 0xFF) * scale;
+					g *= (s >> 8 & 0xFF) * scale;
+					b *= (s & 0xFF) * scale;
+					a *= (s >> 24) * scale;
+				}
+				if (t.blend) {
+					unsigned s = c[x + k];
+					const float scale = (1 - a) / 255;
+					r = r * a + (s >> 16 & 0xFF) * scale;
+					g = g * a + (s >> 8 & 0xFF) * scale;
+					b = b * a + (s & 0xFF) * scale;
+				}
+				c[x + k] = pack(r, g, b);
+				d[x + k] = zs[k];
+			}
+		}
+	}
+}
+
+// capture writes the last frame to file in binary PPM form and returns
+// true if successful
+//
+bool Rasterizer::capture(const char* file) const {
+
+	if (!colour) return false;
+
+	FILE* fp = fopen(file, "wb");
+	if (!fp) return false;
+
+	char header[40];
+	int  n = sprintf(header, "P6\n%d %d\n255\n", width, height);
+	bool rc = fwrite(header, 1, n, fp) == (size_t)n;
+	unsigned char* row = new unsigned char[3 * width];
+	for (int y = 0; y < height && rc; y++) {
+		const unsigned* c = colour + y * stride;
+		for (int x = 0; x < width; x++) {
+			row[3 * x]     = (unsigned char)(c[x] >> 16);
+			row[3 * x + 1] = (unsigned char)(c[x] >> 8);
+			row[3 * x + 2] = (unsigned char)c[x];
+		}
+		rc = fwrite(row, 1, 3 * width, fp) == (size_t)(3 * width);
+	}
+	delete [] row;
+	fclose(fp);
+
+	return rc;
+}
+
+// release stops the workers and releases the buffers
+//
+void Rasterizer::release() {
+
+	quit = true;
+	for (int i = 0; i < nWorkers; i++)
+		worker[i].start.set();
+	for (int i = 0; i < nWorkers; i++)
+		worker[i].thread.join();
+	nWorkers = 0;
+
+	if (bin) {
+		for (int i = 0; i < tilesX * tilesY; i++)
+			if (bin[i]) delete [] bin[i];
+		delete [] bin;
+		bin = NULL;
+	}
+	if (nBinned)   { delete [] nBinned;   nBinned   = NULL; }
+	if (maxBinned) { delete [] maxBinned; maxBinned = NULL; }
+	if (colour)    { delete [] colour;    colour    = NULL; }
+	if (depth)     { delete [] depth;     depth     = NULL; }
+	if (triangle)  { delete [] triangle;  triangle  = NULL; }
+	if (cache)     { delete [] cache;     cache     = NULL; }
+	if (stamp)     { delete [] stamp;     stamp     = NULL; }
+	nTriangles   = 0;
+	maxTriangles = 0;
+	maxCache     = 0;
+}
+
+// destructor stops the workers and releases the buffers
+//
+Rasterizer::~Rasterizer() {
+
+	release();
+}
+#endif
@@ -0,0 +1,173 @@
+#ifndef _RASTERIZER_H_
+#define _RASTERIZER_H_
+
+/* Header for the Rasterizer Module
+ *
+ * consists of RasterTexture declaration
+ *             Rasterizer declaration
+ *
+ * Rasterizer.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+
+#if GRAPHICS_API == HEADLESS
+#include "Threads.h"        // for Thread and Event
+#include "IGraphicsCard.h"  // for Shape
+#include "math.h"           // for Matrix, Vector and Colour
+#include "VertexCodec.h"    // for PackedVertex and VertexPacking
+
+//-------------------------------- RasterTexture -------------------------
+//
+// RasterTexture holds the texels of a texture in 0xAARRGGBB form, top
+// row first
+//
+struct RasterTexture {
+	int       width;  // number of texels in a row
+	int       height; // number of rows
+	unsigned* texel;  // texels, NULL if not loaded
+};
+
+//-------------------------------- Rasterizer ----------------------------
+//
+// Rasterizer draws triangles into a colour and depth buffer on the CPU.
+// draw transforms, lights and clips the triangles of a draw call and
+// bins them by the screen tiles that they overlap.  end rasterizes the
+// tiles in parallel - each worker thread takes the next unclaimed tile
+// and draws the triangles in its bin in the order that they were drawn,
+// four pixels at a time
+//
+class ILight;
+
+class Rasterizer {
+
+	static const int TILE_SIZE   = 32; // side of a screen tile in pixels
+	static const int MAX_THREADS = 16; // worker threads
+	static const int MAX_LIGHTS  = 8;  // lights applied to a vertex
+	static const int MIN_ITEMS   = 64; // initial allocation of a list
+
+	// ClipVertex is a vertex in homogeneous clip space with its lit
+	// colour and texture coordinates
+	struct ClipVertex {
+		float x, y, z, w;
+		float r, g, b, a;
+		float u, v;
+	};
+
+	// Triangle holds the edge functions of a binned triangle and the
+	// planes of its attributes in screen space - the planes hold z, 1/w
+	// and each colour component and texture coordinate divided by w
+	struct Triangle {
+		float edge[3][3];   // A, B, C of each edge function
+		bool  topLeft[3];   // edge owns the pixels that lie on it?
+		float plane[8][3];  // dx, dy, constant of each attribute
+		int   x0, y0;       // top left pixel of the bounding box
+		int   x1, y1;       // bottom right pixel of the bounding box
+		const RasterTexture* texture; // texture to sample, NULL if none
+		bool  blend;        // alpha blended?
+	};
+
+	// Source holds the properties of a light source that is on
+	struct Source {
+		int    type;       // LightType
+		Colour diffuse;    // diffuse colour
+		Colour ambient;    // ambient colour
+		Vector position;   // position in world space
+		Vector direction;  // unit direction in world space
+		float  range;      // maximum distance lit
+		float  a0, a1, a2; // attenuation coefficients
+		float  cosPhi;     // cosine of half the outer cone angle
+		float  cosTheta;   // cosine of half the inner cone angle
+	};
+
+	// Worker is a thread that rasterizes tiles
+	struct Worker {
+		Rasterizer* rasterizer; // rasterizer that owns the worker
+		Thread      thread;     // worker thread
+		Event       start;      // signals the worker to rasterize
+		Event       done;       // signals that the worker has finished
+	};
+
+	int       width;      // width of the frame in pixels
+	int       height;     // height of the frame in pixels
+	int       stride;     // pixels in a row of the buffers
+	int       tilesX;     // tiles across the frame
+	int       tilesY;     // tiles down the frame
+	unsigned* colour;     // colour buffer - 0x00RRGGBB
+	float*    depth;      // depth buffer
+	unsigned  clear;      // clear colour
+	Matrix    viewProjection; // view-projection transformation
+
+	// background image drawn behind the frame
+	const RasterTexture* backdrop;
+	int       backLeft, backTop, backRight, backBottom;
+
+	// lighting
+	Colour        ambient_;           // global ambient light
+	const ILight* light_[MAX_LIGHTS]; // light sources
+	Source        source[MAX_LIGHTS]; // light sources that are on
+	int           nSources;           // number of light sources on
+
+	// triangles and bins
+	Triangle* triangle;     // triangles set up for this frame
+	int       nTriangles;   // number of triangles set up
+	int       maxTriangles; // number of triangles allocated
+	int**     bin;          // triangles that overlap each tile
+	int*      nBinned;      // number of triangles in each bin
+	int*      maxBinned;    // number of triangles allocated for each bin
+
+	// vertex cache for the current draw
+	ClipVertex* cache;    // transformed vertices
+	int*        stamp;    // draw that transformed each cached vertex
+	int         maxCache; // number of vertices allocated
+	int         nDraws;   // number of draws so far
+	const VertexPacking* packing; // packing of the current draw, if any
+
+	// workers
+	Worker        worker[MAX_THREADS];
+	int           nWorkers;          // number of worker threads
+	volatile long nextTile;          // next tile to claim
+	volatile bool quit;              // tells the workers to finish
+
+	Rasterizer(const Rasterizer&);            // prevents copying
+	Rasterizer& operator=(const Rasterizer&); // prevents assignment
+	void  release();
+	const ClipVertex& transform(const char* vb, int vertexSize, int i,
+	 const Matrix& world, const Colour& diffuse);
+	void  clip(const ClipVertex& a, const ClipVertex& b,
+	 const ClipVertex& c, const RasterTexture* texture, bool blend);
+	void  point(const ClipVertex& v, const RasterTexture* texture,
+	 bool blend);
+	void  setupTriangle(const float* sx, const float* sy, float (*f)[8],
+	 const RasterTexture* texture, bool blend, bool cull);
+	void  add(const Triangle& t);
+	void  work();
+	void  rasterize(int tile);
+	void  fill(int x0, int y0, int x1, int y1);
+	void  scan(const Triangle& t, int x0, int y0, int x1, int y1);
+	static void serve(void* worker);
+
+  public:
+	Rasterizer();
+	~Rasterizer();
+	bool setup(int w, int h, int threads);
+	int  workers() const { return nWorkers; }
+	void ambient(const Colour& c) { ambient_ = c; }
+	void light(int index, const ILight* l);
+	void begin(const Matrix& vp, const Colour& c);
+	void background(const RasterTexture* t, int left, int top, int right,
+	 int bottom);
+	void draw(const Matrix& world, const Colour& diffuse,
+	 const RasterTexture* texture, bool blend, Shape type, const char* vb,
+	 int vertexSize, const VertexPacking* p, int nVertices, const void* ib,
+	 bool wide, int baseVertex, int startIndex, int nPrimitives);
+	void end();
+	bool capture(const char* file) const;
+	int  triangles() const { return nTriangles; }
+};
+#endif
+
+#endif
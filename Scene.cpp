@@ -1,1330 +1,2755 @@
-/* Scene Module Implementation
- *
- * Scene.cpp
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include <fstream>
-using namespace std;
-#include "IInput.h"        // for Keyboard, Mouse, Joystick interfaces
-#include "IAudio.h"        // for Audio and Sound interfaces
-#include "ICameras.h"      // for Camera
-#include "IHUD.h"          // for HUD and Text interfaces
-#include "IGraphicsCard.h" // for Graphic and DeviceTexture interfaces
-#include "ModelSettings.h" // for FLOOR, MOUSE_BUTTON_SCALE, ROLL_SPEED
-#include "Utilities.h"     // for error()
-#include "Scene.h"         // for Scene, Object, Box, SoundBox, Grid,
-                           // Vertex, Texture class declarations
-
-//-------------------------------- Scene ---------------------------------
-//
-// Scene manages the scene component of the model
-//
-IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, IAudio* a, 
- IHUD* h, ICameras* c) {
-
-	return new Scene(k, m, j, a, h, c);
-}
-
-Scene::Scene(IKeyboard* k, IMouse* m, IJoystick* j, IAudio* a, IHUD* h, ICameras* c) :
- keyboard(k), mouse(m), joystick(j), audio(a), hud(h), cameras(c) {
-
-    noObjects = 0;
-    for (int i = 0; i < MAX_OBJECTS; i++)
-        object[i] = NULL;
-
-	noTextures = 0;
-    for (int i = 0; i < MAX_TEXTURES; i++)
-        texture[i] = NULL;
-	background         = NULL;
-	backgroundTopLeftX = 0;
-	backgroundWidth    = BACKGROUND_WIDTH;
-	backgroundRatio    = (float) BACKGROUND_HEIGHT / BACKGROUND_WIDTH;
-
-	/*  */
-	tree = NULL;
-
-    heroX  = NULL;
-    heroY  = NULL;
-    heroZ  = NULL;
-	heroPos = NULL;
-
-    lastUpdate     = 0;
-	Object::scene  = this;
-	Texture::scene = this;
-
-	//particle implementation
-	/* you can't get particle system pointer address here.
-	because of that, the first particle system initialization is done in Display::setup.
-	if you try to receive a pointer to particle system here, it means that you will receive a NULL pointer.
-	Look at the Game::setup() and see the Order.
-	*/
-	
-	
-}
-
-// add adds a pointer to Object *o to the scene
-// and returns true if successful, false otherwise
-//
-bool Scene::add(IObject* o) {
-
-    int i;
-    bool rc = false;
-
-    for (i = 0; i < noObjects; i++)
-        if (!object[i]) {
-            object[i] = o;
-            i = noObjects + 1;
-            rc = true;
-        }
-    if (i == noObjects && noObjects < MAX_OBJECTS) {
-        object[noObjects++] = o;
-        rc = true;
-    }
-
-    return rc;
-}
-
-// add adds a pointer to ITexture *t to the scene
-// and returns true if successful, false otherwise
-//
-bool Scene::add(ITexture* t) {
-
-    int i;
-    bool rc = false;
-
-    for (i = 0; i < noTextures; i++)
-        if (!texture[i]) {
-            texture[i] = t;
-            i = noTextures + 1;
-            rc = true;
-        }
-    if (i == noTextures && noTextures < MAX_TEXTURES) {
-        texture[noTextures++] = t;
-        rc = true;
-    }
-
-    return rc;
-}
-
-// setup creates the objects and textures in the initiale scene
-//
-bool Scene::setup(int now) {
-
-    lastUpdate = now;
-
-	
-
-	// create colours
-	Colour white(1, 1, 1, 1);
-	Colour black(0, 0, 0, 1);
-	Colour clr919(0.9f, 0.1f, 0.9f, 1);
-	Colour clr118(0.1f, 0.1f, 0.8f, 1);
-	Colour clr181(0.1f, 0.8f, 0.1f, 1);
-	Colour clr111(0.1f, 0.1f, 0.1f, 1);
-	Colour clr881(0.8f, 0.8f, 0.1f, 1);
-	Colour clr199(0.1f, 0.9f, 0.9f, 1);
-	Colour clr631(0.6f, 0.3f, 0.1f, 1);
-	Colour clr361(0.3f, 0.6f, 0.1f, 1);
-	Colour clr136(0.1f, 0.3f, 0.6f, 1);
-	Colour clr168(0.1f, 0.6f, 0.8f, 1);
-	Colour clr668(0.6f, 0.6f, 0.8f, 1);
-	Colour clr821(0.8f, 0.2f, 0.1f, 1);
-	Colour clr861(0.8f, 0.6f, 0.1f, 1);
-	Colour clt136(1.0f, 1.0f, 1.0f, 0);
-	Colour red(1, 0, 0, 1);
-	Colour grey(0.7f, 0.7f, 0.7f, 1);
-
-	tree = CreateTexture("tree01S.dds"); //tree environment
-
-	// create textures
-	background = CreateTexture(BACKGROUND);
-
-    // initial objects
-	Colour clr[] = {clr919, clr181, clr118, clr881, clr111, clr199}; 
-
-	sun = CreateSphere(30.0f, 20, 20, red); 
-    sun->move(-500, 500, 0);
-
-	moon = CreateSphere(30.0f, 20, 20, grey); 
-    moon->move(500, -500, 0);
-
-	// put trees on the plate
-	add(CreateBillboard(VIEWPOINT, cameras, -50, -50, 50, 50, clt136, tree));
-	object[noObjects-1]->move(-100, 30, 200);
-
-	add(CreateBillboard(VIEWPOINT, cameras, -50, -100, 50, 50, clt136, tree));
-	object[noObjects-1]->move(-310, 30, -255);
-
-	add(CreateBillboard(VIEWPOINT, cameras, -25, -25, 50, 50, clt136, tree));
-	object[noObjects-1]->move(110, 30, -150);
-
-	add(CreateBillboard(VIEWPOINT, cameras, -75, -75, 50, 50, clt136, tree));
-	object[noObjects-1]->move(450, 30, 220);
-
-
-	mainHero = CreateXFile("cannonS.x");
-	mainHero->scale(0.3f, 0.3f, 0.3f);
-
-	
-	
-	mainHero->move(0, 0, 0);
-
-    // Terrain and hero objects
-    //
-	ITexture* terrainTexture = CreateTexture("terrain2.bmp");
-    terrain = CreateTerrain(4, 50, "heightmap.bmp", terrainTexture);
-    terrain->move(0, FLOOR + 20, 100);
-
-
-	heroCamera = CreateCamera(Vector(100, 100, 200), Vector(0, 0, -1), Vector(0, 1, 0), mainHero, SECOND_PERSON);
-
-	heroCamera->attach(mainHero, false);
-	cameras->setCamera(heroCamera, true);
-
-
-
-
-    terrain->align(mainHero, 0, 1, cameras);
-
-    heroX = CreateText(0, 0.30f, 1, 0.47f);
-    heroY = CreateText(0, 0.37f, 1, 0.54f);
-    heroZ = CreateText(0, 0.44f, 1, 0.61f);
-    heroPos = CreateText(0, 0.51f, 1, 0.68f);
-
-    return noObjects <= MAX_OBJECTS;
-}
-
-// update updates the position and orientation of each object for time "now"
-// according to the keys pressed
-//
-void Scene::update(int now) {
-
-    int delta;
-    int dr = 0;  // roll the right box around its x axis
-    int ds = 0;  // spin the right box around its y axis
-    int dt = 0;  // roll the top   box around its z axis
-	float df = 0;      // move hero along x direction
-	float dg = 0;      // move hero along y direction
-	int   joy_x = 0,     // joystick x-axis: turn left/right
-          joy_y = 0,     // joystick y-axis: advance/retreat
-          joy_z = 0,     // joystick z-axis: turn up/down
-          joy_rz = 0;    // joystick rz-axis:
-	static int dw = 1; // direction control on hero
-
-    delta = now - lastUpdate;
-    lastUpdate = now;
-
-	::ParticleSystemAddress(ps);
-
-	for(int i=0; i < noObjects; i++)
-		object[i]->orient();
-
-    // joystick input rotates the camera
-    joystick->handle(joy_x, joy_y, joy_z, joy_rz);
-
-
-
-	
-	switch(cameras->returnType()) {
-		case SECOND_PERSON:
-			if (keyboard->pressed('D'))
-				dg += delta;
-			if (keyboard->pressed('A'))
-				dg -= delta;
-			if (keyboard->pressed('S'))
-				df -= delta;
-			if (keyboard->pressed('W'))
-				df += delta;
-
-			if (joy_y)
-				 df += -joy_y;
-		    if (joy_x)
-				 dg -= -joy_x;
-
-			if(mouse->pressed(LEFT_BUTTON)) {
-				ps[0]->addParticle(); //particle implementation
-			}
-
-			break;
-
-
-		case THIRD_PERSON:
-			if (keyboard->pressed(NUM6))
-				dg += delta;
-			if (keyboard->pressed(NUM4))
-				dg -= delta;
-			if (keyboard->pressed(NUM5))
-				df -= delta;
-			if (keyboard->pressed(NUM8))
-				df += delta;
-			break;
-
-		default:
-			break;
-	}
-
-	sun->planetRotate(CONSTANT_ROLL * 2);
-	moon->planetRotate(CONSTANT_ROLL * 2);
-
-
-
-    if (hud->isOn()) {
-        char str[MAX_CHAR + 1];
-        Vector v;
-        v = mainHero->orientation('x');
-        wsprintf(str, "Hero x orientation %d, %d, %d", 
-         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
-        heroX->set(str);
-        v = mainHero->orientation('y');
-        wsprintf(str, "Hero y orientation %d, %d, %d", 
-         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
-        heroY->set(str);
-        v = mainHero->orientation('z');
-        wsprintf(str, "Hero z orientation %d, %d, %d", 
-         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
-        heroZ->set(str);
-		v = mainHero->position();
-        wsprintf(str, "Hero position %d, %d, %d", 
-         (int)(v.x), (int)(v.y), (int)(v.z));
-        heroPos->set(str);
-    }
-
-	// zoom into the background image for the scene 
-	//
-	backgroundTopLeftX += delta * BACKGROUND_SPEED;
-	if ((int)backgroundTopLeftX > BACKGROUND_TOP_LEFT_XMAX)
-		backgroundTopLeftX = 0;
-
-    // move the hero across the terrain
-	if (terrain && mainHero && (dg || df)) {
-		terrain->align(mainHero, dg * dw * MOVE_SPEED, df * dw * MOVE_SPEED, cameras);
-	}
-
-	// force feedback
-	//
-	if (joystick->pressed(BUTTON_5))
-		joystick->applyForce(0);
-
-
-		ps[0]->update(delta*0.001f); //particle implementation
-		ps[1]->update(delta*0.01f);
-}
-
-// drawBackground draws the background image for the scene
-//
-void Scene::drawBackground() {
-
-	if (background) {
-		IDeviceTexture* deviceTexture;
-		deviceTexture = background->deviceTexture();
-		if (deviceTexture)
-			deviceTexture->draw((int)backgroundTopLeftX, 
-			 (int)(backgroundTopLeftX * backgroundRatio),
-			 (int)(backgroundWidth  - 2 * backgroundTopLeftX),
-			 (int)((backgroundWidth - 2 * backgroundTopLeftX) * backgroundRatio));
-	}
-}
-
-// drawOpaque draws the graphic representations of the objects in the
-// scene that are opaque
-//
-void Scene::drawOpaque() {
-
-	IGraphic* graphic;
-    for (int i = 0; i < noObjects; i++) {
-        graphic = object[i]->graphic();
-        if (graphic && graphic->opaque())
-            graphic->draw(object[i]);
-    }
-}
-
-// drawTranslucent draws the graphic representations of the objects in
-// the scene that are translucent
-//
-void Scene::drawTranslucent() {
-
-    IGraphic* graphic;
-    for (int i = 0; i < noObjects; i++) {
-        graphic = object[i]->graphic();
-        if (graphic && !graphic->opaque())
-            graphic->draw(object[i]);
-    }
-}
-
-// suspend suspends the graphical representation of each object
-// and each texture
-//
-void Scene::suspend() {
-
-    IGraphic* graphic;
-    for (int i = 0; i < noObjects; i++) {
-        graphic = object[i]->graphic();
-        if (graphic) graphic->suspend(); 
-    }
-
-	IDeviceTexture* deviceTexture;
-	for (int i = 0; i < noTextures; i++) {
-		deviceTexture = texture[i]->deviceTexture();
-		if (deviceTexture) deviceTexture->suspend();
-	}
-}
-
-// restore re-initializes the time of the last update
-//
-bool Scene::restore(int now) {
-
-    lastUpdate = now;
-
-    return true;
-}
-
-// remove removes the pointer to IObject *o from the scene and
-// returns true if successful, false otherwise
-//
-bool Scene::remove(IObject* o) {
-
-    bool rc = false;
-
-    for (int i = 0; i < noObjects; i++)
-        if (object[i] == o) {
-            object[i] = NULL;
-            rc = true;
-        }
-    while (!object[noObjects - 1])
-        noObjects--;
-
-    return rc;
-}
-
-// remove removes the pointer to ITexture *t from the scene and
-// returns true if successful, false otherwise
-//
-bool Scene::remove(ITexture* t) {
-
-    bool rc = false;
-
-    for (int i = 0; i < noTextures; i++)
-        if (texture[i] == t) {
-            texture[i] = NULL;
-            rc = true;
-        }
-    while (!texture[noTextures - 1])
-        noTextures--;
-
-    return rc;
-}
-
-// destructor deletes all of the objects in the scene
-//
-Scene::~Scene() {
-
-    for (int i = 0; i < noObjects; i++)
-        if (object[i]) 
-            object[i]->Delete();
-}
-
-//-------------------------------- Object ----------------------------------
-//
-// An Object is a member of the scene that can be manipulated and has a 
-// graphic representation that can be drawn
-//
-IScene* Object::scene = NULL;
-
-// constructor creates a 3-D object that is represented by a set of
-// graphics primitives
-//
-Object::Object(Shape shape, float* dimension, int* partition, Colour clr, 
- bool antiAlias) {
-
-	add(); // add this object to the scene
-
-	vertex    = NULL;
-	index     = NULL;
-	attribute = NULL;
-	visual    = CreateMesh(shape, dimension, partition, clr, antiAlias);
-}
-
-Object::Object(Shape shape, const char* filename, bool antiAlias) {
-
-	add(); // add this object to the scene
-
-	vertex    = NULL;
-	index     = NULL;
-	attribute = NULL;
-	visual    = CreateMesh(shape, filename, antiAlias);
-}
-
-Object::Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
- ITexture* texture, bool antiAlias) : 
- nPrimitives(noPrimitives), nVertices(noVertices) {
-    
-	add(); // add this object to the scene
-
-    // determine total number of indices
-	switch (shape) {
-        case POINT_LIST:     nIndices = nPrimitives;     break;
-        case LINE_LIST:      nIndices = 2 * nPrimitives; break;
-        case LINE_STRIP:     nIndices = nPrimitives + 1; break;
-        case TRIANGLE_LIST:  nIndices = 3 * nPrimitives; break;
-        case TRIANGLE_STRIP: nIndices = nPrimitives + 2; break;
-        case TRIANGLE_FAN:   nIndices = nPrimitives + 1; break;
-        default: nIndices = nPrimitives;
-    }
-	// allocate memory for lists
-    vertex    = new Vertex[nVertices];
-	index     = new short[nIndices];
-	attribute = NULL;
-	// temporary allocation
-	IDeviceTexture* devTex = (texture ? texture->deviceTexture() : NULL);
-	// create graphic representation
-    visual = CreateGraphic(shape, nPrimitives, nVertices, sizeof(Vertex), 
-	 nIndices, clr, devTex, antiAlias);
-	// initialize counters for sequential construction of the set of
-	// primitives from the constructors of the derived classes
-	nVertices = 0;
-	nIndices  = 0;
-	nSurfaces = 0;
-}
-
-Object::Object(Shape shape, int noPrimitives, int noVertices, 
- Colour* clr, ITexture** texture, int nSubsets, bool antiAlias) : 
- nPrimitives(noPrimitives), nVertices(noVertices) {
-
-	add(); // add this object to the scene
-
-    // determine total number of indices
-	switch (shape) {
-        case POINT_LIST:     nIndices = nPrimitives;     break;
-        case LINE_LIST:      nIndices = 2 * nPrimitives; break;
-        case LINE_STRIP:     nIndices = nPrimitives + 1; break;
-        case TRIANGLE_LIST:  nIndices = 3 * nPrimitives; break;
-        case TRIANGLE_STRIP: nIndices = nPrimitives + 2; break;
-        case TRIANGLE_FAN:   nIndices = nPrimitives + 1; break;
-        default: nIndices = nPrimitives;
-    }
-	// allocate memory for lists
-    vertex    = new Vertex[nVertices];
-	index     = new short[nIndices];
-	attribute = new unsigned[nPrimitives];
-	// temporary allocation
-	IDeviceTexture** devTex = new IDeviceTexture*[nSubsets];
-	for (int i = 0; i < nSubsets; i++)
-		if (texture && texture[i])
-			devTex[i] = texture[i]->deviceTexture();
-		else
-			devTex[i] = NULL;
-	// create graphic representation
-    visual = CreateMesh(nSubsets, nPrimitives, nVertices, clr, devTex,
-	 antiAlias);
-	// finished with device texture addresses
-	delete [] devTex;
-	// initialize counters for sequential construction of the set of
-	// primitives from the constructors of the derived classes
-	nVertices = 0;
-	nIndices  = 0;
-	nSurfaces = 0;
-}
-
-// add adds the current object to the scene
-//
-void Object::add() {
-    
-    if (scene)
-        scene->add(this);
-    else
-        error("Object::00 Can\'t access the scene object");
-}
-
-// add constructs a surface from a pair of triangle primitives by adding
-// to the vertex, index and attribute lists
-//
-void Object::add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n) {
-
-    #if ZAXIS_DIRECTION == INTO_SCREEN
-    // order triangle vertices in clockwise arrangement
-    int v1, v2, v3, v4;
-    // add four vertices to describe the side
-    v1 = add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
-    v2 = add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
-    v3 = add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
-    v4 = add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
-    // add six indices to describe the two triangles 
-    add(v1);
-    add(v2);
-    add(v3);
-    add(v1);
-    add(v3);
-    add(v4);
-	// associates the two triangles with the surface
-	if (attribute) {
-		attribute[2 * nSurfaces]     = nSurfaces;
-		attribute[2 * nSurfaces + 1] = nSurfaces;
-		nSurfaces++;
-	}
-    #elif ZAXIS_DIRECTION == OUT_OF_SCREEN
-    // order triangle vertices in counter-clockwise arrangement
-    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
-    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
-    add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
-    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
-    add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
-    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
-    #endif
-}
-
-// add adds a Vertex to the list of vertices for the object
-//
-int Object::add(float x, float y, float z, float nx, float ny, 
- float nz, float tu, float tv) {
-
-	vertex[nVertices] = Vertex(x, y, z, nx, ny, nz, tu, tv);
-
-	return nVertices++;
-}
-
-// local returns the vector part of vertex i
-//
-Vector Object::local(int i) const {
-
-	return vertex[i].position();
-}
-
-// populateVB fills the vertex buffer at vb with vertex data
-//
-void Object::populateVB(void* vb) const {
-
-	Vertex* p = (Vertex*)vb;
-
-	for (int i = 0; i < nVertices; i++)
-		*p++ = vertex[i];
-}
-
-// populateIB fills the index buffer at ib with index data
-//
-void Object::populateIB(void* ib) const {
-
-	short* p = (short*)ib;
-
-	for (int i = 0; i < nIndices; i++)
-		*p++ = index[i];
-}
-
-// populateAB fills the attribute buffer at ab with index data
-//
-void Object::populateAB(void* ab) const {
-
-	unsigned* p = (unsigned*)ab;
-
-	for (int i = 0; i < nPrimitives; i++)
-		*p++ = attribute[i];
-}
-
-// add constructs a surface from a pair of triangle primitives by adding
-// to the vertex, index and attribute lists
-//
-void Object::add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n,
- int tu, int tv) {
-
-    #if ZAXIS_DIRECTION == INTO_SCREEN
-    // order triangle vertices in clockwise arrangement
-    int v1, v2, v3, v4;
-    // add four vertices to describe the side
-    v1 = add(p1.x, p1.y, p1.z, n.x, n.y, n.z,         0,         0);
-    v2 = add(p2.x, p2.y, p2.z, n.x, n.y, n.z,         0, (float)tv);
-    v3 = add(p3.x, p3.y, p3.z, n.x, n.y, n.z, (float)tu, (float)tv);
-    v4 = add(p4.x, p4.y, p4.z, n.x, n.y, n.z, (float)tu,         0);
-    // add six indices to describe the two triangles 
-    add(v1);
-    add(v2);
-    add(v3);
-    add(v1);
-    add(v3);
-    add(v4);
-	// associates the two triangles with the surface
-	if (attribute) {
-		attribute[2 * nSurfaces]     = nSurfaces;
-		attribute[2 * nSurfaces + 1] = nSurfaces;
-		nSurfaces++;
-	}
-    #elif ZAXIS_DIRECTION == OUT_OF_SCREEN
-    // order triangle vertices in counter-clockwise arrangement
-    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
-    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
-    add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
-    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
-    add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
-    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
-    #endif
-}
-
-// add adds a vertex number to the index list
-//
-void Object::add(int vertex) {
-
-	index[nIndices++] = vertex;
-}
-
-// add adds a texture to the object
-//
-void Object::add(ITexture* texture) {
-
-	if (texture)
-		visual->add(texture->deviceTexture());
-}
-
-Object::~Object() {
-
-    if (visual)
-        delete visual;
-    if (vertex)
-        delete [] vertex;
-	if (index)
-		delete [] index;
-    if (scene)
-        scene->remove(this);
-    else
-        error("Object::90 Can\'t access the Scene component");
-}
-
-//-------------------------------- Stock Shapes --------------------------
-//
-// Sphere is an Object identifiable by a radius and two tesselation 
-// parameters
-//
-IObject* CreateSphere(float radius, int slices, int stacks, Colour clr, 
- bool antiAlias) {
-
-	float dimension[1] = {radius};
-	int   partition[2] = {slices, stacks};
-	
-	return new Object(SPHERE, dimension, partition, clr, antiAlias);
-}
-
-// Cylinder is an Object identifiable by an upper radius, a lower radius
-// a height and two tesselation parameters 
-//
-IObject* CreateCylinder(float upper, float lower, float height, 
- int slices, int stacks, Colour clr, bool antiAlias) {
-	
-	float dimension[3] = {upper, lower, height};
-	int   partition[2] = {slices, stacks};
-
-	return new Object(CYLINDER, dimension, partition, clr, antiAlias);
-}
-
-// Torus is an Object identifiable by an inner radius, an outer radius
-// and two tesselation parameters 
-//
-IObject* CreateTorus(float inner, float outer, int slices, int stacks,
- Colour clr, bool antiAlias) {
-	
-	float dimension[2] = {inner, outer};
-	int   partition[2] = {slices, stacks};
-
-	return new Object(TORUS, dimension, partition, clr, antiAlias);
-}
-
-// Teapot is an Object that represents the Utah Teapot 
-//
-IObject* CreateTeapot(Colour clr, bool antiAlias) {
-
-	return new Object(TEAPOT, NULL, NULL, clr, antiAlias);
-}
-
-// XFile is an Object that is described in X-File format 
-//
-IObject* CreateXFile(const char* filename, bool antiAlias) {
-
-	return new Object(X_FILE, filename, antiAlias);
-}
-
-//-------------------------------- Box -------------------------------------
-//
-// Box is an Object identifiable by two points - lower close left, and
-// upper faraway right - and a colour
-//
-IObject* CreateBox(float minx, float miny, float minz, float maxx, 
- float maxy, float maxz, Colour c, ITexture* texture, int tu, int tv, 
- bool antiAlias) {
-
-	return new Box(minx, miny, minz, maxx, maxy, maxz, c, texture, tu, 
-	 tv, antiAlias);
-}
-
-IObject* CreateBox(float minx, float miny, float minz, float maxx, 
- float maxy, float maxz, Colour* c, ITexture** texture, int tu, int tv, 
- bool antiAlias) {
-
-	return new Box(minx, miny, minz, maxx, maxy, maxz, c, texture, tu,
-	 tv, antiAlias);
-}
-
-// constructor builds the Box from its two extreme points
-//
-Box::Box(float minx, float miny, float minz, float maxx, float maxy,
- float maxz, Colour c, ITexture* texture, int tu, int tv, bool antiAlias)
- : Object(TRIANGLE_LIST, 12, 24, c, texture, antiAlias) {
-
-    Vector p1 = Vector(minx, miny, ZAXIS_DIRECTION * minz),
-           p2 = Vector(minx, maxy, ZAXIS_DIRECTION * minz),
-           p3 = Vector(maxx, maxy, ZAXIS_DIRECTION * minz),
-           p4 = Vector(maxx, miny, ZAXIS_DIRECTION * minz),
-           p5 = Vector(minx, miny, ZAXIS_DIRECTION * maxz),
-           p6 = Vector(minx, maxy, ZAXIS_DIRECTION * maxz),
-           p7 = Vector(maxx, maxy, ZAXIS_DIRECTION * maxz),
-           p8 = Vector(maxx, miny, ZAXIS_DIRECTION * maxz);
-    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1), tu, tv); // front
-    add(p4, p3, p7, p8, Vector(1, 0,                    0), tu, tv); // right
-    add(p8, p7, p6, p5, Vector(0, 0, ZAXIS_DIRECTION *  1), tu, tv); // back
-    add(p6, p2, p1, p5, Vector(-1, 0,                   0), tu, tv); // left
-    add(p1, p4, p8, p5, Vector(0, -1,                   0), tu, tv); // bottom
-    add(p2, p6, p7, p3, Vector(0, 1,                    0), tu, tv); // top
-}
-
-// constructor builds the Box from its two extreme points
-//
-Box::Box(float minx, float miny, float minz, float maxx, float maxy,
- float maxz, Colour* c, ITexture** texture, int tu, int tv, 
- bool antiAlias) : Object(TRIANGLE_LIST, 12, 24, c, texture, 6, 
- antiAlias) {
-
-    Vector p1 = Vector(minx, miny, ZAXIS_DIRECTION * minz),
-           p2 = Vector(minx, maxy, ZAXIS_DIRECTION * minz),
-           p3 = Vector(maxx, maxy, ZAXIS_DIRECTION * minz),
-           p4 = Vector(maxx, miny, ZAXIS_DIRECTION * minz),
-           p5 = Vector(minx, miny, ZAXIS_DIRECTION * maxz),
-           p6 = Vector(minx, maxy, ZAXIS_DIRECTION * maxz),
-           p7 = Vector(maxx, maxy, ZAXIS_DIRECTION * maxz),
-           p8 = Vector(maxx, miny, ZAXIS_DIRECTION * maxz);
-    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1), tu, tv); // front
-    add(p4, p3, p7, p8, Vector(1, 0,                    0), tu, tv); // right
-    add(p8, p7, p6, p5, Vector(0, 0, ZAXIS_DIRECTION *  1), tu, tv); // back
-    add(p6, p2, p1, p5, Vector(-1, 0,                   0), tu, tv); // left
-    add(p1, p4, p8, p5, Vector(0, -1,                   0), tu, tv); // bottom
-    add(p2, p6, p7, p3, Vector(0, 1,                    0), tu, tv); // top
-}
-
-//-------------------------------------- Grid ------------------------------
-//
-// A Grid is a set of mutually perpendicular lines in a plane defined 
-// parallel to the x-y plane
-//
-IObject* CreateGrid(int min, int y, int max, int n, Colour clr, 
- bool antiAlias) {
-
-	return new Grid(min, y, max, n, clr, antiAlias);
-}
-
-Grid::Grid(int min, int y, int max, int n, Colour clr, bool antiAlias) : 
- Object(LINE_LIST, 2 * n, 4 * n, clr, NULL, antiAlias) {
-
-    int i, inc = (max - min) / (n - 1);
-    for (i = min; i <= max; i += inc) {
-        add(add((float)min, (float)y, (float)i, 0, 1, 0));
-        add(add((float)max, (float)y, (float)i, 0, 1, 0));
-        add(add((float)i, (float)y, (float)min, 0, 1, 0));
-        add(add((float)i, (float)y, (float)max, 0, 1, 0));
-    }
-}
-
-//-------------------------------- Terrain ---------------------------------
-//
-// A Terrain is an Object that consists of a grid of triangles where the
-// height of each vertex is specified using a height map
-//
-IObject* CreateTerrain(int cellSpacing, float depth, const char* heightMap, 
- ITexture* tFile) {
-
-    // open the height bitmap file
-    std::ifstream fp(heightMap, std::ios::in | std::ios::binary);
-
-    // garbage info
-    unsigned char  cjunk;
-    unsigned short sjunk;
-    unsigned int   djunk;
-
-    // useful info
-    unsigned int   width;     // width of the bitmap
-    unsigned int   height;    // height of the bitmap
-    unsigned short bitdepth;  // bit depth 1, 4, 8, 16, 24, 32
-    unsigned int   offset;    // offset to bitmap data in bytes
-
-    // read the file header
-    fp.read((char*)&(sjunk),  sizeof(sjunk));
-    fp.read((char*)&(djunk),  sizeof(djunk));
-    fp.read((char*)&(sjunk),  sizeof(sjunk));
-    fp.read((char*)&(sjunk),  sizeof(sjunk));
-    fp.read((char*)&(offset), sizeof(offset));
-
-    // read the info header
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(width),    sizeof(djunk));
-    fp.read((char*)&(height),   sizeof(djunk));
-    fp.read((char*)&(sjunk),    sizeof(sjunk));
-    fp.read((char*)&(bitdepth), sizeof(sjunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-    fp.read((char*)&(djunk),    sizeof(djunk));
-
-    // move to start of image - skip bytes if offset > 54
-    for (int i = 54; i < (int)offset; i++)
-        fp.read((char*)&(cjunk), sizeof(cjunk));
-
-    return new Terrain(fp, width, height, bitdepth, cellSpacing, depth, 
-	 tFile);
-}
-
-Terrain::Terrain(std::ifstream& fp, unsigned width, unsigned height, 
- unsigned bitdepth, int cellSpacing, float depth, ITexture* tFile) : 
- Object(TRIANGLE_LIST, 2 * (width - 1) * (height - 1), 
- 4 * (width - 1) * (height - 1), Colour(1, 1, 1, 1), tFile, true), 
- cols(width), rows(height), spacing(cellSpacing) {
-
-    // allocate space for reading one full scan line
-    unsigned depthInBytes = (unsigned) bitdepth / TERRAIN_CHAR_BIT;
-    unsigned bufferSize   = (unsigned)((width * bitdepth)
-     / float(TERRAIN_CHAR_BIT));
-    unsigned char* buffer = new (std::nothrow) unsigned char[bufferSize];
-
-    // compute the vertices from (rows, cols, spacing)
-	// and add each vertex to the list of vertices
-    float x, y, z = - 0.5f * (rows - 1) * spacing;
-    float uInc = 1.0f / (cols - 1), vInc = 1.0f / (rows - 1), u, v = 1.0f;
-    for (int i = 0; i < rows; i++) {
-        u = 0;
-        x = - 0.5f * (cols - 1) * spacing;
-        fp.read((char*)buffer, bufferSize);
-        for (int j = 0; j < cols; j++) {
-            y = depth * greyScale(buffer + depthInBytes * j, depthInBytes)
-             - depth * 0.5f;
-            // add vertex
-			add(x, y, z, 0, 1, 0, u, v);
-            x += spacing;
-            u += uInc;
-        }
-        z += spacing;
-        v -= vInc;
-    }
-    // de-allocate space
-    delete [] buffer;
-
-    // Compute the indices
-    int k = 0;
-    for (int i = 0; i < rows - 1; i++, k++) {
-        for (int j = 0; j < cols - 1; j++, k++) {
-            add(k);
-            add(k + cols);
-            add(k + cols + 1);
-            add(k);
-            add(k + cols + 1);
-            add(k + 1);
-        }
-    }
-
-		// define the bounding box for the terrain
-	float minx = 0.5f * (cols - 1) * spacing;
-	float miny = 0.5f * depth;
-	float minz = 0.5f * (rows - 1) * spacing;
-
-	//particle implementation
-
-	setBoundingBox(-minx, -miny, -minz, minx, miny, minz);
-}
-
-// greyScale returns the grey scale equivalent of the data at pixel
-// in the range [0.0f, 1.0f]
-//
-float Terrain::greyScale(void* pixel, unsigned int depthInBytes) {
-
-    int grey = HEIGHT_MAP_FLOOR * 100;
-    unsigned char* buffer = (unsigned char*) pixel;
-
-    switch (depthInBytes) {
-        case 1u:
-			error("Terrain 20:: 8 bit height mapping is not implemented");
-            break;
-        case 2u:
-			error("Terrain 21:: 16 bit height mapping is not implemented");
-            break;
-        case 3u:
-            // Pixel data stored in reverse order on file
-            struct {
-                unsigned char blue;
-                unsigned char green;
-                unsigned char red;
-            } p;
-            memcpy((char*)&p, buffer, 3);
-            // there is no unique formula for converting from
-            // rgb to grayscale - a common one is
-            // .30 * r + .59 * g + .11 * b
-            // here, we do not compensate for g predominance
-            // but use even weighting
-            grey = 33 * p.red + 33 * p.green + 33 * p.blue;
-            if (grey < HEIGHT_MAP_FLOOR * 100)
-               grey = HEIGHT_MAP_FLOOR * 100;
-            break;
-        case 4u:
-			error("Terrain 22:: 32 bit height mapping is not implemented");
-            break;
-    }
-
-    return grey / 25500.f; // 255 * 100 => value in range [0.0f, 1.0f]
-}
-
-// align aligns the traversing object with the terrain by retrieving
-// the elevation of the terrain corresponding to the new position of
-// the object where delx and delz define its movements in the world x
-// and z directions respectively, by orienting the object in the
-// direction of its movement with respect to the world y axis, and
-// by inclining the object so that it moves along the face of its
-// host triangle within the terrain.
-// This function does not alter the position or orientation of the
-// object if the values of the movement parameters place the object
-// at or beyond the boundary of the terrain
-//
-void Terrain::align(IObject* object, float delx, float delz, ICameras* camera) const {
-	float tempz=delz * 3;
-	float tempx=delx * 3;
-
-    Frame* frame = (Frame*)object;
-	float dx, dz, dely, slope, mPath, mTrrn, denom;
-    Vector n, heading(0), centre = position();
-
-    // retrieve the position of the traversing object
-    Vector position = object->position();
-	// update the x and z componwents of the position
-	// the y component is determined below
-    position.x += delx;
-    position.z += delz;
-
-
-    // determine row, column indices corresponding to the new position
-    int i = int((position.x - centre.x) / spacing + (cols - 1) / 2.0f); //ü ġ  ׷ ġ  ̽  .
-    int j = int((position.z - centre.z) / spacing + (rows - 1) / 2.0f);
-
-    // ensure that traversing object is within the terrain boundaries
-    if (i >= BORDER && i < cols - BORDER && j >= BORDER && j < rows -
-		BORDER) {
-        // determine the world coordinates of the
-        // corners of the quad that contains (x,z)
-        Vector aa = local(cols * j + i) * world();
-        Vector ab = local(cols * (j + 1) + i) * world();
-        Vector bb = local(cols * (j + 1) + i + 1) * world();
-        Vector ba = local(cols * j + i + 1) * world();
-
-        // determine the quad triangle that contains the current position
-        if (abs(bb.x - aa.x) > TINY_VALUE && position.z > (bb.z - aa.z)
-         * (position.x - aa.x) / (bb.x - aa.x) + aa.z || abs(bb.x - aa.x)
-		 <= TINY_VALUE && position.x < aa.x && bb.z > aa.z) {
-            // x, z lies within the triangle aa-ab-bb
-            //
-            // determine interpolation factors with respect to ab
-            dx = (position.x - ab.x) / (bb.x - ab.x);
-            dz = (position.z - ab.z) / (aa.z - ab.z);
-            // interpolate to find the elevation of the updated position
-            dely = ab.y + dx * (bb.y - ab.y) + dz * (aa.y - ab.y) +
-			 CLEARANCE - position.y;
-            //
-            // determine normal to the plane of the host triangle
-            n = - normal(cross(bb - ab, ab - aa));
-            // find inclination axis in the plane and angle of inclination
-            if (abs(delx) > TINY_VALUE || abs(delz) > TINY_VALUE) {
-                // find point xp, yp, zp along path of traversing object
-                if (abs(delx) > TINY_VALUE && abs(delz) > TINY_VALUE) {
-                    // find intersection of the path with ab-bb
-                    mPath = delz / delx;
-                    mTrrn = (bb.z - ab.z) / (bb.x - ab.x);
-                    denom = mPath - mTrrn;
-                    slope = (bb.y - ab.y) / (bb.x - ab.x);
-                    heading.x = (ab.z - aa.z - mTrrn * (ab.x - aa.x)) / denom;
-                    heading.y = slope * (heading.x - ab.x + aa.x) + ab.y - aa.y;
-                    heading.z = mPath * heading.x;
-                }
-                else if (abs(delx) < TINY_VALUE) {
-                    // path is perpendicular to ab-bb
-                    heading.x = ab.x - aa.x;
-                    heading.y = ab.y - aa.y;
-                    heading.z = ab.z - aa.z;
-                }
-                else {
-                    // path is parallel to ab-bb
-                    heading.x = bb.x - ab.x;
-                    heading.y = bb.y - ab.y;
-                    heading.z = bb.z - ab.z;
-                }
-            }
-        }
-        else {
-            // x,z lies within the triangle aa-bb-ba
-            //
-            // determine interpolation factors with respect to ba
-            dx = (position.x - ba.x) / (aa.x - ba.x);
-            dz = (position.z - ba.z) / (bb.z - ba.z);
-            // interpolate to find new elevation of the updated position
-            dely = ba.y + dx * (aa.y - ba.y) + dz * (bb.y - ba.y) + 
-			 CLEARANCE - position.y;
-            //
-            // determine normal to the plane of the host triangle
-            n = - normal(cross(ba - aa, bb - ba));
-            // find inclination axis in the plane and angle of inclination
-            if (abs(delx) > TINY_VALUE || abs(delz) > TINY_VALUE) {
-                // find point xp, zp along path of traversing object
-                if (abs(delx) > TINY_VALUE && abs(delz) > TINY_VALUE) {
-                    // find intersection of path with aa-ba
-                    mPath = delz / delx;
-                    mTrrn = (ba.z - aa.z) / (ba.x - aa.x);
-                    denom = mPath - mTrrn;
-                    slope = (ba.y - aa.y) / (ba.x - aa.x);
-                    heading.x = (bb.z - ba.z - mTrrn * (bb.x - ba.x)) / denom;
-                    heading.y = slope * (heading.x - bb.x + ba.x) + bb.y - ba.y;
-                    heading.z = mPath * heading.x;
-               }
-                else if (abs(delx) < TINY_VALUE) {
-                    // path is perpendicular to aa-ba
-                    heading.x = bb.x - ba.x;
-                    heading.y = bb.y - ba.y;
-                    heading.z = bb.z - ba.z;
-                }
-                else {
-                    // path is parallel to aa-ba
-                    heading.x = ba.x - aa.x;
-                    heading.y = ba.y - aa.y;
-                    heading.z = ba.z - aa.z;
-				}
-            }
-		}
-
-        // move the traversing object to its new position
-		
-	//	Vector carHead = normal(camera->heading());
-
-	//	delx *= carHead.z;
-//		////dely *= carHead.y;
-	//	delz *= carHead.z;
-		
-		//Vector head, up, right;
-
-		//	
-		//	head = normal(camera->heading()); 
-		//	up = normal(camera->top());     
-		//	right = cross(up, head);
-
-		//	delz *= camera->heading().z;
-		//	delx = right.x
-
-		
-
-//		object->move(delx, dely, delz);
-
-
-		// restore previous orientation
-		//Matrix before = frame->restore();
-		//// determine instantaneous orientation of traversing
-		//// object with resepct to its supporting triangle and
-		//// average previous and current to suppress choppiness
-		//n = normal(Vector(before.m21, before.m22, before.m23) + n);
-		//Vector z = normal(Vector(before.m31, before.m32, before.m33) + heading);
-		//Vector x = cross(n, z);
-
-		//
-
-		//Matrix orientation(x.x, x.y, x.z, 0,
-		//	               n.x, n.y, n.z, 0,
-		//				   z.x, z.y, z.z, 0,
-		//				     0,   0,   0, 1);
-		//// orient the traversing object with 
-		//// respect to its supporting triangle
-		//frame->orient(orientation);
-		//frame->save(orientation);
-		
-
-		Vector h, u, r;
-
-			
-			h = -normal(camera->heading()); //to make look at opposite of my camera //basically this object looks at me, so I reverse it
-
-			
-			u = normal(camera->top());     
-			r = cross(u, h);
-
-		//Matrix rot(r.x, r.y, r.z, 0, 
-		//       u.x, u.y, u.z, 0, 
-		//	   h.x, h.y, h.z, 0, 
-		//	     0,   0,   0, 1);
-	
-	/*		Matrix rot(0, 0, 0, 0, 
-		       0, 0, 0, 0, 
-			   0, 0, 0, 0, 
-			     0,   0,   0, 1);*/
-
-//   vecHead.x,  dely,  vecHead.z, 1);
-//			Vector vecHead = camera->heading();		
-//			vecHead *= 3;
-
-			Vector vecHeads = normal(camera->heading());
-			Vector vecTop = normal(camera->top());
-			Vector vecRight = cross(vecTop, vecHeads);
-			
-			vecHeads *= tempz; //delx, delz ϸ û 
-			vecRight *= tempx;
-		/*
-		Matrix rot(r.x, r.y, r.z, 0, 
-		       u.x, u.y, u.z, 0, 
-		   h.x, h.y, h.z, 0, 
-		   vecHeads.x + vecRight.x,  0,  vecHeads.z + vecRight.z, 1);
-	*/
-
-	object->move(0, dely, 0);
-
-	Matrix rot(r.x, r.y, r.z, 0, 
-		       u.x, u.y, u.z, 0, 
-		   h.x, h.y, h.z, 0, 
-		   vecHeads.x + vecRight.x,  0,  vecHeads.z + vecRight.z, 1);
-
-
-
-		frame->orient(rot); 
-		frame->save(rot);
-		
-	}
-}
-
-//-------------------------------- Billboard ------------------------------
-//
-// Billboard is a two dimensional rectangle that always faces the current
-// camera 
-//
-IObject* CreateBillboard(Orientation orient, ICameras* cs, float minx, 
- float miny, float maxx, float maxy, Colour c, ITexture* texture) {
-	
-	return new Billboard(orient, cs, minx, miny, maxx, maxy, c, texture);
-}
-
-Billboard::Billboard(Orientation orient, ICameras* cs, float minx, 
- float miny, float maxx, float maxy, Colour c, ITexture* texture) : 
- cameras(cs), type(orient),
- Object(TRIANGLE_LIST, 2, 4, c, texture, false) {
-
-//Object::Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
-// ITexture* texture, bool antiAlias) : 
-
-    Vector p1 = Vector(minx, miny, 0),
-           p2 = Vector(minx, maxy, 0),
-           p3 = Vector(maxx, maxy, 0),
-           p4 = Vector(maxx, miny, 0);
-
-    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1)); 
-}
-
-// orient orients the billboard so that its normal is parallel to the
-// direction from the billboard to the camera
-//
-void Billboard::orient() {
-
-	Vector h, u, r, p = position();
-	switch (type) {
-		case SCREEN:
-			h = normal(cameras->heading()); 
-			u = normal(cameras->top());     
-			r = cross(u, h);
-			break;
-		case VIEW_PLANE:
-			h = normal(cameras->heading()); // fixed
-			u = Vector(0, 1, 0);
-			r = cross(u, h);
-			u = cross(h, r);
-			break;
-		case VIEWPOINT:
-			h = normal(p - cameras->position()); // fixed
-			u = Vector(0, -1, 0);
-			r = cross(u, h);
-			u = cross(h, r);
-			break;
-		case AXIAL:
-			h = normal(p - cameras->position());
-			u = Vector(0, 1, 0); // fixed
-			r = cross(u, h);
-			h = cross(h, r);
-			break;
-	}
-	Matrix rot(r.x, r.y, r.z, 0, 
-		       u.x, u.y, u.z, 0, 
-			   h.x, h.y, h.z, 0, 
-			     0,   0,   0, 1);
-	Frame::orient(rot); 
-}
-
-//-------------------------------- Vertex ---------------------------------
-//
-// Vertex holds all of the data that describes a vertex
-//
-Vertex::Vertex(float xx, float yy, float zz, float nxx, float nyy,
- float nzz, float ttu, float ttv) {
-
-    x = xx;
-    y = yy;
-    z = zz;
-    nx = nxx;
-    ny = nyy;
-    nz = nzz;
-    tu = ttu;
-    tv = ttv;
-}
-
-// position returns the vector that defines the position of the vertex
-//
-Vector Vertex::position() const {
-
-	return Vector(x, y, z);
-}
-
-//-------------------------------- Texture -------------------------------
-//
-// Texture manages a texture for a set of objects
-//
-ITexture* CreateTexture(const char* file, unsigned flags) { 
-
-	return new Texture(file, flags, Colour());
-}
-
-ITexture* CreateTexture(const char* file, unsigned flags, Colour brdrClr) { 
-
-	return new Texture(file, flags, brdrClr);
-}
-
-IScene* Texture::scene = NULL;
-
-// constructor adds a pointer to the texture to the scene and
-// creates the graphics card representation of the texture
-//
-Texture::Texture(const char* file, unsigned flags, Colour brdrClr) {
-
-	if (scene)
-		scene->add(this);
-	else
-		error("Texture 00: Couldn\'t access the scene object");
-
-	deviceTexture_ = CreateDeviceTexture(file, flags, brdrClr);
-}
-
-// destructor deletes the graphics card representation and removes the pointer to the
-// texture from the scene
-//
-Texture::~Texture() {
-
-	deviceTexture_->Delete();
-	if (scene)
-		scene->remove(this);
-	else
-		error("Texture 90:: Couldn\'t access the scene object");
-}
-
-
-
+/* Scene Module Implementation
+ *
+ * Scene.cpp
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include <fstream>
+#include <emmintrin.h>     // for SSE2 intrinsics
+#include <cstring>         // for strlen, memcpy, memcmp
+#include <cstdio>          // for sprintf, remove
+#include <cctype>          // for tolower
+#include <new>             // for std::nothrow
+using namespace std;
+#include "IInput.h"        // for Keyboard, Mouse, Joystick interfaces
+#include "IAudio.h"        // for Audio and Sound interfaces
+#include "ICameras.h"      // for Camera
+#include "IHUD.h"          // for HUD and Text interfaces
+#include "IGraphicsCard.h" // for Graphic and DeviceTexture interfaces
+#include "ModelSettings.h" // for FLOOR, MOUSE_BUTTON_SCALE, ROLL_SPEED
+#include "UISettings.h"    // for HUD_SPRITE_IMAGE
+#include "Utilities.h"     // for error()
+#include "MeshOptimizer.h" // for the mesh optimization functions
+#include "MeshLoader.h"    // for loadMesh, releaseMesh, MeshData
+#include "TextureBaker.h"  // for the baked data functions
+#include "Files.h"         // for MappedFile, fileStamp, tempName, replaceFile
+#include "Atlas.h"         // for Atlas
+#include "TextureCache.h"  // for the keys of the texture cache
+#include "HeightMap.h"     // for HeightMap, readHeightMap, convertScanLine
+#include "Scene.h"         // for Scene, Object, Box, SoundBox, Grid,
+                           // Vertex, Texture class declarations
+
+//-------------------------------- Scene ---------------------------------
+//
+// Scene manages the scene component of the model
+//
+IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, IAudio* a, 
+ IHUD* h, ICameras* c) {
+
+	return new Scene(k, m, j, a, h, c);
+}
+
+Scene::Scene(IKeyboard* k, IMouse* m, IJoystick* j, IAudio* a, IHUD* h, ICameras* c) :
+ keyboard(k), mouse(m), joystick(j), audio(a), hud(h), cameras(c) {
+
+	drawn       = NULL;
+	sphere      = NULL;
+	sorted      = NULL;
+	owner       = NULL;
+	sortedOwner = NULL;
+	cell        = NULL;
+	capacity    = 0;
+	nDrawn      = 0;
+	nCulled     = 0;
+
+	background         = NULL;
+	backgroundTopLeftX = 0;
+	backgroundWidth    = BACKGROUND_WIDTH;
+	backgroundRatio    = (float) BACKGROUND_HEIGHT / BACKGROUND_WIDTH;
+
+	/* ³»²¯ */
+	tree = NULL;
+
+    heroX  = NULL;
+    heroY  = NULL;
+    heroZ  = NULL;
+	heroPos = NULL;
+	culling = NULL;
+
+    lastUpdate     = 0;
+	Object::scene  = this;
+	Texture::scene = this;
+
+	//particle implementation
+	/* you can't get particle system pointer address here.
+	because of that, the first particle system initialization is done in Display::setup.
+	if you try to receive a pointer to particle system here, it means that you will receive a NULL pointer.
+	Look at the Game::setup() and see the Order.
+	*/
+	
+	
+}
+
+// add adds a pointer to Object *o to the scene, stores the handle that
+// identifies it in the object and returns true if successful, false 
+// otherwise
+//
+bool Scene::add(IObject* o) {
+
+	Object* obj = static_cast<Object*>(o);
+	if (object.contains(obj->handle))
+		return false;
+	obj->handle = object.add(o);
+
+    return obj->handle != NO_HANDLE;
+}
+
+// add adds a pointer to ITexture *t to the scene, stores the handle that
+// identifies it in the texture and returns true if successful, false 
+// otherwise
+//
+bool Scene::add(ITexture* t) {
+
+	Texture* tex = static_cast<Texture*>(t);
+	if (texture.contains(tex->handle))
+		return false;
+	tex->handle = texture.add(t);
+
+    return tex->handle != NO_HANDLE;
+}
+
+// setup creates the objects and textures in the initiale scene
+//
+bool Scene::setup(int now) {
+
+    lastUpdate = now;
+
+	
+
+	// create colours
+	Colour white(1, 1, 1, 1);
+	Colour black(0, 0, 0, 1);
+	Colour clr919(0.9f, 0.1f, 0.9f, 1);
+	Colour clr118(0.1f, 0.1f, 0.8f, 1);
+	Colour clr181(0.1f, 0.8f, 0.1f, 1);
+	Colour clr111(0.1f, 0.1f, 0.1f, 1);
+	Colour clr881(0.8f, 0.8f, 0.1f, 1);
+	Colour clr199(0.1f, 0.9f, 0.9f, 1);
+	Colour clr631(0.6f, 0.3f, 0.1f, 1);
+	Colour clr361(0.3f, 0.6f, 0.1f, 1);
+	Colour clr136(0.1f, 0.3f, 0.6f, 1);
+	Colour clr168(0.1f, 0.6f, 0.8f, 1);
+	Colour clr668(0.6f, 0.6f, 0.8f, 1);
+	Colour clr821(0.8f, 0.2f, 0.1f, 1);
+	Colour clr861(0.8f, 0.6f, 0.1f, 1);
+	Colour clt136(1.0f, 1.0f, 1.0f, 0);
+	Colour red(1, 0, 0, 1);
+	Colour grey(0.7f, 0.7f, 0.7f, 1);
+
+	// pack the small textures of the billboards, the particles and the
+	// hud into shared atlas pages, so that the trees, the particles and
+	// the hud sample one texture
+	const char* sprites[] = {"tree01S.dds", GUN_PARTICLE_IMAGE, 
+	 SNOW_PARTICLE_IMAGE, HUD_SPRITE_IMAGE};
+	Atlas::build(sprites, sizeof sprites / sizeof sprites[0]);
+
+	tree = CreateTexture("tree01S.dds"); //tree environment
+
+	// create textures
+	background = CreateTexture(BACKGROUND);
+
+    // initial objects
+	Colour clr[] = {clr919, clr181, clr118, clr881, clr111, clr199}; 
+
+	sun = CreateSphere(30.0f, 20, 20, red); 
+    sun->move(-500, 500, 0);
+
+	moon = CreateSphere(30.0f, 20, 20, grey); 
+    moon->move(500, -500, 0);
+
+	// put trees on the plate - each object adds itself to the scene; the
+	// trees are instances of one billboard, scaled to their sizes, so
+	// that they share its quad and draw with one call
+	IObject* trunk = CreateBillboard(VIEWPOINT, cameras, -50, -50, 50, 50,
+	 clt136, tree);
+	trunk->move(-100, 30, 200);
+
+	IObject* copy = CreateInstance(trunk);
+	copy->scale(1, 1.5f, 1);
+	copy->move(-310, 5, -255);
+
+	copy = CreateInstance(trunk);
+	copy->scale(0.75f, 0.75f, 0.75f);
+	copy->move(110, 42.5f, -150);
+
+	copy = CreateInstance(trunk);
+	copy->scale(1.25f, 1.25f, 1.25f);
+	copy->move(450, 17.5f, 220);
+
+
+	mainHero = CreateXFile("cannonS.x");
+	mainHero->scale(0.3f, 0.3f, 0.3f);
+
+	
+	
+	mainHero->move(0, 0, 0);
+
+    // Terrain and hero objects
+    //
+	ITexture* terrainTexture = CreateTexture("terrain2.bmp");
+    terrain = CreateTerrain(4, 50, "heightmap.bmp", terrainTexture);
+    terrain->move(0, FLOOR + 20, 100);
+
+
+	Vector eye(100, 100, 200), heading(0, 0, -1), up(0, 1, 0);
+	heroCamera = CreateCamera(eye, heading, up, mainHero, SECOND_PERSON);
+
+	heroCamera->attach(mainHero, false);
+	cameras->setCamera(heroCamera, true);
+
+
+
+
+    terrain->align(mainHero, 0, 1, cameras);
+
+    heroX = CreateText(0, 0.30f, 1, 0.47f);
+    heroY = CreateText(0, 0.37f, 1, 0.54f);
+    heroZ = CreateText(0, 0.44f, 1, 0.61f);
+    heroPos = CreateText(0, 0.51f, 1, 0.68f);
+    culling = CreateText(0, 0.58f, 1, 0.75f);
+
+    return true;
+}
+
+// update updates the position and orientation of each object for time "now"
+// according to the keys pressed
+//
+void Scene::update(int now) {
+
+    int delta;
+    int dr = 0;  // roll the right box around its x axis
+    int ds = 0;  // spin the right box around its y axis
+    int dt = 0;  // roll the top   box around its z axis
+	float df = 0;      // move hero along x direction
+	float dg = 0;      // move hero along y direction
+	int   joy_x = 0,     // joystick x-axis: turn left/right
+          joy_y = 0,     // joystick y-axis: advance/retreat
+          joy_z = 0,     // joystick z-axis: turn up/down
+          joy_rz = 0;    // joystick rz-axis:
+	static int dw = 1; // direction control on hero
+
+    delta = now - lastUpdate;
+    lastUpdate = now;
+
+	#if GRAPHICS_API != HEADLESS
+	::ParticleSystemAddress(ps);
+	#endif
+
+	// turn the billboards towards the camera and move the objects that
+	// are in motion
+	Components::face();
+	Components::integrate(delta * 0.001f);
+
+    // joystick input rotates the camera
+    joystick->handle(joy_x, joy_y, joy_z, joy_rz);
+
+
+
+	
+	switch(cameras->returnType()) {
+		case SECOND_PERSON:
+			if (keyboard->pressed('D'))
+				dg += delta;
+			if (keyboard->pressed('A'))
+				dg -= delta;
+			if (keyboard->pressed('S'))
+				df -= delta;
+			if (keyboard->pressed('W'))
+				df += delta;
+
+			if (joy_y)
+				 df += -joy_y;
+		    if (joy_x)
+				 dg -= -joy_x;
+
+			#if GRAPHICS_API != HEADLESS
+			if(mouse->pressed(LEFT_BUTTON)) {
+				ps[0]->addParticle(); //particle implementation
+			}
+			#endif
+
+			break;
+
+
+		case THIRD_PERSON:
+			if (keyboard->pressed(NUM6))
+				dg += delta;
+			if (keyboard->pressed(NUM4))
+				dg -= delta;
+			if (keyboard->pressed(NUM5))
+				df -= delta;
+			if (keyboard->pressed(NUM8))
+				df += delta;
+			break;
+
+		default:
+			break;
+	}
+
+	sun->planetRotate(CONSTANT_ROLL * 2);
+	moon->planetRotate(CONSTANT_ROLL * 2);
+
+
+
+    if (hud->isOn()) {
+        char str[MAX_CHAR + 1];
+        Vector v;
+        v = mainHero->orientation('x');
+        sprintf(str, "Hero x orientation %d, %d, %d", 
+         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
+        heroX->set(str);
+        v = mainHero->orientation('y');
+        sprintf(str, "Hero y orientation %d, %d, %d", 
+         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
+        heroY->set(str);
+        v = mainHero->orientation('z');
+        sprintf(str, "Hero z orientation %d, %d, %d", 
+         (int)(100 * v.x), (int)(100 * v.y), (int)(100 * v.z));
+        heroZ->set(str);
+		v = mainHero->position();
+        sprintf(str, "Hero position %d, %d, %d", 
+         (int)(v.x), (int)(v.y), (int)(v.z));
+        heroPos->set(str);
+        sprintf(str, "Objects drawn %d, culled %d", nDrawn, nCulled);
+        culling->set(str);
+    }
+
+	// zoom into the background image for the scene 
+	//
+	backgroundTopLeftX += delta * BACKGROUND_SPEED;
+	if ((int)backgroundTopLeftX > BACKGROUND_TOP_LEFT_XMAX)
+		backgroundTopLeftX = 0;
+
+    // move the hero across the terrain
+	if (terrain && mainHero && (dg || df)) {
+		terrain->align(mainHero, dg * dw * MOVE_SPEED, df * dw * MOVE_SPEED, cameras);
+	}
+
+	// force feedback
+	//
+	if (joystick->pressed(BUTTON_5))
+		joystick->applyForce(0);
+
+
+		#if GRAPHICS_API != HEADLESS
+		ps[0]->update(delta*0.001f); //particle implementation
+		ps[1]->update(delta*0.01f);
+		#endif
+}
+
+// select lets each object in the scene select the parts of itself to
+// be drawn for the current viewpoint, viewing frustum and number of
+// pixels per unit of projected size at unit distance
+//
+void Scene::select(const Vector& viewpoint, const Frustum& frustum, 
+ float lodScale) {
+
+    for (int i = 0; i < object.size(); i++)
+        object[i]->select(viewpoint, frustum, lodScale);
+
+	cull(frustum);
+}
+
+// reserve ensures that the culling arrays hold at least n objects
+//
+void Scene::reserve(int n) {
+
+	if (n > capacity) {
+		delete [] drawn;
+		delete [] sphere;
+		delete [] sorted;
+		delete [] owner;
+		delete [] sortedOwner;
+		delete [] cell;
+		capacity    = n > 2 * capacity ? n : 2 * capacity;
+		drawn       = new bool[capacity];
+		sphere      = new Sphere[capacity];
+		sorted      = new Sphere[capacity];
+		owner       = new int[capacity];
+		sortedOwner = new int[capacity];
+		cell        = new int[capacity];
+	}
+}
+
+// cull flags the objects that lie at least partly within the viewing
+// frustum - objects without bounds are always drawn.  Once there are more
+// than CULL_GRID_OBJECTS bounded objects, their spheres are bucketed into
+// a grid in the x-z plane and whole cells are accepted or rejected before
+// the spheres in straddling cells are tested
+//
+void Scene::cull(const Frustum& frustum) {
+
+	reserve(object.size());
+
+	// gather the bounding spheres in world space
+	int n = 0;
+	for (int i = 0; i < object.size(); i++) {
+		Vector c;
+		float  r;
+		drawn[i] = true;
+		if (static_cast<Object*>(object[i])->bound(c, r)) {
+			sphere[n].x = c.x;
+			sphere[n].y = c.y;
+			sphere[n].z = c.z;
+			sphere[n].r = r;
+			owner[n++]  = i;
+		}
+	}
+
+	if (n <= CULL_GRID_OBJECTS)
+		cull(frustum, sphere, owner, n);
+	else {
+		// size the grid to hold about CULL_CELL_OBJECTS spheres per cell
+		float minx = sphere[0].x, maxx = minx;
+		float minz = sphere[0].z, maxz = minz;
+		for (int k = 1; k < n; k++) {
+			if (sphere[k].x < minx) minx = sphere[k].x;
+			if (sphere[k].x > maxx) maxx = sphere[k].x;
+			if (sphere[k].z < minz) minz = sphere[k].z;
+			if (sphere[k].z > maxz) maxz = sphere[k].z;
+		}
+		int side = (int)sqrtf((float)n / CULL_CELL_OBJECTS);
+		if (side < 1)
+			side = 1;
+		else if (side > MAX_SIDE)
+			side = MAX_SIDE;
+		int   nCells = side * side;
+		float fx     = side / (maxx - minx + 1.0f);
+		float fz     = side / (maxz - minz + 1.0f);
+
+		// count the spheres in each cell and bound each cell
+		for (int c = 0; c <= nCells; c++)
+			start[c] = 0;
+		// a coordinate at the far bound can round up to side in float,
+		// so the row and column are clamped to the grid
+		for (int k = 0; k < n; k++) {
+			const Sphere& s = sphere[k];
+			int row = (int)((s.z - minz) * fz);
+			int col = (int)((s.x - minx) * fx);
+			row = row < 0 ? 0 : row >= side ? side - 1 : row;
+			col = col < 0 ? 0 : col >= side ? side - 1 : col;
+			int c = row * side + col;
+			Vector l(s.x - s.r, s.y - s.r, s.z - s.r);
+			Vector h(s.x + s.r, s.y + s.r, s.z + s.r);
+			if (!start[c + 1]++) {
+				lo[c] = l;
+				hi[c] = h;
+			}
+			else {
+				if (l.x < lo[c].x) lo[c].x = l.x;
+				if (l.y < lo[c].y) lo[c].y = l.y;
+				if (l.z < lo[c].z) lo[c].z = l.z;
+				if (h.x > hi[c].x) hi[c].x = h.x;
+				if (h.y > hi[c].y) hi[c].y = h.y;
+				if (h.z > hi[c].z) hi[c].z = h.z;
+			}
+			cell[k] = c;
+		}
+
+		// bucket the spheres by cell - start[c] ends up at the first
+		// sphere of cell c + 1, which is then shifted back into place
+		for (int c = 0; c < nCells; c++)
+			start[c + 1] += start[c];
+		for (int k = 0; k < n; k++) {
+			int j = start[cell[k]]++;
+			sorted[j]      = sphere[k];
+			sortedOwner[j] = owner[k];
+		}
+		for (int c = nCells; c > 0; c--)
+			start[c] = start[c - 1];
+		start[0] = 0;
+
+		// reject or accept whole cells and test the spheres in the cells
+		// that straddle the frustum
+		for (int c = 0; c < nCells; c++) {
+			int first = start[c], count = start[c + 1] - first;
+			if (count) {
+				switch (classify(frustum, lo[c], hi[c])) {
+					case -1:
+						for (int k = first; k < first + count; k++)
+							drawn[sortedOwner[k]] = false;
+						break;
+					case 0:
+						cull(frustum, sorted + first, sortedOwner + first,
+						 count);
+						break;
+				}
+			}
+		}
+	}
+
+	nDrawn = 0;
+	for (int i = 0; i < object.size(); i++)
+		if (drawn[i])
+			nDrawn++;
+	nCulled = object.size() - nDrawn;
+}
+
+// cull tests the n bounding spheres at s against the planes of the
+// viewing frustum four at a time and flags object who[k], which sphere k
+// bounds, as drawn if the sphere lies at least partly inside the frustum
+//
+void Scene::cull(const Frustum& frustum, const Sphere* s, const int* who,
+ int n) {
+
+	__m128 px[6], py[6], pz[6], pd[6];
+	for (int p = 0; p < 6; p++) {
+		px[p] = _mm_set1_ps(frustum.plane[p].n.x);
+		py[p] = _mm_set1_ps(frustum.plane[p].n.y);
+		pz[p] = _mm_set1_ps(frustum.plane[p].n.z);
+		pd[p] = _mm_set1_ps(frustum.plane[p].d);
+	}
+
+	int k = 0;
+	for (; k + 4 <= n; k += 4) {
+		// transpose four spheres into x, y, z and r registers
+		__m128 x = _mm_loadu_ps(&s[k].x);
+		__m128 y = _mm_loadu_ps(&s[k + 1].x);
+		__m128 z = _mm_loadu_ps(&s[k + 2].x);
+		__m128 r = _mm_loadu_ps(&s[k + 3].x);
+		_MM_TRANSPOSE4_PS(x, y, z, r);
+		// a sphere is outside if its centre lies further than its radius
+		// behind any one plane
+		__m128 nr  = _mm_sub_ps(_mm_setzero_ps(), r);
+		__m128 out = _mm_setzero_ps();
+		for (int p = 0; p < 6; p++) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x),
+			 _mm_mul_ps(py[p], y)), _mm_add_ps(_mm_mul_ps(pz[p], z), pd[p]));
+			out = _mm_or_ps(out, _mm_cmplt_ps(d, nr));
+		}
+		int mask = _mm_movemask_ps(out);
+		for (int j = 0; j < 4; j++)
+			drawn[who[k + j]] = !(mask & (1 << j));
+	}
+	for (; k < n; k++) {
+		Vector c(s[k].x, s[k].y, s[k].z);
+		bool in = true;
+		for (int p = 0; p < 6 && in; p++)
+			in = dot(frustum.plane[p].n, c) + frustum.plane[p].d >= -s[k].r;
+		drawn[who[k]] = in;
+	}
+}
+
+// drawBackground draws the background image for the scene
+//
+void Scene::drawBackground() {
+
+	if (background) {
+		IDeviceTexture* deviceTexture;
+		deviceTexture = background->deviceTexture();
+		if (deviceTexture)
+			deviceTexture->draw((int)backgroundTopLeftX, 
+			 (int)(backgroundTopLeftX * backgroundRatio),
+			 (int)(backgroundWidth  - 2 * backgroundTopLeftX),
+			 (int)((backgroundWidth - 2 * backgroundTopLeftX) * backgroundRatio));
+	}
+}
+
+// drawOpaque draws the graphic representations of the objects in the
+// scene that are opaque
+//
+void Scene::drawOpaque() {
+
+	IGraphic* graphic;
+    for (int i = 0; i < object.size(); i++) {
+        graphic = object[i]->graphic();
+        if (graphic && graphic->opaque() && visible(i))
+            graphic->draw(object[i]);
+    }
+}
+
+// drawTranslucent draws the graphic representations of the objects in
+// the scene that are translucent
+//
+void Scene::drawTranslucent() {
+
+    IGraphic* graphic;
+    for (int i = 0; i < object.size(); i++) {
+        graphic = object[i]->graphic();
+        if (graphic && !graphic->opaque() && visible(i))
+            graphic->draw(object[i]);
+    }
+}
+
+// suspend suspends the graphical representation of each object - the
+// textures are in the managed pool and survive the loss of the device
+//
+void Scene::suspend() {
+
+    IGraphic* graphic;
+    for (int i = 0; i < object.size(); i++) {
+        graphic = object[i]->graphic();
+        if (graphic) graphic->suspend(); 
+    }
+}
+
+// restore re-initializes the time of the last update
+//
+bool Scene::restore(int now) {
+
+    lastUpdate = now;
+
+    return true;
+}
+
+// remove removes the pointer to IObject *o from the scene and
+// returns true if successful, false otherwise
+//
+bool Scene::remove(IObject* o) {
+
+    return object.remove(static_cast<Object*>(o)->handle);
+}
+
+// remove removes the pointer to ITexture *t from the scene and
+// returns true if successful, false otherwise
+//
+bool Scene::remove(ITexture* t) {
+
+    return texture.remove(static_cast<Texture*>(t)->handle);
+}
+
+// destructor deletes all of the objects in the scene
+//
+Scene::~Scene() {
+
+	// each object removes itself from the scene as it is deleted, so
+	// the last object is always the next one to delete
+    for (int i = object.size() - 1; i >= 0; i--)
+        if (i < object.size())
+            object[i]->Delete();
+
+	delete [] drawn;
+	delete [] sphere;
+	delete [] sorted;
+	delete [] owner;
+	delete [] sortedOwner;
+	delete [] cell;
+	Atlas::clear();
+}
+
+//-------------------------------- Object ----------------------------------
+//
+// An Object is a member of the scene that can be manipulated and has a 
+// graphic representation that can be drawn
+//
+IScene* Object::scene = NULL;
+
+// constructor creates a 3-D object that is represented by a set of
+// graphics primitives
+//
+Object::Object(Shape shape, float* dimension, int* partition, Colour clr, 
+ bool antiAlias) {
+
+	add(); // add this object to the scene
+
+	vertex    = NULL;
+	index     = NULL;
+	attribute = NULL;
+	maxIndex  = 0;
+	users     = new int(1);
+	visual    = CreateMesh(shape, dimension, partition, clr, antiAlias);
+
+	// bound the shape for culling - the teapot is left unbounded
+	float r;
+	switch (shape) {
+		case SPHERE:
+			setBoundingSphere(dimension[0], Vector());
+			break;
+		case CYLINDER:
+			r = dimension[0] > dimension[1] ? dimension[0] : dimension[1];
+			setBoundingSphere(sqrtf(r * r + 0.25f * dimension[2] *
+			 dimension[2]), Vector());
+			break;
+		case TORUS:
+			setBoundingSphere(dimension[0] + dimension[1], Vector());
+			break;
+	}
+}
+
+Object::Object(Shape shape, const char* filename, bool antiAlias) {
+
+	add(); // add this object to the scene
+
+	users = new int(1);
+	create(shape, filename, antiAlias);
+}
+
+// constructor creates an object without lists or a graphic
+// representation - the derived class creates them once it knows them
+//
+Object::Object() : visual(NULL), vertex(NULL), index(NULL), 
+ attribute(NULL), nPrimitives(0), nVertices(0), nIndices(0), 
+ nSurfaces(0), maxIndex(0) {
+
+	add(); // add this object to the scene
+
+	users = new int(1);
+}
+
+// create creates the graphic representation of a mesh that the graphics
+// card reads from filename
+//
+void Object::create(Shape shape, const char* filename, bool antiAlias) {
+
+	vertex    = NULL;
+	index     = NULL;
+	attribute = NULL;
+	maxIndex  = 0;
+	visual    = CreateMesh(shape, filename, antiAlias);
+}
+
+// constructor creates an instance of object o that shares its graphic
+// representation and its vertex, index and attribute lists - the lists
+// and the representation are released with the last object that uses
+// them
+//
+Object::Object(const Object* o) : visual(o->visual), vertex(o->vertex),
+ index(o->index), attribute(o->attribute), nPrimitives(o->nPrimitives),
+ nVertices(o->nVertices), nIndices(o->nIndices),
+ nSurfaces(o->nSurfaces), maxIndex(o->maxIndex), users(o->users) {
+
+	add(); // add this object to the scene
+
+	(*users)++;
+	setBounds(*o);
+}
+
+Object::Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
+ ITexture* texture, bool antiAlias) : 
+ nPrimitives(noPrimitives), nVertices(noVertices) {
+    
+	add(); // add this object to the scene
+
+    // determine total number of indices
+	switch (shape) {
+        case POINT_LIST:     nIndices = nPrimitives;     break;
+        case LINE_LIST:      nIndices = 2 * nPrimitives; break;
+        case LINE_STRIP:     nIndices = nPrimitives + 1; break;
+        case TRIANGLE_LIST:  nIndices = 3 * nPrimitives; break;
+        case TRIANGLE_STRIP: nIndices = nPrimitives + 2; break;
+        case TRIANGLE_FAN:   nIndices = nPrimitives + 1; break;
+        default: nIndices = nPrimitives;
+    }
+	// allocate memory for lists
+    vertex    = new Vertex[nVertices];
+	index     = new unsigned[nIndices];
+	attribute = NULL;
+	users     = new int(1);
+	// texture coordinates address the texture's region of its atlas page
+	if (texture)
+		for (int i = 0; i < 4; i++)
+			tile[i] = static_cast<Texture*>(texture)->region()[i];
+	// temporary allocation
+	IDeviceTexture* devTex = (texture ? texture->deviceTexture() : NULL);
+	// create graphic representation
+    visual = CreateGraphic(shape, nPrimitives, nVertices, sizeof(Vertex), 
+	 nIndices, clr, devTex, antiAlias);
+	// initialize counters for sequential construction of the set of
+	// primitives from the constructors of the derived classes
+	nVertices = 0;
+	nIndices  = 0;
+	nSurfaces = 0;
+	maxIndex  = 0;
+}
+
+Object::Object(Shape shape, int noPrimitives, int noVertices, 
+ Colour* clr, ITexture** texture, int nSubsets, bool antiAlias) {
+
+	add(); // add this object to the scene
+
+	users = new int(1);
+	create(shape, noPrimitives, noVertices, clr, texture, nSubsets, 
+	 antiAlias);
+}
+
+// create allocates the lists for noPrimitives primitives of noVertices
+// vertices in nSubsets surfaces and creates their graphic representation
+//
+void Object::create(Shape shape, int noPrimitives, int noVertices, 
+ Colour* clr, ITexture** texture, int nSubsets, bool antiAlias) {
+
+	nPrimitives = noPrimitives;
+	nVertices   = noVertices;
+    // determine total number of indices
+	switch (shape) {
+        case POINT_LIST:     nIndices = nPrimitives;     break;
+        case LINE_LIST:      nIndices = 2 * nPrimitives; break;
+        case LINE_STRIP:     nIndices = nPrimitives + 1; break;
+        case TRIANGLE_LIST:  nIndices = 3 * nPrimitives; break;
+        case TRIANGLE_STRIP: nIndices = nPrimitives + 2; break;
+        case TRIANGLE_FAN:   nIndices = nPrimitives + 1; break;
+        default: nIndices = nPrimitives;
+    }
+	// allocate memory for lists
+    vertex    = new Vertex[nVertices];
+	index     = new unsigned[nIndices];
+	attribute = new unsigned[nPrimitives];
+	// temporary allocation
+	IDeviceTexture** devTex = new IDeviceTexture*[nSubsets];
+	for (int i = 0; i < nSubsets; i++)
+		if (texture && texture[i])
+			devTex[i] = texture[i]->deviceTexture();
+		else
+			devTex[i] = NULL;
+	// create graphic representation
+    visual = CreateMesh(nSubsets, nPrimitives, nVertices, clr, devTex,
+	 antiAlias);
+	// finished with device texture addresses
+	delete [] devTex;
+	// initialize counters for sequential construction of the set of
+	// primitives from the constructors of the derived classes
+	nVertices = 0;
+	nIndices  = 0;
+	nSurfaces = 0;
+	maxIndex  = 0;
+}
+
+// add adds the current object to the scene at its finest level of
+// detail
+//
+void Object::add() {
+    
+	handle  = NO_HANDLE;
+	lod     = 0;
+	tile[0] = 0;
+	tile[1] = 0;
+	tile[2] = 1;
+	tile[3] = 1;
+    if (scene)
+        scene->add(this);
+    else
+        error("Object::00 Can\'t access the scene object");
+}
+
+// add constructs a surface from a pair of triangle primitives by adding
+// to the vertex, index and attribute lists
+//
+void Object::add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n) {
+
+    #if ZAXIS_DIRECTION == INTO_SCREEN
+    // order triangle vertices in clockwise arrangement
+    int v1, v2, v3, v4;
+    // add four vertices to describe the side
+    v1 = add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
+    v2 = add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
+    v3 = add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
+    v4 = add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
+    // add six indices to describe the two triangles 
+    add(v1);
+    add(v2);
+    add(v3);
+    add(v1);
+    add(v3);
+    add(v4);
+	// associates the two triangles with the surface
+	if (attribute) {
+		attribute[2 * nSurfaces]     = nSurfaces;
+		attribute[2 * nSurfaces + 1] = nSurfaces;
+		nSurfaces++;
+	}
+    #elif ZAXIS_DIRECTION == OUT_OF_SCREEN
+    // order triangle vertices in counter-clockwise arrangement
+    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
+    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
+    add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
+    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
+    add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
+    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
+    #endif
+}
+
+// add adds a Vertex to the list of vertices for the object - mapping
+// its texture coordinates into the object's region of the texture
+//
+int Object::add(float x, float y, float z, float nx, float ny, 
+ float nz, float tu, float tv) {
+
+	Atlas::map(tile, tu, tv);
+	vertex[nVertices] = Vertex(x, y, z, nx, ny, nz, tu, tv);
+
+	return nVertices++;
+}
+
+// set replaces the Vertex at index i in the list of vertices
+//
+void Object::set(int i, float x, float y, float z, float nx, float ny, 
+ float nz, float tu, float tv) {
+
+	Atlas::map(tile, tu, tv);
+	vertex[i] = Vertex(x, y, z, nx, ny, nz, tu, tv);
+}
+
+// local returns the vector part of vertex i
+//
+Vector Object::local(int i) const {
+
+	return vertex[i].position();
+}
+
+// bound returns the bounding sphere of the object in world space through
+// centre and radius and returns true if the object is bounded, false
+// otherwise - an object built from vertices is bounded by the sphere
+// around the box that encloses its vertices
+//
+bool Object::bound(Vector& centre, float& radius) {
+
+	if (!hasBoundingSphere() && vertex && nVertices) {
+		Vector lo = local(0), hi = lo;
+		for (int i = 1; i < nVertices; i++) {
+			Vector p = local(i);
+			if (p.x < lo.x) lo.x = p.x;
+			if (p.y < lo.y) lo.y = p.y;
+			if (p.z < lo.z) lo.z = p.z;
+			if (p.x > hi.x) hi.x = p.x;
+			if (p.y > hi.y) hi.y = p.y;
+			if (p.z > hi.z) hi.z = p.z;
+		}
+		setBoundingSphere(0.5f * (hi - lo).length(), 0.5f * (lo + hi));
+	}
+	// a loaded mesh knows its own bounds
+	if (!hasBoundingSphere() && visual) {
+		Vector c;
+		float  r;
+		if (visual->bound(c, r))
+			setBoundingSphere(r, c);
+	}
+	if (!hasBoundingSphere())
+		return false;
+
+	// scale the radius by the longest axis of the world transformation
+	Matrix w = world();
+	float sx = Vector(w.m11, w.m12, w.m13).length();
+	float sy = Vector(w.m21, w.m22, w.m23).length();
+	float sz = Vector(w.m31, w.m32, w.m33).length();
+	float s  = sx > sy ? sx : sy;
+	centre = boundingCentre() * w;
+	radius = boundingRadius() * (s > sz ? s : sz);
+
+	return true;
+}
+
+// select chooses the level of detail of the object's graphic from the
+// diameter of its bounding sphere in pixels - level l starts below
+// MESH_LOD_PIXELS / 2^(l - 1) and the diameter must pass a threshold by
+// MESH_LOD_HYSTERESIS before the level changes, so that an object at a
+// threshold does not pop back and forth - an unbounded object and an
+// object around the viewpoint are drawn at the finest level
+//
+void Object::select(const Vector& viewpoint, const Frustum& frustum,
+ float lodScale) {
+
+	Vector c;
+	float  r;
+	if (!bound(c, r)) {
+		lod = 0;
+		return;
+	}
+	float d = (c - viewpoint).length();
+	if (d <= r) {
+		lod = 0;
+		return;
+	}
+	float size = 2 * r * lodScale / d;
+	while (lod > 0 && size > (1 + MESH_LOD_HYSTERESIS) * MESH_LOD_PIXELS /
+	 (1 << (lod - 1)))
+		lod--;
+	while (lod < MAX_LOD && size < (1 - MESH_LOD_HYSTERESIS) *
+	 MESH_LOD_PIXELS / (1 << lod))
+		lod++;
+}
+
+// populateVB fills the vertex buffer at vb with vertex data
+//
+void Object::populateVB(void* vb) const {
+
+	Vertex* p = (Vertex*)vb;
+
+	for (int i = 0; i < nVertices; i++)
+		*p++ = vertex[i];
+}
+
+// populateVB fills the vertex buffer at vb with the n vertices that
+// start at index first
+//
+void Object::populateVB(void* vb, int first, int n) const {
+
+	Vertex* p = (Vertex*)vb;
+
+	for (int i = first; i < first + n; i++)
+		*p++ = vertex[i];
+}
+
+// populateIB fills the index buffer at ib with index data - the
+// buffer holds 32-bit indices if wideIndices() is true and 16-bit
+// indices otherwise
+//
+void Object::populateIB(void* ib) const {
+
+	if (wideIndices()) {
+		unsigned* p = (unsigned*)ib;
+		for (int i = 0; i < nIndices; i++)
+			*p++ = index[i];
+	}
+	else {
+		unsigned short* p = (unsigned short*)ib;
+		for (int i = 0; i < nIndices; i++)
+			*p++ = (unsigned short)index[i];
+	}
+}
+
+// populateAB fills the attribute buffer at ab with index data
+//
+void Object::populateAB(void* ab) const {
+
+	unsigned* p = (unsigned*)ab;
+
+	for (int i = 0; i < nPrimitives; i++)
+		*p++ = attribute[i];
+}
+
+// add constructs a surface from a pair of triangle primitives by adding
+// to the vertex, index and attribute lists
+//
+void Object::add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n,
+ int tu, int tv) {
+
+    #if ZAXIS_DIRECTION == INTO_SCREEN
+    // order triangle vertices in clockwise arrangement
+    int v1, v2, v3, v4;
+    // add four vertices to describe the side
+    v1 = add(p1.x, p1.y, p1.z, n.x, n.y, n.z,         0,         0);
+    v2 = add(p2.x, p2.y, p2.z, n.x, n.y, n.z,         0, (float)tv);
+    v3 = add(p3.x, p3.y, p3.z, n.x, n.y, n.z, (float)tu, (float)tv);
+    v4 = add(p4.x, p4.y, p4.z, n.x, n.y, n.z, (float)tu,         0);
+    // add six indices to describe the two triangles 
+    add(v1);
+    add(v2);
+    add(v3);
+    add(v1);
+    add(v3);
+    add(v4);
+	// associates the two triangles with the surface
+	if (attribute) {
+		attribute[2 * nSurfaces]     = nSurfaces;
+		attribute[2 * nSurfaces + 1] = nSurfaces;
+		nSurfaces++;
+	}
+    #elif ZAXIS_DIRECTION == OUT_OF_SCREEN
+    // order triangle vertices in counter-clockwise arrangement
+    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
+    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
+    add(p2.x, p2.y, p2.z, n.x, n.y, n.z, 0, 1);
+    add(p1.x, p1.y, p1.z, n.x, n.y, n.z, 0, 0);
+    add(p4.x, p4.y, p4.z, n.x, n.y, n.z, 1, 0);
+    add(p3.x, p3.y, p3.z, n.x, n.y, n.z, 1, 1);
+    #endif
+}
+
+// add adds a vertex number to the index list
+//
+void Object::add(int vertex) {
+
+	index[nIndices++] = vertex;
+	if ((unsigned)vertex > maxIndex)
+		maxIndex = vertex;
+}
+
+// surface associates primitive i with surface s
+//
+void Object::surface(int i, unsigned s) {
+
+	if (attribute && i < nPrimitives) {
+		attribute[i] = s;
+		if ((int)s >= nSurfaces)
+			nSurfaces = s + 1;
+	}
+}
+
+// optimize welds the duplicate vertices of the finished lists, reorders
+// the triangles of a triangle list for the vertex cache and for overdraw
+// - keeping each run of triangles that share an attribute together - and
+// numbers the vertices in order of first use.  If the lists were read
+// from file, the order is baked beside it with the extension
+// MESH_BAKE_EXT and is read back until file changes
+//
+void Object::optimize(Shape shape, const char* file) {
+
+	#if MESH_OPTIMIZE
+	if (!vertex || !index || nVertices <= 0 || nIndices <= 0)
+		return;
+	int  stride    = sizeof(Vertex) / sizeof(float);
+	bool triangles = shape == TRIANGLE_LIST && nIndices == 3 * nPrimitives;
+
+	// the baked order holds the settings of the optimizer, the new
+	// number of each vertex and the reordered indices
+	char     baked[MAX_PATH + 1];
+	unsigned key[3];
+	int      size  = (1 + nVertices + nIndices) * sizeof(unsigned);
+	unsigned* order = NULL;
+	if (file && strlen(file) + strlen(MESH_BAKE_EXT) <= MAX_PATH &&
+	 fileStamp(file, key)) {
+		strcopy(baked, file, MAX_PATH);
+		strcatenate(baked, MESH_BAKE_EXT, MAX_PATH);
+		order = new (std::nothrow) unsigned[size / sizeof(unsigned)];
+	}
+	if (order && loadBakedData(baked, key, order, size) &&
+	 order[0] == (MESH_OVERDRAW_CLUSTER | VERTEX_CACHE_SIZE << 16)) {
+		const unsigned* remap = order + 1;
+		const unsigned* list  = remap + nVertices;
+		bool valid = true;
+		for (int i = 0; i < nVertices && valid; i++)
+			valid = remap[i] < (unsigned)nVertices;
+		for (int i = 0; i < nIndices && valid; i++)
+			valid = list[i] < (unsigned)nVertices;
+		if (valid) {
+			Vertex* v = new Vertex[nVertices];
+			for (int i = 0; i < nVertices; i++)
+				v[remap[i]] = vertex[i];
+			delete [] vertex;
+			vertex   = v;
+			maxIndex = 0;
+			for (int i = 0; i < nIndices; i++) {
+				index[i] = list[i];
+				if (index[i] > maxIndex)
+					maxIndex = index[i];
+			}
+			delete [] order;
+			return;
+		}
+	}
+	float before = triangles ? acmr(index, nIndices, nVertices) : 0;
+
+	// point each index at the first copy of its vertex
+	unsigned* remap = new unsigned[nVertices];
+	int distinct = weldVertices((const float*)vertex, nVertices, stride,
+	 remap);
+	for (int i = 0; i < nIndices; i++)
+		index[i] = remap[index[i]];
+
+	if (triangles) {
+		for (int first = 0, last; first < nPrimitives; first = last) {
+			last = first + 1;
+			while (attribute && last < nPrimitives &&
+			 attribute[last] == attribute[first])
+				last++;
+			optimizeCache(index + 3 * first, 3 * (last - first), nVertices);
+			optimizeOverdraw(index + 3 * first, 3 * (last - first),
+			 (const float*)vertex, stride, MESH_OVERDRAW_CLUSTER);
+		}
+	}
+
+	// renumber the vertices in order of first use
+	optimizeFetch(index, nIndices, nVertices, remap);
+	Vertex* v = new Vertex[nVertices];
+	for (int i = 0; i < nVertices; i++)
+		v[remap[i]] = vertex[i];
+	delete [] vertex;
+	vertex   = v;
+	maxIndex = 0;
+	for (int i = 0; i < nIndices; i++)
+		if (index[i] > maxIndex)
+			maxIndex = index[i];
+	if (order) {
+		order[0] = MESH_OVERDRAW_CLUSTER | VERTEX_CACHE_SIZE << 16;
+		memcpy(order + 1, remap, nVertices * sizeof(unsigned));
+		memcpy(order + 1 + nVertices, index, nIndices * sizeof(unsigned));
+		saveBakedData(baked, key, order, size);
+		delete [] order;
+	}
+	delete [] remap;
+
+	if (nPrimitives >= MESH_REPORT_PRIMITIVES) {
+		char str[120];
+		int after = triangles ? int(100 * acmr(index, nIndices, nVertices)) :
+		 0;
+		sprintf(str, "Mesh: %d primitives, %d of %d vertices distinct, "
+		 "ACMR %d.%02d before and %d.%02d after", nPrimitives, distinct,
+		 nVertices, int(100 * before) / 100, int(100 * before) % 100,
+		 after / 100, after % 100);
+		report(str);
+	}
+	#endif
+}
+
+// add adds a texture to the object
+//
+void Object::add(ITexture* texture) {
+
+	if (texture)
+		visual->add(texture->deviceTexture());
+}
+
+// instance creates an object that shares the graphic representation
+// of the current object - see CreateInstance
+//
+Object* Object::instance() const {
+
+	return new Object(this);
+}
+
+// destructor releases the graphic representation and the lists unless
+// another instance still uses them
+//
+Object::~Object() {
+
+	if (--*users == 0) {
+		if (visual)
+			visual->Delete();
+		if (vertex)
+			delete [] vertex;
+		if (index)
+			delete [] index;
+		if (attribute)
+			delete [] attribute;
+		delete users;
+	}
+    if (scene)
+        scene->remove(this);
+    else
+        error("Object::90 Can\'t access the Scene component");
+}
+
+// CreateInstance creates an object that shares the graphic representation
+// of prototype - the display device draws the instances of a graphic
+// that are queued one after another with a single draw call.  Terrain
+// cannot be instanced
+//
+IObject* CreateInstance(const IObject* prototype) {
+
+	return prototype ? static_cast<const Object*>(prototype)->instance() :
+	 NULL;
+}
+
+//-------------------------------- Stock Shapes --------------------------
+//
+// Sphere is an Object identifiable by a radius and two tesselation 
+// parameters
+//
+IObject* CreateSphere(float radius, int slices, int stacks, Colour clr, 
+ bool antiAlias) {
+
+	float dimension[1] = {radius};
+	int   partition[2] = {slices, stacks};
+	
+	return new Object(SPHERE, dimension, partition, clr, antiAlias);
+}
+
+// Cylinder is an Object identifiable by an upper radius, a lower radius
+// a height and two tesselation parameters 
+//
+IObject* CreateCylinder(float upper, float lower, float height, 
+ int slices, int stacks, Colour clr, bool antiAlias) {
+	
+	float dimension[3] = {upper, lower, height};
+	int   partition[2] = {slices, stacks};
+
+	return new Object(CYLINDER, dimension, partition, clr, antiAlias);
+}
+
+// Torus is an Object identifiable by an inner radius, an outer radius
+// and two tesselation parameters 
+//
+IObject* CreateTorus(float inner, float outer, int slices, int stacks,
+ Colour clr, bool antiAlias) {
+	
+	float dimension[2] = {inner, outer};
+	int   partition[2] = {slices, stacks};
+
+	return new Object(TORUS, dimension, partition, clr, antiAlias);
+}
+
+// Teapot is an Object that represents the Utah Teapot 
+//
+IObject* CreateTeapot(Colour clr, bool antiAlias) {
+
+	return new Object(TEAPOT, NULL, NULL, clr, antiAlias);
+}
+
+// XFile is an Object that is described in X-File format or in OBJ 
+// format - the native loader reads text and binary .x files and .obj
+// files on a loader thread; a file that it cannot read is left to the 
+// graphics card
+//
+IObject* CreateXFile(const char* filename, bool antiAlias) {
+
+	return new Model(filename, antiAlias);
+}
+
+//-------------------------------- Model -----------------------------------
+//
+// Model is an Object read from a mesh file by the native mesh loader
+//
+// constructor submits the file to the loader - the model draws nothing
+// until the loader hands it the lists
+//
+Model::Model(const char* f, bool a) : antiAlias(a), loading(NULL) {
+
+	file = new char[strlen(f) + 1];
+	strcopy(file, f, strlen(f));
+	loading = new ModelLoad(file, this);
+	Loader::submit(loading);
+}
+
+// instance creates an object that shares the graphic representation of
+// the model - a model that is still loading has none to share, so its
+// instance reads the file for itself
+//
+Object* Model::instance() const {
+
+	return loading ? new Model(file, antiAlias) : Object::instance();
+}
+
+// loaded copies the vertices and faces of mesh, read from file -
+// grouping the faces by material so that each surface is one run of
+// triangles.  A file that the native loader cannot read is left to the
+// graphics card
+//
+void Model::loaded(const MeshData& mesh, bool read) {
+
+	loading = NULL;
+	if (!read) {
+		create(X_FILE, file, antiAlias);
+		return;
+	}
+
+	// one colour and one texture for each material - materials that
+	// name the same texture file share one texture
+	Colour*    c       = new Colour[mesh.nMaterials];
+	ITexture** texture = new ITexture*[mesh.nMaterials];
+	for (int i = 0; i < mesh.nMaterials; i++) {
+		const MeshMaterial& m = mesh.material[i];
+		c[i] = Colour(m.diffuse[0], m.diffuse[1], m.diffuse[2], 
+		 m.diffuse[3]);
+		texture[i] = NULL;
+		if (m.texture[0]) {
+			texture[i] = Texture::find(m.texture, 0, Colour());
+			if (!texture[i])
+				texture[i] = CreateTexture(m.texture);
+		}
+	}
+	create(TRIANGLE_LIST, mesh.nFaces, mesh.nVertices, c, texture, 
+	 mesh.nMaterials, antiAlias);
+	delete [] c;
+	delete [] texture;
+
+	for (int i = 0; i < mesh.nVertices; i++) {
+		const float* v = mesh.vertex + 8 * i;
+		add(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+	}
+	int n = 0;
+	for (int s = 0; s < mesh.nMaterials; s++)
+		for (int f = 0; f < mesh.nFaces; f++)
+			if (mesh.attribute[f] == (unsigned)s) {
+				add(mesh.index[3 * f]);
+				add(mesh.index[3 * f + 1]);
+				add(mesh.index[3 * f + 2]);
+				surface(n++, s);
+			}
+	optimize(TRIANGLE_LIST, file);
+}
+
+// destructor stops the loader from handing the lists to a deleted model
+//
+Model::~Model() {
+
+	if (loading)
+		loading->cancel();
+	delete [] file;
+}
+
+//-------------------------------- ModelLoad -------------------------------
+//
+// ModelLoad reads a mesh file on a loader thread for a waiting model
+//
+ModelLoad::ModelLoad(const char* f, Model* m) : tried(false), read(false),
+ model(m) {
+
+	file = new char[strlen(f) + 1];
+	strcopy(file, f, strlen(f));
+	mesh = new MeshData;
+}
+
+// load reads the lists of the file on a loader thread
+//
+void ModelLoad::load() {
+
+	tried = true;
+	read  = loadMesh(file, *mesh);
+}
+
+// finish hands the lists to the waiting model on the render thread - a
+// file that the stopping pool did not start is read here, since the
+// model has nothing to draw without it
+//
+void ModelLoad::finish() {
+
+	if (!model)
+		return;
+	if (!tried)
+		load();
+	model->loaded(*mesh, read);
+}
+
+// destructor releases the name and the lists
+//
+ModelLoad::~ModelLoad() {
+
+	delete [] file;
+	if (read)
+		releaseMesh(*mesh);
+	delete mesh;
+}
+
+//-------------------------------- Box -------------------------------------
+//
+// Box is an Object identifiable by two points - lower close left, and
+// upper faraway right - and a colour
+//
+IObject* CreateBox(float minx, float miny, float minz, float maxx, 
+ float maxy, float maxz, Colour c, ITexture* texture, int tu, int tv, 
+ bool antiAlias) {
+
+	return new Box(minx, miny, minz, maxx, maxy, maxz, c, texture, tu, 
+	 tv, antiAlias);
+}
+
+IObject* CreateBox(float minx, float miny, float minz, float maxx, 
+ float maxy, float maxz, Colour* c, ITexture** texture, int tu, int tv, 
+ bool antiAlias) {
+
+	return new Box(minx, miny, minz, maxx, maxy, maxz, c, texture, tu,
+	 tv, antiAlias);
+}
+
+// constructor builds the Box from its two extreme points
+//
+Box::Box(float minx, float miny, float minz, float maxx, float maxy,
+ float maxz, Colour c, ITexture* texture, int tu, int tv, bool antiAlias)
+ : Object(TRIANGLE_LIST, 12, 24, c, texture, antiAlias) {
+
+    Vector p1 = Vector(minx, miny, ZAXIS_DIRECTION * minz),
+           p2 = Vector(minx, maxy, ZAXIS_DIRECTION * minz),
+           p3 = Vector(maxx, maxy, ZAXIS_DIRECTION * minz),
+           p4 = Vector(maxx, miny, ZAXIS_DIRECTION * minz),
+           p5 = Vector(minx, miny, ZAXIS_DIRECTION * maxz),
+           p6 = Vector(minx, maxy, ZAXIS_DIRECTION * maxz),
+           p7 = Vector(maxx, maxy, ZAXIS_DIRECTION * maxz),
+           p8 = Vector(maxx, miny, ZAXIS_DIRECTION * maxz);
+    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1), tu, tv); // front
+    add(p4, p3, p7, p8, Vector(1, 0,                    0), tu, tv); // right
+    add(p8, p7, p6, p5, Vector(0, 0, ZAXIS_DIRECTION *  1), tu, tv); // back
+    add(p6, p2, p1, p5, Vector(-1, 0,                   0), tu, tv); // left
+    add(p1, p4, p8, p5, Vector(0, -1,                   0), tu, tv); // bottom
+    add(p2, p6, p7, p3, Vector(0, 1,                    0), tu, tv); // top
+	optimize(TRIANGLE_LIST);
+}
+
+// constructor builds the Box from its two extreme points
+//
+Box::Box(float minx, float miny, float minz, float maxx, float maxy,
+ float maxz, Colour* c, ITexture** texture, int tu, int tv, 
+ bool antiAlias) : Object(TRIANGLE_LIST, 12, 24, c, texture, 6, 
+ antiAlias) {
+
+    Vector p1 = Vector(minx, miny, ZAXIS_DIRECTION * minz),
+           p2 = Vector(minx, maxy, ZAXIS_DIRECTION * minz),
+           p3 = Vector(maxx, maxy, ZAXIS_DIRECTION * minz),
+           p4 = Vector(maxx, miny, ZAXIS_DIRECTION * minz),
+           p5 = Vector(minx, miny, ZAXIS_DIRECTION * maxz),
+           p6 = Vector(minx, maxy, ZAXIS_DIRECTION * maxz),
+           p7 = Vector(maxx, maxy, ZAXIS_DIRECTION * maxz),
+           p8 = Vector(maxx, miny, ZAXIS_DIRECTION * maxz);
+    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1), tu, tv); // front
+    add(p4, p3, p7, p8, Vector(1, 0,                    0), tu, tv); // right
+    add(p8, p7, p6, p5, Vector(0, 0, ZAXIS_DIRECTION *  1), tu, tv); // back
+    add(p6, p2, p1, p5, Vector(-1, 0,                   0), tu, tv); // left
+    add(p1, p4, p8, p5, Vector(0, -1,                   0), tu, tv); // bottom
+    add(p2, p6, p7, p3, Vector(0, 1,                    0), tu, tv); // top
+	optimize(TRIANGLE_LIST);
+}
+
+//-------------------------------------- Grid ------------------------------
+//
+// A Grid is a set of mutually perpendicular lines in a plane defined 
+// parallel to the x-y plane
+//
+IObject* CreateGrid(int min, int y, int max, int n, Colour clr, 
+ bool antiAlias) {
+
+	return new Grid(min, y, max, n, clr, antiAlias);
+}
+
+Grid::Grid(int min, int y, int max, int n, Colour clr, bool antiAlias) : 
+ Object(LINE_LIST, 2 * n, 4 * n, clr, NULL, antiAlias) {
+
+    int i, inc = (max - min) / (n - 1);
+    for (i = min; i <= max; i += inc) {
+        add(add((float)min, (float)y, (float)i, 0, 1, 0));
+        add(add((float)max, (float)y, (float)i, 0, 1, 0));
+        add(add((float)i, (float)y, (float)min, 0, 1, 0));
+        add(add((float)i, (float)y, (float)max, 0, 1, 0));
+    }
+	optimize(LINE_LIST);
+}
+
+//-------------------------------- Terrain ---------------------------------
+//
+// A Terrain is an Object that consists of a grid of triangles where the
+// height of each vertex is specified using a height map
+//
+IObject* CreateTerrain(int cellSpacing, float depth, const char* heightMap, 
+ ITexture* tFile) {
+
+	// the tiled copy of the height map sits beside the height map
+	char tiledFile[MAX_PATH + 1];
+	strcopy(tiledFile, heightMap, MAX_PATH);
+	strcatenate(tiledFile, TERRAIN_TILE_EXT, MAX_PATH);
+	LONGLONG begin = ticks();
+
+	// convert the height map to the tiled format unless the tiled file
+	// was built from the same height map with the same spacing and depth
+	// - the stamp of the height map identifies it without reading it
+	Terrain::Header header;
+	unsigned key[3] = {0, 0, 0};
+	bool stamped = fileStamp(heightMap, key);
+	bool cached  = Terrain::current(tiledFile, stamped ? key : NULL, 
+	 cellSpacing, depth, header);
+	if (!cached) {
+
+        // open the height bitmap file
+        std::ifstream fp(heightMap, std::ios::in | std::ios::binary);
+		if (!fp)
+			error("Terrain::16 Couldn\'t open the height map");
+
+        // read the format of its pixels and move to the first scan line
+        HeightMap format;
+        bool valid = fp && readHeightMap(fp, format);
+        if (fp && !valid)
+            error("Terrain::15 Height maps must be uncompressed BMP files "
+             "of 8, 16, 24 or 32 bit pixels");
+
+        if (!valid || !Terrain::convert(fp, format, key, 
+         cellSpacing, depth, tiledFile, header))
+            header.tileCols = header.tileRows = 0;
+	}
+
+    IObject* terrain = new Terrain(tiledFile, header, cellSpacing, depth, 
+	 tFile);
+
+	char str[Terrain::MAX_CHAR + 1];
+	sprintf(str, "Terrain: %s %dx%d tiles ready in %d ms", 
+	 cached ? "cached" : "rebuilt", header.tileCols, header.tileRows, 
+	 microseconds(begin, ticks()) / 1000);
+	report(str);
+
+	return terrain;
+}
+
+// fileSize returns the number of bytes in the tiled height file that
+// header describes
+//
+unsigned Terrain::fileSize(const Header& header) {
+
+	unsigned n = header.tileCols * header.tileRows;
+
+	return sizeof(Header) + n * (sizeof(Record) + TILE_DATA * 
+	 sizeof(float)) + 2 * LODS * EDGES * sizeof(int) + 
+	 3 * patternPrimitives() * sizeof(unsigned short);
+}
+
+// current returns true if tiledFile holds a complete tiled height file
+// that was built with the current format from a height map stamped with
+// key with the given cell spacing and depth, and copies its header into
+// header - a NULL key (no height map) accepts any tiled file built with
+// the same spacing and depth
+//
+bool Terrain::current(const char* tiledFile, const unsigned* key, 
+ int spacing, float depth, Header& header) {
+
+	std::ifstream fp(tiledFile, std::ios::in | std::ios::binary);
+	fp.read((char*)&header, sizeof header);
+	bool rc = fp && !strncmp(header.magic, "TILE", 4) && 
+	 header.version == VERSION && (!key || !memcmp(header.key, key, sizeof header.key)) && 
+	 header.spacing == spacing && header.depth == depth && 
+	 header.tileCols > 0 && header.tileRows > 0;
+	if (rc) {
+		fp.seekg(0, std::ios::end);
+		rc = fp && (unsigned)fp.tellg() == fileSize(header);
+	}
+
+	return rc;
+}
+
+// convert reads the scan lines of the height map from fp a band of
+// tiles at a time and writes the tiled height file - the header is
+// followed by a Record for each tile and then by the data for each
+// tile: its heights followed by the x, y and z components of its unit
+// vertex normals, with the values along a shared edge stored in both
+// tiles.  The file ends with the index patterns: the start and the
+// count of each pattern followed by its 16-bit indices.  The file is
+// written under a name of its own and renamed once complete, so that
+// an interrupted conversion never leaves a partial file under tiledFile
+//
+bool Terrain::convert(std::ifstream& fp, const HeightMap& format,
+ const unsigned* key, int spacing, float depth, const char* tiledFile, 
+ Header& header) {
+
+	unsigned width  = format.width;
+	unsigned height = format.height;
+	char temp[MAX_PATH + 1];
+	if (!tempName(temp, tiledFile, MAX_PATH)) {
+		error("Terrain::11 Couldn\'t create the tiled height file");
+		return false;
+	}
+	std::ofstream out(temp, std::ios::out | std::ios::binary | 
+	 std::ios::trunc);
+	if (!out) {
+		error("Terrain::11 Couldn\'t create the tiled height file");
+		return false;
+	}
+
+	memcpy(header.magic, "TILE", 4);
+	header.version  = VERSION;
+	memcpy(header.key, key, sizeof header.key);
+	header.spacing  = spacing;
+	header.depth    = depth;
+	header.width    = width;
+	header.height   = height;
+	header.tileCols = tiles(width);
+	header.tileRows = tiles(height);
+	int cols = header.tileCols * TILE + 1;
+	int side = cols + 2; // one column of apron at either end of a row
+	int n    = header.tileCols * header.tileRows;
+	LONGLONG begin = ticks(), converting = 0;
+
+    // allocate space for one full scan line, one band of tiles, one
+	// tile, its gradients and the summary records - each scan line is
+	// padded to a multiple of 4 bytes
+    unsigned bufferSize   = format.pitch;
+    unsigned char* buffer = new unsigned char[bufferSize];
+	float*  band   = new float[(TILE_SIDE + 2) * side];
+	float*  tile   = new float[TILE_DATA];
+	float*  slope  = new float[2 * TILE_VERTICES];
+	Record* record = new Record[n];
+
+	// reserve space for the header and the records
+	out.write((char*)&header, sizeof header);
+	out.write((char*)record, n * sizeof(Record));
+
+	for (int tr = 0; tr < header.tileRows; tr++) {
+		// row k of the band holds grid row tr * TILE + k - 1 and column
+		// j + 1 holds grid column j, so that each tile has an apron of
+		// one row and column on every side for the central differences;
+		// the first three rows repeat the last three rows of the
+		// previous band; the apron beyond the first row and column
+		// replicates them, as do rows and columns beyond the last
+		int first = 1;
+		if (tr) {
+			memcpy(band, band + TILE * side, 3 * side * sizeof(float));
+			first = 3;
+		}
+		for (int k = first; k < TILE_SIDE + 2; k++) {
+			float* row = band + k * side;
+			if (tr * TILE + k - 1 < (int)height) {
+				fp.read((char*)buffer, bufferSize);
+				LONGLONG t = ticks();
+				convertScanLine(format, buffer, row + 1, 
+				 HEIGHT_MAP_FLOOR / 255.f);
+				converting += ticks() - t;
+				row[0] = row[1];
+				for (int j = width + 1; j < side; j++)
+					row[j] = row[width];
+			}
+			else
+				memcpy(row, row - side, side * sizeof(float));
+		}
+		if (!tr)
+			memcpy(band, band + side, side * sizeof(float));
+		// write the tiles in the band
+		for (int tc = 0; tc < header.tileCols; tc++) {
+			const float* centre = band + side + tc * TILE + 1;
+			for (int r = 0; r < TILE_SIDE; r++)
+				memcpy(tile + r * TILE_SIDE, centre + r * side,
+				 TILE_SIDE * sizeof(float));
+			gradients(centre, side, slope, slope + TILE_VERTICES);
+			normals(slope, slope + TILE_VERTICES, depth / spacing,
+			 tile + TILE_VERTICES, tile + 2 * TILE_VERTICES, 
+			 tile + 3 * TILE_VERTICES, TILE_VERTICES);
+			measure(tile, record[tr * header.tileCols + tc]);
+			out.write((char*)tile, TILE_DATA * sizeof(float));
+		}
+	}
+
+	// write the index patterns, reordered for the vertex cache, as
+	// 16-bit indices
+	int nPattern = 3 * patternPrimitives();
+	unsigned* index = new unsigned[nPattern];
+	unsigned short* packed = new unsigned short[nPattern];
+	int start[LODS * EDGES], count[LODS * EDGES];
+	float before, after;
+	patterns(index, start, count, before, after);
+	for (int i = 0; i < nPattern; i++)
+		packed[i] = (unsigned short)index[i];
+	out.write((char*)start, sizeof start);
+	out.write((char*)count, sizeof count);
+	out.write((char*)packed, nPattern * sizeof(unsigned short));
+
+	// write the records and put the complete file in place
+	out.seekp(sizeof header);
+	out.write((char*)record, n * sizeof(Record));
+	out.close();
+	bool rc = !out.fail() && replaceFile(temp, tiledFile);
+	if (!rc) {
+		remove(temp);
+		error("Terrain::12 Couldn\'t write the tiled height file");
+	}
+	else {
+		char str[MAX_CHAR + 1];
+		sprintf(str, "Terrain: converted %dx%d %d-bit height map in %d ms"
+		 " (%d ms in scan line conversion)", width, height, format.bits, 
+		 microseconds(begin, ticks()) / 1000, 
+		 microseconds(0, converting) / 1000);
+		report(str);
+		sprintf(str, "Terrain: index patterns ACMR %d.%02d before and "
+		 "%d.%02d after", int(100 * before) / 100, int(100 * before) % 100,
+		 int(100 * after) / 100, int(100 * after) % 100);
+		report(str);
+	}
+
+	// de-allocate space
+	delete [] buffer;
+	delete [] band;
+	delete [] tile;
+	delete [] slope;
+	delete [] record;
+	delete [] index;
+	delete [] packed;
+
+	return rc;
+}
+
+Terrain::Terrain(const char* tiledFile, const Header& header, 
+ int cellSpacing, float d, ITexture* tFile) : 
+ Object(TRIANGLE_LIST, patternPrimitives(), slots(header) * TILE_VERTICES,
+ Colour(1, 1, 1, 1), tFile, true), spacing(cellSpacing), depth(d) {
+
+	// map the tiled height file - a height map that could not be
+	// converted leaves the terrain empty, and the conversion has
+	// reported why
+	record   = NULL;
+	data     = NULL;
+	tileCols = 0;
+	tileRows = 0;
+	if (header.tileCols > 0 && header.tileRows > 0)
+		map(tiledFile, header);
+	cols    = tileCols * TILE + 1;
+	rows    = tileRows * TILE + 1;
+	int n   = tileRows * tileCols;
+
+	// reserve the slots in the vertex buffer - the streamer fills them
+	nSlots = slots(header);
+	for (int i = 0; i < nSlots * TILE_VERTICES; i++)
+		add(0, 0, 0, 0, 1, 0);
+
+	// add the index patterns shared by all tiles - from the tiled file,
+	// where they were built and reordered once
+	int nPattern = 3 * patternPrimitives();
+	if (file.view()) {
+		const int* p = (const int*)(data + n * TILE_DATA);
+		memcpy(start, p, sizeof start);
+		memcpy(count, p + LODS * EDGES, sizeof count);
+		const unsigned short* pattern = 
+		 (const unsigned short*)(p + 2 * LODS * EDGES);
+		for (int i = 0; i < nPattern; i++)
+			add(pattern[i]);
+	}
+	else {
+		unsigned* pattern = new unsigned[nPattern];
+		float before, after;
+		patterns(pattern, start, count, before, after);
+		for (int i = 0; i < nPattern; i++)
+			add(pattern[i]);
+		delete [] pattern;
+	}
+
+	// build the quadtree from the tile records - leaves occupy the
+	// first n nodes
+	lod      = new int[n];
+	resident = new int[n];
+	visible  = new int[n];
+	node     = new Node[2 * n];
+	range    = new Range[nSlots];
+	slot     = new Slot[nSlots];
+	queued   = new int[nSlots];
+	finished = new int[nSlots];
+	for (int t = 0; t < n; t++) {
+		lod[t]      = LODS - 1;
+		resident[t] = -1;
+	}
+	for (int s = 0; s < nSlots; s++) {
+		slot[s].tile  = -1;
+		slot[s].state = FREE;
+		slot[s].used  = 0;
+	}
+	nNodes    = n;
+	root      = n ? build(0, 0, tileCols, tileRows) : -1;
+	nRanges   = 0;
+	nVisible  = 0;
+	frame     = 0;
+	nQueued   = 0;
+	nFinished = 0;
+	head      = 0;
+
+	// start the streamer - without it, the terrain has nothing to draw
+	quit = false;
+	if (n && (!wake.valid() || !lock.valid() || 
+	 !thread.start(streamer, this))) {
+		error("Terrain::14 Couldn\'t start the terrain streamer");
+		root = -1;
+	}
+
+		// define the bounding box for the terrain
+	float minx = 0.5f * (cols - 1) * spacing;
+	float miny = 0.5f * depth;
+	float minz = 0.5f * (rows - 1) * spacing;
+
+	//particle implementation
+
+	setBoundingBox(-minx, -miny, -minz, minx, miny, minz);
+}
+
+// map maps the tiled height file described by header into memory - the
+// operating system reads only the pages that are touched - and returns
+// true if the file holds every tile that header describes
+//
+bool Terrain::map(const char* tiledFile, const Header& header) {
+
+	if (!file.open(tiledFile)) {
+		error("Terrain::13 Couldn\'t map the tiled height file");
+		return false;
+	}
+	if (file.size() != fileSize(header)) {
+		error("Terrain::17 The tiled height file is incomplete");
+		file.close();
+		return false;
+	}
+
+	tileCols = header.tileCols;
+	tileRows = header.tileRows;
+	record   = (const Record*)(file.view() + sizeof(Header));
+	data     = (const float*)(record + tileCols * tileRows);
+
+	return true;
+}
+
+// slots returns the number of slots in the vertex buffer for the
+// terrain described by header
+//
+int Terrain::slots(const Header& header) {
+
+	int n = header.tileCols * header.tileRows;
+
+	return n > TERRAIN_SLOTS ? TERRAIN_SLOTS : n > 0 ? n : 1;
+}
+
+// patternPrimitives returns the number of primitives in the index
+// patterns for all levels of detail - a pattern consists of fans over
+// blocks of 2 x 2 cells and drops one primitive for each block along
+// an edge that borders a coarser tile; over all edge combinations,
+// each edge borders a coarser tile half of the time
+//
+int Terrain::patternPrimitives() {
+
+	int n = 0;
+	for (int l = 0; l < LODS; l++) {
+		int b = TILE / (2 << l); // blocks along the side of a tile
+		n += EDGES * (8 * b * b - 2 * b);
+	}
+
+	return n;
+}
+
+// patterns builds the index patterns for each level of detail and each
+// combination of coarser neighbours in index, with the first index and
+// the number of primitives of each pattern in start and count - indices
+// are local to a tile; the midpoint of a block edge that lies on a tile
+// edge bordering a coarser neighbour is dropped so that the tile meets
+// its neighbour without cracks.  Each pattern is then reordered for the
+// vertex cache and the average cache miss rates of the patterns before
+// and after are returned through before and after
+//
+void Terrain::patterns(unsigned* index, int* start, int* count,
+ float& before, float& after) {
+
+	int k = 0; // primitives added so far
+	for (int l = 0; l < LODS; l++) {
+		int s = 1 << l;
+		for (int m = 0; m < EDGES; m++) {
+			start[l * EDGES + m] = 3 * k;
+			for (int r = 0; r < TILE; r += 2 * s) {
+				for (int c = 0; c < TILE; c += 2 * s) {
+					// perimeter of the block in clockwise order starting
+					// from its lower left corner
+					int p[8], np = 0;
+					p[np++] = r * TILE_SIDE + c;
+					if (c || !(m & WEST))
+						p[np++] = (r + s) * TILE_SIDE + c;
+					p[np++] = (r + 2 * s) * TILE_SIDE + c;
+					if (r + 2 * s < TILE || !(m & NORTH))
+						p[np++] = (r + 2 * s) * TILE_SIDE + c + s;
+					p[np++] = (r + 2 * s) * TILE_SIDE + c + 2 * s;
+					if (c + 2 * s < TILE || !(m & EAST))
+						p[np++] = (r + s) * TILE_SIDE + c + 2 * s;
+					p[np++] = r * TILE_SIDE + c + 2 * s;
+					if (r || !(m & SOUTH))
+						p[np++] = r * TILE_SIDE + c + s;
+					// fan about the centre of the block
+					int centre = (r + s) * TILE_SIDE + c + s;
+					for (int v = 0; v < np; v++, k++) {
+						index[3 * k]     = centre;
+						index[3 * k + 1] = p[v];
+						index[3 * k + 2] = p[(v + 1) % np];
+					}
+				}
+			}
+			count[l * EDGES + m] = k - start[l * EDGES + m] / 3;
+		}
+	}
+	before = after = 0;
+	for (int i = 0; i < LODS * EDGES; i++) {
+		before += count[i] * acmr(index + start[i], 3 * count[i],
+		 TILE_VERTICES);
+		#if MESH_OPTIMIZE
+		optimizeCache(index + start[i], 3 * count[i], TILE_VERTICES);
+		#endif
+		after  += count[i] * acmr(index + start[i], 3 * count[i],
+		 TILE_VERTICES);
+	}
+	before /= k;
+	after  /= k;
+}
+
+// measure finds the lowest and highest heights of the tile at h and
+// its geometric error at each level of detail as the largest vertical
+// distance between the full resolution grid and the grid sampled at
+// the step for that level - the error never decreases with the level
+//
+void Terrain::measure(const float* h, Record& r) {
+
+	r.lo = r.hi = h[0];
+	for (int k = 1; k < TILE_VERTICES; k++) {
+		if (h[k] < r.lo) r.lo = h[k];
+		if (h[k] > r.hi) r.hi = h[k];
+	}
+
+	float* e = r.deviation;
+	e[0] = 0;
+	for (int l = 1; l < LODS; l++) {
+		int s = 1 << l;
+		e[l] = e[l - 1];
+		for (int i = 0; i <= TILE; i++) {
+			// rows of the coarse cell that contains row i
+			int ia = i / s * s;
+			if (ia == TILE) ia -= s;
+			float fi = (i - ia) / float(s);
+			for (int j = 0; j <= TILE; j++) {
+				// columns of the coarse cell that contains column j
+				int ja = j / s * s;
+				if (ja == TILE) ja -= s;
+				float fj = (j - ja) / float(s);
+				const float* c = h + ia * TILE_SIDE + ja;
+				float lower = c[0] + fj * (c[s] - c[0]);
+				float upper = c[s * TILE_SIDE] + fj * 
+				 (c[s * TILE_SIDE + s] - c[s * TILE_SIDE]);
+				float d = fabs(lower + fi * (upper - lower) - 
+				 h[i * TILE_SIDE + j]);
+				if (d > e[l])
+					e[l] = d;
+			}
+		}
+	}
+}
+
+// gradients calculates the x and z gradients of the heights of a tile
+// by central differences and stores them at gx and gz - h points to
+// the first height of the tile within a grid of heights whose rows are
+// side apart and that surrounds the tile with an apron of one height
+//
+void Terrain::gradients(const float* h, int side, float* gx, float* gz) {
+
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	for (int r = 0; r < TILE_SIDE; r++, h += side) {
+		int c = 0;
+		// four vertices at a time
+		for (; c + 4 <= TILE_SIDE; c += 4) {
+			_mm_storeu_ps(gx + c, _mm_mul_ps(half, _mm_sub_ps(
+			 _mm_loadu_ps(h + c + 1), _mm_loadu_ps(h + c - 1))));
+			_mm_storeu_ps(gz + c, _mm_mul_ps(half, _mm_sub_ps(
+			 _mm_loadu_ps(h + c + side), _mm_loadu_ps(h + c - side))));
+		}
+		for (; c < TILE_SIDE; c++) {
+			gx[c] = 0.5f * (h[c + 1] - h[c - 1]);
+			gz[c] = 0.5f * (h[c + side] - h[c - side]);
+		}
+		gx += TILE_SIDE;
+		gz += TILE_SIDE;
+	}
+}
+
+// normals calculates the unit normals of n vertices of the heightfield
+// from their gradients gx and gz and stores them at nx, ny and nz -
+// slope is the ratio of the elevation scale to the cell spacing
+//
+void Terrain::normals(const float* gx, const float* gz, float slope, 
+ float* nx, float* ny, float* nz, int n) {
+
+	const __m128 one = _mm_set1_ps(1);
+	const __m128 s   = _mm_set1_ps(-slope);
+	int i = 0;
+
+	// four vertices at a time
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_mul_ps(s, _mm_loadu_ps(gx + i));
+		__m128 z = _mm_mul_ps(s, _mm_loadu_ps(gz + i));
+		__m128 l = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(one, 
+		 _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(z, z)))));
+		_mm_storeu_ps(nx + i, _mm_mul_ps(x, l));
+		_mm_storeu_ps(ny + i, l);
+		_mm_storeu_ps(nz + i, _mm_mul_ps(z, l));
+	}
+	for (; i < n; i++) {
+		float x = - slope * gx[i], z = - slope * gz[i];
+		float l = 1.0f / sqrtf(1 + x * x + z * z);
+		nx[i] = x * l;
+		ny[i] = l;
+		nz[i] = z * l;
+	}
+}
+
+// build builds the quadtree node that bounds the tiles in columns
+// [minCol, maxCol) and rows [minRow, maxRow) and returns its index
+//
+int Terrain::build(int minCol, int minRow, int maxCol, int maxRow) {
+
+	int n;
+
+	if (maxCol - minCol == 1 && maxRow - minRow == 1) {
+		// leaf - bound the tile using its record
+		n = minRow * tileCols + minCol;
+		float x = (minCol * TILE - 0.5f * (cols - 1)) * spacing;
+		float z = (minRow * TILE - 0.5f * (rows - 1)) * spacing;
+		node[n].min  = Vector(x, depth * record[n].lo - 0.5f * depth, z);
+		node[n].max  = Vector(x + TILE * spacing, 
+		 depth * record[n].hi - 0.5f * depth, z + TILE * spacing);
+		node[n].tile = n;
+		for (int k = 0; k < 4; k++)
+			node[n].child[k] = -1;
+	}
+	else {
+		// split into up to four quadrants and bound the children
+		n = nNodes++;
+		int col[3] = { minCol, (minCol + maxCol + 1) / 2, maxCol };
+		int row[3] = { minRow, (minRow + maxRow + 1) / 2, maxRow };
+		int child[4], nc = 0;
+		for (int a = 0; a < 2; a++)
+			for (int b = 0; b < 2; b++)
+				if (col[b] < col[b + 1] && row[a] < row[a + 1])
+					child[nc++] = build(col[b], row[a], col[b + 1], 
+					 row[a + 1]);
+		node[n].min  = node[child[0]].min;
+		node[n].max  = node[child[0]].max;
+		node[n].tile = -1;
+		for (int k = 0; k < 4; k++) {
+			node[n].child[k] = k < nc ? child[k] : -1;
+			if (k < nc) {
+				const Node& c = node[child[k]];
+				if (c.min.x < node[n].min.x) node[n].min.x = c.min.x;
+				if (c.min.y < node[n].min.y) node[n].min.y = c.min.y;
+				if (c.min.z < node[n].min.z) node[n].min.z = c.min.z;
+				if (c.max.x > node[n].max.x) node[n].max.x = c.max.x;
+				if (c.max.y > node[n].max.y) node[n].max.y = c.max.y;
+				if (c.max.z > node[n].max.z) node[n].max.z = c.max.z;
+			}
+		}
+	}
+
+	return n;
+}
+
+// select uploads the tiles that the streamer has generated, finds the
+// tiles within the viewing frustum, selects the level of detail for
+// each so that its projected error does not exceed TERRAIN_PIXEL_ERROR,
+// limits the difference between neighbouring tiles to one level,
+// requests the tiles within the frustum and around the viewpoint that
+// are not resident, and gathers the ranges for the resident tiles
+// within the frustum
+//
+void Terrain::select(const Vector& viewpoint, const Frustum& frustum, 
+ float lodScale) {
+
+	if (root < 0) return;
+	frame++;
+
+	// upload the tiles that the streamer has generated
+	bool more = true;
+	while (more) {
+		int s = -1;
+		lock.enter();
+		if (nFinished)
+			s = finished[--nFinished];
+		lock.leave();
+		if (s < 0)
+			more = false;
+		else {
+			slot[s].state = READY;
+			if (graphic())
+				graphic()->update(this, s * TILE_VERTICES, TILE_VERTICES);
+		}
+	}
+
+	// gather the tiles within the frustum - tiles that have left the
+	// frustum revert to the coarsest level
+	Vector offset = position();
+	Vector eye = viewpoint - offset;
+	for (int k = 0; k < nVisible; k++)
+		lod[visible[k]] = LODS - 1;
+	nVisible = 0;
+	cull(root, frustum, offset, false);
+
+	// choose the coarsest level whose error is tolerable at the distance
+	// of the tile from the viewpoint
+	for (int k = 0; k < nVisible; k++) {
+		int t = visible[k];
+		const Vector& min = node[t].min;
+		const Vector& max = node[t].max;
+		float dx = eye.x < min.x ? min.x - eye.x : 
+		 eye.x > max.x ? eye.x - max.x : 0;
+		float dy = eye.y < min.y ? min.y - eye.y : 
+		 eye.y > max.y ? eye.y - max.y : 0;
+		float dz = eye.z < min.z ? min.z - eye.z : 
+		 eye.z > max.z ? eye.z - max.z : 0;
+		float tolerance = TERRAIN_PIXEL_ERROR * 
+		 sqrtf(dx * dx + dy * dy + dz * dz);
+		int l = 0;
+		while (l + 1 < LODS && depth * record[t].deviation[l + 1] * 
+		 lodScale <= tolerance)
+			l++;
+		lod[t] = l;
+	}
+
+	// refine tiles that are more than one level coarser than a neighbour
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int k = 0; k < nVisible; k++) {
+			int t = visible[k], r = t / tileCols, c = t % tileCols;
+			int neighbour[4] = { c > 0 ? t - 1 : -1, 
+			 r < tileRows - 1 ? t + tileCols : -1,
+			 c < tileCols - 1 ? t + 1 : -1, r > 0 ? t - tileCols : -1 };
+			for (int e = 0; e < 4; e++)
+				if (neighbour[e] >= 0 && lod[t] > lod[neighbour[e]] + 1) {
+					lod[t]  = lod[neighbour[e]] + 1;
+					changed = true;
+				}
+		}
+	}
+
+	// request the tiles within the frustum first and then those around
+	// the viewpoint
+	for (int k = 0; k < nVisible; k++)
+		request(visible[k]);
+	int c0 = int((eye.x / spacing + 0.5f * (cols - 1)) / TILE);
+	int r0 = int((eye.z / spacing + 0.5f * (rows - 1)) / TILE);
+	for (int r = r0 - TERRAIN_PREFETCH; r <= r0 + TERRAIN_PREFETCH; r++)
+		for (int c = c0 - TERRAIN_PREFETCH; c <= c0 + TERRAIN_PREFETCH; c++)
+			if (r >= 0 && r < tileRows && c >= 0 && c < tileCols)
+				request(r * tileCols + c);
+
+	// gather the ranges for the resident tiles within the frustum
+	nRanges = 0;
+	for (int k = 0; k < nVisible; k++) {
+		int t = visible[k];
+		if (resident[t] >= 0 && slot[resident[t]].state == READY)
+			addRange(t);
+	}
+}
+
+// cull adds the tiles under node n that are not outside the frustum to
+// the list of visible tiles - once a node lies entirely inside the
+// frustum, its descendants are not tested
+//
+void Terrain::cull(int n, const Frustum& frustum, const Vector& offset, 
+ bool inside) {
+
+	if (!inside) {
+		int c = classify(frustum, node[n].min + offset, 
+		 node[n].max + offset);
+		if (c < 0) return;
+		inside = c > 0;
+	}
+	if (node[n].tile >= 0)
+		visible[nVisible++] = node[n].tile;
+	else
+		for (int k = 0; k < 4 && node[n].child[k] >= 0; k++)
+			cull(node[n].child[k], frustum, offset, inside);
+}
+
+// request marks tile t as needed in the current frame and, if it is
+// not resident, assigns it a free slot or the least recently used slot
+// that neither the current frame nor the last one needs and queues the
+// slot for the streamer - if every slot is in use, the tile waits for a
+// later frame.  The slot is uploaded no sooner than the next frame, so
+// the device has finished the draws that read it before it is replaced
+//
+void Terrain::request(int t) {
+
+	if (resident[t] >= 0) {
+		slot[resident[t]].used = frame;
+		return;
+	}
+
+	int s = -1;
+	for (int k = 0; k < nSlots && (s < 0 || slot[s].state != FREE); k++)
+		if (slot[k].state == FREE || (slot[k].state == READY && 
+		 slot[k].used < frame - 1 && (s < 0 || 
+		 slot[k].used < slot[s].used)))
+			s = k;
+
+	if (s >= 0) {
+		if (slot[s].tile >= 0)
+			resident[slot[s].tile] = -1;
+		slot[s].tile  = t;
+		slot[s].state = LOADING;
+		slot[s].used  = frame;
+		resident[t]   = s;
+		lock.enter();
+		queued[(head + nQueued++) % nSlots] = s;
+		lock.leave();
+		wake.set();
+	}
+}
+
+// streamer is the entry point of the streamer thread
+//
+void Terrain::streamer(void* terrain) {
+
+	((Terrain*)terrain)->stream();
+}
+
+// stream generates the vertices for the queued slots in the order in
+// which they were queued until the terrain is destroyed
+//
+void Terrain::stream() {
+
+	while (!quit) {
+		wake.wait();
+		bool more = true;
+		while (more && !quit) {
+			int s = -1;
+			lock.enter();
+			if (nQueued) {
+				s    = queued[head];
+				head = (head + 1) % nSlots;
+				nQueued--;
+			}
+			lock.leave();
+			if (s < 0)
+				more = false;
+			else {
+				generate(s);
+				lock.enter();
+				finished[nFinished++] = s;
+				lock.leave();
+			}
+		}
+	}
+}
+
+// generate generates the vertices of the tile assigned to slot s from
+// the mapped heights and normals
+//
+void Terrain::generate(int s) {
+
+	int t  = slot[s].tile;
+	int i0 = (t / tileCols) * TILE;
+	int j0 = (t % tileCols) * TILE;
+	const float* h  = data + t * TILE_DATA;
+	const float* nx = h + TILE_VERTICES;
+	const float* ny = nx + TILE_VERTICES;
+	const float* nz = ny + TILE_VERTICES;
+    float uInc = 1.0f / (cols - 1), vInc = 1.0f / (rows - 1);
+
+	int k = s * TILE_VERTICES;
+	for (int i = i0; i <= i0 + TILE; i++)
+		for (int j = j0; j <= j0 + TILE; j++, k++, h++, nx++, ny++, nz++)
+			set(k, (j - 0.5f * (cols - 1)) * spacing, 
+			 depth * *h - 0.5f * depth, (i - 0.5f * (rows - 1)) * spacing,
+			 *nx, *ny, *nz, j * uInc, 1.0f - i * vInc);
+}
+
+// addRange adds the range that draws tile t at its selected level of
+// detail using the pattern that matches its coarser neighbours
+//
+void Terrain::addRange(int t) {
+
+	int l = lod[t], r = t / tileCols, c = t % tileCols, m = 0;
+	if (c > 0 && lod[t - 1] > l)                   m |= WEST;
+	if (r < tileRows - 1 && lod[t + tileCols] > l) m |= NORTH;
+	if (c < tileCols - 1 && lod[t + 1] > l)        m |= EAST;
+	if (r > 0 && lod[t - tileCols] > l)            m |= SOUTH;
+
+	Range& next = range[nRanges++];
+	next.baseVertex  = resident[t] * TILE_VERTICES;
+	next.nVertices   = TILE_VERTICES;
+	next.startIndex  = start[l * EDGES + m];
+	next.nPrimitives = count[l * EDGES + m];
+}
+
+// sample returns the address of the height of the grid vertex in column
+// i and row j within the mapped data - the components of its normal
+// follow at intervals of TILE_VERTICES; a vertex on an edge shared by two tiles
+// is read from the tile with the lower index
+//
+const float* Terrain::sample(int i, int j) const {
+
+	int c = i / TILE < tileCols ? i / TILE : tileCols - 1;
+	int r = j / TILE < tileRows ? j / TILE : tileRows - 1;
+
+	return data + (r * tileCols + c) * TILE_DATA + 
+	 (j - r * TILE) * TILE_SIDE + i - c * TILE;
+}
+
+// point returns the position in the local frame of the grid vertex in
+// column i and row j
+//
+Vector Terrain::point(int i, int j) const {
+
+	return Vector((i - 0.5f * (cols - 1)) * spacing, 
+	 depth * *sample(i, j) - 0.5f * depth, 
+	 (j - 0.5f * (rows - 1)) * spacing);
+}
+
+// vertexNormal returns the unit normal in the local frame of the grid
+// vertex in column i and row j
+//
+Vector Terrain::vertexNormal(int i, int j) const {
+
+	const float* h = sample(i, j);
+
+	return Vector(h[TILE_VERTICES], h[2 * TILE_VERTICES], 
+	 h[3 * TILE_VERTICES]);
+}
+
+Terrain::~Terrain() {
+
+	// stop the streamer before releasing what it uses
+	if (thread.running()) {
+		quit = true;
+		wake.set();
+		thread.join();
+	}
+
+	delete [] lod;
+	delete [] resident;
+	delete [] visible;
+	delete [] node;
+	delete [] range;
+	delete [] slot;
+	delete [] queued;
+	delete [] finished;
+}
+
+// align aligns the traversing object with the terrain by retrieving
+// the elevation of the terrain corresponding to the new position of
+// the object where delx and delz define its movements in the world x
+// and z directions respectively, by orienting the object in the
+// direction of its movement with respect to the world y axis, and
+// by inclining the object so that it moves along the face of its
+// host triangle within the terrain.
+// This function does not alter the position or orientation of the
+// object if the values of the movement parameters place the object
+// at or beyond the boundary of the terrain
+//
+void Terrain::align(IObject* object, float delx, float delz, ICameras* camera) const {
+	float tempz=delz * 3;
+	float tempx=delx * 3;
+
+    Frame* frame = (Frame*)object;
+	float dx, dz, dely, slope, mPath, mTrrn, denom;
+    Vector n, heading(0), centre = position();
+
+    // retrieve the position of the traversing object
+    Vector position = object->position();
+	// update the x and z componwents of the position
+	// the y component is determined below
+    position.x += delx;
+    position.z += delz;
+
+
+    // determine row, column indices corresponding to the new position
+    int i = int((position.x - centre.x) / spacing + (cols - 1) / 2.0f); //¹°Ã¼ÀÇ À§Ä¡¿¡¼­ ÇöÀç Å×·¹ÀÎÀÇ À§Ä¡¸¦ »©¼­ ½ºÆäÀÌ½Ì °£°ÝÀ¸·Î ³ª´«´Ù.
+    int j = int((position.z - centre.z) / spacing + (rows - 1) / 2.0f);
+
+    // ensure that traversing object is within the terrain boundaries
+    if (i >= BORDER && i < cols - BORDER && j >= BORDER && j < rows -
+		BORDER) {
+        // determine the world coordinates of the
+        // corners of the quad that contains (x,z)
+        Vector aa = point(i, j) * world();
+        Vector ab = point(i, j + 1) * world();
+        Vector bb = point(i + 1, j + 1) * world();
+        Vector ba = point(i + 1, j) * world();
+
+        // determine the quad triangle that contains the current position
+        if (abs(bb.x - aa.x) > TINY_VALUE && position.z > (bb.z - aa.z)
+         * (position.x - aa.x) / (bb.x - aa.x) + aa.z || abs(bb.x - aa.x)
+		 <= TINY_VALUE && position.x < aa.x && bb.z > aa.z) {
+            // x, z lies within the triangle aa-ab-bb
+            //
+            // determine interpolation factors with respect to ab
+            dx = (position.x - ab.x) / (bb.x - ab.x);
+            dz = (position.z - ab.z) / (aa.z - ab.z);
+            // interpolate to find the elevation of the updated position
+            dely = ab.y + dx * (bb.y - ab.y) + dz * (aa.y - ab.y) +
+			 CLEARANCE - position.y;
+            //
+            // average the stored normals at the corners of the host
+            // triangle
+            n = orientation(normal(vertexNormal(i, j) + 
+             vertexNormal(i, j + 1) + vertexNormal(i + 1, j + 1)));
+            // find inclination axis in the plane and angle of inclination
+            if (abs(delx) > TINY_VALUE || abs(delz) > TINY_VALUE) {
+                // find point xp, yp, zp along path of traversing object
+                if (abs(delx) > TINY_VALUE && abs(delz) > TINY_VALUE) {
+                    // find intersection of the path with ab-bb
+                    mPath = delz / delx;
+                    mTrrn = (bb.z - ab.z) / (bb.x - ab.x);
+                    denom = mPath - mTrrn;
+                    slope = (bb.y - ab.y) / (bb.x - ab.x);
+                    heading.x = (ab.z - aa.z - mTrrn * (ab.x - aa.x)) / denom;
+                    heading.y = slope * (heading.x - ab.x + aa.x) + ab.y - aa.y;
+                    heading.z = mPath * heading.x;
+                }
+                else if (abs(delx) < TINY_VALUE) {
+                    // path is perpendicular to ab-bb
+                    heading.x = ab.x - aa.x;
+                    heading.y = ab.y - aa.y;
+                    heading.z = ab.z - aa.z;
+                }
+                else {
+                    // path is parallel to ab-bb
+                    heading.x = bb.x - ab.x;
+                    heading.y = bb.y - ab.y;
+                    heading.z = bb.z - ab.z;
+                }
+            }
+        }
+        else {
+            // x,z lies within the triangle aa-bb-ba
+            //
+            // determine interpolation factors with respect to ba
+            dx = (position.x - ba.x) / (aa.x - ba.x);
+            dz = (position.z - ba.z) / (bb.z - ba.z);
+            // interpolate to find new elevation of the updated position
+            dely = ba.y + dx * (aa.y - ba.y) + dz * (bb.y - ba.y) + 
+			 CLEARANCE - position.y;
+            //
+            // average the stored normals at the corners of the host
+            // triangle
+            n = orientation(normal(vertexNormal(i, j) + 
+             vertexNormal(i + 1, j) + vertexNormal(i + 1, j + 1)));
+            // find inclination axis in the plane and angle of inclination
+            if (abs(delx) > TINY_VALUE || abs(delz) > TINY_VALUE) {
+                // find point xp, zp along path of traversing object
+                if (abs(delx) > TINY_VALUE && abs(delz) > TINY_VALUE) {
+                    // find intersection of path with aa-ba
+                    mPath = delz / delx;
+                    mTrrn = (ba.z - aa.z) / (ba.x - aa.x);
+                    denom = mPath - mTrrn;
+                    slope = (ba.y - aa.y) / (ba.x - aa.x);
+                    heading.x = (bb.z - ba.z - mTrrn * (bb.x - ba.x)) / denom;
+                    heading.y = slope * (heading.x - bb.x + ba.x) + bb.y - ba.y;
+                    heading.z = mPath * heading.x;
+               }
+                else if (abs(delx) < TINY_VALUE) {
+                    // path is perpendicular to aa-ba
+                    heading.x = bb.x - ba.x;
+                    heading.y = bb.y - ba.y;
+                    heading.z = bb.z - ba.z;
+                }
+                else {
+                    // path is parallel to aa-ba
+                    heading.x = ba.x - aa.x;
+                    heading.y = ba.y - aa.y;
+                    heading.z = ba.z - aa.z;
+				}
+            }
+		}
+
+        // move the traversing object to its new position
+		
+	//	Vector carHead = normal(camera->heading());
+
+	//	delx *= carHead.z;
+//		////dely *= carHead.y;
+	//	delz *= carHead.z;
+		
+		//Vector head, up, right;
+
+		//	
+		//	head = normal(camera->heading()); 
+		//	up = normal(camera->top());     
+		//	right = cross(up, head);
+
+		//	delz *= camera->heading().z;
+		//	delx = right.x
+
+		
+
+//		object->move(delx, dely, delz);
+
+
+		// restore previous orientation
+		//Matrix before = frame->restore();
+		//// determine instantaneous orientation of traversing
+		//// object with resepct to its supporting triangle and
+		//// average previous and current to suppress choppiness
+		//n = normal(Vector(before.m21, before.m22, before.m23) + n);
+		//Vector z = normal(Vector(before.m31, before.m32, before.m33) + heading);
+		//Vector x = cross(n, z);
+
+		//
+
+		//Matrix orientation(x.x, x.y, x.z, 0,
+		//	               n.x, n.y, n.z, 0,
+		//				   z.x, z.y, z.z, 0,
+		//				     0,   0,   0, 1);
+		//// orient the traversing object with 
+		//// respect to its supporting triangle
+		//frame->orient(orientation);
+		//frame->save(orientation);
+		
+
+		Vector h, u, r;
+
+			
+			h = -normal(camera->heading()); //to make look at opposite of my camera //basically this object looks at me, so I reverse it
+
+			
+			u = normal(camera->top());     
+			r = cross(u, h);
+
+		//Matrix rot(r.x, r.y, r.z, 0, 
+		//       u.x, u.y, u.z, 0, 
+		//	   h.x, h.y, h.z, 0, 
+		//	     0,   0,   0, 1);
+	
+	/*		Matrix rot(0, 0, 0, 0, 
+		       0, 0, 0, 0, 
+			   0, 0, 0, 0, 
+			     0,   0,   0, 1);*/
+
+//   vecHead.x,  dely,  vecHead.z, 1);
+//			Vector vecHead = camera->heading();		
+//			vecHead *= 3;
+
+			Vector vecHeads = normal(camera->heading());
+			Vector vecTop = normal(camera->top());
+			Vector vecRight = cross(vecTop, vecHeads);
+			
+			vecHeads *= tempz; //delx, delz·Î ÇÏ¸é ¾öÃ» ´À¸²
+			vecRight *= tempx;
+		/*
+		Matrix rot(r.x, r.y, r.z, 0, 
+		       u.x, u.y, u.z, 0, 
+		   h.x, h.y, h.z, 0, 
+		   vecHeads.x + vecRight.x,  0,  vecHeads.z + vecRight.z, 1);
+	*/
+
+	object->move(0, dely, 0);
+
+	Matrix rot(r.x, r.y, r.z, 0, 
+		       u.x, u.y, u.z, 0, 
+		   h.x, h.y, h.z, 0, 
+		   vecHeads.x + vecRight.x,  0,  vecHeads.z + vecRight.z, 1);
+
+
+
+		frame->orient(rot); 
+		frame->save(rot);
+		
+	}
+}
+
+//-------------------------------- Billboard ------------------------------
+//
+// Billboard is a two dimensional rectangle that always faces the current
+// camera 
+//
+IObject* CreateBillboard(Orientation orient, ICameras* cs, float minx, 
+ float miny, float maxx, float maxy, Colour c, ITexture* texture) {
+	
+	return new Billboard(orient, cs, minx, miny, maxx, maxy, c, texture);
+}
+
+Billboard::Billboard(Orientation orient, ICameras* cs, float minx, 
+ float miny, float maxx, float maxy, Colour c, ITexture* texture) : 
+ Object(TRIANGLE_LIST, 2, 4, c, texture, false) {
+
+	facing = Components::addFacing(placement(), cs, orient);
+
+//Object::Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
+// ITexture* texture, bool antiAlias) : 
+
+    Vector p1 = Vector(minx, miny, 0),
+           p2 = Vector(minx, maxy, 0),
+           p3 = Vector(maxx, maxy, 0),
+           p4 = Vector(maxx, miny, 0);
+
+    add(p1, p2, p3, p4, Vector(0, 0, ZAXIS_DIRECTION * -1)); 
+}
+
+// constructor creates an instance of billboard b that faces the cameras
+// cs in the same way
+//
+Billboard::Billboard(const Billboard* b, ICameras* cs, Orientation orient)
+ : Object(b) {
+
+	facing = Components::addFacing(placement(), cs, orient);
+}
+
+// instance creates a billboard that shares the quad of the current
+// billboard
+//
+Object* Billboard::instance() const {
+
+	const Facing* f = Components::facing(facing);
+
+	return f ? new Billboard(this, f->cameras, f->type) : NULL;
+}
+
+// orient orients the billboard so that its normal is parallel to the
+// direction from the billboard to the camera
+//
+void Billboard::orient() {
+
+	const Facing* f = Components::facing(facing);
+	if (f)
+		Components::face(*f);
+}
+
+// destructor removes the facing from the component store
+//
+Billboard::~Billboard() {
+
+	Components::removeFacing(facing);
+}
+
+//-------------------------------- Vertex ---------------------------------
+//
+// Vertex holds all of the data that describes a vertex
+//
+Vertex::Vertex(float xx, float yy, float zz, float nxx, float nyy,
+ float nzz, float ttu, float ttv) {
+
+    x = xx;
+    y = yy;
+    z = zz;
+    nx = nxx;
+    ny = nyy;
+    nz = nzz;
+    tu = ttu;
+    tv = ttv;
+}
+
+// position returns the vector that defines the position of the vertex
+//
+Vector Vertex::position() const {
+
+	return Vector(x, y, z);
+}
+
+//-------------------------------- Texture -------------------------------
+//
+// Texture manages a texture for a set of objects
+//
+ITexture* CreateTexture(const char* file, unsigned flags) { 
+
+	return new Texture(file, flags, Colour());
+}
+
+ITexture* CreateTexture(const char* file, unsigned flags, Colour brdrClr) { 
+
+	return new Texture(file, flags, brdrClr);
+}
+
+IScene* Texture::scene = NULL;
+
+// constructor adds a pointer to the texture to the scene and
+// creates the graphics card representation of the texture
+//
+Texture::Texture(const char* file, unsigned flags, Colour brdrClr) {
+
+	// the texture is found again by the key of the texture cache
+	handle      = NO_HANDLE;
+	key         = file ? TextureCache::key(file) : NULL;
+	this->flags = flags ? flags : OB_FLAGS;
+	border      = TextureCache::colour(brdrClr);
+	if (scene)
+		scene->add(this);
+	else
+		error("Texture 00: Couldn\'t access the scene object");
+
+	// a packed file is sampled from its atlas page, which the textures
+	// of every file on the page share
+	region_[0] = 0;
+	region_[1] = 0;
+	region_[2] = 1;
+	region_[3] = 1;
+	const char* page = Atlas::find(file, region_);
+	deviceTexture_ = CreateDeviceTexture(page ? page : file, flags,
+	 brdrClr);
+}
+
+// find returns the texture in the scene that was created from file with
+// flags and brdrClr, NULL if there is none - files are compared by the
+// normalized paths that the texture cache keys
+//
+ITexture* Texture::find(const char* file, unsigned flags, Colour brdrClr) {
+
+	Scene* s = static_cast<Scene*>(scene);
+	if (!s || !file)
+		return NULL;
+	char*     k = TextureCache::key(file);
+	unsigned  f = flags ? flags : OB_FLAGS;
+	unsigned  b = TextureCache::colour(brdrClr);
+	ITexture* found = NULL;
+	for (int i = 0; !found && i < s->texture.size(); i++) {
+		const Texture* t = static_cast<Texture*>(s->texture[i]);
+		if (t->key && t->flags == f && t->border == b && !strcmp(t->key, k))
+			found = s->texture[i];
+	}
+	delete [] k;
+
+	return found;
+}
+
+// destructor deletes the graphics card representation and removes the pointer to the
+// texture from the scene
+//
+Texture::~Texture() {
+
+	delete [] key;
+	deviceTexture_->Delete();
+	if (scene)
+		scene->remove(this);
+	else
+		error("Texture 90:: Couldn\'t access the scene object");
+}
+
+
+
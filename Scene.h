@@ -1,338 +1,588 @@
-#ifndef _SCENE_H_
-#define _SCENE_H_
-
-/* Header for the Scene Module
- *
- * consists of Scene declaration
- *             Object declaration
- *             Box declaration
- *             SoundBox declaration
- *             ViewingBox declaration
- *             Grid declaration
- *             Vertex declaration
- *             Texture declaration
- *
- * Scene.h
- * version 1.0
- * gam670/dps905
- * Jan 11 2010
- * Chris Szalwinski
- */
-
-#include "IScene.h"
-#include "Body.h"  // for Frame
-#include "Particle.h"
-
-
-
-
-
-//-------------------------------- Scene ---------------------------------
-//
-// Scene manages the scene component of the model
-//
-class IText;
-class ISound;
-class ICamera;
-enum CameraType;
-
-class Scene : public IScene {
-
-	static const int MAX_OBJECTS  = 50;
-	static const int MAX_TEXTURES = 50;
-	static const int MAX_CHAR     = 80;
-
-    IObject*   object[MAX_OBJECTS];   // points to the objects in the scene
-	ITexture*  texture[MAX_TEXTURES]; // points to the textures in the scene
-    IKeyboard* keyboard;              // points to the keyboard object
-    IMouse*    mouse;                 // points to the mouse object
-    IJoystick* joystick;              // points to the joystick object
-    IAudio*    audio;                 // points to the audio object
-	ITexture*  background;            // points to the background texture
-	IObject*   terrain;               // points to the terrain
-    IHUD*      hud;                   // points to the heads up display
-    IText*     heroX;              // points to spinner x axis orientation
-    IText*     heroY;              // points to spinner y axis orientation
-    IText*     heroZ;              // points to spinner z axis orientation
-    IText*     heroPos;              // points to spinner z axis orientation
-	ICamera*   camera;                // points to camera attached to object
-	ICamera*   heroCamera;           // points to camera attached to hero
-	ICameras*  cameras;               // points to the set of cameras
-
-	ParticleSystem* ps[10]; //particle implementation
-
-	IObject*   sun;
-	IObject*   moon;
-	
-	IObject* mainHero;
-	ITexture* tree;
-	IObject* treeObj;
-
-	int noObjects;                    // number of objects
-	int noTextures;                   // number of textures
-    int lastUpdate;                   // time that the scene was last updated
-
-	int   backgroundWidth;    // width of the background image in pixels
-	float backgroundRatio;    // height to width ratio of background image
-	float backgroundTopLeftX; // x coordinate of top left corner ofthe image
-
- 
-    Scene(const Scene& s);            // prevents copying
-    Scene& operator=(const Scene& s); // prevents assignment
-    bool    add(IObject*);
-    bool    remove(IObject*);
-    bool    add(ITexture*);
-    bool    remove(ITexture*);
-
-
-protected:
-   Scene(IKeyboard* k, IMouse* m, IJoystick* , IAudio* a, IHUD* h, ICameras* c);
-   	IObject** const objects() const { return (IObject**)object; }
-	int       numberObjects() const { return noObjects; }
-	    virtual ~Scene();
-
-  public:
-	friend IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, 
-	 IAudio* a, IHUD* h, ICameras* c);
-    bool   setup(int now);
-    void   update(int now);
-	void   drawBackground();
-    void   drawOpaque();
-	void   drawTranslucent();
-    void   suspend();
-    bool   restore(int now);
-	void   Delete() { delete this; }
-	IObject* returnCurrentHero() { return mainHero; }
-	IObject* returnCurrentTerrain() { return terrain; }
-	friend class Object;
-	friend class Texture;
-};
-
-//-------------------------------- AnimatedScene -------------------------
-//
-// AnimatedScene is a Scene with moving Objects that may collide with one
-// another
-//
-class AnimatedScene : public Scene {
-
-	IObject** const object; // points to arrays of objects
-	int noObjects;          // current number of objects
-	int lastUpdate;         // time that the scene was last updated
-
-    AnimatedScene(IKeyboard* k, IMouse* m, IJoystick* , ICameras* c,
-	 IAudio* a, IHUD* h);
-    AnimatedScene(const Scene& s);            // prevents copying
-    AnimatedScene& operator=(const Scene& s); // prevents assignment
-
-  public:
-	friend IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, 
-	 ICameras* c, IAudio* a, IHUD* h);
-    bool setup(int now);
-	void update(int now);
-    bool restore(int now);
-	friend class Object;
-};
-
-//-------------------------------- Object --------------------------------
-//
-// Object holds the information for a single object in the scene
-//
-class ISound;
-class Vertex;
-enum Shape;
-
-class Object : public Body {
-
-	static IScene* scene;  // points to the scene manager
-    IGraphic* visual;      // points to the graphic representation
-    Vertex*   vertex;      // defines unique vertices
-	short*    index;       // defines primitives in terms of vertices
-	unsigned* attribute;   // defines surfaces in terms of primitives
-	int       nPrimitives; // number of primitives in the set
-	int       nVertices;   // number of vertices currently stored
-	int       nIndices;    // number of indices currently stored
-	int       nSurfaces;   // number of surfaces currently stored
-
-    void release();
-
-	void add();                          // adds object to the scene
-    Object(const Object& o);             // prevent copies
-    Object& operator=(const Object& o);  // prevent assignment
-
-  protected:
-	Object(Shape shape, float* dimension, int* partition, Colour clr, 
-	 bool antiAlias);
-	Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
-	 ITexture* texture, bool antiAlias);
-    Object(Shape shape, int noPrimitives, int noVertices, Colour* clr, 
-	 ITexture** texture, int nSubsets, bool antiAlias);
-	Object(Shape shape, const char* filename, bool antiAlias);
-     void add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n);
-	int  add(float x, float y, float z, float nx, float ny, float nz, 
-	 float tu = 0, float tv = 0);
-    void add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n, int tu, 
-	 int tv);
-	void add(int vertex);
-	Vector local(int i) const;
-    virtual ~Object();
-
-  public:
-	friend IObject* CreateSphere(float radius, int slices, int stacks, 
-	 Colour c, bool antiAlias);
-	friend IObject* CreateCylinder(float upper, float lower, float height, 
-	 int slices, int stacks, Colour c, bool antiAlias);
-	friend IObject* CreateTorus(float inner, float outer, int slices, 
-	 int stacks, Colour c, bool antiAlias);
-	friend IObject* CreateTeapot(Colour c, bool antiAlias);
-	friend IObject* CreateXFile(const char* filename, bool antiAlias);
-	IGraphic* graphic() const { return visual; }
-	void   populateVB(void* vb) const;
-	void   populateIB(void* ib) const;
-	void   populateAB(void* ab) const;
-	void   add(ITexture* texture);
-	void   orient() {}
-	void   align(IObject*, float, float, ICameras*) const {}
-	void   Delete() { delete this; }
-//	void returnBoundingBoxMin() {}
-	
-	friend class Scene;
-};
-
-//-------------------------------- Billboard -----------------------------
-//
-// Billboard is a two dimensional rectangle that always faces the current
-// camera 
-//
-class Billboard : public Object {
-
-	ICameras* cameras; // points to the set of cameras
-	Orientation type;  // method of orientation
-
-  protected:
-	Billboard(Orientation orient, ICameras* cs, float minx, float miny, 
-	 float maxx, float maxy, Colour c, ITexture* texture);
-	virtual ~Billboard() {}
-  public:
-	friend IObject* CreateBillboard(Orientation orient, ICameras* cs, 
-	 float minx, float miny, float maxx, float maxy, Colour c,
-	 ITexture* texture);
-	void orient();
-};
-
-//-------------------------------- Box -------------------------------------
-//
-// Box is an Object identifiable by two points - lower close left, and
-// upper faraway right - and a colour
-//
-class Box : public Object {
-
-  protected:
-    Box(float minx, float miny, float minz, float maxx, float maxy,
-     float maxz, Colour c, ITexture* texture, int tu, int tv, 
-	 bool antiAlias);
-    Box(float minx, float miny, float minz, float maxx, float maxy,
-     float maxz, Colour* c, ITexture** texture, int tu, int tv, 
-	 bool antiAlias);
-	virtual ~Box() {}
-
-  public:
-	friend IObject* CreateBox(float minx, float miny, float minz, 
-	 float maxx, float maxy, float maxz, Colour c, ITexture* texture, 
-	 int tu, int tv, bool antiAlias);
-	friend IObject* CreateBox(float minx, float miny, float minz, 
-	 float maxx, float maxy, float maxz, Colour* c, ITexture** texture, 
-	 int tu, int tv, bool antiAlias);
-};
-
-//-------------------------------- Grid ------------------------------------
-//
-// Grid is a set of mutually perpendicular lines in a plane defined 
-// parallel to the x-y plane
-//
-class Grid : public Object {
-
-  protected:
-    Grid(int min, int y, int max, int n, Colour clr, bool antiAlias);
-	virtual ~Grid() {}
-
-  public:
-	friend IObject* CreateGrid(int min, int y, int max, int n, Colour clr, 
-	 bool antiAlias);
-};
-
-//-------------------------------- Terrain -------------------------------
-//
-// A Terrain is an Object that consists of a grid of triangles where the
-// height of each vertex is specified using a height map
-//
-class ifstream;
-
-class Terrain : public Object {
-
-    int rows;       // number of vertices in the z direction
-    int cols;       // number of vertices in the x direction
-    int spacing;    // spacing between vertices in either x or z direction
-//	Vector min;
-//	Vector max;
-
-	Terrain(std::ifstream& fp, unsigned width, unsigned height, 
-	 unsigned bitdepth, int cellSpacing, float depth, ITexture* tFile);
-
-    float greyScale(void* pixel, unsigned int depthInBytes);
-
-  public:
-    friend IObject* CreateTerrain(int cellSpacing, float depth, 
-	 const char* heightMap, ITexture* tFile);
-    void align(IObject* object, float dxx, float dzz, ICameras* camera) const;
-	//particle implementation
-//	void returnBoundingBoxMin() {  }
-//	Vector returnBoudningBoxMax() { return max; }
-};
-
-//-------------------------------- Vertex ----------------------------------
-//
-// Vertex holds the data that describes a single vertex of a graphics
-// primitive
-//
-class Vertex {
-
-    float x;   // x coordinate in the local frame
-    float y;   // y coordinate in the local frame
-    float z;   // z coordinate in the local frame
-    float nx;  // x coordinate of normal in local frame
-    float ny;  // y coordinate of normal in local frame
-    float nz;  // z coordinate of normal in local frame
-    float tu;  // u coordinate of texture
-    float tv;  // v coordinate of texture
-
-  public:
-    Vertex(float xx = 0, float yy = 0, float zz = 0, float nxx = 0, 
-	 float nyy = 0, float nzz = 0, float ttu = 0, float ttv = 0);
-	Vector position() const;
-};
-
-//-------------------------------- Texture -------------------------------
-//
-// A Texture holds the address of the deviceTexture for a single texture
-//
-class Texture : public ITexture {
-
-	static IScene* scene;           // points to the scene manager
-	IDeviceTexture* deviceTexture_; // points to the representation on the
-	                                // graphics card 
-
-	Texture(const char* file, unsigned flags, Colour brdrClr);
-	Texture(const Texture&);
-	Texture& operator=(const Texture&);
-	virtual ~Texture();
-
-  public:
-	friend ITexture* CreateTexture(const char* file, unsigned flags);
-	friend ITexture* CreateTexture(const char* file, unsigned flags,
-	 Colour brdrClr);
-	IDeviceTexture* deviceTexture() const { return deviceTexture_; }
-	void Delete() { delete this; }
-	friend class Scene;
-};
-
-#endif
+#ifndef _SCENE_H_
+#define _SCENE_H_
+
+/* Header for the Scene Module
+ *
+ * consists of Scene declaration
+ *             Object declaration
+ *             Box declaration
+ *             SoundBox declaration
+ *             ViewingBox declaration
+ *             Grid declaration
+ *             Vertex declaration
+ *             Texture declaration
+ *
+ * Scene.h
+ * version 1.0
+ * gam670/dps905
+ * Jan 11 2010
+ * Chris Szalwinski
+ */
+
+#include "IScene.h"
+#include "Body.h"  // for Frame
+#include "DeviceSettings.h" // for GRAPHICS_API
+#if GRAPHICS_API != HEADLESS
+#include "Particle.h" // the particle systems draw through D3DX
+#endif
+#include "SlotMap.h" // for SlotMap
+#include "Threads.h" // for Thread, Event, Lock
+#include "Files.h"   // for MappedFile
+#include "Loader.h"  // for Loader and LoadRequest
+
+
+
+
+
+//-------------------------------- Scene ---------------------------------
+//
+// Scene manages the scene component of the model
+//
+class IText;
+class ISound;
+class ICamera;
+enum CameraType;
+
+class Scene : public IScene {
+
+	static const int MAX_CHAR     = 80;
+	static const int MAX_SIDE     = 64; // cells along a side of the grid
+
+	// Sphere is the bounding sphere of an object in world space
+	struct Sphere {
+		float x, y, z; // centre
+		float r;       // radius
+	};
+
+    SlotMap<IObject*>  object;        // points to the objects in the scene
+	SlotMap<ITexture*> texture;       // points to the textures in the scene
+    IKeyboard* keyboard;              // points to the keyboard object
+    IMouse*    mouse;                 // points to the mouse object
+    IJoystick* joystick;              // points to the joystick object
+    IAudio*    audio;                 // points to the audio object
+	ITexture*  background;            // points to the background texture
+	IObject*   terrain;               // points to the terrain
+    IHUD*      hud;                   // points to the heads up display
+    IText*     heroX;              // points to spinner x axis orientation
+    IText*     heroY;              // points to spinner y axis orientation
+    IText*     heroZ;              // points to spinner z axis orientation
+    IText*     heroPos;              // points to spinner z axis orientation
+    IText*     culling;               // points to the culling counts
+	ICamera*   camera;                // points to camera attached to object
+	ICamera*   heroCamera;           // points to camera attached to hero
+	ICameras*  cameras;               // points to the set of cameras
+
+	#if GRAPHICS_API != HEADLESS
+	ParticleSystem* ps[10]; //particle implementation
+	#endif
+
+	IObject*   sun;
+	IObject*   moon;
+	
+	IObject* mainHero;
+	ITexture* tree;
+	IObject* treeObj;
+
+    int lastUpdate;                   // time that the scene was last updated
+
+	// frustum culling
+	bool*   drawn;       // is each object inside the viewing frustum?
+	Sphere* sphere;      // bounding spheres of the bounded objects
+	Sphere* sorted;      // the same spheres bucketed by grid cell
+	int*    owner;       // object bounded by each sphere
+	int*    sortedOwner; // object bounded by each bucketed sphere
+	int*    cell;        // grid cell of each sphere
+	int     capacity;    // number of objects allocated for
+	int     nDrawn;      // number of objects drawn in the last frame
+	int     nCulled;     // number of objects culled in the last frame
+	int     start[MAX_SIDE * MAX_SIDE + 1]; // first sphere in each cell
+	Vector  lo[MAX_SIDE * MAX_SIDE]; // lower bound of each cell
+	Vector  hi[MAX_SIDE * MAX_SIDE]; // upper bound of each cell
+
+	int   backgroundWidth;    // width of the background image in pixels
+	float backgroundRatio;    // height to width ratio of background image
+	float backgroundTopLeftX; // x coordinate of top left corner ofthe image
+
+ 
+    Scene(const Scene& s);            // prevents copying
+    Scene& operator=(const Scene& s); // prevents assignment
+    bool    add(IObject*);
+    bool    remove(IObject*);
+    bool    add(ITexture*);
+    bool    remove(ITexture*);
+	void    reserve(int n);
+	void    cull(const Frustum& frustum);
+	void    cull(const Frustum& frustum, const Sphere* s, const int* who,
+	 int n);
+	// objects added since the last cull have not been tested yet
+	bool    visible(int i) const { return i >= nDrawn + nCulled || drawn[i]; }
+
+
+protected:
+   Scene(IKeyboard* k, IMouse* m, IJoystick* , IAudio* a, IHUD* h, ICameras* c);
+   	const SlotMap<IObject*>& objects() const { return object; }
+	int       numberObjects() const { return object.size(); }
+	    virtual ~Scene();
+
+  public:
+	friend IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, 
+	 IAudio* a, IHUD* h, ICameras* c);
+    bool   setup(int now);
+    void   update(int now);
+	void   select(const Vector& viewpoint, const Frustum& frustum, 
+	 float lodScale);
+	void   drawBackground();
+    void   drawOpaque();
+	void   drawTranslucent();
+	void   cullCounts(int& d, int& c) const { d = nDrawn; c = nCulled; }
+    void   suspend();
+    bool   restore(int now);
+	void   Delete() { delete this; }
+	IObject* returnCurrentHero() { return mainHero; }
+	IObject* returnCurrentTerrain() { return terrain; }
+	friend class Object;
+	friend class Texture;
+};
+
+//-------------------------------- AnimatedScene -------------------------
+//
+// AnimatedScene is a Scene with moving Objects that may collide with one
+// another
+//
+class AnimatedScene : public Scene {
+
+	IObject** const object; // points to arrays of objects
+	int noObjects;          // current number of objects
+	int lastUpdate;         // time that the scene was last updated
+
+    AnimatedScene(IKeyboard* k, IMouse* m, IJoystick* , ICameras* c,
+	 IAudio* a, IHUD* h);
+    AnimatedScene(const Scene& s);            // prevents copying
+    AnimatedScene& operator=(const Scene& s); // prevents assignment
+
+  public:
+	friend IScene* CreateScene(IKeyboard* k, IMouse* m, IJoystick* j, 
+	 ICameras* c, IAudio* a, IHUD* h);
+    bool setup(int now);
+	void update(int now);
+    bool restore(int now);
+	friend class Object;
+};
+
+//-------------------------------- Object --------------------------------
+//
+// Object holds the information for a single object in the scene
+//
+class ISound;
+class Vertex;
+enum Shape;
+
+class Object : public Body {
+
+	static const int MAX_LOD = 7; // coarsest level of detail selected
+
+	static IScene* scene;  // points to the scene manager
+    IGraphic* visual;      // points to the graphic representation
+    Vertex*   vertex;      // defines unique vertices
+	unsigned* index;       // defines primitives in terms of vertices
+	unsigned* attribute;   // defines surfaces in terms of primitives
+	int       nPrimitives; // number of primitives in the set
+	int       nVertices;   // number of vertices currently stored
+	int       nIndices;    // number of indices currently stored
+	int       nSurfaces;   // number of surfaces currently stored
+	unsigned  maxIndex;    // largest index currently stored
+	Handle    handle;      // identifies the object in the scene
+	int*      users;       // objects that share the graphic and lists
+	int       lod;         // level of detail selected for the graphic
+	float     tile[4];     // region of the texture's atlas page that the
+	                       // texture coordinates address
+
+    void release();
+
+	void add();                          // adds object to the scene
+    Object(const Object& o);             // prevent copies
+    Object& operator=(const Object& o);  // prevent assignment
+
+  protected:
+	Object(Shape shape, float* dimension, int* partition, Colour clr, 
+	 bool antiAlias);
+	Object(Shape shape, int noPrimitives, int noVertices, Colour clr, 
+	 ITexture* texture, bool antiAlias);
+    Object(Shape shape, int noPrimitives, int noVertices, Colour* clr, 
+	 ITexture** texture, int nSubsets, bool antiAlias);
+	Object(Shape shape, const char* filename, bool antiAlias);
+	Object(const Object* o);
+	Object();
+	void create(Shape shape, const char* filename, bool antiAlias);
+	void create(Shape shape, int noPrimitives, int noVertices, Colour* clr,
+	 ITexture** texture, int nSubsets, bool antiAlias);
+     void add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n);
+	int  add(float x, float y, float z, float nx, float ny, float nz, 
+	 float tu = 0, float tv = 0);
+    void add(Vector p1, Vector p2, Vector p3, Vector p4, Vector n, int tu, 
+	 int tv);
+	void add(int vertex);
+	void set(int i, float x, float y, float z, float nx, float ny, 
+	 float nz, float tu = 0, float tv = 0);
+	void surface(int primitive, unsigned s);
+	void optimize(Shape shape, const char* file = NULL);
+	Vector local(int i) const;
+    virtual ~Object();
+
+  public:
+	friend IObject* CreateSphere(float radius, int slices, int stacks, 
+	 Colour c, bool antiAlias);
+	friend IObject* CreateCylinder(float upper, float lower, float height, 
+	 int slices, int stacks, Colour c, bool antiAlias);
+	friend IObject* CreateTorus(float inner, float outer, int slices, 
+	 int stacks, Colour c, bool antiAlias);
+	friend IObject* CreateTeapot(Colour c, bool antiAlias);
+	friend IObject* CreateXFile(const char* filename, bool antiAlias);
+	virtual Object* instance() const;
+	IGraphic* graphic() const { return visual; }
+	void   populateVB(void* vb) const;
+	void   populateVB(void* vb, int first, int n) const;
+	void   populateIB(void* ib) const;
+	bool   wideIndices() const { return maxIndex > 0xFFFF; }
+	bool   streamed() const { return false; }
+	void   populateAB(void* ab) const;
+	void   add(ITexture* texture);
+	void   orient() {}
+	void   align(IObject*, float, float, ICameras*) const {}
+	bool   bound(Vector& centre, float& radius);
+	void   Delete() { delete this; }
+//	void returnBoundingBoxMin() {}
+	
+	const Range* ranges(int& n) const { n = 0; return NULL; }
+	void   select(const Vector& viewpoint, const Frustum& frustum,
+	 float lodScale);
+	int    level() const { return lod; }
+	friend class Scene;
+};
+
+//-------------------------------- Billboard -----------------------------
+//
+// Billboard is a two dimensional rectangle that always faces the current
+// camera 
+//
+class Billboard : public Object {
+
+	Handle facing;     // identifies the orientation towards the camera
+
+  protected:
+	Billboard(Orientation orient, ICameras* cs, float minx, float miny, 
+	 float maxx, float maxy, Colour c, ITexture* texture);
+	Billboard(const Billboard* b, ICameras* cs, Orientation orient);
+	virtual ~Billboard();
+  public:
+	friend IObject* CreateBillboard(Orientation orient, ICameras* cs, 
+	 float minx, float miny, float maxx, float maxy, Colour c,
+	 ITexture* texture);
+	Object* instance() const;
+	void orient();
+};
+
+//-------------------------------- Box -------------------------------------
+//
+// Box is an Object identifiable by two points - lower close left, and
+// upper faraway right - and a colour
+//
+class Box : public Object {
+
+  protected:
+    Box(float minx, float miny, float minz, float maxx, float maxy,
+     float maxz, Colour c, ITexture* texture, int tu, int tv, 
+	 bool antiAlias);
+    Box(float minx, float miny, float minz, float maxx, float maxy,
+     float maxz, Colour* c, ITexture** texture, int tu, int tv, 
+	 bool antiAlias);
+	virtual ~Box() {}
+
+  public:
+	friend IObject* CreateBox(float minx, float miny, float minz, 
+	 float maxx, float maxy, float maxz, Colour c, ITexture* texture, 
+	 int tu, int tv, bool antiAlias);
+	friend IObject* CreateBox(float minx, float miny, float minz, 
+	 float maxx, float maxy, float maxz, Colour* c, ITexture** texture, 
+	 int tu, int tv, bool antiAlias);
+};
+
+//-------------------------------- Model -----------------------------------
+//
+// Model is an Object read from a mesh file by the native mesh loader - 
+// one surface for each material of the file.  The file is read on a
+// loader thread and the model has no graphic until it has been read
+//
+struct MeshData;
+class ModelLoad;
+
+class Model : public Object {
+
+	char*      file;      // name of the mesh file
+	bool       antiAlias; // antialias the graphic?
+	ModelLoad* loading;   // reads the mesh file, NULL if idle
+
+  protected:
+	Model(const char* file, bool antiAlias);
+	virtual ~Model();
+
+  public:
+	friend IObject* CreateXFile(const char* filename, bool antiAlias);
+	Object* instance() const;
+	void    loaded(const MeshData& mesh, bool read);
+};
+
+//-------------------------------- ModelLoad -----------------------------
+//
+// ModelLoad reads a mesh file on a loader thread and hands its lists to
+// the waiting model on the render thread.  load() never reads the model,
+// so a model deleted while its file is loading does not race the loader
+// thread
+//
+class ModelLoad : public LoadRequest {
+
+	char*     file;  // name of the mesh file
+	MeshData* mesh;  // lists read from the file
+	bool      tried; // has a loader thread tried to read the file?
+	bool      read;  // were the lists read?
+	Model*    model; // model waiting for the lists, NULL if none
+
+	ModelLoad(const ModelLoad&);            // prevents copying
+	ModelLoad& operator=(const ModelLoad&); // prevents assignment
+
+  public:
+	ModelLoad(const char* file, Model* m);
+	void load();
+	void finish();
+	void cancel() { model = NULL; }
+	virtual ~ModelLoad();
+};
+
+//-------------------------------- Grid ------------------------------------
+//
+// Grid is a set of mutually perpendicular lines in a plane defined 
+// parallel to the x-y plane
+//
+class Grid : public Object {
+
+  protected:
+    Grid(int min, int y, int max, int n, Colour clr, bool antiAlias);
+	virtual ~Grid() {}
+
+  public:
+	friend IObject* CreateGrid(int min, int y, int max, int n, Colour clr, 
+	 bool antiAlias);
+};
+
+//-------------------------------- Terrain -------------------------------
+//
+// A Terrain is an Object that consists of a grid of triangles where the
+// height of each vertex is specified using a height map
+//
+// The grid is split into square tiles of TILE x TILE cells.  Each tile
+// is drawn at one of LODS levels of detail that share a single set of
+// index patterns, and a quadtree over the tiles culls those that lie
+// outside the viewing frustum
+//
+// The heights and normals are read from a tiled copy of the height map
+// that is mapped into memory and rebuilt only when the height map, the
+// cell spacing or the depth changes.  A streamer thread generates the vertices of the
+// tiles around the viewpoint into a fixed pool of slots in the vertex
+// buffer, reusing the least recently used slots
+//
+class ifstream;
+struct HeightMap;
+
+class Terrain : public Object {
+
+	static const int TILE          = 32;  // cells along the side of a tile
+	static const int TILE_SIDE     = TILE + 1;
+	static const int TILE_VERTICES = TILE_SIDE * TILE_SIDE;
+	static const int TILE_DATA     = 4 * TILE_VERTICES; // heights, normals
+	static const int LODS          = 5;   // levels of detail per tile
+	static const int EDGES         = 16;  // combinations of coarser edges
+	static const int VERSION       = 7;   // version of the tiled format
+	static const int MAX_CHAR      = 127; // characters in a report
+
+	// edges of a tile that border a coarser neighbour
+	enum Edge { WEST = 1, NORTH = 2, EAST = 4, SOUTH = 8 };
+
+	// states of a slot in the vertex buffer
+	enum State { FREE, LOADING, READY };
+
+	// Header describes the contents of a tiled height file
+	struct Header {
+		char magic[4];    // identifies a tiled height file
+		int  version;     // version of the tiled format
+		unsigned key[3];  // stamp of the height map - its size and time
+		int  spacing;     // cell spacing used to build the normals
+		float depth;      // elevation scale used to build the normals
+		int  width;       // width of the height map in pixels
+		int  height;      // height of the height map in pixels
+		int  tileCols;    // number of tiles in the x direction
+		int  tileRows;    // number of tiles in the z direction
+	};
+
+	// Record holds the summary of a single tile in a tiled height file
+	// - the heights are in the range [0.0f, 1.0f]
+	struct Record {
+		float lo;               // lowest height in the tile
+		float hi;               // highest height in the tile
+		float deviation[LODS];  // geometric error at each level
+	};
+
+	// Node is a node of the quadtree that bounds the tiles
+	struct Node {
+		Vector min;   // lower bound of the node in the local frame
+		Vector max;   // upper bound of the node in the local frame
+		int child[4]; // indices of the child nodes, -1 if none
+		int tile;     // index of the tile for a leaf node, -1 otherwise
+	};
+
+	// Slot holds the state of a block of TILE_VERTICES vertices
+	struct Slot {
+		int tile;     // tile stored in the slot, -1 if none
+		int state;    // FREE, LOADING or READY
+		int used;     // frame in which the tile was last needed
+	};
+
+    int rows;       // number of vertices in the z direction
+    int cols;       // number of vertices in the x direction
+    int spacing;    // spacing between vertices in either x or z direction
+	float depth;    // difference in elevation between white and black
+	int tileRows;   // number of tiles in the z direction
+	int tileCols;   // number of tiles in the x direction
+	int nNodes;     // number of nodes in the quadtree
+	int root;       // index of the root node of the quadtree
+	int nRanges;    // number of tiles selected for drawing
+	int nVisible;   // number of tiles within the frustum
+	int nSlots;     // number of slots in the vertex buffer
+	int frame;      // number of selections so far
+	int*   lod;       // level of detail selected for each tile
+	int*   resident;  // slot that holds each tile, -1 if none
+	int*   visible;   // tiles within the frustum
+	Node*  node;      // quadtree nodes - the leaves come first
+	Range* range;     // ranges selected for drawing
+	Slot*  slot;      // slots in the vertex buffer
+	int start[LODS * EDGES]; // first index of each pattern
+	int count[LODS * EDGES]; // number of primitives in each pattern
+
+	MappedFile file;      // tiled height file, mapped into memory
+	const Record* record; // summary of each tile in the mapped file
+	const float* data;    // heights and normals of each tile in the
+	                      // mapped file
+
+	Thread thread;           // streamer thread
+	Event  wake;             // signals the streamer that work is queued
+	Lock   lock;             // guards the queues
+	volatile bool quit;      // tells the streamer to finish
+	int* queued;             // slots awaiting generation
+	int* finished;           // slots generated but not yet uploaded
+	int  nQueued;            // number of slots awaiting generation
+	int  head;               // position of the oldest queued slot
+	int  nFinished;          // number of slots awaiting upload
+
+	Terrain(const char* tiledFile, const Header& header, int cellSpacing, 
+	 float depth, ITexture* tFile);
+	Terrain(const Terrain&);            // prevents copying
+	Terrain& operator=(const Terrain&); // prevents assignment
+	virtual ~Terrain();
+
+	static int tiles(unsigned n) { return (n + TILE - 2) / TILE; }
+	static int patternPrimitives();
+	static int slots(const Header& h);
+	static unsigned fileSize(const Header& header);
+	static bool current(const char* tiledFile, const unsigned* key, 
+	 int spacing, float depth, Header& header);
+	static bool convert(std::ifstream& fp, const HeightMap& format,
+	 const unsigned* key, int spacing, float depth, const char* tiledFile, 
+	 Header& header);
+	static void measure(const float* h, Record& r);
+	static void gradients(const float* h, int side, float* gx, float* gz);
+	static void normals(const float* gx, const float* gz, float slope, 
+	 float* nx, float* ny, float* nz, int n);
+	static void streamer(void* terrain);
+	static void patterns(unsigned* index, int* start, int* count,
+	 float& before, float& after);
+	bool  map(const char* tiledFile, const Header& header);
+	int   build(int minCol, int minRow, int maxCol, int maxRow);
+	void  cull(int n, const Frustum& frustum, const Vector& offset, 
+	 bool inside);
+	void  request(int tile);
+	void  generate(int s);
+	void  stream();
+	void  addRange(int tile);
+	const float* sample(int i, int j) const;
+	Vector point(int i, int j) const;
+	Vector vertexNormal(int i, int j) const;
+
+  public:
+    friend IObject* CreateTerrain(int cellSpacing, float depth, 
+	 const char* heightMap, ITexture* tFile);
+	Object* instance() const { return NULL; } // streams its own tiles
+	const Range* ranges(int& n) const { n = nRanges; return range; }
+	// the vertices of a slot are replaced while the others are drawn
+	bool streamed() const { return true; }
+	void select(const Vector& viewpoint, const Frustum& frustum, 
+	 float lodScale);
+    void align(IObject* object, float dxx, float dzz, ICameras* camera) const;
+};
+
+//-------------------------------- Vertex ----------------------------------
+//
+// Vertex holds the data that describes a single vertex of a graphics
+// primitive
+//
+class Vertex {
+
+    float x;   // x coordinate in the local frame
+    float y;   // y coordinate in the local frame
+    float z;   // z coordinate in the local frame
+    float nx;  // x coordinate of normal in local frame
+    float ny;  // y coordinate of normal in local frame
+    float nz;  // z coordinate of normal in local frame
+    float tu;  // u coordinate of texture
+    float tv;  // v coordinate of texture
+
+  public:
+    Vertex(float xx = 0, float yy = 0, float zz = 0, float nxx = 0, 
+	 float nyy = 0, float nzz = 0, float ttu = 0, float ttv = 0);
+	Vector position() const;
+};
+
+//-------------------------------- Texture -------------------------------
+//
+// A Texture holds the address of the deviceTexture for a single texture
+// - the page's deviceTexture if the texture's file is packed into an
+// atlas page
+//
+class Texture : public ITexture {
+
+	static IScene* scene;           // points to the scene manager
+	IDeviceTexture* deviceTexture_; // points to the representation on the
+	                                // graphics card 
+	Handle handle;                  // identifies the texture in the scene
+	char*    key;                   // normalized name of the texture file
+	unsigned flags;                 // sampling flags
+	unsigned border;                // packed border colour
+	float  region_[4];              // left, top, width and height of the
+	                                // file in its atlas page - the whole
+	                                // texture if the file is not packed
+
+	Texture(const char* file, unsigned flags, Colour brdrClr);
+	Texture(const Texture&);
+	Texture& operator=(const Texture&);
+	virtual ~Texture();
+
+  public:
+	friend ITexture* CreateTexture(const char* file, unsigned flags);
+	friend ITexture* CreateTexture(const char* file, unsigned flags,
+	 Colour brdrClr);
+	static ITexture* find(const char* file, unsigned flags, Colour brdrClr);
+	IDeviceTexture* deviceTexture() const { return deviceTexture_; }
+	const float* region() const { return region_; }
+	void Delete() { delete this; }
+	friend class Scene;
+};
+
+#endif
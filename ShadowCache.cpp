@@ -0,0 +1,75 @@
+/* ShadowCache Module Implementation
+ *
+ * ShadowCache.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "ShadowCache.h" // for ShadowCache
+
+#if GRAPHICS_API == DIRECT3D
+#include <new>           // for std::nothrow
+#include "Utilities.h"   // for report(), ticks() and microseconds()
+
+//-------------------------------- ShadowCache ---------------------------
+//
+// ShadowCache accounts for the system memory copies of device resources
+//
+int      ShadowCache::held      = 0;
+int      ShadowCache::nRestored = 0;
+int      ShadowCache::restored_ = 0;
+LONGLONG ShadowCache::start     = 0;
+
+// allocate returns a shadow of size bytes, or NULL if the shadow would
+// exceed the budget
+//
+char* ShadowCache::allocate(int size) {
+
+	char* data = NULL;
+	if (size > 0 && held + size <= SHADOW_BUDGET &&
+	 (data = new (std::nothrow) char[size]) != NULL)
+		held += size;
+
+	return data;
+}
+
+// free releases shadow data of size bytes
+//
+void ShadowCache::free(char*& data, int size) {
+
+	if (data) {
+		delete [] data;
+		data  = NULL;
+		held -= size;
+	}
+}
+
+// begin starts timing a restore
+//
+void ShadowCache::begin() {
+
+	nRestored = 0;
+	restored_ = 0;
+	start     = ticks();
+}
+
+// restored adds a resource of size bytes to the restore
+//
+void ShadowCache::restored(int size) {
+
+	nRestored++;
+	restored_ += size;
+}
+
+// end reports the time and the volume of the restore
+//
+void ShadowCache::end() {
+
+	char str[120];
+	wsprintf(str, "Restore: %d resources, %d KB from shadows in %d us"
+	 " - %d KB held", nRestored, restored_ / 1024,
+	 microseconds(start, ticks()), held / 1024);
+	report(str);
+}
+#endif
@@ -0,0 +1,48 @@
+#ifndef _SHADOW_CACHE_H_
+#define _SHADOW_CACHE_H_
+
+/* Header for the ShadowCache Module
+ *
+ * consists of ShadowCache declaration
+ *
+ * ShadowCache.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API and SHADOW_BUDGET
+
+#if GRAPHICS_API == DIRECT3D
+#include <windows.h>        // for LONGLONG
+
+//-------------------------------- ShadowCache ---------------------------
+//
+// ShadowCache accounts for the copies of uploaded geometry that graphics
+// keep in system memory - the shadows - so that a lost device can be
+// restored from memory rather than from the objects.  Only resources in
+// the default pool are shadowed - the runtime keeps its own copy of a
+// managed resource, such as a texture, and restores it with the device
+//
+// The cache holds at most SHADOW_BUDGET bytes.  A resource that does not
+// fit keeps no shadow and is rebuilt lazily as before.  begin() and end()
+// bracket a restore and report its time and volume to report.log
+//
+class ShadowCache {
+
+	static int      held;      // bytes held in shadows
+	static int      nRestored; // resources re-uploaded in this restore
+	static int      restored_; // bytes re-uploaded in this restore
+	static LONGLONG start;     // counter reading at the start of restore
+
+  public:
+	static char* allocate(int size);
+	static void  free(char*& data, int size);
+	static void  begin();
+	static void  restored(int size);
+	static void  end();
+	static int   bytes() { return held; }
+};
+#endif
+
+#endif
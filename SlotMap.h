@@ -0,0 +1,189 @@
+#ifndef _SLOT_MAP_H_
+#define _SLOT_MAP_H_
+
+/* Header for the SlotMap Container
+ *
+ * consists of Handle declaration
+ *             SlotMap template
+ *
+ * SlotMap.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Handle --------------------------------
+//
+// A Handle identifies an item in a SlotMap - the low SLOT_BITS bits hold
+// the slot that refers to the item and the high bits hold the generation
+// of that slot when the item was added.  A handle that outlives its item
+// no longer matches the generation of its slot and is rejected
+//
+typedef unsigned Handle;
+
+const Handle NO_HANDLE = 0; // never identifies an item
+
+//-------------------------------- SlotMap -------------------------------
+//
+// A SlotMap stores its items contiguously for iteration and adds and
+// removes them in constant time - removal moves the last item into the
+// hole, so the order of the items is not preserved
+//
+template <class T>
+class SlotMap {
+
+	static const int      SLOT_BITS   = 20;
+	static const unsigned SLOT_MASK   = (1u << SLOT_BITS) - 1;
+	static const int      MAX_ITEMS   = 1 << SLOT_BITS;
+	static const int      MIN_ITEMS   = 16;
+
+	T*        item;       // items packed at the front of the array
+	int*      owner;      // slot that refers to each item
+	int*      position;   // position of the item for each slot in use,
+	                      // next free slot for each free slot
+	unsigned* generation; // generation of each slot
+	int       n;          // number of items
+	int       nSlots;     // number of slots used so far
+	int       capacity;   // number of items and slots allocated
+	int       free;       // most recently freed slot, -1 if none
+
+	SlotMap(const SlotMap&);            // prevents copying
+	SlotMap& operator=(const SlotMap&); // prevents assignment
+	bool grow();
+	int  slot(Handle h) const;
+
+  public:
+	SlotMap() : item(0), owner(0), position(0), generation(0), n(0),
+	 nSlots(0), capacity(0), free(-1) {}
+	~SlotMap();
+	Handle add(const T& t);
+	bool   remove(Handle h);
+	bool   contains(Handle h) const { return slot(h) >= 0; }
+	T*     find(Handle h);
+	int    size() const { return n; }
+	T&       operator[](int i)       { return item[i]; }
+	const T& operator[](int i) const { return item[i]; }
+};
+
+// grow doubles the space allocated for items and slots and returns true
+// if successful, false if the map is full
+//
+template <class T>
+bool SlotMap<T>::grow() {
+
+	if (capacity == MAX_ITEMS)
+		return false;
+
+	int c = capacity ? 2 * capacity : MIN_ITEMS;
+	T*        i = new T[c];
+	int*      o = new int[c];
+	int*      p = new int[c];
+	unsigned* g = new unsigned[c];
+	for (int k = 0; k < n; k++) {
+		i[k] = item[k];
+		o[k] = owner[k];
+	}
+	for (int k = 0; k < nSlots; k++) {
+		p[k] = position[k];
+		g[k] = generation[k];
+	}
+	delete [] item;
+	delete [] owner;
+	delete [] position;
+	delete [] generation;
+	item       = i;
+	owner      = o;
+	position   = p;
+	generation = g;
+	capacity   = c;
+
+	return true;
+}
+
+// slot returns the slot identified by handle h, -1 if h does not
+// identify an item in the map
+//
+template <class T>
+int SlotMap<T>::slot(Handle h) const {
+
+	int s = (int)(h & SLOT_MASK);
+
+	return h != NO_HANDLE && s < nSlots && 
+	 generation[s] == h >> SLOT_BITS ? s : -1;
+}
+
+// add adds a copy of t to the map and returns its handle, NO_HANDLE if
+// the map is full
+//
+template <class T>
+Handle SlotMap<T>::add(const T& t) {
+
+	int s;
+	if (free >= 0) {
+		s    = free;
+		free = position[s];
+	}
+	else if (nSlots < capacity || grow()) {
+		s = nSlots++;
+		generation[s] = 1;
+	}
+	else
+		return NO_HANDLE;
+
+	item[n]     = t;
+	owner[n]    = s;
+	position[s] = n++;
+
+	return generation[s] << SLOT_BITS | s;
+}
+
+// remove removes the item identified by h from the map and returns true
+// if successful, false if h does not identify an item in the map
+//
+template <class T>
+bool SlotMap<T>::remove(Handle h) {
+
+	int s = slot(h);
+	if (s < 0)
+		return false;
+
+	// move the last item into the hole
+	int p = position[s];
+	if (p != --n) {
+		item[p]            = item[n];
+		owner[p]           = owner[n];
+		position[owner[p]] = p;
+	}
+	position[s] = free;
+	free        = s;
+
+	// retire the handle - generation 0 is skipped so that no handle
+	// equals NO_HANDLE
+	generation[s] = (generation[s] + 1) & (~0u >> SLOT_BITS);
+	if (!generation[s])
+		generation[s] = 1;
+
+	return true;
+}
+
+// find returns the address of the item identified by h, NULL if h does
+// not identify an item in the map
+//
+template <class T>
+T* SlotMap<T>::find(Handle h) {
+
+	int s = slot(h);
+
+	return s >= 0 ? item + position[s] : 0;
+}
+
+template <class T>
+SlotMap<T>::~SlotMap() {
+
+	delete [] item;
+	delete [] owner;
+	delete [] position;
+	delete [] generation;
+}
+
+#endif
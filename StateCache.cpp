@@ -0,0 +1,242 @@
+/* StateCache Module Implementation
+ *
+ * StateCache.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "StateCache.h" // for StateCache
+
+#if GRAPHICS_API == DIRECT3D
+#include <cstring> // for memcmp, memset
+
+//-------------------------------- StateCache ----------------------------
+//
+// StateCache shadows the state of the display device and drops redundant
+// calls
+//
+LPDIRECT3DDEVICE9 StateCache::d3dd = NULL;
+
+DWORD StateCache::render[MAX_RENDER_STATES];
+bool  StateCache::renderKnown[MAX_RENDER_STATES];
+DWORD StateCache::sampler[MAX_SAMPLERS][MAX_SAMPLER_STATES];
+bool  StateCache::samplerKnown[MAX_SAMPLERS][MAX_SAMPLER_STATES];
+DWORD StateCache::stage[MAX_STAGES][MAX_STAGE_STATES];
+bool  StateCache::stageKnown[MAX_STAGES][MAX_STAGE_STATES];
+IDirect3DBaseTexture9* StateCache::texture_[MAX_SAMPLERS];
+bool  StateCache::textureKnown[MAX_SAMPLERS];
+D3DMATERIAL9 StateCache::material_;
+bool  StateCache::materialKnown = false;
+D3DMATRIX StateCache::transform_[MAX_TRANSFORMS];
+bool  StateCache::transformKnown[MAX_TRANSFORMS];
+DWORD StateCache::fvf_          = 0;
+bool  StateCache::fvfKnown      = false;
+IDirect3DVertexBuffer9* StateCache::vb = NULL;
+UINT  StateCache::stride        = 0;
+bool  StateCache::streamKnown   = false;
+IDirect3DIndexBuffer9* StateCache::ib = NULL;
+bool  StateCache::indicesKnown  = false;
+
+int StateCache::issued     = 0;
+int StateCache::saved      = 0;
+int StateCache::lastIssued = 0;
+int StateCache::lastSaved  = 0;
+
+// attach shadows display device d, which holds unknown state
+//
+void StateCache::attach(LPDIRECT3DDEVICE9 d) {
+
+	d3dd = d;
+	forget();
+}
+
+// forget marks every state as unknown - call after the device has been
+// reset or its state has been changed without the cache
+//
+void StateCache::forget() {
+
+	memset(renderKnown, 0, sizeof renderKnown);
+	memset(samplerKnown, 0, sizeof samplerKnown);
+	memset(stageKnown, 0, sizeof stageKnown);
+	memset(textureKnown, 0, sizeof textureKnown);
+	memset(transformKnown, 0, sizeof transformKnown);
+	materialKnown = false;
+	forgetGeometry();
+}
+
+// forgetGeometry marks the vertex format, stream source and indices as
+// unknown - call after a D3DX mesh has drawn itself
+//
+void StateCache::forgetGeometry() {
+
+	fvfKnown     = false;
+	streamKnown  = false;
+	indicesKnown = false;
+}
+
+// renderState sets render state s to value v
+//
+void StateCache::renderState(D3DRENDERSTATETYPE s, DWORD v) {
+
+	if (s < MAX_RENDER_STATES && renderKnown[s] && render[s] == v)
+		saved++;
+	else {
+		d3dd->SetRenderState(s, v);
+		if (s < MAX_RENDER_STATES) {
+			render[s]      = v;
+			renderKnown[s] = true;
+		}
+		issued++;
+	}
+}
+
+// samplerState sets state s of sampler i to value v
+//
+void StateCache::samplerState(DWORD i, D3DSAMPLERSTATETYPE s, DWORD v) {
+
+	bool cached = i < MAX_SAMPLERS && s < MAX_SAMPLER_STATES;
+	if (cached && samplerKnown[i][s] && sampler[i][s] == v)
+		saved++;
+	else {
+		d3dd->SetSamplerState(i, s, v);
+		if (cached) {
+			sampler[i][s]      = v;
+			samplerKnown[i][s] = true;
+		}
+		issued++;
+	}
+}
+
+// stageState sets state s of texture stage i to value v
+//
+void StateCache::stageState(DWORD i, D3DTEXTURESTAGESTATETYPE s, DWORD v) {
+
+	bool cached = i < MAX_STAGES && s < MAX_STAGE_STATES;
+	if (cached && stageKnown[i][s] && stage[i][s] == v)
+		saved++;
+	else {
+		d3dd->SetTextureStageState(i, s, v);
+		if (cached) {
+			stage[i][s]      = v;
+			stageKnown[i][s] = true;
+		}
+		issued++;
+	}
+}
+
+// texture binds texture t to sampler i
+//
+void StateCache::texture(DWORD i, IDirect3DBaseTexture9* t) {
+
+	if (i < MAX_SAMPLERS && textureKnown[i] && texture_[i] == t)
+		saved++;
+	else {
+		d3dd->SetTexture(i, t);
+		if (i < MAX_SAMPLERS) {
+			texture_[i]     = t;
+			textureKnown[i] = true;
+		}
+		issued++;
+	}
+}
+
+// material sets the material reflectivity to *m
+//
+void StateCache::material(const D3DMATERIAL9* m) {
+
+	if (materialKnown && !memcmp(&material_, m, sizeof material_))
+		saved++;
+	else {
+		d3dd->SetMaterial(m);
+		material_     = *m;
+		materialKnown = true;
+		issued++;
+	}
+}
+
+// slot returns the cache slot for transformation t, -1 if t is not
+// cached
+//
+int StateCache::slot(D3DTRANSFORMSTATETYPE t) {
+
+	switch (t) {
+		case D3DTS_VIEW:       return 0;
+		case D3DTS_PROJECTION: return 1;
+		case D3DTS_WORLD:      return 2;
+		default:               return -1;
+	}
+}
+
+// transform sets transformation t to matrix *m
+//
+void StateCache::transform(D3DTRANSFORMSTATETYPE t, const D3DMATRIX* m) {
+
+	int i = slot(t);
+	if (i >= 0 && transformKnown[i] &&
+	 !memcmp(&transform_[i], m, sizeof transform_[i]))
+		saved++;
+	else {
+		d3dd->SetTransform(t, m);
+		if (i >= 0) {
+			transform_[i]     = *m;
+			transformKnown[i] = true;
+		}
+		issued++;
+	}
+}
+
+// fvf sets the flexible vertex format to f
+//
+void StateCache::fvf(DWORD f) {
+
+	if (fvfKnown && fvf_ == f)
+		saved++;
+	else {
+		d3dd->SetFVF(f);
+		fvf_     = f;
+		fvfKnown = true;
+		issued++;
+	}
+}
+
+// stream sets vertex buffer v holding vertices of the given size as the
+// source of stream 0
+//
+void StateCache::stream(IDirect3DVertexBuffer9* v, UINT size) {
+
+	if (streamKnown && vb == v && stride == size)
+		saved++;
+	else {
+		d3dd->SetStreamSource(0, v, 0, size);
+		vb          = v;
+		stride      = size;
+		streamKnown = true;
+		issued++;
+	}
+}
+
+// indices sets index buffer i
+//
+void StateCache::indices(IDirect3DIndexBuffer9* i) {
+
+	if (indicesKnown && ib == i)
+		saved++;
+	else {
+		d3dd->SetIndices(i);
+		ib           = i;
+		indicesKnown = true;
+		issued++;
+	}
+}
+
+// endFrame closes the counts for the current frame and starts new ones
+//
+void StateCache::endFrame() {
+
+	lastIssued = issued;
+	lastSaved  = saved;
+	issued     = 0;
+	saved      = 0;
+}
+#endif
@@ -0,0 +1,87 @@
+#ifndef _STATE_CACHE_H_
+#define _STATE_CACHE_H_
+
+/* Header for the StateCache Module
+ *
+ * consists of StateCache declaration
+ *
+ * StateCache.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for GRAPHICS_API
+
+#if GRAPHICS_API == DIRECT3D
+#include <d3d9.h> // for basic D3D
+
+//-------------------------------- StateCache ----------------------------
+//
+// StateCache shadows the state of the display device and drops each call
+// that would set a state to the value that it already holds - the cache
+// counts the calls that it passes to the device and the calls that it
+// saves
+//
+// A state that the cache has not seen set is unknown and the next call
+// that sets it always reaches the device.  Code that changes the device
+// behind the cache's back must call forget() or forgetGeometry()
+//
+class StateCache {
+
+	static const int MAX_RENDER_STATES  = 256; // D3DRS_ values
+	static const int MAX_SAMPLERS       = 16;  // pixel shader samplers
+	static const int MAX_SAMPLER_STATES = 14;  // D3DSAMP_ values
+	static const int MAX_STAGES         = 8;   // texture stages
+	static const int MAX_STAGE_STATES   = 33;  // D3DTSS_ values
+	static const int MAX_TRANSFORMS     = 3;   // view, projection, world
+
+	static LPDIRECT3DDEVICE9 d3dd; // Direct3D display device
+
+	static DWORD render[MAX_RENDER_STATES];
+	static bool  renderKnown[MAX_RENDER_STATES];
+	static DWORD sampler[MAX_SAMPLERS][MAX_SAMPLER_STATES];
+	static bool  samplerKnown[MAX_SAMPLERS][MAX_SAMPLER_STATES];
+	static DWORD stage[MAX_STAGES][MAX_STAGE_STATES];
+	static bool  stageKnown[MAX_STAGES][MAX_STAGE_STATES];
+	static IDirect3DBaseTexture9* texture_[MAX_SAMPLERS];
+	static bool  textureKnown[MAX_SAMPLERS];
+	static D3DMATERIAL9 material_;
+	static bool  materialKnown;
+	static D3DMATRIX transform_[MAX_TRANSFORMS];
+	static bool  transformKnown[MAX_TRANSFORMS];
+	static DWORD fvf_;
+	static bool  fvfKnown;
+	static IDirect3DVertexBuffer9* vb;
+	static UINT  stride;
+	static bool  streamKnown;
+	static IDirect3DIndexBuffer9* ib;
+	static bool  indicesKnown;
+
+	static int issued;     // calls passed to the device this frame
+	static int saved;      // calls dropped this frame
+	static int lastIssued; // calls passed to the device last frame
+	static int lastSaved;  // calls dropped last frame
+
+	static int slot(D3DTRANSFORMSTATETYPE t);
+
+  public:
+	static void attach(LPDIRECT3DDEVICE9 d);
+	static void forget();
+	static void forgetGeometry();
+	static void renderState(D3DRENDERSTATETYPE s, DWORD v);
+	static void samplerState(DWORD i, D3DSAMPLERSTATETYPE s, DWORD v);
+	static void stageState(DWORD i, D3DTEXTURESTAGESTATETYPE s, DWORD v);
+	static void texture(DWORD i, IDirect3DBaseTexture9* t);
+	static void material(const D3DMATERIAL9* m);
+	static void transform(D3DTRANSFORMSTATETYPE t, const D3DMATRIX* m);
+	static void fvf(DWORD f);
+	static void stream(IDirect3DVertexBuffer9* v, UINT size);
+	static void indices(IDirect3DIndexBuffer9* i);
+	static void endFrame();
+	static int  callsIssued() { return lastIssued; }
+	static int  callsSaved()  { return lastSaved; }
+};
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+/* TextureBaker Module Implementation
+ *
+ * TextureBaker.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio>                // for fopen, fread, fwrite, sprintf
+#include <cstring>               // for memcpy, memset, memcmp
+#include "DeviceSettings.h"      // for TEXTURE_BAKE, TEXTURE_BAKE_EXT
+#include "Utilities.h"           // for report(), strcopy(), ticks()
+#include "TextureCompressor.h"   // for buildMipChain, compressImage
+#include "Files.h"               // for fileStamp, tempName, replaceFile
+#include "TextureBaker.h"        // for texture baking functions
+
+const unsigned BAKE_VERSION = 1; // version of the baked format
+const unsigned BAKE_MAGIC   = 'B' | 'A' << 8 | 'K' << 16 | 'E' << 24;
+
+//-------------------------------- Baked Files ---------------------------
+//
+// A baked file is a DDS file whose reserved header words hold BAKE_MAGIC,
+// BAKE_VERSION and the stamp of the texture file it was baked from.  A
+// file of baked data leads with the same words and the size of its data
+//
+const int DDS_HEADER  = 128; // bytes in the header of a DDS file
+const int DATA_HEADER = 24;  // bytes in the header of baked data
+
+inline void put32(unsigned char* p, unsigned v) {
+
+	p[0] = (unsigned char)v;
+	p[1] = (unsigned char)(v >> 8);
+	p[2] = (unsigned char)(v >> 16);
+	p[3] = (unsigned char)(v >> 24);
+}
+
+// isBaked returns true if baked holds a baked file stamped with key
+//
+bool isBaked(const char* baked, const unsigned* key) {
+
+	unsigned char h[DDS_HEADER], k[20];
+	FILE* fp = fopen(baked, "rb");
+	bool rc = fp && fread(h, 1, DDS_HEADER, fp) == DDS_HEADER;
+	if (fp)
+		fclose(fp);
+	put32(k, BAKE_MAGIC);
+	put32(k + 4, BAKE_VERSION);
+	for (int i = 0; i < 3; i++)
+		put32(k + 8 + 4 * i, key[i]);
+
+	return rc && !memcmp(h, "DDS ", 4) && !memcmp(h + 32, k, sizeof k);
+}
+
+// replace writes the header of size n at h followed by the size bytes at
+// data to baked and returns true if successful - the file is written
+// under a name of its own and then renamed, so that two threads baking
+// the same file do not mix their writes
+//
+static bool replace(const char* baked, const unsigned char* h, int n,
+ const void* data, int size) {
+
+	char temp[MAX_PATH + 1];
+	if (!tempName(temp, baked, MAX_PATH))
+		return false;
+	FILE* fp = fopen(temp, "wb");
+	bool rc = fp && fwrite(h, 1, n, fp) == (size_t)n &&
+	 fwrite(data, 1, size, fp) == (size_t)size;
+	if (fp)
+		rc = !fclose(fp) && rc;
+	if (rc)
+		rc = replaceFile(temp, baked);
+	else
+		remove(temp);
+
+	return rc;
+}
+
+// saveBakedImage writes image to baked stamped with key and returns
+// true if successful
+//
+bool saveBakedImage(const char* baked, const Image& image,
+ const unsigned* key) {
+
+	unsigned char h[DDS_HEADER];
+	bool blocks = image.format != IMAGE_ARGB;
+	memset(h, 0, sizeof h);
+	memcpy(h, "DDS ", 4);
+	put32(h + 4, 124);
+	// caps, height, width, pixel format and mip count, with a linear
+	// size or a pitch
+	put32(h + 8, 0x1007 | 0x20000 | (blocks ? 0x80000 : 0x8));
+	put32(h + 12, image.height);
+	put32(h + 16, image.width);
+	put32(h + 20, blocks ? imageLevelSize(image.format, image.width,
+	 image.height) : image.width * 4);
+	put32(h + 28, image.levels);
+	put32(h + 32, BAKE_MAGIC);
+	put32(h + 36, BAKE_VERSION);
+	for (int i = 0; i < 3; i++)
+		put32(h + 40 + 4 * i, key[i]);
+	put32(h + 76, 32);
+	if (blocks) {
+		put32(h + 80, 0x4);
+		memcpy(h + 84, image.format == IMAGE_DXT1 ? "DXT1" : "DXT5", 4);
+	}
+	else {
+		put32(h + 80, 0x41);
+		put32(h + 88, 32);
+		put32(h + 92, 0xFF0000);
+		put32(h + 96, 0xFF00);
+		put32(h + 100, 0xFF);
+		put32(h + 104, 0xFF000000);
+	}
+	// texture, complex and mip map
+	put32(h + 108, 0x1000 | (image.levels > 1 ? 0x400008 : 0));
+
+	return replace(baked, h, DDS_HEADER, image.data, image.size);
+}
+
+// loadBakedData reads the size bytes of data that baked holds into data
+// and returns true if baked is stamped with key and holds size bytes
+//
+bool loadBakedData(const char* baked, const unsigned* key, void* data,
+ int size) {
+
+	unsigned char h[DATA_HEADER], k[DATA_HEADER];
+	put32(k, BAKE_MAGIC);
+	put32(k + 4, BAKE_VERSION);
+	for (int i = 0; i < 3; i++)
+		put32(k + 8 + 4 * i, key[i]);
+	put32(k + 20, size);
+	FILE* fp = fopen(baked, "rb");
+	bool rc = fp && fread(h, 1, DATA_HEADER, fp) == DATA_HEADER &&
+	 !memcmp(h, k, DATA_HEADER) && fread(data, 1, size, fp) ==
+	 (size_t)size;
+	if (fp)
+		fclose(fp);
+
+	return rc;
+}
+
+// saveBakedData writes the size bytes at data to baked stamped with key
+// and returns true if successful
+//
+bool saveBakedData(const char* baked, const unsigned* key,
+ const void* data, int size) {
+
+	unsigned char h[DATA_HEADER];
+	put32(h, BAKE_MAGIC);
+	put32(h + 4, BAKE_VERSION);
+	for (int i = 0; i < 3; i++)
+		put32(h + 8 + 4 * i, key[i]);
+	put32(h + 20, size);
+
+	return replace(baked, h, DATA_HEADER, data, size);
+}
+
+// loadBakedImage loads the baked copy of file if it is current and
+// otherwise loads file, bakes it and saves the baked copy - an image
+// that is already compressed or already holds a mip chain is left as it
+// is
+//
+bool loadBakedImage(const char* file, Image& image) {
+
+	if (!TEXTURE_BAKE || !file)
+		return loadImage(file, image);
+
+	char baked[MAX_PATH + 1];
+	unsigned key[3];
+	strcopy(baked, file, MAX_PATH);
+	strcatenate(baked, TEXTURE_BAKE_EXT, MAX_PATH);
+	bool source = fileStamp(file, key);
+	if (source && isBaked(baked, key) && loadImage(baked, image))
+		return true;
+	if (!loadImage(file, image))
+		return false;
+
+	if (source && image.format == IMAGE_ARGB && image.levels == 1) {
+		LONGLONG begin = ticks();
+		buildMipChain(image, TEXTURE_BAKE_THREADS);
+		compressImage(image, TEXTURE_BAKE_THREADS);
+		bool saved = saveBakedImage(baked, image, key);
+		char str[MAX_PATH + 81];
+		sprintf(str, "Texture: baked %s %dx%d %s in %d ms%s", file,
+		 image.width, image.height, image.format == IMAGE_ARGB ? "ARGB" :
+		 image.format == IMAGE_DXT1 ? "BC1" : "BC3",
+		 microseconds(begin, ticks()) / 1000, saved ? "" :
+		 " - couldn\'t save the baked copy");
+		report(str);
+	}
+
+	return true;
+}
@@ -0,0 +1,45 @@
+#ifndef _TEXTURE_BAKER_H_
+#define _TEXTURE_BAKER_H_
+
+/* Header for the TextureBaker Module
+ *
+ * consists of texture baking functions
+ *
+ * TextureBaker.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "ImageDecoder.h" // for Image
+
+//-------------------------------- Texture Baking ------------------------
+//
+// Baking turns an uncompressed texture file into the image that the card
+// samples - a full mip chain, filtered in linear light, compressed to
+// BC1 (DXT1) blocks if the image is opaque or to BC3 (DXT5) blocks if
+// not.  The baked image is stored beside the texture file as a DDS file
+// with the extension TEXTURE_BAKE_EXT, stamped with the size and the
+// time of the texture file, and is loaded as it is until the texture
+// file changes.  An image whose sides are not multiples of four keeps
+// its texels uncompressed
+//
+// The mip filter and the block compressor are in TextureCompressor.h
+//
+// loadBakedImage loads the baked copy of file, baking it first if it is
+// missing or out of date - an image that cannot be baked is loaded as it
+// is
+bool loadBakedImage(const char* file, Image& image);
+// a baked file is stamped with the three words of a key - fileStamp in
+// Files.h stamps a file with its size and the time of its last write
+bool isBaked(const char* baked, const unsigned* key);
+bool saveBakedImage(const char* baked, const Image& image,
+ const unsigned* key);
+// baked data is a block of bytes stamped in the same way, such as the
+// optimized order of a mesh file
+bool loadBakedData(const char* baked, const unsigned* key, void* data,
+ int size);
+bool saveBakedData(const char* baked, const unsigned* key,
+ const void* data, int size);
+
+#endif
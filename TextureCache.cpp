@@ -0,0 +1,256 @@
+/* TextureCache Module Implementation
+ *
+ * TextureCache.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>          // for strlen, strcmp
+#include "IGraphicsCard.h"  // for IDeviceTexture
+#include "math.h"           // for Colour
+#include "TextureCache.h"   // for TextureCache
+
+//-------------------------------- TextureCache --------------------------
+//
+// TextureCache shares device textures and evicts them in order of use
+//
+TextureCache::Entry* TextureCache::bucket[BUCKETS] = {NULL};
+TextureCache::Entry* TextureCache::oldest          = NULL;
+TextureCache::Entry* TextureCache::newest          = NULL;
+unsigned TextureCache::frame     = 0;
+int      TextureCache::resident_ = 0;
+int      TextureCache::entries_  = 0;
+int      TextureCache::hits_     = 0;
+int      TextureCache::misses_   = 0;
+
+// key returns a copy of path in lower case with forward slashes and
+// without empty, . and .. segments - a .. that cannot be resolved is
+// kept
+//
+char* TextureCache::key(const char* path) {
+
+	int n = (int)strlen(path);
+	char* key = new char[n + 1];
+	int k = 0;
+	if (path[0] == '/' || path[0] == '\\')
+		key[k++] = '/';
+	int root = k; // segments cannot be removed before root
+	for (int i = 0; i < n; ) {
+		// the next segment is path[i, j)
+		while (i < n && (path[i] == '/' || path[i] == '\\'))
+			i++;
+		int j = i;
+		while (j < n && path[j] != '/' && path[j] != '\\')
+			j++;
+		if (j == i)
+			break;
+		bool dot    = j - i == 1 && path[i] == '.';
+		bool dotdot = j - i == 2 && path[i] == '.' && path[i + 1] == '.';
+		// the last segment of the key is key[s, k)
+		int s = k;
+		while (s > root && key[s - 1] == '/')
+			s--;
+		while (s > root && key[s - 1] != '/')
+			s--;
+		bool parent = k > root && !(k - s == 3 && key[s] == '.' &&
+		 key[s + 1] == '.');
+		if (dot)
+			;
+		else if (dotdot && parent)
+			k = s;
+		else {
+			for (int c = i; c < j; c++) {
+				char ch = path[c];
+				key[k++] = ch >= 'A' && ch <= 'Z' ? ch + 'a' - 'A' : ch;
+			}
+			if (j < n)
+				key[k++] = '/';
+		}
+		i = j;
+	}
+	// a trailing separator only follows a segment that was dropped
+	if (k > root && key[k - 1] == '/')
+		k--;
+	key[k] = '\0';
+
+	return key;
+}
+
+// hash returns the bucket for key, flags and border
+//
+static int hash(const char* key, unsigned flags, unsigned border,
+ int buckets) {
+
+	unsigned h = 2166136261u;
+	for (const char* p = key; *p; p++)
+		h = (h ^ (unsigned char)*p) * 16777619u;
+	h = (h ^ flags) * 16777619u;
+	h = (h ^ border) * 16777619u;
+
+	return (int)(h % buckets);
+}
+
+// colour returns colour c as a packed argb value
+//
+unsigned TextureCache::colour(const Colour& c) {
+
+	return (unsigned)(c.a * 255 + 0.5f) << 24 |
+	 (unsigned)(c.r * 255 + 0.5f) << 16 |
+	 (unsigned)(c.g * 255 + 0.5f) << 8 | (unsigned)(c.b * 255 + 0.5f);
+}
+
+// unlink removes entry e from the order of use
+//
+void TextureCache::unlink(Entry* e) {
+
+	if (e->prev) e->prev->next = e->next;
+	else         oldest        = e->next;
+	if (e->next) e->next->prev = e->prev;
+	else         newest        = e->prev;
+	e->prev = NULL;
+	e->next = NULL;
+}
+
+// append adds entry e to the order of use as the most recently used
+//
+void TextureCache::append(Entry* e) {
+
+	e->prev = newest;
+	e->next = NULL;
+	if (newest) newest->next = e;
+	else        oldest       = e;
+	newest = e;
+}
+
+// find returns the texture for file, flags and border, with one more
+// user, NULL if the cache does not hold it
+//
+IDeviceTexture* TextureCache::find(const char* file, unsigned flags,
+ const Colour& border) {
+
+	if (!file)
+		return NULL;
+	char*    k = key(file);
+	unsigned b = colour(border);
+	Entry*   e = bucket[hash(k, flags, b, BUCKETS)];
+	while (e && (e->users < 0 || e->flags != flags || e->border != b ||
+	 strcmp(e->key, k)))
+		e = e->chain;
+	delete [] k;
+	if (!e)
+		return NULL;
+	e->users++;
+	hits_++;
+
+	return e->texture;
+}
+
+// add adds texture, which has been created for file, flags and border,
+// to the cache with one user and returns its entry
+//
+TextureCache::Entry* TextureCache::add(IDeviceTexture* texture,
+ const char* file, unsigned flags, const Colour& border) {
+
+	Entry* e    = new Entry;
+	e->key      = key(file ? file : "");
+	e->flags    = flags;
+	e->border   = colour(border);
+	e->texture  = texture;
+	e->users    = 1;
+	e->bytes    = 0;
+	e->lastUsed = frame;
+	int h       = hash(e->key, e->flags, e->border, BUCKETS);
+	e->chain    = bucket[h];
+	bucket[h]   = e;
+	append(e);
+	entries_++;
+	misses_++;
+
+	return e;
+}
+
+// release removes a user from entry e and returns true if the texture
+// is to be deleted - a texture without users is kept until the cache
+// evicts it
+//
+bool TextureCache::release(Entry* e) {
+
+	if (!e)
+		return true;
+	if (e->users > 0) {
+		e->users--;
+		return false;
+	}
+
+	// the cache is evicting the texture
+	Entry** p = &bucket[hash(e->key, e->flags, e->border, BUCKETS)];
+	while (*p && *p != e)
+		p = &(*p)->chain;
+	if (*p)
+		*p = e->chain;
+	unlink(e);
+	resident_ -= e->bytes;
+	entries_--;
+	delete [] e->key;
+	delete e;
+
+	return true;
+}
+
+// used marks the texture of entry e as used in the current frame
+//
+void TextureCache::used(Entry* e) {
+
+	if (e) {
+		e->lastUsed = frame;
+		if (e != newest) {
+			unlink(e);
+			append(e);
+		}
+	}
+}
+
+// resident records that the texture of entry e occupies bytes on the
+// card - 0 once it has been suspended
+//
+void TextureCache::resident(Entry* e, int bytes) {
+
+	if (e) {
+		resident_ += bytes - e->bytes;
+		e->bytes   = bytes;
+	}
+}
+
+// endFrame evicts the least recently used textures that were not used
+// in the frame until the textures on the card fit the budget, and starts
+// the next frame
+//
+void TextureCache::endFrame() {
+
+	Entry* e = oldest;
+	while (resident_ > TEXTURE_BUDGET && e && e->lastUsed != frame) {
+		Entry* next = e->next;
+		if (e->bytes && e->users)
+			e->texture->suspend();
+		else if (e->bytes) {
+			e->users = -1;
+			e->texture->Delete();
+		}
+		e = next;
+	}
+	frame++;
+}
+
+// flush deletes every texture that has no users
+//
+void TextureCache::flush() {
+
+	for (Entry* e = oldest, *next; e; e = next) {
+		next = e->next;
+		if (!e->users) {
+			e->users = -1;
+			e->texture->Delete();
+		}
+	}
+}
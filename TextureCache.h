@@ -0,0 +1,89 @@
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+/* Header for the TextureCache Module
+ *
+ * consists of TextureCache declaration
+ *
+ * TextureCache.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "DeviceSettings.h" // for TEXTURE_BUDGET
+
+//-------------------------------- TextureCache --------------------------
+//
+// TextureCache shares device textures between their users - the scene's
+// textures and the materials of meshes - so that a texture file is read
+// and uploaded once for each set of sampling flags and border colour
+//
+// The cache looks up a texture by its normalized path - lower case with
+// forward slashes and without . and .. segments - its flags and its
+// border colour.  Each texture counts its users.  A texture without users
+// stays in the cache until it is evicted, so that a file that is loaded
+// again is not read again.
+//
+// The cache keeps its textures in order of last use.  At the end of each
+// frame, while the textures on the card exceed TEXTURE_BUDGET bytes, the
+// least recently used texture that was not used in the frame is evicted
+// - deleted if it has no users, suspended otherwise.  A suspended
+// texture is set up again when it is next attached
+//
+class IDeviceTexture;
+struct Colour;
+
+class TextureCache {
+
+  public:
+	// Entry is a texture in the cache
+	struct Entry {
+		char*           key;      // normalized path
+		unsigned        flags;    // sampling flags
+		unsigned        border;   // border colour
+		IDeviceTexture* texture;  // the shared texture
+		int             users;    // users of the texture, -1 if evicted
+		int             bytes;    // bytes of the texture on the card
+		unsigned        lastUsed; // frame in which the texture was used
+		Entry*          chain;    // next entry in the same bucket
+		Entry*          prev;     // entry used less recently
+		Entry*          next;     // entry used more recently
+	};
+
+  private:
+	static const int BUCKETS = 256; // buckets in the hash table
+
+	static Entry*   bucket[BUCKETS]; // entries by hash of their keys
+	static Entry*   oldest;          // least recently used entry
+	static Entry*   newest;          // most recently used entry
+	static unsigned frame;           // current frame
+	static int      resident_;       // bytes of textures on the card
+	static int      entries_;        // textures in the cache
+	static int      hits_;           // lookups that found a texture
+	static int      misses_;         // lookups that created a texture
+
+	static void unlink(Entry* e);
+	static void append(Entry* e);
+
+  public:
+	// key returns the normalized copy of path, which the caller deletes,
+	// and colour the packed form of a border colour that the cache keys
+	static char*    key(const char* path);
+	static unsigned colour(const Colour& c);
+	static IDeviceTexture* find(const char* file, unsigned flags,
+	 const Colour& border);
+	static Entry* add(IDeviceTexture* texture, const char* file,
+	 unsigned flags, const Colour& border);
+	static bool   release(Entry* e);
+	static void   used(Entry* e);
+	static void   resident(Entry* e, int bytes);
+	static void   endFrame();
+	static void   flush();
+	static int    resident()  { return resident_; }
+	static int    textures()  { return entries_; }
+	static int    hits()      { return hits_; }
+	static int    misses()    { return misses_; }
+};
+
+#endif
@@ -0,0 +1,412 @@
+/* TextureCompressor Module Implementation
+ *
+ * TextureCompressor.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>             // for memcpy, memset
+#include <cmath>               // for powf, fabsf
+#include <new>                 // for std::nothrow
+#include "Threads.h"           // for Thread, processors()
+#include "TextureCompressor.h" // for buildMipChain, compressImage
+
+const int MAX_THREADS = 16;   // threads that work on a texture
+const int GAMMA_STEPS = 4096; // linear values in the gamma table
+
+//-------------------------------- Gamma ---------------------------------
+//
+// Gamma converts between the sRGB encoding of stored texels and linear
+// light, in which texels are averaged
+//
+static struct Gamma {
+	float         linear[256];        // linear value of each sRGB level
+	unsigned char level[GAMMA_STEPS]; // sRGB level of each linear step
+
+	Gamma() {
+		for (int i = 0; i < 256; i++) {
+			float c = i / 255.f;
+			linear[i] = c <= 0.04045f ? c / 12.92f :
+			 powf((c + 0.055f) / 1.055f, 2.4f);
+		}
+		for (int i = 0; i < GAMMA_STEPS; i++) {
+			float l = i / float(GAMMA_STEPS - 1);
+			float c = l <= 0.0031308f ? l * 12.92f :
+			 1.055f * powf(l, 1 / 2.4f) - 0.055f;
+			level[i] = (unsigned char)(c * 255 + 0.5f);
+		}
+	}
+	unsigned encode(float l) const {
+		return level[(int)(l * (GAMMA_STEPS - 1) + 0.5f)];
+	}
+} srgb;
+
+//-------------------------------- Threads -------------------------------
+//
+// Band is a range of rows that one thread works on
+//
+struct Band {
+	void (*work)(void* context, int first, int last);
+	void* context; // shared description of the work
+	int   first;   // first row of the band
+	int   last;    // row past the band
+};
+
+static void runBand(void* b) {
+
+	Band* band = (Band*)b;
+	band->work(band->context, band->first, band->last);
+}
+
+// parallel splits rows [0, n) into bands and works on them on threads
+// threads - one for each processor if threads is 0 - the calling thread
+// works on the first band and on any band whose thread did not start
+//
+static void parallel(void (*work)(void*, int, int), void* context, int n,
+ int threads) {
+
+	if (threads <= 0)          threads = processors();
+	if (threads > MAX_THREADS) threads = MAX_THREADS;
+	if (threads > n)           threads = n;
+	if (threads < 1)           threads = 1;
+
+	Band   band[MAX_THREADS];
+	Thread thread[MAX_THREADS];
+	for (int i = 0; i < threads; i++) {
+		band[i].work    = work;
+		band[i].context = context;
+		band[i].first   = n * i / threads;
+		band[i].last    = n * (i + 1) / threads;
+	}
+	for (int i = 1; i < threads; i++)
+		if (!thread[i].start(runBand, &band[i]))
+			runBand(&band[i]);
+	runBand(&band[0]);
+	for (int i = 1; i < threads; i++)
+		thread[i].join();
+}
+
+//-------------------------------- Mip Chain -----------------------------
+//
+// Level describes the filtering of one level into the next
+//
+struct Level {
+	const unsigned* src; // texels of the finer level
+	unsigned*       dst; // texels of the coarser level
+	int             sw;  // width of the finer level
+	int             sh;  // height of the finer level
+	int             dw;  // width of the coarser level
+};
+
+// filterRows averages each 2 x 2 group of finer texels into rows [first,
+// last) of the coarser level - the colours are weighted by their alpha,
+// so that transparent texels do not darken their neighbours
+//
+static void filterRows(void* c, int first, int last) {
+
+	const Level& l = *(const Level*)c;
+	for (int y = first; y < last; y++) {
+		const unsigned* r0 = l.src + (2 * y < l.sh ? 2 * y : l.sh - 1) * l.sw;
+		const unsigned* r1 = l.src + (2 * y + 1 < l.sh ? 2 * y + 1 :
+		 l.sh - 1) * l.sw;
+		unsigned* d = l.dst + y * l.dw;
+		for (int x = 0; x < l.dw; x++) {
+			int x0 = 2 * x < l.sw ? 2 * x : l.sw - 1;
+			int x1 = 2 * x + 1 < l.sw ? 2 * x + 1 : l.sw - 1;
+			unsigned s[4] = {r0[x0], r0[x1], r1[x0], r1[x1]};
+			float r = 0, g = 0, b = 0;
+			int a = 0;
+			for (int k = 0; k < 4; k++)
+				a += s[k] >> 24;
+			for (int k = 0; k < 4; k++) {
+				float w = a ? float(s[k] >> 24) : 1;
+				r += srgb.linear[s[k] >> 16 & 0xFF] * w;
+				g += srgb.linear[s[k] >> 8 & 0xFF] * w;
+				b += srgb.linear[s[k] & 0xFF] * w;
+			}
+			float total = a ? float(a) : 4;
+			d[x] = (unsigned)(a + 2) / 4 << 24 |
+			 srgb.encode(r / total) << 16 | srgb.encode(g / total) << 8 |
+			 srgb.encode(b / total);
+		}
+	}
+}
+
+// buildMipChain replaces the single level of an uncompressed image with
+// a full chain and returns true if successful
+//
+bool buildMipChain(Image& image, int threads) {
+
+	if (!image.data || image.format != IMAGE_ARGB || image.levels != 1)
+		return false;
+
+	// size the chain
+	int levels = 1, size = imageLevelSize(IMAGE_ARGB, image.width,
+	 image.height);
+	for (int w = image.width, h = image.height; w > 1 || h > 1; levels++) {
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+		size += imageLevelSize(IMAGE_ARGB, w, h);
+	}
+	unsigned* chain = new (std::nothrow) unsigned[size / 4];
+	if (!chain)
+		return false;
+	memcpy(chain, image.data, image.size);
+
+	// filter each level from the one above it
+	Level l;
+	l.src = chain;
+	l.sw  = image.width;
+	l.sh  = image.height;
+	for (int i = 1; i < levels; i++) {
+		int dh = l.sh > 1 ? l.sh / 2 : 1;
+		l.dw   = l.sw > 1 ? l.sw / 2 : 1;
+		l.dst  = (unsigned*)l.src + l.sw * l.sh;
+		parallel(filterRows, &l, dh, threads);
+		l.src = l.dst;
+		l.sw  = l.dw;
+		l.sh  = dh;
+	}
+
+	delete [] (unsigned*)image.data;
+	image.data   = (unsigned char*)chain;
+	image.levels = levels;
+	image.size   = size;
+
+	return true;
+}
+
+//-------------------------------- Block Compression ---------------------
+//
+// A BC1 block holds two 565 end points and a 2-bit index for each of its
+// 16 texels that selects an end point or one of the two colours between
+// them.  A BC3 block adds an alpha block ahead of the colour block: two
+// 8-bit end points and a 3-bit index for each texel that selects an end
+// point or one of the six values between them
+//
+// pack565 returns the 565 form of the colour c
+//
+static unsigned pack565(const float* c) {
+
+	int r = (int)(c[0] * 31 / 255 + 0.5f);
+	int g = (int)(c[1] * 63 / 255 + 0.5f);
+	int b = (int)(c[2] * 31 / 255 + 0.5f);
+	r = r < 0 ? 0 : r > 31 ? 31 : r;
+	g = g < 0 ? 0 : g > 63 ? 63 : g;
+	b = b < 0 ? 0 : b > 31 ? 31 : b;
+
+	return r << 11 | g << 5 | b;
+}
+
+// unpack565 sets c to the colour that the card decodes from 565 form p
+//
+static void unpack565(unsigned p, int* c) {
+
+	int r = p >> 11 & 31, g = p >> 5 & 63, b = p & 31;
+	c[0] = r << 3 | r >> 2;
+	c[1] = g << 2 | g >> 4;
+	c[2] = b << 3 | b >> 2;
+}
+
+// colourBlock compresses the colours of 16 texels into the 8 bytes at
+// out - the end points are the extremes of the texels along their
+// principal axis, drawn in by a sixteenth of their distance
+//
+static void colourBlock(const unsigned* t, unsigned char* out) {
+
+	float c[16][3], mean[3] = {0, 0, 0};
+	for (int i = 0; i < 16; i++) {
+		c[i][0] = float(t[i] >> 16 & 0xFF);
+		c[i][1] = float(t[i] >> 8 & 0xFF);
+		c[i][2] = float(t[i] & 0xFF);
+		for (int k = 0; k < 3; k++)
+			mean[k] += c[i][k] / 16;
+	}
+
+	// the principal axis by power iteration on the covariance
+	float m[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+	for (int i = 0; i < 16; i++)
+		for (int j = 0; j < 3; j++)
+			for (int k = 0; k < 3; k++)
+				m[j][k] += (c[i][j] - mean[j]) * (c[i][k] - mean[k]);
+	float axis[3] = {1, 1, 1};
+	for (int n = 0; n < 8; n++) {
+		float v[3], big = 0;
+		for (int j = 0; j < 3; j++) {
+			v[j] = m[j][0] * axis[0] + m[j][1] * axis[1] + m[j][2] * axis[2];
+			if (fabsf(v[j]) > big) big = fabsf(v[j]);
+		}
+		if (big == 0)
+			break;
+		for (int j = 0; j < 3; j++)
+			axis[j] = v[j] / big;
+	}
+
+	// the extremes along the axis
+	int lo = 0, hi = 0;
+	float pLo = 0, pHi = 0;
+	for (int i = 0; i < 16; i++) {
+		float p = (c[i][0] - mean[0]) * axis[0] + (c[i][1] - mean[1]) *
+		 axis[1] + (c[i][2] - mean[2]) * axis[2];
+		if (i == 0 || p < pLo) { pLo = p; lo = i; }
+		if (i == 0 || p > pHi) { pHi = p; hi = i; }
+	}
+	float e0[3], e1[3];
+	for (int k = 0; k < 3; k++) {
+		float inset = (c[hi][k] - c[lo][k]) / 16;
+		e0[k] = c[hi][k] - inset;
+		e1[k] = c[lo][k] + inset;
+	}
+
+	// the first end point must be the greater for four colours
+	unsigned p0 = pack565(e0), p1 = pack565(e1);
+	if (p0 < p1) {
+		unsigned p = p0;
+		p0 = p1;
+		p1 = p;
+	}
+	int pal[4][3];
+	unpack565(p0, pal[0]);
+	unpack565(p1, pal[1]);
+	for (int k = 0; k < 3; k++) {
+		pal[2][k] = (2 * pal[0][k] + pal[1][k]) / 3;
+		pal[3][k] = (pal[0][k] + 2 * pal[1][k]) / 3;
+	}
+	unsigned indices = 0;
+	if (p0 != p1)
+		for (int i = 0; i < 16; i++) {
+			int best = 0, bestD = 0;
+			for (int j = 0; j < 4; j++) {
+				int dr = (int)c[i][0] - pal[j][0];
+				int dg = (int)c[i][1] - pal[j][1];
+				int db = (int)c[i][2] - pal[j][2];
+				int d  = dr * dr + dg * dg + db * db;
+				if (j == 0 || d < bestD) { bestD = d; best = j; }
+			}
+			indices |= best << (2 * i);
+		}
+
+	out[0] = (unsigned char)p0;
+	out[1] = (unsigned char)(p0 >> 8);
+	out[2] = (unsigned char)p1;
+	out[3] = (unsigned char)(p1 >> 8);
+	for (int i = 0; i < 4; i++)
+		out[4 + i] = (unsigned char)(indices >> (8 * i));
+}
+
+// alphaBlock compresses the alpha of 16 texels into the 8 bytes at out
+//
+static void alphaBlock(const unsigned* t, unsigned char* out) {
+
+	int lo = 255, hi = 0;
+	for (int i = 0; i < 16; i++) {
+		int a = t[i] >> 24;
+		if (a < lo) lo = a;
+		if (a > hi) hi = a;
+	}
+	memset(out, 0, 8);
+	out[0] = (unsigned char)hi;
+	out[1] = (unsigned char)lo;
+	if (hi == lo)
+		return;
+
+	int v[8] = {hi, lo};
+	for (int i = 1; i < 7; i++)
+		v[i + 1] = ((7 - i) * hi + i * lo + 3) / 7;
+	for (int i = 0; i < 16; i++) {
+		int a = t[i] >> 24, best = 0, bestD = 256;
+		for (int j = 0; j < 8; j++) {
+			int d = a > v[j] ? a - v[j] : v[j] - a;
+			if (d < bestD) { bestD = d; best = j; }
+		}
+		int bit = 3 * i;
+		out[2 + bit / 8] |= (unsigned char)(best << (bit % 8));
+		if (bit % 8 > 5)
+			out[3 + bit / 8] |= (unsigned char)(best >> (8 - bit % 8));
+	}
+}
+
+// Blocks describes the compression of one level
+//
+struct Blocks {
+	const unsigned* src;   // texels of the level
+	unsigned char*  dst;   // blocks of the level
+	int             w;     // width of the level
+	int             h;     // height of the level
+	bool            alpha; // BC3 rather than BC1?
+};
+
+// compressRows compresses block rows [first, last) of a level - the
+// texels of a level narrower or shorter than a block are repeated
+//
+static void compressRows(void* c, int first, int last) {
+
+	const Blocks& b = *(const Blocks*)c;
+	int across = (b.w + 3) / 4, unit = b.alpha ? 16 : 8;
+	for (int by = first; by < last; by++)
+		for (int bx = 0; bx < across; bx++) {
+			unsigned t[16];
+			for (int y = 0; y < 4; y++)
+				for (int x = 0; x < 4; x++) {
+					int sx = bx * 4 + x < b.w ? bx * 4 + x : b.w - 1;
+					int sy = by * 4 + y < b.h ? by * 4 + y : b.h - 1;
+					t[y * 4 + x] = b.src[sy * b.w + sx];
+				}
+			unsigned char* out = b.dst + (by * across + bx) * unit;
+			if (b.alpha) {
+				alphaBlock(t, out);
+				out += 8;
+			}
+			colourBlock(t, out);
+		}
+}
+
+// compressImage compresses every level of an uncompressed image to BC1
+// blocks if every texel is opaque and to BC3 blocks otherwise, and
+// returns true if successful - the sides of the image must be multiples
+// of four
+//
+bool compressImage(Image& image, int threads) {
+
+	if (!image.data || image.format != IMAGE_ARGB || image.width & 3 ||
+	 image.height & 3)
+		return false;
+	const unsigned* t = (const unsigned*)image.data;
+	bool opaque = true;
+	for (int i = 0; i < image.width * image.height && opaque; i++)
+		opaque = t[i] >> 24 == 0xFF;
+	ImageFormat f = opaque ? IMAGE_DXT1 : IMAGE_DXT5;
+
+	int size = 0;
+	for (int i = 0, w = image.width, h = image.height; i < image.levels;
+	 i++) {
+		size += imageLevelSize(f, w, h);
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+	unsigned* blocks = new (std::nothrow) unsigned[size / 4];
+	if (!blocks)
+		return false;
+
+	Blocks b;
+	b.src   = t;
+	b.dst   = (unsigned char*)blocks;
+	b.w     = image.width;
+	b.h     = image.height;
+	b.alpha = !opaque;
+	for (int i = 0; i < image.levels; i++) {
+		parallel(compressRows, &b, (b.h + 3) / 4, threads);
+		b.src += b.w * b.h;
+		b.dst += imageLevelSize(f, b.w, b.h);
+		b.w    = b.w > 1 ? b.w / 2 : 1;
+		b.h    = b.h > 1 ? b.h / 2 : 1;
+	}
+
+	delete [] (unsigned*)image.data;
+	image.data   = (unsigned char*)blocks;
+	image.format = f;
+	image.size   = size;
+
+	return true;
+}
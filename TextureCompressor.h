@@ -0,0 +1,28 @@
+#ifndef _TEXTURE_COMPRESSOR_H_
+#define _TEXTURE_COMPRESSOR_H_
+
+/* Header for the TextureCompressor Module
+ *
+ * consists of mip chain and block compression functions
+ *
+ * TextureCompressor.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "ImageDecoder.h" // for Image
+
+//-------------------------------- Texture Compression -------------------
+//
+// buildMipChain replaces the single level of an uncompressed image with
+// a full mip chain, filtered in linear light.  compressImage compresses
+// every level to BC1 (DXT1) blocks if the image is opaque and to BC3
+// (DXT5) blocks if not.  Both work on memory alone and split their work
+// across threads threads - one for each processor if threads is 0 - so
+// that the baker and the atlas builder share them on any host
+//
+bool buildMipChain(Image& image, int threads);
+bool compressImage(Image& image, int threads);
+
+#endif
@@ -0,0 +1,339 @@
+/* Threads Module Implementation
+ *
+ * Threads.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "Threads.h" // for Thread, Event, Lock and Semaphore
+
+#ifdef _WIN32
+#include <windows.h> // for CreateThread, CreateEvent, CRITICAL_SECTION
+#else
+#include <pthread.h> // for pthread_create, pthread_mutex_t, pthread_cond_t
+#include <unistd.h>  // for sysconf, usleep
+#endif
+#include <new>       // for std::nothrow
+
+//-------------------------------- Thread --------------------------------
+//
+// Start is the function that a new thread runs and its argument
+//
+struct Start {
+	void (*function)(void*);
+	void* argument;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI run(LPVOID s) {
+#else
+static void* run(void* s) {
+#endif
+
+	Start start = *(Start*)s;
+	delete (Start*)s;
+	start.function(start.argument);
+
+	return 0;
+}
+
+// start runs function(argument) on a new thread and returns true if the
+// thread started
+//
+bool Thread::start(void (*function)(void*), void* argument) {
+
+	join();
+	Start* s = new (std::nothrow) Start;
+	if (!s)
+		return false;
+	s->function = function;
+	s->argument = argument;
+	#ifdef _WIN32
+	handle = CreateThread(NULL, 0, run, s, 0, NULL);
+	#else
+	pthread_t* t = new (std::nothrow) pthread_t;
+	if (t && pthread_create(t, NULL, run, s)) {
+		delete t;
+		t = 0;
+	}
+	handle = t;
+	#endif
+	if (!handle)
+		delete s;
+
+	return handle != 0;
+}
+
+// join waits for the thread to finish and releases it
+//
+void Thread::join() {
+
+	if (!handle)
+		return;
+	#ifdef _WIN32
+	WaitForSingleObject(handle, INFINITE);
+	CloseHandle(handle);
+	#else
+	pthread_join(*(pthread_t*)handle, NULL);
+	delete (pthread_t*)handle;
+	#endif
+	handle = 0;
+}
+
+//-------------------------------- Event ---------------------------------
+//
+// Signal is the host form of an event, a lock and a semaphore without
+// Win32 - a mutex, a condition and a count
+//
+#ifndef _WIN32
+struct Signal {
+	pthread_mutex_t mutex;
+	pthread_cond_t  condition;
+	int             count;
+};
+
+static Signal* createSignal() {
+
+	Signal* s = new (std::nothrow) Signal;
+	if (s) {
+		s->count = 0;
+		if (pthread_mutex_init(&s->mutex, NULL)) {
+			delete s;
+			s = 0;
+		}
+		else if (pthread_cond_init(&s->condition, NULL)) {
+			pthread_mutex_destroy(&s->mutex);
+			delete s;
+			s = 0;
+		}
+	}
+
+	return s;
+}
+
+static void destroySignal(void* h) {
+
+	Signal* s = (Signal*)h;
+	if (s) {
+		pthread_cond_destroy(&s->condition);
+		pthread_mutex_destroy(&s->mutex);
+		delete s;
+	}
+}
+
+// raise adds n to the count of signal h, at most max, and wakes its
+// waiting threads
+//
+static void raise(void* h, int n, int max) {
+
+	Signal* s = (Signal*)h;
+	pthread_mutex_lock(&s->mutex);
+	s->count = s->count + n > max ? max : s->count + n;
+	pthread_cond_broadcast(&s->condition);
+	pthread_mutex_unlock(&s->mutex);
+}
+
+// lower waits for the count of signal h to be positive and decrements it
+//
+static void lower(void* h) {
+
+	Signal* s = (Signal*)h;
+	pthread_mutex_lock(&s->mutex);
+	while (!s->count)
+		pthread_cond_wait(&s->condition, &s->mutex);
+	s->count--;
+	pthread_mutex_unlock(&s->mutex);
+}
+#endif
+
+// constructor creates an event that is not set
+//
+Event::Event() {
+
+	#ifdef _WIN32
+	handle = CreateEvent(NULL, FALSE, FALSE, NULL);
+	#else
+	handle = createSignal();
+	#endif
+}
+
+Event::~Event() {
+
+	#ifdef _WIN32
+	if (handle) CloseHandle(handle);
+	#else
+	destroySignal(handle);
+	#endif
+}
+
+// set releases one waiting thread, or the next thread to wait
+//
+void Event::set() {
+
+	#ifdef _WIN32
+	SetEvent(handle);
+	#else
+	raise(handle, 1, 1);
+	#endif
+}
+
+// wait waits for the event to be set and resets it
+//
+void Event::wait() {
+
+	#ifdef _WIN32
+	WaitForSingleObject(handle, INFINITE);
+	#else
+	lower(handle);
+	#endif
+}
+
+//-------------------------------- Lock ----------------------------------
+//
+// constructor creates a lock that no thread holds
+//
+Lock::Lock() {
+
+	#ifdef _WIN32
+	CRITICAL_SECTION* c = new (std::nothrow) CRITICAL_SECTION;
+	if (c)
+		InitializeCriticalSection(c);
+	handle = c;
+	#else
+	pthread_mutex_t* m = new (std::nothrow) pthread_mutex_t;
+	if (m && pthread_mutex_init(m, NULL)) {
+		delete m;
+		m = 0;
+	}
+	handle = m;
+	#endif
+}
+
+Lock::~Lock() {
+
+	#ifdef _WIN32
+	if (handle) {
+		DeleteCriticalSection((CRITICAL_SECTION*)handle);
+		delete (CRITICAL_SECTION*)handle;
+	}
+	#else
+	if (handle) {
+		pthread_mutex_destroy((pthread_mutex_t*)handle);
+		delete (pthread_mutex_t*)handle;
+	}
+	#endif
+}
+
+void Lock::enter() {
+
+	#ifdef _WIN32
+	EnterCriticalSection((CRITICAL_SECTION*)handle);
+	#else
+	pthread_mutex_lock((pthread_mutex_t*)handle);
+	#endif
+}
+
+void Lock::leave() {
+
+	#ifdef _WIN32
+	LeaveCriticalSection((CRITICAL_SECTION*)handle);
+	#else
+	pthread_mutex_unlock((pthread_mutex_t*)handle);
+	#endif
+}
+
+//-------------------------------- Semaphore -----------------------------
+//
+// constructor creates a semaphore with a count of 0
+//
+Semaphore::Semaphore() {
+
+	#ifdef _WIN32
+	handle = CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL);
+	#else
+	handle = createSignal();
+	#endif
+}
+
+Semaphore::~Semaphore() {
+
+	#ifdef _WIN32
+	if (handle) CloseHandle(handle);
+	#else
+	destroySignal(handle);
+	#endif
+}
+
+// release adds n to the count
+//
+void Semaphore::release(int n) {
+
+	#ifdef _WIN32
+	ReleaseSemaphore(handle, n, NULL);
+	#else
+	raise(handle, n, 0x7FFFFFFF);
+	#endif
+}
+
+// wait waits for the count to be positive and decrements it
+//
+void Semaphore::wait() {
+
+	#ifdef _WIN32
+	WaitForSingleObject(handle, INFINITE);
+	#else
+	lower(handle);
+	#endif
+}
+
+//-------------------------------- Atomics -------------------------------
+//
+long atomicIncrement(volatile long* v) {
+
+	#ifdef _WIN32
+	return InterlockedIncrement(v);
+	#else
+	return __sync_add_and_fetch(v, 1);
+	#endif
+}
+
+long atomicDecrement(volatile long* v) {
+
+	#ifdef _WIN32
+	return InterlockedDecrement(v);
+	#else
+	return __sync_sub_and_fetch(v, 1);
+	#endif
+}
+
+long long atomicCompareExchange(volatile long long* v, long long value,
+ long long comparand) {
+
+	#ifdef _WIN32
+	return InterlockedCompareExchange64(v, value, comparand);
+	#else
+	return __sync_val_compare_and_swap(v, comparand, value);
+	#endif
+}
+
+int processors() {
+
+	#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+	#else
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? (int)n : 1;
+	#endif
+}
+
+void sleepFor(int milliseconds) {
+
+	#ifdef _WIN32
+	Sleep(milliseconds);
+	#else
+	usleep(milliseconds * 1000);
+	#endif
+}
@@ -0,0 +1,111 @@
+#ifndef _THREADS_H_
+#define _THREADS_H_
+
+/* Header for the Threads Module
+ *
+ * consists of Thread declaration
+ *             Event declaration
+ *             Lock declaration
+ *             Semaphore declaration
+ *             atomic counter functions
+ *
+ * Threads.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- Threads -------------------------------
+//
+// The classes wrap the threads and the synchronization objects of the
+// host - Win32 where _WIN32 is defined and POSIX threads elsewhere - so
+// that the modules that work on several threads build on either.  Each
+// object holds an opaque handle to the host object, NULL if the host
+// could not create it
+//
+// Thread runs a function on a thread of its own.  join() waits for the
+// function to return and is called by the destructor
+//
+class Thread {
+
+	void* handle;
+
+	Thread(const Thread&);            // prevents copying
+	Thread& operator=(const Thread&); // prevents assignment
+
+  public:
+	Thread() : handle(0) {}
+	~Thread() { join(); }
+	bool start(void (*function)(void*), void* argument);
+	void join();
+	bool running() const { return handle != 0; }
+};
+
+// Event is a signal that releases a single waiting thread and resets
+// itself
+//
+class Event {
+
+	void* handle;
+
+	Event(const Event&);            // prevents copying
+	Event& operator=(const Event&); // prevents assignment
+
+  public:
+	Event();
+	~Event();
+	bool valid() const { return handle != 0; }
+	void set();
+	void wait();
+};
+
+// Lock is a mutual exclusion lock - enter() blocks while another thread
+// holds it
+//
+class Lock {
+
+	void* handle;
+
+	Lock(const Lock&);            // prevents copying
+	Lock& operator=(const Lock&); // prevents assignment
+
+  public:
+	Lock();
+	~Lock();
+	bool valid() const { return handle != 0; }
+	void enter();
+	void leave();
+};
+
+// Semaphore counts the units of work available - wait() blocks until
+// the count is positive and then decrements it
+//
+class Semaphore {
+
+	void* handle;
+
+	Semaphore(const Semaphore&);            // prevents copying
+	Semaphore& operator=(const Semaphore&); // prevents assignment
+
+  public:
+	Semaphore();
+	~Semaphore();
+	bool valid() const { return handle != 0; }
+	void release(int n = 1);
+	void wait();
+};
+
+// atomicIncrement and atomicDecrement change *v by one as a single step
+// and return the new value
+long atomicIncrement(volatile long* v);
+long atomicDecrement(volatile long* v);
+// atomicCompareExchange sets *v to value if it holds comparand, as a
+// single step, and returns the value that it held
+long long atomicCompareExchange(volatile long long* v, long long value,
+ long long comparand);
+// processors returns the number of processors on the host
+int  processors();
+// sleepFor suspends the calling thread for milliseconds ms
+void sleepFor(int milliseconds);
+
+#endif
@@ -0,0 +1,175 @@
+/* VertexCodec Module Implementation
+ *
+ * VertexCodec.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cmath>         // for fabsf, sqrtf
+#include <emmintrin.h>   // for SSE2 intrinsics
+#include "VertexCodec.h" // for PackedVertex and VertexPacking
+
+//-------------------------------- Vertex Packing ------------------------
+//
+// An unpacked vertex is x, y, z, nx, ny, nz, tu, tv.  The position and
+// the texture coordinates are quantized to 16 bits across the bounds of
+// the mesh and the unit normal is folded onto the octahedron |u| + |v| +
+// |w| = 1 and stored as its u and v
+//
+static const float QUANTA   = 32767.f; // largest magnitude of a channel
+static const float MIN_STEP = 1e-30f;  // step of a flat channel
+
+// octahedral returns the octahedral form of unit normal (x, y, z)
+// through u and v
+//
+static void octahedral(float x, float y, float z, float& u, float& v) {
+
+	float l = fabsf(x) + fabsf(y) + fabsf(z);
+	u = l > 0 ? x / l : 0;
+	v = l > 0 ? y / l : 0;
+	if (z < 0) {
+		// fold the lower half over the diagonals
+		float t = u;
+		u = (1 - fabsf(v)) * (t >= 0 ? 1 : -1);
+		v = (1 - fabsf(t)) * (v >= 0 ? 1 : -1);
+	}
+}
+
+// choosePacking sets the quantization of the n vertices at vertex from
+// their bounds and returns true if no position moves by more than
+// maxError and no texture coordinate by more than maxUVError - a mesh
+// with a degenerate normal is left unpacked
+//
+bool choosePacking(const float* vertex, int n, float maxError,
+ float maxUVError, VertexPacking& p) {
+
+	if (n <= 0 || !vertex)
+		return false;
+
+	// bound every channel four at a time
+	__m128 lo0 = _mm_loadu_ps(vertex),     hi0 = lo0;
+	__m128 lo1 = _mm_loadu_ps(vertex + 4), hi1 = lo1;
+	for (int i = 0; i < n; i++) {
+		const float* v = vertex + i * VERTEX_FLOATS;
+		__m128 a = _mm_loadu_ps(v);
+		__m128 b = _mm_loadu_ps(v + 4);
+		lo0 = _mm_min_ps(lo0, a);
+		hi0 = _mm_max_ps(hi0, a);
+		lo1 = _mm_min_ps(lo1, b);
+		hi1 = _mm_max_ps(hi1, b);
+		float l = v[3] * v[3] + v[4] * v[4] + v[5] * v[5];
+		if (l < 0.25f || l > 4)
+			return false;
+	}
+	float lo[8], hi[8];
+	_mm_storeu_ps(lo, lo0);
+	_mm_storeu_ps(lo + 4, lo1);
+	_mm_storeu_ps(hi, hi0);
+	_mm_storeu_ps(hi + 4, hi1);
+
+	// channels 0-2 are x, y, z and channels 5-6 are tu, tv
+	const int source[8] = {0, 1, 2, -1, -1, 6, 7, -1};
+	for (int c = 0; c < 8; c++) {
+		int s = source[c];
+		if (s < 0) {
+			// octahedral coordinates lie within [-1, 1]
+			p.step[c]   = c == 7 ? 0 : 1 / QUANTA;
+			p.centre[c] = 0;
+		}
+		else {
+			p.step[c]   = (hi[s] - lo[s]) / (2 * QUANTA);
+			p.centre[c] = 0.5f * (hi[s] + lo[s]);
+			if (0.5f * p.step[c] > (c < 3 ? maxError : maxUVError))
+				return false;
+			// a flat channel still detects a vertex that leaves it
+			if (!(p.step[c] > 0))
+				p.step[c] = MIN_STEP;
+		}
+	}
+
+	return true;
+}
+
+// encodeVertices packs the n vertices at vertex into packed and returns
+// true if every vertex lies within the bounds of p - a vertex outside
+// the bounds is clamped to them
+//
+bool encodeVertices(const float* vertex, int n, const VertexPacking& p,
+ PackedVertex* packed) {
+
+	float inv[8];
+	for (int c = 0; c < 8; c++)
+		inv[c] = p.step[c] > 0 ? 1 / p.step[c] : 0;
+	const __m128 c0    = _mm_loadu_ps(p.centre);
+	const __m128 c1    = _mm_loadu_ps(p.centre + 4);
+	const __m128 i0    = _mm_loadu_ps(inv);
+	const __m128 i1    = _mm_loadu_ps(inv + 4);
+	const __m128 limit = _mm_set1_ps(QUANTA + 0.5f);
+	const __m128 lower = _mm_set1_ps(-QUANTA);
+	const __m128 upper = _mm_set1_ps(QUANTA);
+	const __m128 mask  = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	int outside = 0;
+	for (int i = 0; i < n; i++) {
+		const float* v = vertex + i * VERTEX_FLOATS;
+		float u, w;
+		octahedral(v[3], v[4], v[5], u, w);
+		__m128 a = _mm_setr_ps(v[0], v[1], v[2], u);
+		__m128 b = _mm_setr_ps(w, v[6], v[7], 0);
+		a = _mm_mul_ps(_mm_sub_ps(a, c0), i0);
+		b = _mm_mul_ps(_mm_sub_ps(b, c1), i1);
+		outside |= _mm_movemask_ps(_mm_or_ps(
+		 _mm_cmpgt_ps(_mm_and_ps(a, mask), limit),
+		 _mm_cmpgt_ps(_mm_and_ps(b, mask), limit)));
+		a = _mm_min_ps(_mm_max_ps(a, lower), upper);
+		b = _mm_min_ps(_mm_max_ps(b, lower), upper);
+		_mm_storeu_si128((__m128i*)packed[i].q,
+		 _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+	}
+
+	return !outside;
+}
+
+// decodeVertices unpacks the n vertices at packed into vertex
+//
+void decodeVertices(const PackedVertex* packed, int n,
+ const VertexPacking& p, float* vertex) {
+
+	const __m128 c0 = _mm_loadu_ps(p.centre);
+	const __m128 c1 = _mm_loadu_ps(p.centre + 4);
+	const __m128 s0 = _mm_loadu_ps(p.step);
+	const __m128 s1 = _mm_loadu_ps(p.step + 4);
+
+	for (int i = 0; i < n; i++) {
+		__m128i q = _mm_loadu_si128((const __m128i*)packed[i].q);
+		// sign-extend the channels to 32 bits
+		__m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(q, q),
+		 16));
+		__m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(q, q),
+		 16));
+		a = _mm_add_ps(_mm_mul_ps(a, s0), c0);
+		b = _mm_add_ps(_mm_mul_ps(b, s1), c1);
+		float f[8];
+		_mm_storeu_ps(f, a);
+		_mm_storeu_ps(f + 4, b);
+
+		// unfold the normal from the octahedron
+		float u = f[3], v = f[4], w = 1 - fabsf(u) - fabsf(v);
+		if (w < 0) {
+			float t = u;
+			u = (1 - fabsf(v)) * (t >= 0 ? 1 : -1);
+			v = (1 - fabsf(t)) * (v >= 0 ? 1 : -1);
+		}
+		float l = sqrtf(u * u + v * v + w * w);
+		float* o = vertex + i * VERTEX_FLOATS;
+		o[0] = f[0];
+		o[1] = f[1];
+		o[2] = f[2];
+		o[3] = u / l;
+		o[4] = v / l;
+		o[5] = w / l;
+		o[6] = f[5];
+		o[7] = f[6];
+	}
+}
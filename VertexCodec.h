@@ -0,0 +1,47 @@
+#ifndef _VERTEX_CODEC_H_
+#define _VERTEX_CODEC_H_
+
+/* Header for the VertexCodec Module
+ *
+ * consists of PackedVertex declaration
+ *             VertexPacking declaration
+ *             vertex encoding and decoding functions
+ *
+ * VertexCodec.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+//-------------------------------- PackedVertex --------------------------
+//
+// PackedVertex holds a vertex in 16 bytes rather than 32 - eight 16-bit
+// channels hold the position, the normal in octahedral form, the texture
+// coordinates and a pad
+//
+//   x | y | z | normal u | normal v | tu | tv | 0
+//
+const int VERTEX_FLOATS = 8; // floats in an unpacked vertex
+
+struct PackedVertex {
+	short q[8];
+};
+
+//-------------------------------- VertexPacking -------------------------
+//
+// VertexPacking holds the quantization of the vertices of a single mesh,
+// chosen from its bounds - channel c decodes as q * step[c] + centre[c]
+//
+struct VertexPacking {
+	float step[8];   // value of a unit in each channel
+	float centre[8]; // value of 0 in each channel
+};
+
+bool choosePacking(const float* vertex, int n, float maxError,
+ float maxUVError, VertexPacking& p);
+bool encodeVertices(const float* vertex, int n, const VertexPacking& p,
+ PackedVertex* packed);
+void decodeVertices(const PackedVertex* packed, int n,
+ const VertexPacking& p, float* vertex);
+
+#endif
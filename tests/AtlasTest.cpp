@@ -0,0 +1,160 @@
+/* Atlas Test
+ *
+ * packs three small bitmaps into an atlas page beside one that is too
+ * large to pack, and checks that each packed file has a region of its own
+ * on the page, that texture coordinates mapped into the region sample
+ * the file's texels from the composed page and that the padding repeats
+ * the file's edges
+ *
+ * AtlasTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio>          // for fopen, fwrite, fclose, remove, sprintf
+#include <cstring>         // for strcmp
+#include "Test.h"          // for CHECK
+#include "ModelSettings.h" // for ATLAS_FILE, ATLAS_MAX_SIDE, ATLAS_PADDING
+#include "ImageDecoder.h"  // for Image, loadImage, decompressImage
+#include "Atlas.h"         // for Atlas
+
+const int FILES  = 4; // files handed to the atlas - the last is too large
+const int PACKED = 3; // files that the atlas packs
+
+const char* FILE_NAME[FILES] = {"AtlasTest0.bmp", "AtlasTest1.bmp",
+ "AtlasTest2.bmp", "AtlasTest3.bmp"};
+const int WIDTH[FILES]  = {32, 16, 8, ATLAS_MAX_SIDE + 8};
+const int HEIGHT[FILES] = {16, 32, 8, 8};
+
+// the colours of the top left, top right, bottom left and bottom right
+// quadrants of each file - values that BC1 blocks keep exactly
+const unsigned QUADRANT[FILES][4] = {
+	{0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFFFFFF},
+	{0xFFFFFF00, 0xFF00FFFF, 0xFFFF00FF, 0xFF000000},
+	{0xFF00FF00, 0xFF00FF00, 0xFF00FF00, 0xFF00FF00},
+	{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}
+};
+
+// colour returns the colour of texel [x, y] of file f
+//
+static unsigned colour(int f, int x, int y) {
+
+	return QUADRANT[f][(y >= HEIGHT[f] / 2) * 2 + (x >= WIDTH[f] / 2)];
+}
+
+// writeBitmap writes file f as a 24-bit BMP, bottom row first
+//
+static bool writeBitmap(int f) {
+
+	int w = WIDTH[f], h = HEIGHT[f];
+	int pitch = (3 * w + 3) & ~3;
+	unsigned size = pitch * h;
+	unsigned char header[54] = {'B', 'M'};
+	unsigned v[13] = {54 + size, 0, 54, 40, (unsigned)w, (unsigned)h,
+	 1 | 24 << 16, 0, size, 0, 0, 0, 0};
+	for (int i = 0; i < 13; i++)
+		for (int b = 0; b < 4; b++)
+			header[2 + 4 * i + b] = (unsigned char)(v[i] >> (8 * b));
+	FILE* fp = fopen(FILE_NAME[f], "wb");
+	if (!fp)
+		return false;
+	fwrite(header, 1, 54, fp);
+	unsigned char* row = new unsigned char[pitch];
+	for (int y = h - 1; y >= 0; y--) {
+		for (int x = 0; x < pitch; x++)
+			row[x] = 0;
+		for (int x = 0; x < w; x++) {
+			unsigned c = colour(f, x, y);
+			row[3 * x]     = (unsigned char)c;
+			row[3 * x + 1] = (unsigned char)(c >> 8);
+			row[3 * x + 2] = (unsigned char)(c >> 16);
+		}
+		fwrite(row, 1, pitch, fp);
+	}
+	delete [] row;
+
+	return fclose(fp) == 0;
+}
+
+// texel returns the texel of the page at the texture coordinates [u, v]
+//
+static unsigned texel(const Image& page, float u, float v) {
+
+	int x = int(u * page.width), y = int(v * page.height);
+	if (x < 0 || y < 0 || x >= page.width || y >= page.height)
+		return 0;
+
+	return ((const unsigned*)page.data)[y * page.width + x];
+}
+
+int main() {
+
+	for (int f = 0; f < FILES; f++)
+		CHECK(writeBitmap(f));
+	CHECK(Atlas::build(FILE_NAME, FILES) == 1);
+
+	// every small file is on the first page and the large file is not
+	char name[32];
+	sprintf(name, ATLAS_FILE, 0);
+	float region[FILES][4];
+	for (int f = 0; f < PACKED; f++) {
+		const char* page = Atlas::find(FILE_NAME[f], region[f]);
+		CHECK(page && !strcmp(page, name));
+	}
+	CHECK(!Atlas::find(FILE_NAME[PACKED], region[PACKED]));
+	CHECK(Atlas::find("ATLASTEST0.BMP", region[PACKED]));
+
+	// the regions lie within the page and do not overlap
+	for (int f = 0; f < PACKED; f++) {
+		CHECK(region[f][0] > 0 && region[f][1] > 0);
+		CHECK(region[f][0] + region[f][2] < 1);
+		CHECK(region[f][1] + region[f][3] < 1);
+		for (int g = 0; g < f; g++)
+			CHECK(region[f][0] >= region[g][0] + region[g][2] ||
+			 region[g][0] >= region[f][0] + region[f][2] ||
+			 region[f][1] >= region[g][1] + region[g][3] ||
+			 region[g][1] >= region[f][1] + region[f][3]);
+	}
+
+	// coordinates mapped into each region sample the file's texels
+	Image page;
+	CHECK(loadImage(name, page) && decompressImage(page));
+	for (int f = 0; f < PACKED && page.data; f++) {
+		CHECK(region[f][2] * page.width == WIDTH[f]);
+		CHECK(region[f][3] * page.height == HEIGHT[f]);
+		for (int q = 0; q < 4; q++) {
+			float u = q % 2 ? 0.75f : 0.25f, v = q / 2 ? 0.75f : 0.25f;
+			Atlas::map(region[f], u, v);
+			CHECK(texel(page, u, v) == QUADRANT[f][q]);
+		}
+		// the corner texels and the padding beyond them repeat the
+		// corners of the file
+		float u = 0, v = 0;
+		Atlas::map(region[f], u, v);
+		CHECK(texel(page, u, v) == QUADRANT[f][0]);
+		CHECK(texel(page, u - float(ATLAS_PADDING) / page.width,
+		 v - float(ATLAS_PADDING) / page.height) == QUADRANT[f][0]);
+		u = v = 1;
+		Atlas::map(region[f], u, v);
+		float du = 0.5f / page.width, dv = 0.5f / page.height;
+		CHECK(texel(page, u - du, v - dv) == QUADRANT[f][3]);
+		CHECK(texel(page, u + (2 * ATLAS_PADDING - 1) * du,
+		 v + (2 * ATLAS_PADDING - 1) * dv) == QUADRANT[f][3]);
+	}
+	releaseImage(page);
+
+	// an unpacked file keeps its own coordinates
+	float whole[4] = {0, 0, 1, 1}, u = 0.3f, v = 0.6f;
+	Atlas::map(whole, u, v);
+	CHECK(u == 0.3f && v == 0.6f);
+
+	Atlas::clear();
+	CHECK(!Atlas::find(FILE_NAME[0], region[0]));
+	for (int f = 0; f < FILES; f++)
+		remove(FILE_NAME[f]);
+	remove(name);
+	printf("AtlasTest: %d failures\n", failures);
+
+	return failures;
+}
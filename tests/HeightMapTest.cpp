@@ -0,0 +1,284 @@
+/* HeightMap Test
+ *
+ * builds small height maps in memory - paletted, 16-bit, 24-bit and
+ * 32-bit pixels, with and without masks of their own - checks the
+ * formats that the reader accepts and refuses, and checks that the SSE2
+ * kernels convert each scan line to the same heights as the scalar loops
+ *
+ * HeightMapTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>     // for memcmp
+#include <string>      // for std::string
+#include <sstream>     // for std::istringstream
+#include "Test.h"      // for CHECK
+#include "HeightMap.h" // for HeightMap, readHeightMap, convertScanLine
+
+const int   MAX_WIDTH = 40;           // widest scan line tested
+const float FLOOR     = 120 / 255.f;  // a floor above zero
+
+// File collects the bytes of a file under construction
+//
+struct File {
+	unsigned char data[8192];
+	int           size;
+	File() : size(0) {}
+	void byte(unsigned v) { data[size++] = (unsigned char)v; }
+	void u16(unsigned v)  { byte(v); byte(v >> 8); }
+	void u32(unsigned v)  { u16(v); u16(v >> 16); }
+};
+
+// bmp builds the headers of a width x height height map with bits per
+// pixel - mask holds the masks of a BI_BITFIELDS file and palette the
+// colours of an 8-bit file
+//
+static File bmp(int bits, int width, int height, unsigned compression,
+ const unsigned* mask = 0, const unsigned* palette = 0, int colours = 0) {
+
+	File f;
+	int pitch  = (width * bits + 31) / 32 * 4;
+	int offset = 54 + (mask ? 12 : 0) + 4 * colours;
+	f.byte('B');
+	f.byte('M');
+	f.u32(offset + height * pitch);
+	f.u32(0);
+	f.u32(offset);
+	f.u32(40);
+	f.u32(width);
+	f.u32(height);
+	f.u16(1);
+	f.u16(bits);
+	f.u32(compression);
+	f.u32(height * pitch);
+	f.u32(0);
+	f.u32(0);
+	f.u32(colours);
+	f.u32(0);
+	for (int c = 0; mask && c < 3; c++)
+		f.u32(mask[c]);
+	for (int i = 0; i < colours; i++)
+		f.u32(palette[i]);
+
+	return f;
+}
+
+// pixels appends height scan lines of pseudo-random bytes to f
+//
+static void pixels(File& f, int pitch, int height) {
+
+	static unsigned seed = 12345;
+	for (int i = 0; i < pitch * height; i++) {
+		seed = seed * 1103515245 + 12345;
+		f.byte(seed >> 16);
+	}
+}
+
+// read reads the headers of the height map in f into map and leaves in
+// at its first scan line
+//
+static bool read(const File& f, std::istringstream& in, HeightMap& map) {
+
+	in.str(std::string((const char*)f.data, f.size));
+
+	return readHeightMap(in, map);
+}
+
+// same converts each scan line of the height map in f with and without
+// SSE2 and returns true if the heights are the same, bit for bit
+//
+static bool same(const File& f, float floor) {
+
+	std::istringstream in;
+	HeightMap map;
+	if (!read(f, in, map))
+		return false;
+	bool rc = true;
+	unsigned char line[4 * MAX_WIDTH];
+	float simd[MAX_WIDTH], scalar[MAX_WIDTH];
+	for (int r = 0; r < map.height; r++) {
+		if (!in.read((char*)line, map.pitch))
+			return false;
+		convertScanLine(map, line, simd, floor);
+		convertScanLine(map, line, scalar, floor, false);
+		rc = rc && !memcmp(simd, scalar, map.width * sizeof(float));
+		for (int j = 0; j < map.width; j++)
+			rc = rc && simd[j] >= floor && simd[j] < 1.0001f;
+	}
+
+	return rc;
+}
+
+// heights converts the first scan line of the height map in f into h
+//
+static bool heights(const File& f, float* h, bool simd) {
+
+	std::istringstream in;
+	HeightMap map;
+	unsigned char line[4 * MAX_WIDTH];
+	if (!read(f, in, map) || !in.read((char*)line, map.pitch))
+		return false;
+	convertScanLine(map, line, h, 0, simd);
+
+	return true;
+}
+
+// ramp returns a grey ramp palette
+//
+static const unsigned* ramp() {
+
+	static unsigned palette[256];
+	for (unsigned i = 0; i < 256; i++)
+		palette[i] = i << 16 | i << 8 | i;
+
+	return palette;
+}
+
+static void testRead() {
+
+	std::istringstream in;
+	HeightMap map;
+	File f = bmp(24, 5, 3, 0);
+	pixels(f, 16, 3);
+	CHECK(read(f, in, map));
+	CHECK(map.width == 5 && map.height == 3 && map.bits == 24 &&
+	 map.pitch == 16);
+	CHECK(in.get() == f.data[54]);
+
+	// the masks and the palette come before the scan lines
+	const unsigned grey[3] = {0xFFFF, 0xFFFF, 0xFFFF};
+	f = bmp(16, 3, 1, 3, grey);
+	pixels(f, 8, 1);
+	CHECK(read(f, in, map));
+	CHECK(map.pitch == 8 && map.mask[0] == 0xFFFF && map.mask[2] == 0xFFFF);
+	CHECK(in.get() == f.data[66]);
+	f = bmp(8, 3, 1, 0, 0, ramp(), 256);
+	pixels(f, 4, 1);
+	CHECK(read(f, in, map) && map.ramp && map.pitch == 4);
+	CHECK(in.get() == f.data[54 + 1024]);
+
+	// X1R5G5B5 and X8R8G8B8 unless the file has masks of its own
+	CHECK(read(bmp(16, 1, 1, 0), in, map) && map.mask[0] == 0x7C00 &&
+	 map.mask[1] == 0x03E0 && map.mask[2] == 0x001F);
+	CHECK(read(bmp(32, 1, 1, 0), in, map) && map.mask[0] == 0xFF0000 &&
+	 map.mask[1] == 0x00FF00 && map.mask[2] == 0x0000FF);
+}
+
+static void testRefused() {
+
+	std::istringstream in;
+	HeightMap map;
+	const unsigned top[3]  = {0x80000000, 0xFF00, 0xFF};
+	const unsigned none[3] = {0, 0xFF00, 0xFF};
+	const unsigned wide[3] = {0x10000, 0xFF00, 0xFF};
+	const unsigned bgr[3]  = {0xFF0000, 0xFF00, 0xFF};
+	CHECK(!read(bmp(8, 4, 1, 1, 0, ramp(), 256), in, map));  // BI_RLE8
+	CHECK(!read(bmp(4, 4, 1, 0, 0, ramp(), 16), in, map));   // 4-bit
+	CHECK(!read(bmp(24, 4, 1, 3, bgr), in, map));            // masks, 24-bit
+	CHECK(!read(bmp(32, 4, 1, 3, top), in, map));            // top bit
+	CHECK(!read(bmp(32, 4, 1, 3, none), in, map));           // empty mask
+	CHECK(!read(bmp(16, 4, 1, 3, wide), in, map));           // beyond pixel
+	CHECK(!read(bmp(24, 4, (unsigned)-1, 0), in, map));      // top-down
+	CHECK(!read(bmp(24, 0, 1, 0), in, map));                 // no pixels
+
+	File f = bmp(24, 4, 1, 0);
+	f.data[0] = 'P';
+	CHECK(!read(f, in, map));
+	f = bmp(8, 4, 1, 0, 0, ramp(), 256);
+	f.data[10] = 54; // scan lines within the palette
+	f.data[11] = 0;
+	CHECK(!read(f, in, map));
+}
+
+static void testHeights() {
+
+	float h[4];
+
+	// a grey 16-bit mask holds a full-precision elevation
+	const unsigned grey[3] = {0xFFFF, 0xFFFF, 0xFFFF};
+	File f = bmp(16, 3, 1, 3, grey);
+	f.u16(0xFFFF);
+	f.u16(0);
+	f.u16(0x8000);
+	f.u16(0);
+	CHECK(heights(f, h, true));
+	CHECK(h[0] == 1 && h[1] == 0 && h[2] > 0.5f && h[2] < 0.5001f);
+
+	// X1R5G5B5 ignores the top bit and averages the channels
+	f = bmp(16, 3, 1, 0);
+	f.u16(0xFFFF);
+	f.u16(0x801F);
+	f.u16(0x7C00);
+	f.u16(0);
+	CHECK(heights(f, h, false));
+	CHECK(h[0] > 0.9999f && h[0] < 1.0001f);
+	CHECK(h[1] > 0.3333f && h[1] < 0.3334f &&
+	 h[2] > 0.3333f && h[2] < 0.3334f);
+
+	// X8R8G8B8 ignores the top byte
+	f = bmp(32, 2, 1, 0);
+	f.u32(0x00FFFFFF);
+	f.u32(0xFF000000);
+	CHECK(heights(f, h, false));
+	CHECK(h[0] > 0.9999f && h[0] < 1.0001f && h[1] == 0);
+
+	// an 8-bit pixel is a palette index - not a grey level
+	unsigned palette[4] = {0xFFFFFF, 0x000000, 0x0000FF, 0x808080};
+	f = bmp(8, 4, 1, 0, 0, palette, 4);
+	f.u32(0x03020100);
+	CHECK(heights(f, h, true));
+	CHECK(h[0] == 1 && h[1] == 0 && h[2] > 0.3333f && h[2] < 0.3334f &&
+	 h[3] > 0.5019f && h[3] < 0.502f);
+	f = bmp(8, 4, 1, 0, 0, ramp(), 256);
+	f.u32(0xFF804000);
+	CHECK(heights(f, h, true));
+	CHECK(h[0] == 0 && h[1] > 0.2509f && h[1] < 0.251f && h[3] == 1);
+}
+
+// testKernels checks every format at a width that the kernels cover
+// exactly and one that leaves pixels for the scalar loops to finish
+//
+static void testKernels() {
+
+	unsigned palette[256];
+	for (unsigned i = 0; i < 256; i++)
+		palette[i] = (i * 7919) & 0xFFFFFF;
+	const unsigned grey16[3] = {0xFFFF, 0xFFFF, 0xFFFF};
+	const unsigned rgb565[3] = {0xF800, 0x07E0, 0x001F};
+	const unsigned rgb10[3]  = {0x3FF00000, 0x000FFC00, 0x000003FF};
+	const unsigned grey32[3] = {0x00FFFFFF, 0x00FFFFFF, 0x00FFFFFF};
+	const int widths[2] = {MAX_WIDTH, MAX_WIDTH - 3};
+	for (int w = 0; w < 2; w++) {
+		int width = widths[w];
+		for (int k = 0; k < 2; k++) {
+			float floor = k ? FLOOR : 0;
+			File f[8];
+			f[0] = bmp(8, width, 3, 0, 0, ramp(), 256);
+			f[1] = bmp(8, width, 3, 0, 0, palette, 256);
+			f[2] = bmp(16, width, 3, 0);
+			f[3] = bmp(16, width, 3, 3, grey16);
+			f[4] = bmp(16, width, 3, 3, rgb565);
+			f[5] = bmp(24, width, 3, 0);
+			f[6] = bmp(32, width, 3, 0);
+			f[7] = bmp(32, width, 3, 3, w ? rgb10 : grey32);
+			for (int i = 0; i < 8; i++) {
+				const int bits[8] = {8, 8, 16, 16, 16, 24, 32, 32};
+				pixels(f[i], (width * bits[i] + 31) / 32 * 4, 3);
+				CHECK(same(f[i], floor));
+			}
+		}
+	}
+}
+
+int main() {
+
+	testRead();
+	testRefused();
+	testHeights();
+	testKernels();
+	printf("HeightMapTest: %d failures\n", failures);
+
+	return failures;
+}
@@ -0,0 +1,290 @@
+/* ImageDecoder Test
+ *
+ * builds small BMP, TGA and DDS files in memory - bottom-up and top-down
+ * rows, paletted pixels, run-length packets across rows, DXT blocks and
+ * mip chains - and checks the texels that the decoder returns
+ *
+ * ImageDecoderTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>        // for memcmp, memcpy
+#include "Test.h"         // for CHECK
+#include "ImageDecoder.h" // for decodeImage, loadImage, decompressImage
+
+const char* FILE_NAME = "ImageDecoderTest.bmp";
+
+// File collects the bytes of a file under construction
+//
+struct File {
+	unsigned char data[1024];
+	int           size;
+	File() : size(0) {}
+	void byte(unsigned v) { data[size++] = (unsigned char)v; }
+	void u16(unsigned v)  { byte(v); byte(v >> 8); }
+	void u32(unsigned v)  { u16(v); u16(v >> 16); }
+	void bgr(unsigned c)  { byte(c); byte(c >> 8); byte(c >> 16); }
+	void zeros(int n)     { while (n--) byte(0); }
+};
+
+// the texels of a 3 x 2 image, top row first
+static const unsigned texels[6] = {
+	0xFF102030, 0xFF405060, 0xFF708090,
+	0xFFA0B0C0, 0xFFD0E0F0, 0xFF0F1F2F};
+
+// same returns true if image holds w x h 32-bit texels equal to t
+//
+static bool same(const Image& image, int w, int h, const unsigned* t) {
+
+	return image.format == IMAGE_ARGB && image.width == w &&
+	 image.height == h && image.levels == 1 && image.size == w * h * 4 &&
+	 !memcmp(image.data, t, w * h * 4);
+}
+
+// bmp builds a 24-bit BMP of texels, stored bottom row first unless
+// topDown
+//
+static File bmp(bool topDown) {
+
+	File f;
+	int pitch = 12; // three 24-bit pixels padded to four bytes
+	f.byte('B');
+	f.byte('M');
+	f.u32(54 + 2 * pitch);
+	f.u32(0);
+	f.u32(54);
+	f.u32(40);
+	f.u32(3);
+	f.u32(topDown ? (unsigned)-2 : 2);
+	f.u16(1);
+	f.u16(24);
+	f.u32(0);
+	f.u32(2 * pitch);
+	f.zeros(16);
+	for (int r = 0; r < 2; r++) {
+		int y = topDown ? r : 1 - r;
+		for (int x = 0; x < 3; x++)
+			f.bgr(texels[y * 3 + x]);
+		f.zeros(pitch - 9);
+	}
+
+	return f;
+}
+
+static void testBMP() {
+
+	Image image;
+	File up = bmp(false), down = bmp(true);
+	CHECK(decodeImage(up.data, up.size, image) && same(image, 3, 2, texels));
+	releaseImage(image);
+	CHECK(decodeImage(down.data, down.size, image) &&
+	 same(image, 3, 2, texels));
+	releaseImage(image);
+
+	// a 4-bit paletted image - indices 0, 1 and 2 in each row
+	File p;
+	unsigned palette[3] = {0x112233, 0x445566, 0x778899};
+	unsigned expected[6];
+	p.byte('B');
+	p.byte('M');
+	p.u32(54 + 12 + 8);
+	p.u32(0);
+	p.u32(54 + 12);
+	p.u32(40);
+	p.u32(3);
+	p.u32(2);
+	p.u16(1);
+	p.u16(4);
+	p.u32(0);
+	p.u32(8);
+	p.zeros(8);
+	p.u32(3);
+	p.u32(0);
+	for (int i = 0; i < 3; i++) {
+		p.bgr(palette[i]);
+		p.byte(0);
+	}
+	for (int r = 0; r < 2; r++) {
+		p.byte(0x01);
+		p.byte(0x20);
+		p.zeros(2);
+	}
+	for (int i = 0; i < 6; i++)
+		expected[i] = 0xFF000000 | palette[i % 3];
+	CHECK(decodeImage(p.data, p.size, image) && same(image, 3, 2, expected));
+	releaseImage(image);
+
+	// a file cut short of its rows is refused
+	CHECK(!decodeImage(up.data, up.size - 4, image) && !image.data);
+
+	// loadImage reads the file from disk
+	FILE* fp = fopen(FILE_NAME, "wb");
+	CHECK(fp && fwrite(up.data, 1, up.size, fp) == (size_t)up.size);
+	if (fp)
+		fclose(fp);
+	CHECK(loadImage(FILE_NAME, image) && same(image, 3, 2, texels));
+	releaseImage(image);
+	remove(FILE_NAME);
+	CHECK(!loadImage(FILE_NAME, image) && !image.data);
+}
+
+// tgaHeader adds the header of a run-length encoded true colour TGA of
+// w x h pixels of bits bits - descriptor holds the alpha bits and the
+// row order
+//
+static void tgaHeader(File& f, int w, int h, int bits, int descriptor) {
+
+	f.byte(0);
+	f.byte(0);
+	f.byte(10);
+	f.zeros(9);
+	f.u16(w);
+	f.u16(h);
+	f.byte(bits);
+	f.byte(descriptor);
+}
+
+static void testTGA() {
+
+	// 24-bit, bottom row first - a run that fills the start of the bottom
+	// row, a run that crosses into the top row and a raw packet of more
+	// pixels than remain, which is refused
+	File f;
+	tgaHeader(f, 3, 2, 24, 0);
+	f.byte(0x80 | 1);
+	f.bgr(texels[3]);
+	f.byte(0x80 | 1);
+	f.bgr(texels[5]);
+	f.byte(3);
+	for (int i = 0; i < 4; i++)
+		f.bgr(texels[i]);
+	Image image;
+	CHECK(!decodeImage(f.data, f.size, image));
+
+	// the same runs ended by a raw packet of the two pixels that remain
+	File g;
+	unsigned expected[6] = {
+		texels[5], texels[1], texels[2],
+		texels[3], texels[3], texels[5]};
+	tgaHeader(g, 3, 2, 24, 0);
+	g.byte(0x80 | 1);
+	g.bgr(texels[3]);
+	g.byte(0x80 | 1);
+	g.bgr(texels[5]);
+	g.byte(1);
+	g.bgr(texels[1]);
+	g.bgr(texels[2]);
+	CHECK(decodeImage(g.data, g.size, image) && same(image, 3, 2, expected));
+	releaseImage(image);
+
+	// 32-bit with 8 bits of alpha, top row first
+	File a;
+	unsigned alpha[4] = {0x80FF0000, 0x80FF0000, 0x0000FF00, 0xFF0000FF};
+	tgaHeader(a, 2, 2, 32, 0x28);
+	a.byte(0x80 | 1);
+	a.u32(alpha[0]);
+	a.byte(1);
+	a.u32(alpha[2]);
+	a.u32(alpha[3]);
+	CHECK(decodeImage(a.data, a.size, image) && same(image, 2, 2, alpha));
+	releaseImage(image);
+
+	// a file whose packets stop short of the image is refused
+	CHECK(!decodeImage(a.data, a.size - 4, image) && !image.data);
+}
+
+// ddsHeader adds the header of a DDS file of w x h texels and levels mip
+// levels - DXT1 blocks if dxt1, otherwise 32-bit A8R8G8B8 pixels
+//
+static void ddsHeader(File& f, int w, int h, int levels, bool dxt1) {
+
+	f.byte('D');
+	f.byte('D');
+	f.byte('S');
+	f.byte(' ');
+	f.u32(124);
+	f.u32(0x1007 | 0x20000);
+	f.u32(h);
+	f.u32(w);
+	f.u32(0);
+	f.u32(0);
+	f.u32(levels);
+	f.zeros(44);
+	f.u32(32);
+	if (dxt1) {
+		f.u32(0x4);
+		f.u32('D' | 'X' << 8 | 'T' << 16 | '1' << 24);
+		f.zeros(20);
+	}
+	else {
+		f.u32(0x41);
+		f.u32(0);
+		f.u32(32);
+		f.u32(0xFF0000);
+		f.u32(0xFF00);
+		f.u32(0xFF);
+		f.u32(0xFF000000);
+	}
+	f.u32(0x401008);
+	f.zeros(16);
+}
+
+static void testDDS() {
+
+	// an 8 x 8 DXT1 chain of three levels - 4, 1 and 1 blocks - in which
+	// every block is red but for its second texel, which is blue
+	File f;
+	ddsHeader(f, 8, 8, 3, true);
+	CHECK(f.size == 128);
+	for (int b = 0; b < 6; b++) {
+		f.u16(0xF800);
+		f.u16(0x001F);
+		f.u32(0x4);
+	}
+	Image image;
+	CHECK(decodeImage(f.data, f.size, image));
+	CHECK(image.format == IMAGE_DXT1 && image.width == 8 &&
+	 image.height == 8 && image.levels == 3 && image.size == 48);
+	CHECK(image.data && !memcmp(image.data, f.data + 128, 48));
+	CHECK(decompressImage(image));
+	CHECK(image.format == IMAGE_ARGB && image.levels == 1 &&
+	 image.size == 8 * 8 * 4);
+	const unsigned* t = (const unsigned*)image.data;
+	CHECK(t && t[0] == 0xFFFF0000 && t[1] == 0xFF0000FF &&
+	 t[4] == 0xFFFF0000 && t[5] == 0xFF0000FF && t[8] == 0xFFFF0000);
+	releaseImage(image);
+
+	// the levels that the file holds in full are kept
+	CHECK(decodeImage(f.data, f.size - 8, image) && image.levels == 2 &&
+	 image.size == 40);
+	releaseImage(image);
+
+	// a 2 x 2 chain of 32-bit pixels - two levels
+	File a;
+	ddsHeader(a, 2, 2, 2, false);
+	unsigned pixels[5] = {0x11223344, 0x55667788, 0x99AABBCC, 0xDDEEFF00,
+	 0x80808080};
+	for (int i = 0; i < 5; i++)
+		a.u32(pixels[i]);
+	CHECK(decodeImage(a.data, a.size, image));
+	CHECK(image.format == IMAGE_ARGB && image.width == 2 &&
+	 image.height == 2 && image.levels == 2 && image.size == 20);
+	CHECK(image.data && !memcmp(image.data, pixels, 20));
+	releaseImage(image);
+
+	// a cube map is refused
+	a.data[113] |= 0x200 >> 8;
+	CHECK(!decodeImage(a.data, a.size, image) && !image.data);
+}
+
+int main() {
+
+	testBMP();
+	testTGA();
+	testDDS();
+	printf("ImageDecoderTest: %d failures\n", failures);
+
+	return failures;
+}
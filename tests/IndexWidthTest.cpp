@@ -0,0 +1,143 @@
+/* Index Width Test
+ *
+ * checks the width of the indices that objects hand to the headless
+ * graphics card - a grid of 80000 vertices needs 32-bit indices, a small
+ * grid keeps 16-bit indices, and a terrain of more than 65536 vertices
+ * keeps its 16-bit tile-local indices and addresses every vertex of each
+ * tile through the base vertex of its range
+ *
+ * The test links the scene and the headless card with the engine
+ * modules that make headless builds
+ *
+ * IndexWidthTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio>          // for fopen, fwrite, fclose, remove
+#include "Test.h"          // for CHECK
+#include "IScene.h"        // for CreateScene, CreateGrid, CreateTerrain, Range
+#include "HeadlessCard.h"  // for Graphic
+#include "ModelSettings.h" // for TERRAIN_TILE_EXT
+#include "Threads.h"       // for sleepFor
+
+const char* HEIGHT_MAP = "IndexWidthTest.bmp";
+const char* TILED_MAP  = "IndexWidthTest.bmp" TERRAIN_TILE_EXT;
+const int   MAP_SIDE   = 513; // pixels along the side of the height map
+const int   TILE_CELLS = 32;  // cells along the side of a terrain tile
+
+// writeHeightMap writes a 24-bit BMP of MAP_SIDE x MAP_SIDE rolling hills
+//
+static bool writeHeightMap(const char* file) {
+
+	int pitch = (3 * MAP_SIDE + 3) & ~3;
+	unsigned char h[54] = {'B', 'M'};
+	unsigned size = pitch * MAP_SIDE;
+	unsigned v[13] = {54 + size, 0, 54, 40, MAP_SIDE, MAP_SIDE, 1 | 24 << 16,
+	 0, size, 0, 0, 0, 0};
+	for (int i = 0; i < 13; i++)
+		for (int b = 0; b < 4; b++)
+			h[2 + 4 * i + b] = (unsigned char)(v[i] >> (8 * b));
+	FILE* fp = fopen(file, "wb");
+	if (!fp)
+		return false;
+	fwrite(h, 1, 54, fp);
+	unsigned char* row = new unsigned char[pitch];
+	for (int y = 0; y < MAP_SIDE; y++) {
+		for (int x = 0; x < pitch; x++)
+			row[x] = 0;
+		for (int x = 0; x < MAP_SIDE; x++)
+			row[3 * x] = row[3 * x + 1] = row[3 * x + 2] =
+			 (unsigned char)((x * 7 + y * 3) % 256);
+		fwrite(row, 1, pitch, fp);
+	}
+	delete [] row;
+
+	return fclose(fp) == 0;
+}
+
+// setup has the graphic of object copy its vertices and indices - there
+// is no recorder, so the draw records nothing
+//
+static const Graphic* setup(IObject* object) {
+
+	Graphic* g = (Graphic*)object->graphic();
+	if (g)
+		g->draw(object);
+
+	return g;
+}
+
+static void testGrids() {
+
+	// 20000 lines each way - 80000 vertices
+	IObject* big = CreateGrid(0, 0, 19999, 20000, Colour(1, 1, 1));
+	const Graphic* g = setup(big);
+	CHECK(g && big->wideIndices());
+	CHECK(g && g->wide() && g->vertices() > 0xFFFF);
+	int n;
+	CHECK(g && !big->ranges(n) && g->within(0, 0, g->indices() / 2));
+	big->Delete();
+
+	// a small grid keeps 16-bit indices
+	IObject* small = CreateGrid(-10, 0, 10, 11, Colour(1, 1, 1));
+	g = setup(small);
+	CHECK(g && !small->wideIndices() && !g->wide());
+	CHECK(g && g->within(0, 0, g->indices() / 2));
+	small->Delete();
+}
+
+static void testTerrain() {
+
+	CHECK(writeHeightMap(HEIGHT_MAP));
+	IObject* terrain = CreateTerrain(4, 50, HEIGHT_MAP);
+	const Graphic* g = setup(terrain);
+	int tiles = (MAP_SIDE - 2 + TILE_CELLS) / TILE_CELLS;
+	tiles *= tiles;
+	CHECK(g && g->vertices() > 0xFFFF);
+	CHECK(g && g->vertices() == tiles * (TILE_CELLS + 1) * (TILE_CELLS + 1));
+	// the tile-local indices stay 16-bit by design
+	CHECK(g && !terrain->wideIndices() && !g->wide());
+
+	// select from above the centre until the streamer has generated every
+	// tile - a frustum of cleared planes accepts the whole terrain
+	Frustum everything;
+	int n = 0;
+	const Range* range = NULL;
+	for (int i = 0; i < 1000 && n < tiles; i++) {
+		terrain->select(Vector(0, 100, 0), everything, 1);
+		range = terrain->ranges(n);
+		if (n < tiles)
+			sleepFor(10);
+	}
+	CHECK(n == tiles);
+
+	// every range reaches past the first 65536 vertices only through its
+	// base vertex
+	bool inside = true, far = false;
+	for (int i = 0; i < n && g; i++) {
+		if (!g->within(range[i].baseVertex, range[i].startIndex,
+		 range[i].nPrimitives))
+			inside = false;
+		if (range[i].baseVertex + range[i].nVertices > 0x10000)
+			far = true;
+	}
+	CHECK(inside);
+	CHECK(far);
+	terrain->Delete();
+	remove(HEIGHT_MAP);
+	remove(TILED_MAP);
+}
+
+int main() {
+
+	// the objects add themselves to the scene as they are created
+	IScene* scene = CreateScene(NULL, NULL, NULL, NULL, NULL, NULL);
+	testGrids();
+	testTerrain();
+	scene->Delete();
+	printf("IndexWidthTest: %d failures\n", failures);
+
+	return failures;
+}
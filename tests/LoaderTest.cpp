@@ -0,0 +1,108 @@
+/* Loader Test
+ *
+ * submits requests to the loader pool and checks that each is loaded
+ * once before it is finished, that the render thread finishes them all,
+ * that stopping the pool finishes those that have not started, and that
+ * requests beyond the nodes of the lock-free lists, or submitted while the
+ * pool is stopped, are loaded at once
+ *
+ * LoaderTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include "Test.h"   // for CHECK
+#include "Loader.h" // for Loader and LoadRequest
+
+const int REQUESTS = 1000;
+
+static volatile long loads    = 0; // calls to load()
+static int           finishes = 0; // calls to finish()
+static int           unloaded = 0; // requests finished without loading
+static int           deleted  = 0; // requests deleted
+
+// Request counts the calls made on it
+//
+class Request : public LoadRequest {
+
+	volatile long loaded; // times load() was called
+	int           spin;   // work done by load()
+
+  public:
+	Request(int s) : loaded(0), spin(s) {}
+	void load() {
+		volatile int sum = 0;
+		for (int i = 0; i < spin; i++)
+			sum = sum + i;
+		atomicIncrement(&loaded);
+		atomicIncrement(&loads);
+	}
+	void finish() {
+		CHECK(loaded <= 1);
+		if (!loaded)
+			unloaded++;
+		finishes++;
+	}
+	~Request() { deleted++; }
+};
+
+// run submits REQUESTS requests to a pool of threads threads and finishes
+// them on this thread
+//
+static void run(int threads) {
+
+	loads = finishes = unloaded = deleted = 0;
+	CHECK(Loader::start(threads));
+	for (int i = 0; i < REQUESTS; i++)
+		Loader::submit(new Request(i % 64 * 100));
+	while (Loader::outstanding())
+		Loader::finish();
+	CHECK(loads == REQUESTS);
+	CHECK(finishes == REQUESTS);
+	CHECK(deleted == REQUESTS);
+	CHECK(unloaded == 0);
+	Loader::stop();
+	CHECK(Loader::outstanding() == 0);
+}
+
+int main() {
+
+	run(0);
+	run(1);
+	run(4);
+
+	// stop finishes every request - loaded or not - exactly once
+	loads = finishes = unloaded = deleted = 0;
+	CHECK(Loader::start(2));
+	for (int i = 0; i < REQUESTS; i++)
+		Loader::submit(new Request(10000));
+	Loader::stop();
+	CHECK(finishes == REQUESTS);
+	CHECK(deleted == REQUESTS);
+	CHECK(loads + unloaded == REQUESTS);
+	CHECK(Loader::outstanding() == 0);
+
+	// with every node in flight, submit loads and finishes a request
+	// itself
+	loads = finishes = unloaded = deleted = 0;
+	CHECK(Loader::start(0));
+	for (int i = 0; i < LOADER_REQUESTS + 10; i++)
+		Loader::submit(new Request(0));
+	CHECK(finishes == 10 && unloaded == 0);
+	CHECK(Loader::outstanding() == LOADER_REQUESTS);
+	CHECK(Loader::finish() == LOADER_REQUESTS);
+	CHECK(loads == LOADER_REQUESTS + 10 && deleted == LOADER_REQUESTS + 10);
+	Loader::stop();
+
+	// once the pool has stopped, submit loads and finishes a request
+	// itself
+	loads = finishes = unloaded = deleted = 0;
+	Loader::submit(new Request(0));
+	CHECK(loads == 1 && finishes == 1 && deleted == 1);
+	CHECK(Loader::outstanding() == 0);
+
+	printf("LoaderTest: %d failures\n", failures);
+
+	return failures;
+}
@@ -0,0 +1,145 @@
+/* Rasterizer Regression Test
+ *
+ * draws a fixed scene - overlapping triangles at different depths, 16-
+ * and 32-bit indices and an alpha blended quad - and checks the colours
+ * of chosen pixels and that every number of worker threads rasterizes
+ * the same frame, frame after frame
+ *
+ * RasterizerTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>      // for memcmp
+#include "Test.h"       // for CHECK
+#include "Rasterizer.h" // for Rasterizer
+
+const int WIDTH  = 200; // not a multiple of the tile size
+const int HEIGHT = 150;
+const int FRAMES = 3;   // frames drawn by each rasterizer
+const char* FILE_NAME = "RasterizerTest.ppm";
+
+// vertices are x, y, z, nx, ny, nz, tu, tv in clip space - the view
+// projection is the identity - and each triangle is clockwise on screen
+//
+static const float near_[3][8] = {
+	{-0.2f,  0.2f, 0.2f, 0, 0, -1, 0, 0},
+	{ 0.2f,  0.2f, 0.2f, 0, 0, -1, 1, 0},
+	{-0.2f, -0.2f, 0.2f, 0, 0, -1, 0, 1}};
+static const float far_[3][8] = {
+	{-0.8f,  0.8f, 0.5f, 0, 0, -1, 0, 0},
+	{ 0.8f,  0.8f, 0.5f, 0, 0, -1, 1, 0},
+	{-0.8f, -0.8f, 0.5f, 0, 0, -1, 0, 1}};
+static const float quad[4][8] = {
+	{0.3f, -0.3f, 0.1f, 0, 0, -1, 0, 0},
+	{0.9f, -0.3f, 0.1f, 0, 0, -1, 1, 0},
+	{0.3f, -0.9f, 0.1f, 0, 0, -1, 0, 1},
+	{0.9f, -0.9f, 0.1f, 0, 0, -1, 1, 1}};
+
+// identity returns the identity transformation
+//
+static Matrix identity() {
+
+	Matrix m;
+	m.m11 = m.m22 = m.m33 = m.m44 = 1;
+	return m;
+}
+
+// render draws the scene FRAMES times with threads workers and leaves
+// the last frame in rgb - returns false if a frame differs from the
+// first
+//
+static bool render(int threads, unsigned char* rgb) {
+
+	Rasterizer r;
+	CHECK(r.setup(WIDTH, HEIGHT, threads));
+	CHECK(r.workers() == threads);
+	Matrix I = identity();
+	unsigned short nearIndex[3] = {0, 1, 2};
+	unsigned       farIndex[3]  = {0, 1, 2};
+	unsigned short quadIndex[6] = {0, 1, 2, 1, 3, 2};
+
+	bool same = true;
+	unsigned char* first = new unsigned char[3 * WIDTH * HEIGHT];
+	for (int f = 0; f < FRAMES; f++) {
+		r.ambient(Colour(1, 1, 1));
+		r.begin(I, Colour(0, 0, 1));
+		// the near triangle is drawn first, so that the far triangle
+		// must fail the depth test where they overlap
+		r.draw(I, Colour(0, 1, 0), NULL, false, TRIANGLE_LIST,
+		 (const char*)near_, sizeof near_[0], NULL, 3, nearIndex, false,
+		 0, 0, 1);
+		r.draw(I, Colour(1, 0, 0), NULL, false, TRIANGLE_LIST,
+		 (const char*)far_, sizeof far_[0], NULL, 3, farIndex, true, 0, 0,
+		 1);
+		r.draw(I, Colour(1, 1, 1, 0.5f), NULL, true, TRIANGLE_LIST,
+		 (const char*)quad, sizeof quad[0], NULL, 4, quadIndex, false, 0,
+		 0, 2);
+		r.end();
+		CHECK(r.triangles() == 4);
+
+		CHECK(r.capture(FILE_NAME));
+		FILE* fp = fopen(FILE_NAME, "rb");
+		int w = 0, h = 0, max = 0;
+		CHECK(fp && fscanf(fp, "P6 %d %d %d", &w, &h, &max) == 3);
+		CHECK(w == WIDTH && h == HEIGHT && max == 255);
+		CHECK(fp && fgetc(fp) == '\n');
+		CHECK(fp && fread(rgb, 1, 3 * WIDTH * HEIGHT, fp) ==
+		 (size_t)(3 * WIDTH * HEIGHT));
+		if (fp)
+			fclose(fp);
+		if (!f)
+			memcpy(first, rgb, 3 * WIDTH * HEIGHT);
+		else if (memcmp(first, rgb, 3 * WIDTH * HEIGHT))
+			same = false;
+	}
+	delete [] first;
+	remove(FILE_NAME);
+
+	return same;
+}
+
+// pixel returns true if the pixel at clip space [x, y] of rgb is within
+// 3 of [r, g, b]
+//
+static bool pixel(const unsigned char* rgb, float x, float y, int r, int g,
+ int b) {
+
+	int sx = int((x * 0.5f + 0.5f) * WIDTH);
+	int sy = int((0.5f - y * 0.5f) * HEIGHT);
+	const unsigned char* p = rgb + 3 * (sy * WIDTH + sx);
+	int e[3] = {p[0] - r, p[1] - g, p[2] - b};
+	bool close = true;
+	for (int i = 0; i < 3; i++)
+		if (e[i] < -3 || e[i] > 3)
+			close = false;
+	if (!close)
+		printf("pixel (%d, %d) is %d %d %d, not %d %d %d\n", sx, sy, p[0],
+		 p[1], p[2], r, g, b);
+
+	return close;
+}
+
+int main() {
+
+	const int n = 3 * WIDTH * HEIGHT;
+	unsigned char* one  = new unsigned char[n];
+	unsigned char* many = new unsigned char[n];
+
+	CHECK(render(1, one));
+	CHECK(render(7, many));
+	CHECK(!memcmp(one, many, n));
+
+	// the materials reflect 70% of the ambient light
+	CHECK(pixel(one, -0.1f, 0.1f, 0, 178, 0));   // near over far
+	CHECK(pixel(one, -0.5f, 0.5f, 178, 0, 0));   // far alone
+	CHECK(pixel(one, 0.7f, -0.1f, 0, 0, 255));   // clear colour
+	CHECK(pixel(one, 0.6f, -0.6f, 89, 89, 217)); // blended over clear
+
+	delete [] one;
+	delete [] many;
+	printf("RasterizerTest: %d failures\n", failures);
+
+	return failures;
+}
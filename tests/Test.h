@@ -0,0 +1,26 @@
+#ifndef _TEST_H_
+#define _TEST_H_
+
+/* Header for the Test Helpers
+ *
+ * consists of the CHECK macro and the failure count
+ *
+ * Test.h
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstdio> // for printf
+
+// failures counts the checks that have failed - main returns it, so
+// that make stops at the first test program with a failure
+//
+static int failures = 0;
+
+// CHECK reports condition c with its file and line if it does not hold
+//
+#define CHECK(c) ((c) ? (void)0 : (void)(failures++, \
+ printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #c)))
+
+#endif
@@ -0,0 +1,169 @@
+/* TextureCompressor Test
+ *
+ * builds mip chains and compresses them to BC1 and BC3 blocks, checks
+ * the filtered and the decompressed texels and that the number of
+ * threads does not change the result
+ *
+ * TextureCompressorTest.cpp
+ * version 1.0
+ * gam670/dps905
+ * Oct 18 2026
+ */
+
+#include <cstring>             // for memcmp
+#include "Test.h"              // for CHECK
+#include "ImageDecoder.h"      // for Image, decompressImage
+#include "TextureCompressor.h" // for buildMipChain, compressImage
+
+const int SIDE = 16;
+
+// create sets image to a single level of w x h texels from f
+//
+static void create(Image& image, int w, int h, unsigned (*f)(int, int)) {
+
+	unsigned* t = new unsigned[w * h];
+	for (int y = 0; y < h; y++)
+		for (int x = 0; x < w; x++)
+			t[y * w + x] = f(x, y);
+	image.width  = w;
+	image.height = h;
+	image.levels = 1;
+	image.format = IMAGE_ARGB;
+	image.size   = w * h * 4;
+	image.data   = (unsigned char*)t;
+}
+
+// the test images - flat grey, black and white columns, a ramp along
+// the diagonal, an opaque half beside a half whose alpha rises row by row,
+// and opaque red columns between transparent blue ones
+//
+static unsigned grey(int, int) {
+	return 0xFF808080;
+}
+static unsigned checker(int x, int) {
+	return x & 1 ? 0xFFFFFFFF : 0xFF000000;
+}
+static unsigned ramp(int x, int y) {
+	int t = (x + y) * 8; // every block lies on one line of colour
+	return 0xFF000000 | t << 16 | (t / 2 + 64) << 8 | (255 - t);
+}
+static unsigned cutout(int x, int y) {
+	return x < SIDE / 2 ? 0xFF20C040 : (y * 16) << 24 | 0x0040C020;
+}
+static unsigned hidden(int x, int) {
+	return x & 1 ? 0xFFFF0000 : 0x000000FF;
+}
+
+// near returns true if each channel of texels a and b differ by at most d
+//
+static bool near(unsigned a, unsigned b, int d) {
+
+	for (int s = 0; s < 32; s += 8) {
+		int e = int(a >> s & 0xFF) - int(b >> s & 0xFF);
+		if (e < -d || e > d)
+			return false;
+	}
+
+	return true;
+}
+
+// texel returns texel [x, y] of the top level of image
+//
+static unsigned texel(const Image& image, int x, int y) {
+
+	return ((const unsigned*)image.data)[y * image.width + x];
+}
+
+static void testMipChain() {
+
+	Image image;
+	create(image, SIDE, SIDE / 2, grey);
+	CHECK(buildMipChain(image, 1));
+	// 16 x 8, 8 x 4, 4 x 2, 2 x 1 and 1 x 1
+	CHECK(image.levels == 5);
+	CHECK(image.size == (128 + 32 + 8 + 2 + 1) * 4);
+	const unsigned* t = (const unsigned*)image.data;
+	bool flat = true;
+	for (int i = 0; i < image.size / 4; i++)
+		if (t[i] != 0xFF808080)
+			flat = false;
+	CHECK(flat);
+	CHECK(!buildMipChain(image, 1)); // already a chain
+	releaseImage(image);
+
+	// black and white average to half the light, not half the level
+	create(image, SIDE, SIDE, checker);
+	CHECK(buildMipChain(image, 0));
+	unsigned level1 = ((const unsigned*)image.data)[SIDE * SIDE];
+	CHECK(near(level1, 0xFFBCBCBC, 1));
+	releaseImage(image);
+
+	// a transparent texel does not darken its opaque neighbour
+	create(image, 2, 2, hidden);
+	CHECK(buildMipChain(image, 1));
+	CHECK(image.levels == 2);
+	CHECK(near(((const unsigned*)image.data)[4], 0x80FF0000, 1));
+	releaseImage(image);
+}
+
+// compress builds and compresses image from f on threads threads, and
+// returns the blocks in image
+//
+static void compress(Image& image, unsigned (*f)(int, int), int threads) {
+
+	create(image, SIDE, SIDE, f);
+	CHECK(buildMipChain(image, threads));
+	CHECK(compressImage(image, threads));
+}
+
+static void testCompression() {
+
+	// an opaque image becomes BC1 blocks - 8 bytes for every 4 x 4 texels
+	// of the 16 x 16, 8 x 8, 4 x 4, 2 x 2 and 1 x 1 levels
+	Image one, many;
+	compress(one, ramp, 1);
+	compress(many, ramp, 7);
+	CHECK(one.format == IMAGE_DXT1 && one.levels == 5);
+	CHECK(one.size == (16 + 4 + 1 + 1 + 1) * 8);
+	CHECK(one.size == many.size && !memcmp(one.data, many.data, one.size));
+	CHECK(decompressImage(one));
+	bool close = true;
+	for (int y = 0; y < SIDE; y++)
+		for (int x = 0; x < SIDE; x++)
+			if (!near(texel(one, x, y), ramp(x, y), 12))
+				close = false;
+	CHECK(close);
+	releaseImage(one);
+	releaseImage(many);
+
+	// an image with alpha becomes BC3 blocks
+	compress(one, cutout, 1);
+	compress(many, cutout, 3);
+	CHECK(one.format == IMAGE_DXT5 && one.levels == 5);
+	CHECK(one.size == (16 + 4 + 1 + 1 + 1) * 16);
+	CHECK(one.size == many.size && !memcmp(one.data, many.data, one.size));
+	CHECK(decompressImage(one));
+	close = true;
+	for (int y = 0; y < SIDE; y++)
+		for (int x = 0; x < SIDE; x++)
+			if (!near(texel(one, x, y), cutout(x, y), 12))
+				close = false;
+	CHECK(close);
+	releaseImage(one);
+	releaseImage(many);
+
+	// sides that are not multiples of four stay uncompressed
+	Image odd;
+	create(odd, 6, 4, grey);
+	CHECK(!compressImage(odd, 1) && odd.format == IMAGE_ARGB);
+	releaseImage(odd);
+}
+
+int main() {
+
+	testMipChain();
+	testCompression();
+	printf("TextureCompressorTest: %d failures\n", failures);
+
+	return failures;
+}